@@ -20,7 +20,6 @@ $(TEST_OUTPUT)_SRC := \
 	$(QUANTUM_SRC) \
 	$(SRC) \
 	$(QUANTUM_PATH)/keymap_introspection.c \
-	tests/test_common/matrix.c \
 	tests/test_common/test_driver.cpp \
 	tests/test_common/keyboard_report_util.cpp \
 	tests/test_common/keycode_util.cpp \
@@ -30,8 +29,15 @@ $(TEST_OUTPUT)_SRC := \
 	tests/test_common/test_logger.cpp \
 	$(patsubst $(ROOTDIR)/%,%,$(wildcard $(TEST_PATH)/*.cpp))
 
+# Tests with CUSTOM_MATRIX = lite scan and debounce through quantum/matrix_common.c
+ifeq ($(strip $(CUSTOM_MATRIX)), lite)
+    $(TEST_OUTPUT)_SRC += tests/test_common/matrix_lite.c
+else
+    $(TEST_OUTPUT)_SRC += tests/test_common/matrix.c
+endif
+
 $(TEST_OUTPUT)_DEFS := $(OPT_DEFS) "-DKEYMAP_C=\"keymap.c\""
 
-$(TEST_OUTPUT)_CONFIG := $(TEST_PATH)/config.h
+$(TEST_OUTPUT)_CONFIG := $(TEST_PATH)/config.h $(POST_CONFIG_H)
 
 VPATH += $(TOP_DIR)/tests/test_common
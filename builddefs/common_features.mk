@@ -24,6 +24,7 @@ QUANTUM_SRC += \
     $(QUANTUM_DIR)/eeconfig.c \
     $(QUANTUM_DIR)/keyboard.c \
     $(QUANTUM_DIR)/keymap_common.c \
+    $(QUANTUM_DIR)/process_keycode/process_dispatch.c \
     $(QUANTUM_DIR)/keycode_config.c \
     $(QUANTUM_DIR)/sync_timer.c \
     $(QUANTUM_DIR)/logging/debug.c \
@@ -70,6 +71,9 @@ ifeq ($(strip $(AUDIO_ENABLE)), yes)
     SRC += $(QUANTUM_DIR)/process_keycode/process_clicky.c
     SRC += $(QUANTUM_DIR)/audio/audio.c ## common audio code, hardware agnostic
     SRC += $(PLATFORM_PATH)/$(PLATFORM_KEY)/$(DRIVER_DIR)/audio_$(strip $(AUDIO_DRIVER)).c
+    ifeq ($(strip $(AUDIO_DRIVER)), dac_additive)
+        SRC += $(QUANTUM_DIR)/audio/audio_mixer.c
+    endif
     SRC += $(QUANTUM_DIR)/audio/voices.c
     SRC += $(QUANTUM_DIR)/audio/luts.c
 endif
@@ -78,6 +82,12 @@ ifeq ($(strip $(SEQUENCER_ENABLE)), yes)
     MUSIC_ENABLE = yes
 endif
 
+ifeq ($(strip $(SEND_STRING_ASYNC_ENABLE)), yes)
+    SEND_STRING_ENABLE := yes
+    OPT_DEFS += -DSEND_STRING_ASYNC_ENABLE
+    SRC += $(QUANTUM_DIR)/send_string/send_string_async.c
+endif
+
 ifeq ($(strip $(MIDI_ENABLE)), yes)
     OPT_DEFS += -DMIDI_ENABLE
     MUSIC_ENABLE = yes
@@ -355,6 +365,7 @@ ifeq ($(strip $(LED_MATRIX_ENABLE)), yes)
     SRC += $(QUANTUM_DIR)/process_keycode/process_led_matrix.c
     SRC += $(QUANTUM_DIR)/led_matrix/led_matrix.c
     SRC += $(QUANTUM_DIR)/led_matrix/led_matrix_drivers.c
+    LED_EFFECT_CORE := yes
     LIB8TION_ENABLE := yes
     CIE1931_CURVE := yes
 
@@ -463,6 +474,7 @@ ifeq ($(strip $(RGB_MATRIX_ENABLE)), yes)
     SRC += $(QUANTUM_DIR)/color.c
     SRC += $(QUANTUM_DIR)/rgb_matrix/rgb_matrix.c
     SRC += $(QUANTUM_DIR)/rgb_matrix/rgb_matrix_drivers.c
+    LED_EFFECT_CORE := yes
     LIB8TION_ENABLE := yes
     CIE1931_CURVE := yes
     RGB_KEYCODES_ENABLE := yes
@@ -615,6 +627,10 @@ ifeq ($(strip $(BACKLIGHT_ENABLE)), yes)
     endif
 endif
 
+ifeq ($(strip $(LED_EFFECT_CORE)), yes)
+    SRC += $(QUANTUM_DIR)/led_effect_core.c
+endif
+
 ifeq ($(strip $(CIE1931_CURVE)), yes)
     OPT_DEFS += -DUSE_CIE1931_CURVE
     LED_TABLES := yes
@@ -674,7 +690,8 @@ ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
     # Determine which (if any) transport files are required
     ifneq ($(strip $(SPLIT_TRANSPORT)), custom)
         QUANTUM_SRC += $(QUANTUM_DIR)/split_common/transport.c \
-                       $(QUANTUM_DIR)/split_common/transactions.c
+                       $(QUANTUM_DIR)/split_common/transactions.c \
+                       $(QUANTUM_DIR)/split_common/split_matrix_events.c
 
         OPT_DEFS += -DSPLIT_COMMON_TRANSACTIONS
 
@@ -800,6 +817,11 @@ ifeq ($(strip $(UNICODE_COMMON)), yes)
     SRC += $(QUANTUM_DIR)/process_keycode/process_unicode_common.c \
            $(QUANTUM_DIR)/unicode/unicode.c \
            $(QUANTUM_DIR)/unicode/utf8.c
+
+    ifeq ($(strip $(UNICODE_ASYNC_ENABLE)), yes)
+        OPT_DEFS += -DUNICODE_ASYNC_ENABLE
+        SRC += $(QUANTUM_DIR)/unicode/unicode_async.c
+    endif
 endif
 
 ifeq ($(strip $(PS2_MOUSE_ENABLE)), yes)
@@ -942,6 +964,9 @@ ifeq ($(strip $(WS2812_DRIVER_REQUIRED)), yes)
         ifeq ($(strip $(WS2812_DRIVER)), pwm)
             OPT_DEFS += -DSTM32_DMA_REQUIRED=TRUE
         endif
+        ifneq ($(filter $(WS2812_DRIVER),pwm spi),)
+            SRC += ws2812_encode.c
+        endif
     endif
 
     # add extra deps
@@ -43,6 +43,12 @@ ifneq ($(USE_CCACHE),no)
     CC_PREFIX ?= ccache
 endif
 
+# Share object files between the builds of a mass-compile, see lib/python/qmk/compiler_cache.py
+COMPILER_CACHE ?= no
+ifneq ($(COMPILER_CACHE),no)
+    CC_PREFIX ?= python3 $(TOP_DIR)/lib/python/qmk/compiler_cache.py
+endif
+
 #---------------- C Compiler Options ----------------
 
 ifeq ($(strip $(LTO_ENABLE)), yes)
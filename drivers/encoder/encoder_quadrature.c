@@ -17,6 +17,11 @@
 // for memcpy
 #include <string.h>
 
+#if defined(ENCODER_SAMPLE_INTERVAL_US) && defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#    define ENCODER_SAMPLE_TIMER_ENABLE
+#endif
+
 #if !defined(ENCODER_RESOLUTIONS) && !defined(ENCODER_RESOLUTION)
 #    define ENCODER_RESOLUTION 4
 #endif
@@ -83,10 +88,14 @@ static uint8_t thisHand, thatHand;
 static uint8_t thatCount;
 #endif
 
+#ifdef ENCODER_SAMPLE_TIMER_ENABLE
+static void encoder_sample_timer_start(void);
+#endif
+
 __attribute__((weak)) void encoder_quadrature_post_init_kb(void) {
     extern void encoder_quadrature_handle_read(uint8_t index, uint8_t pin_a_state, uint8_t pin_b_state);
     // Unused normally, but can be used for things like setting up pin-change interrupts in keyboard code.
-    // During the interrupt, read the pins then call `encoder_handle_read()` with the pin states and it'll queue up an encoder event if needed.
+    // During the interrupt, read the pins then call `encoder_quadrature_handle_read()` with the pin states and it'll count a detent if needed.
 }
 
 void encoder_quadrature_post_init(void) {
@@ -104,6 +113,10 @@ void encoder_quadrature_post_init(void) {
 #endif
 
     encoder_quadrature_post_init_kb();
+
+#ifdef ENCODER_SAMPLE_TIMER_ENABLE
+    encoder_sample_timer_start();
+#endif
 }
 
 void encoder_driver_init(void) {
@@ -206,8 +219,32 @@ void encoder_quadrature_handle_read(uint8_t index, uint8_t pin_a_state, uint8_t
     }
 }
 
-__attribute__((weak)) void encoder_driver_task(void) {
+// Safe to call from an interrupt, detents only ever get added to the running counts in encoder.c
+void encoder_quadrature_sample(void) {
     for (uint8_t i = 0; i < thisCount; i++) {
         encoder_quadrature_handle_read(i, encoder_quadrature_read_pin(i, false), encoder_quadrature_read_pin(i, true));
     }
 }
+
+#ifdef ENCODER_SAMPLE_TIMER_ENABLE
+
+// Pins are sampled from a timer, independently of how long the main loop takes
+static void encoder_sample_callback(virtual_timer_t *vtp, void *p) {
+    encoder_quadrature_sample();
+}
+
+static void encoder_sample_timer_start(void) {
+    static virtual_timer_t encoder_sample_vt;
+    chVTObjectInit(&encoder_sample_vt);
+    chVTSetContinuous(&encoder_sample_vt, TIME_US2I(ENCODER_SAMPLE_INTERVAL_US), encoder_sample_callback, NULL);
+}
+
+__attribute__((weak)) void encoder_driver_task(void) {}
+
+#else // ENCODER_SAMPLE_TIMER_ENABLE
+
+__attribute__((weak)) void encoder_driver_task(void) {
+    encoder_quadrature_sample();
+}
+
+#endif // ENCODER_SAMPLE_TIMER_ENABLE
@@ -15,6 +15,7 @@
 
 #pragma once
 
+#include <stdbool.h>
 #include "quantum/color.h"
 
 /*
@@ -76,3 +77,17 @@ void ws2812_init(void);
  *         - Wait 50us to reset the LEDs
  */
 void ws2812_setleds(rgb_led_t *ledarray, uint16_t number_of_leds);
+
+/*
+ * DMA backed drivers encode into a second buffer while the previous frame is
+ * still being clocked out, and return from ws2812_setleds() immediately.
+ * ws2812_busy() reports whether a previously submitted frame is still in flight,
+ * so callers can skip or coalesce frames instead of re-encoding them.
+ */
+#if defined(WS2812_SPI) || defined(WS2812_PWM)
+bool ws2812_busy(void);
+#else
+static inline bool ws2812_busy(void) {
+    return false;
+}
+#endif
@@ -0,0 +1,49 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "ws2812_encode.h"
+
+#define WS2812_SPI_SYMBOL_1 0b1110
+#define WS2812_SPI_SYMBOL_0 0b1000
+
+#define WS2812_SPI_SYMBOL(nibble, bit) (((nibble) & (1 << (bit))) ? WS2812_SPI_SYMBOL_1 : WS2812_SPI_SYMBOL_0)
+#define WS2812_SPI_NIBBLE(n) \
+    { (WS2812_SPI_SYMBOL(n, 3) << 4) | WS2812_SPI_SYMBOL(n, 2), (WS2812_SPI_SYMBOL(n, 1) << 4) | WS2812_SPI_SYMBOL(n, 0) }
+
+// Each nibble of a colour byte expands into two bytes of SPI data, MSB first.
+static const uint8_t ws2812_spi_nibble_table[16][2] = {
+    WS2812_SPI_NIBBLE(0x0), WS2812_SPI_NIBBLE(0x1), WS2812_SPI_NIBBLE(0x2), WS2812_SPI_NIBBLE(0x3), //
+    WS2812_SPI_NIBBLE(0x4), WS2812_SPI_NIBBLE(0x5), WS2812_SPI_NIBBLE(0x6), WS2812_SPI_NIBBLE(0x7), //
+    WS2812_SPI_NIBBLE(0x8), WS2812_SPI_NIBBLE(0x9), WS2812_SPI_NIBBLE(0xA), WS2812_SPI_NIBBLE(0xB), //
+    WS2812_SPI_NIBBLE(0xC), WS2812_SPI_NIBBLE(0xD), WS2812_SPI_NIBBLE(0xE), WS2812_SPI_NIBBLE(0xF), //
+};
+
+void ws2812_encode_spi(uint8_t *buffer, const rgb_led_t *ledarray, uint16_t number_of_leds) {
+    const uint8_t *channel = (const uint8_t *)ledarray;
+    uint32_t       count   = (uint32_t)number_of_leds * WS2812_CHANNELS;
+
+    for (uint32_t i = 0; i < count; i++) {
+        memcpy(buffer, ws2812_spi_nibble_table[channel[i] >> 4], 2);
+        memcpy(buffer + 2, ws2812_spi_nibble_table[channel[i] & 0x0F], 2);
+        buffer += WS2812_SPI_BYTES_PER_CHANNEL;
+    }
+}
+
+#define WS2812_ENCODE_PWM(name, type)                                                                                   \
+    void name(type *buffer, const rgb_led_t *ledarray, uint16_t number_of_leds, type duty_0, type duty_1) {             \
+        const uint8_t *channel = (const uint8_t *)ledarray;                                                             \
+        uint32_t       count   = (uint32_t)number_of_leds * WS2812_CHANNELS;                                            \
+        const type     delta   = duty_1 - duty_0;                                                                       \
+                                                                                                                        \
+        for (uint32_t i = 0; i < count; i++) {                                                                          \
+            uint8_t data = channel[i];                                                                                  \
+            for (uint8_t bit = 0; bit < 8; bit++) {                                                                     \
+                *buffer++ = duty_0 + ((data >> (7 - bit)) & 0x01) * delta;                                              \
+            }                                                                                                           \
+        }                                                                                                               \
+    }
+
+WS2812_ENCODE_PWM(ws2812_encode_pwm8, uint8_t)
+WS2812_ENCODE_PWM(ws2812_encode_pwm16, uint16_t)
+WS2812_ENCODE_PWM(ws2812_encode_pwm32, uint32_t)
@@ -0,0 +1,49 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include "color.h"
+
+#ifdef WS2812_RGBW
+#    define WS2812_CHANNELS 4
+#else
+#    define WS2812_CHANNELS 3
+#endif
+
+/*
+ * SPI encoding: every data bit is expanded into a 4-bit symbol (0b1110 for a
+ * one, 0b1000 for a zero), so a single colour channel occupies 4 bytes on the
+ * wire and a whole LED occupies WS2812_SPI_BYTES_PER_LED bytes.
+ */
+#define WS2812_SPI_BYTES_PER_CHANNEL 4
+#define WS2812_SPI_BYTES_PER_LED (WS2812_SPI_BYTES_PER_CHANNEL * WS2812_CHANNELS)
+
+/**
+ * @brief Expand an array of LED colours into the SPI bit pattern.
+ *
+ * The colour bytes of `rgb_led_t` are already stored in wire order, so the
+ * channels are encoded in memory order using a 16 entry nibble lookup table.
+ *
+ * @param buffer destination, must hold `number_of_leds * WS2812_SPI_BYTES_PER_LED` bytes
+ * @param ledarray source colours
+ * @param number_of_leds number of LEDs to encode
+ */
+void ws2812_encode_spi(uint8_t *buffer, const rgb_led_t *ledarray, uint16_t number_of_leds);
+
+/**
+ * @brief Expand an array of LED colours into one PWM duty cycle per data bit.
+ *
+ * Three variants are provided to match the width of the timer's capture/compare
+ * register (and therefore the DMA memory width) used by the PWM driver.
+ *
+ * @param buffer destination, must hold `number_of_leds * WS2812_CHANNELS * 8` elements
+ * @param ledarray source colours
+ * @param number_of_leds number of LEDs to encode
+ * @param duty_0 compare value for a zero bit
+ * @param duty_1 compare value for a one bit
+ */
+void ws2812_encode_pwm8(uint8_t *buffer, const rgb_led_t *ledarray, uint16_t number_of_leds, uint8_t duty_0, uint8_t duty_1);
+void ws2812_encode_pwm16(uint16_t *buffer, const rgb_led_t *ledarray, uint16_t number_of_leds, uint16_t duty_0, uint16_t duty_1);
+void ws2812_encode_pwm32(uint32_t *buffer, const rgb_led_t *ledarray, uint16_t number_of_leds, uint32_t duty_0, uint32_t duty_1);
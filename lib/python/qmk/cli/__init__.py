@@ -46,6 +46,7 @@ subcommands = [
     'qmk.cli.format.json',
     'qmk.cli.format.python',
     'qmk.cli.format.text',
+    'qmk.cli.generate.all',
     'qmk.cli.generate.api',
     'qmk.cli.generate.autocorrect_data',
     'qmk.cli.generate.compilation_database',
@@ -0,0 +1,67 @@
+"""Used by the make system to generate every file derived from info.json and keymap.json in one go.
+"""
+from dotty_dict import dotty
+
+from argcomplete.completers import FilesCompleter
+from milc import cli
+
+import qmk.keymap
+from qmk.info import info_json
+from qmk.commands import dump_lines, parse_configurator_json
+from qmk.keyboard import keyboard_completer, keyboard_folder
+from qmk.keymap import keymap_completer
+from qmk.path import normpath, FileType
+from qmk.cli.generate.config_h import generate_config_h_lines
+from qmk.cli.generate.keyboard_c import generate_keyboard_c_lines
+from qmk.cli.generate.keyboard_h import generate_keyboard_h_lines
+from qmk.cli.generate.keymap_h import generate_keymap_h_lines
+from qmk.cli.generate.make_dependencies import generate_make_dependencies_lines
+from qmk.cli.generate.rules_mk import generate_rules_mk_lines
+from qmk.cli.generate.version_h import generate_version_h_lines
+
+
+@cli.argument('-o', '--output', arg_only=True, type=normpath, required=True, help='Directory to write the generated files to')
+@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
+@cli.argument('-e', '--escape', arg_only=True, action='store_true', help="Escape spaces in quiet mode")
+@cli.argument('-kb', '--keyboard', arg_only=True, type=keyboard_folder, completer=keyboard_completer, required=True, help='Keyboard to generate files for.')
+@cli.argument('-km', '--keymap', arg_only=True, completer=keymap_completer, help='Keymap to generate files for.')
+@cli.argument('--keymap-json', arg_only=True, type=FileType('r'), completer=FilesCompleter('.json'), help='The keymap.json to generate keymap files from, if the keymap has one.')
+@cli.argument('-i', '--include', arg_only=True, help='The keyboard\'s own <keyboard>.h, if it has one')
+@cli.argument('--skip-git', arg_only=True, action='store_true', help='Skip Git operations for version.h')
+@cli.argument('--skip-all', arg_only=True, action='store_true', help='Use placeholder values for all defines in version.h (implies --skip-git)')
+@cli.subcommand('Used by the make system to generate every file derived from info.json and keymap.json', hidden=True)
+def generate_all(cli):
+    """Generates every file a keyboard build needs from info.json and keymap.json.
+
+    This is equivalent to running generate-rules-mk, generate-config-h, generate-keyboard-c, generate-keyboard-h, generate-make-dependencies, generate-version-h, and for a keymap.json json2c and generate-keymap-h, but resolves info.json only once. Files are only rewritten when their content changes, so make does not rebuild anything that depends on them otherwise.
+    """
+    output = cli.args.output
+    kb_info_json = info_json(cli.args.keyboard)
+    kb_info_dotty = dotty(kb_info_json)
+
+    dump_lines(output / 'info_rules.mk', generate_rules_mk_lines(kb_info_dotty))
+    dump_lines(output / 'info_config.h', generate_config_h_lines(kb_info_dotty))
+    dump_lines(output / 'default_keyboard.c', generate_keyboard_c_lines(kb_info_json))
+    dump_lines(output / 'default_keyboard.h', generate_keyboard_h_lines(cli.args.keyboard, kb_info_json, cli.args.include))
+    dump_lines(output / 'version.h', generate_version_h_lines(cli.args.skip_git, cli.args.skip_all))
+
+    # The json files are represented by the files generated from them above
+    dump_lines(output / 'info_deps.d', generate_make_dependencies_lines(cli.args.keyboard, cli.args.keymap, include_json=False))
+
+    if cli.args.keymap_json:
+        user_keymap = parse_configurator_json(cli.args.keymap_json)
+        keymap_config = dotty(user_keymap.get('config', {}))
+
+        dump_lines(output / 'rules.mk', generate_rules_mk_lines(keymap_config, True, user_keymap.get('converter', None)))
+        dump_lines(output / 'config.h', generate_config_h_lines(keymap_config, True))
+        dump_lines(output / 'keymap.c', qmk.keymap.generate_c(user_keymap).split('\n'))
+        dump_lines(output / 'keymap.h', generate_keymap_h_lines(user_keymap))
+
+    if cli.args.quiet:
+        info_rules_mk = output / 'info_rules.mk'
+        if cli.args.escape:
+            print(info_rules_mk.as_posix().replace(' ', '\\ '))
+        else:
+            print(info_rules_mk)
+    else:
+        cli.log.info('Wrote generated files to %s.', output)
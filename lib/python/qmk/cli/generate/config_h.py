@@ -14,8 +14,7 @@ from qmk.path import normpath, FileType
 from qmk.constants import GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE
 
 
-def generate_define(define, value=None):
-    is_keymap = cli.args.filename
+def generate_define(define, value=None, is_keymap=False):
     value = f' {value}' if value is not None else ''
     if is_keymap:
         return f"""
@@ -27,7 +26,7 @@ def generate_define(define, value=None):
 #endif // {define}"""
 
 
-def direct_pins(direct_pins, postfix):
+def direct_pins(direct_pins, postfix, is_keymap=False):
     """Return the config.h lines that set the direct pins.
     """
     rows = []
@@ -36,43 +35,43 @@ def direct_pins(direct_pins, postfix):
         cols = ','.join(map(str, [col or 'NO_PIN' for col in row]))
         rows.append('{' + cols + '}')
 
-    return generate_define(f'DIRECT_PINS{postfix}', f'{{ {", ".join(rows)} }}')
+    return generate_define(f'DIRECT_PINS{postfix}', f'{{ {", ".join(rows)} }}', is_keymap)
 
 
-def pin_array(define, pins, postfix):
+def pin_array(define, pins, postfix, is_keymap=False):
     """Return the config.h lines that set a pin array.
     """
     pin_array = ', '.join(map(str, [pin or 'NO_PIN' for pin in pins]))
 
-    return generate_define(f'{define}_PINS{postfix}', f'{{ {pin_array} }}')
+    return generate_define(f'{define}_PINS{postfix}', f'{{ {pin_array} }}', is_keymap)
 
 
-def matrix_pins(matrix_pins, postfix=''):
+def matrix_pins(matrix_pins, postfix='', is_keymap=False):
     """Add the matrix config to the config.h.
     """
     pins = []
 
     if 'direct' in matrix_pins:
-        pins.append(direct_pins(matrix_pins['direct'], postfix))
+        pins.append(direct_pins(matrix_pins['direct'], postfix, is_keymap))
 
     if 'cols' in matrix_pins:
-        pins.append(pin_array('MATRIX_COL', matrix_pins['cols'], postfix))
+        pins.append(pin_array('MATRIX_COL', matrix_pins['cols'], postfix, is_keymap))
 
     if 'rows' in matrix_pins:
-        pins.append(pin_array('MATRIX_ROW', matrix_pins['rows'], postfix))
+        pins.append(pin_array('MATRIX_ROW', matrix_pins['rows'], postfix, is_keymap))
 
     return '\n'.join(pins)
 
 
-def generate_matrix_size(kb_info_json, config_h_lines):
+def generate_matrix_size(kb_info_json, config_h_lines, is_keymap=False):
     """Add the matrix size to the config.h.
     """
     if 'matrix_size' in kb_info_json:
-        config_h_lines.append(generate_define('MATRIX_COLS', kb_info_json['matrix_size']['cols']))
-        config_h_lines.append(generate_define('MATRIX_ROWS', kb_info_json['matrix_size']['rows']))
+        config_h_lines.append(generate_define('MATRIX_COLS', kb_info_json['matrix_size']['cols'], is_keymap))
+        config_h_lines.append(generate_define('MATRIX_ROWS', kb_info_json['matrix_size']['rows'], is_keymap))
 
 
-def generate_matrix_masked(kb_info_json, config_h_lines):
+def generate_matrix_masked(kb_info_json, config_h_lines, is_keymap=False):
     """"Enable matrix mask if required"""
     mask_required = False
 
@@ -82,10 +81,10 @@ def generate_matrix_masked(kb_info_json, config_h_lines):
         mask_required = True
 
     if mask_required:
-        config_h_lines.append(generate_define('MATRIX_MASKED'))
+        config_h_lines.append(generate_define('MATRIX_MASKED', is_keymap=is_keymap))
 
 
-def generate_config_items(kb_info_json, config_h_lines):
+def generate_config_items(kb_info_json, config_h_lines, is_keymap=False):
     """Iterate through the info_config map to generate basic config values.
     """
     info_config_map = json_load(Path('data/mappings/info_config.hjson'))
@@ -104,28 +103,28 @@ def generate_config_items(kb_info_json, config_h_lines):
             continue
 
         if key_type.startswith('array.array'):
-            config_h_lines.append(generate_define(config_key, f'{{ {", ".join(["{" + ",".join(list(map(str, x))) + "}" for x in config_value])} }}'))
+            config_h_lines.append(generate_define(config_key, f'{{ {", ".join(["{" + ",".join(list(map(str, x))) + "}" for x in config_value])} }}', is_keymap))
         elif key_type.startswith('array'):
-            config_h_lines.append(generate_define(config_key, f'{{ {", ".join(map(str, config_value))} }}'))
+            config_h_lines.append(generate_define(config_key, f'{{ {", ".join(map(str, config_value))} }}', is_keymap))
         elif key_type == 'bool':
-            config_h_lines.append(generate_define(config_key, 'true' if config_value else 'false'))
+            config_h_lines.append(generate_define(config_key, 'true' if config_value else 'false', is_keymap))
         elif key_type == 'flag':
             if config_value:
-                config_h_lines.append(generate_define(config_key))
+                config_h_lines.append(generate_define(config_key, is_keymap=is_keymap))
         elif key_type == 'mapping':
             for key, value in config_value.items():
-                config_h_lines.append(generate_define(key, value))
+                config_h_lines.append(generate_define(key, value, is_keymap))
         elif key_type == 'str':
             escaped_str = config_value.replace('\\', '\\\\').replace('"', '\\"')
-            config_h_lines.append(generate_define(config_key, f'"{escaped_str}"'))
+            config_h_lines.append(generate_define(config_key, f'"{escaped_str}"', is_keymap))
         elif key_type == 'bcd_version':
             (major, minor, revision) = config_value.split('.')
-            config_h_lines.append(generate_define(config_key, f'0x{major.zfill(2)}{minor}{revision}'))
+            config_h_lines.append(generate_define(config_key, f'0x{major.zfill(2)}{minor}{revision}', is_keymap))
         else:
-            config_h_lines.append(generate_define(config_key, config_value))
+            config_h_lines.append(generate_define(config_key, config_value, is_keymap))
 
 
-def generate_encoder_config(encoder_json, config_h_lines, postfix=''):
+def generate_encoder_config(encoder_json, config_h_lines, postfix='', is_keymap=False):
     """Generate the config.h lines for encoders."""
     a_pads = []
     b_pads = []
@@ -135,45 +134,77 @@ def generate_encoder_config(encoder_json, config_h_lines, postfix=''):
         b_pads.append(encoder["pin_b"])
         resolutions.append(encoder.get("resolution", None))
 
-    config_h_lines.append(generate_define(f'ENCODER_A_PINS{postfix}', f'{{ {", ".join(a_pads)} }}'))
-    config_h_lines.append(generate_define(f'ENCODER_B_PINS{postfix}', f'{{ {", ".join(b_pads)} }}'))
+    config_h_lines.append(generate_define(f'ENCODER_A_PINS{postfix}', f'{{ {", ".join(a_pads)} }}', is_keymap))
+    config_h_lines.append(generate_define(f'ENCODER_B_PINS{postfix}', f'{{ {", ".join(b_pads)} }}', is_keymap))
 
     if None in resolutions:
         cli.log.debug(f"Unable to generate ENCODER_RESOLUTION{postfix} configuration")
     elif len(resolutions) == 0:
         cli.log.debug(f"Skipping ENCODER_RESOLUTION{postfix} configuration")
     elif len(set(resolutions)) == 1:
-        config_h_lines.append(generate_define(f'ENCODER_RESOLUTION{postfix}', resolutions[0]))
+        config_h_lines.append(generate_define(f'ENCODER_RESOLUTION{postfix}', resolutions[0], is_keymap))
     else:
-        config_h_lines.append(generate_define(f'ENCODER_RESOLUTIONS{postfix}', f'{{ {", ".join(map(str,resolutions))} }}'))
+        config_h_lines.append(generate_define(f'ENCODER_RESOLUTIONS{postfix}', f'{{ {", ".join(map(str,resolutions))} }}', is_keymap))
 
 
-def generate_split_config(kb_info_json, config_h_lines):
+def generate_split_config(kb_info_json, config_h_lines, is_keymap=False):
     """Generate the config.h lines for split boards."""
     if 'handedness' in kb_info_json['split']:
         # TODO: change SPLIT_HAND_MATRIX_GRID to require brackets
         handedness = kb_info_json['split']['handedness']
         if 'matrix_grid' in handedness:
-            config_h_lines.append(generate_define('SPLIT_HAND_MATRIX_GRID', ', '.join(handedness['matrix_grid'])))
+            config_h_lines.append(generate_define('SPLIT_HAND_MATRIX_GRID', ', '.join(handedness['matrix_grid']), is_keymap))
 
     if 'protocol' in kb_info_json['split'].get('transport', {}):
         if kb_info_json['split']['transport']['protocol'] == 'i2c':
-            config_h_lines.append(generate_define('USE_I2C'))
+            config_h_lines.append(generate_define('USE_I2C', is_keymap=is_keymap))
 
     if 'right' in kb_info_json['split'].get('matrix_pins', {}):
-        config_h_lines.append(matrix_pins(kb_info_json['split']['matrix_pins']['right'], '_RIGHT'))
+        config_h_lines.append(matrix_pins(kb_info_json['split']['matrix_pins']['right'], '_RIGHT', is_keymap))
 
     if 'right' in kb_info_json['split'].get('encoder', {}):
-        generate_encoder_config(kb_info_json['split']['encoder']['right'], config_h_lines, '_RIGHT')
+        generate_encoder_config(kb_info_json['split']['encoder']['right'], config_h_lines, '_RIGHT', is_keymap)
 
 
-def generate_led_animations_config(feature, led_feature_json, config_h_lines, enable_prefix, animation_prefix):
+def generate_led_animations_config(feature, led_feature_json, config_h_lines, enable_prefix, animation_prefix, is_keymap=False):
     if 'animation' in led_feature_json.get('default', {}):
-        config_h_lines.append(generate_define(f'{feature.upper()}_DEFAULT_MODE', f'{animation_prefix}{led_feature_json["default"]["animation"].upper()}'))
+        config_h_lines.append(generate_define(f'{feature.upper()}_DEFAULT_MODE', f'{animation_prefix}{led_feature_json["default"]["animation"].upper()}', is_keymap))
 
     for animation in led_feature_json.get('animations', {}):
         if led_feature_json['animations'][animation]:
-            config_h_lines.append(generate_define(f'{enable_prefix}{animation.upper()}'))
+            config_h_lines.append(generate_define(f'{enable_prefix}{animation.upper()}', is_keymap=is_keymap))
+
+
+def generate_config_h_lines(kb_info_json, is_keymap=False):
+    """Returns the lines of an info_config.h for a keyboard's info.json, or the `config` of a keymap.json when `is_keymap` is set.
+    """
+    config_h_lines = [GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE, '#pragma once']
+
+    generate_config_items(kb_info_json, config_h_lines, is_keymap)
+
+    generate_matrix_size(kb_info_json, config_h_lines, is_keymap)
+
+    generate_matrix_masked(kb_info_json, config_h_lines, is_keymap)
+
+    if 'matrix_pins' in kb_info_json:
+        config_h_lines.append(matrix_pins(kb_info_json['matrix_pins'], is_keymap=is_keymap))
+
+    if 'encoder' in kb_info_json:
+        generate_encoder_config(kb_info_json['encoder'], config_h_lines, is_keymap=is_keymap)
+
+    if 'split' in kb_info_json:
+        generate_split_config(kb_info_json, config_h_lines, is_keymap)
+
+    if 'led_matrix' in kb_info_json:
+        generate_led_animations_config('led_matrix', kb_info_json['led_matrix'], config_h_lines, 'ENABLE_LED_MATRIX_', 'LED_MATRIX_', is_keymap)
+
+    if 'rgb_matrix' in kb_info_json:
+        generate_led_animations_config('rgb_matrix', kb_info_json['rgb_matrix'], config_h_lines, 'ENABLE_RGB_MATRIX_', 'RGB_MATRIX_', is_keymap)
+
+    if 'rgblight' in kb_info_json:
+        generate_led_animations_config('rgblight', kb_info_json['rgblight'], config_h_lines, 'RGBLIGHT_EFFECT_', 'RGBLIGHT_MODE_', is_keymap)
+
+    return config_h_lines
 
 
 @cli.argument('filename', nargs='?', arg_only=True, type=FileType('r'), completer=FilesCompleter('.json'), help='A configurator export JSON to be compiled and flashed or a pre-compiled binary firmware file (bin/hex) to be flashed.')
@@ -195,32 +226,7 @@ def generate_config_h(cli):
         cli.subcommands['generate-config-h'].print_help()
         return False
 
-    # Build the info_config.h file.
-    config_h_lines = [GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE, '#pragma once']
-
-    generate_config_items(kb_info_json, config_h_lines)
-
-    generate_matrix_size(kb_info_json, config_h_lines)
-
-    generate_matrix_masked(kb_info_json, config_h_lines)
-
-    if 'matrix_pins' in kb_info_json:
-        config_h_lines.append(matrix_pins(kb_info_json['matrix_pins']))
-
-    if 'encoder' in kb_info_json:
-        generate_encoder_config(kb_info_json['encoder'], config_h_lines)
-
-    if 'split' in kb_info_json:
-        generate_split_config(kb_info_json, config_h_lines)
-
-    if 'led_matrix' in kb_info_json:
-        generate_led_animations_config('led_matrix', kb_info_json['led_matrix'], config_h_lines, 'ENABLE_LED_MATRIX_', 'LED_MATRIX_')
-
-    if 'rgb_matrix' in kb_info_json:
-        generate_led_animations_config('rgb_matrix', kb_info_json['rgb_matrix'], config_h_lines, 'ENABLE_RGB_MATRIX_', 'RGB_MATRIX_')
-
-    if 'rgblight' in kb_info_json:
-        generate_led_animations_config('rgblight', kb_info_json['rgblight'], config_h_lines, 'RGBLIGHT_EFFECT_', 'RGBLIGHT_MODE_')
+    config_h_lines = generate_config_h_lines(kb_info_json, bool(cli.args.filename))
 
     # Show the results
     dump_lines(cli.args.output, config_h_lines, cli.args.quiet)
@@ -126,6 +126,18 @@ def _gen_joystick_axes(info_data):
     return lines
 
 
+def generate_keyboard_c_lines(kb_info_json):
+    """Returns the lines of a default_keyboard.c for a keyboard's info.json.
+    """
+    keyboard_c_lines = [GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE, '#include QMK_KEYBOARD_H', '']
+
+    keyboard_c_lines.extend(_gen_led_configs(kb_info_json))
+    keyboard_c_lines.extend(_gen_matrix_mask(kb_info_json))
+    keyboard_c_lines.extend(_gen_joystick_axes(kb_info_json))
+
+    return keyboard_c_lines
+
+
 @cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
 @cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
 @cli.argument('-kb', '--keyboard', arg_only=True, type=keyboard_folder, completer=keyboard_completer, required=True, help='Keyboard to generate keyboard.c for.')
@@ -135,12 +147,8 @@ def generate_keyboard_c(cli):
     """
     kb_info_json = info_json(cli.args.keyboard)
 
-    # Build the layouts.h file.
-    keyboard_h_lines = [GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE, '#include QMK_KEYBOARD_H', '']
-
-    keyboard_h_lines.extend(_gen_led_configs(kb_info_json))
-    keyboard_h_lines.extend(_gen_matrix_mask(kb_info_json))
-    keyboard_h_lines.extend(_gen_joystick_axes(kb_info_json))
+    # Build the keyboard.c file.
+    keyboard_c_lines = generate_keyboard_c_lines(kb_info_json)
 
     # Show the results
-    dump_lines(cli.args.output, keyboard_h_lines, cli.args.quiet)
+    dump_lines(cli.args.output, keyboard_c_lines, cli.args.quiet)
@@ -86,19 +86,10 @@ def _generate_keycodes(kb_info_json):
     return lines
 
 
-@cli.argument('-i', '--include', nargs='?', arg_only=True, help='Optional file to include')
-@cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
-@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
-@cli.argument('-kb', '--keyboard', arg_only=True, type=keyboard_folder, completer=keyboard_completer, required=True, help='Keyboard to generate keyboard.h for.')
-@cli.subcommand('Used by the make system to generate keyboard.h from info.json', hidden=True)
-def generate_keyboard_h(cli):
-    """Generates the keyboard.h file.
+def generate_keyboard_h_lines(keyboard, kb_info_json, keyboard_h=None):
+    """Returns the lines of a default_keyboard.h for a keyboard's info.json, including `keyboard_h` if given.
     """
-    # Build the info.json file
-    kb_info_json = info_json(cli.args.keyboard)
-
-    keyboard_h = cli.args.include
-    dd_layouts = _generate_layouts(cli.args.keyboard, kb_info_json)
+    dd_layouts = _generate_layouts(keyboard, kb_info_json)
     dd_keycodes = _generate_keycodes(kb_info_json)
     valid_config = dd_layouts or keyboard_h
 
@@ -121,5 +112,21 @@ def generate_keyboard_h(cli):
     if not valid_config:
         keyboard_h_lines.append('#error("<keyboard>.h is required unless your keyboard uses data-driven configuration. Please rename your keyboard\'s header file to <keyboard>.h")')
 
+    return keyboard_h_lines
+
+
+@cli.argument('-i', '--include', nargs='?', arg_only=True, help='Optional file to include')
+@cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
+@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
+@cli.argument('-kb', '--keyboard', arg_only=True, type=keyboard_folder, completer=keyboard_completer, required=True, help='Keyboard to generate keyboard.h for.')
+@cli.subcommand('Used by the make system to generate keyboard.h from info.json', hidden=True)
+def generate_keyboard_h(cli):
+    """Generates the keyboard.h file.
+    """
+    # Build the info.json file
+    kb_info_json = info_json(cli.args.keyboard)
+
+    keyboard_h_lines = generate_keyboard_h_lines(cli.args.keyboard, kb_info_json, cli.args.include)
+
     # Show the results
     dump_lines(cli.args.output, keyboard_h_lines, cli.args.quiet)
@@ -31,6 +31,17 @@ def _generate_keycodes_function(keymap_json):
     return lines
 
 
+def generate_keymap_h_lines(keymap_json):
+    """Returns the lines of a keymap.h for a keymap.json.
+    """
+    keymap_h_lines = [GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE, '#pragma once', '// clang-format off']
+
+    if 'keycodes' in keymap_json and keymap_json['keycodes'] is not None:
+        keymap_h_lines += _generate_keycodes_function(keymap_json)
+
+    return keymap_h_lines
+
+
 @cli.argument('-o', '--output', arg_only=True, type=qmk.path.normpath, help='File to write to')
 @cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
 @cli.argument('filename', type=qmk.path.FileType('r'), arg_only=True, completer=FilesCompleter('.json'), help='Configurator JSON file')
@@ -41,11 +52,8 @@ def generate_keymap_h(cli):
     if cli.args.output and cli.args.output.name == '-':
         cli.args.output = None
 
-    keymap_h_lines = [GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE, '#pragma once', '// clang-format off']
-
     keymap_json = parse_configurator_json(cli.args.filename)
 
-    if 'keycodes' in keymap_json and keymap_json['keycodes'] is not None:
-        keymap_h_lines += _generate_keycodes_function(keymap_json)
+    keymap_h_lines = generate_keymap_h_lines(keymap_json)
 
     dump_lines(cli.args.output, keymap_h_lines, cli.args.quiet)
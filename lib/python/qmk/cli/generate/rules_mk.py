@@ -14,13 +14,12 @@ from qmk.path import normpath, FileType
 from qmk.constants import GPL2_HEADER_SH_LIKE, GENERATED_HEADER_SH_LIKE
 
 
-def generate_rule(rules_key, rules_value):
-    is_keymap = cli.args.filename
+def generate_rule(rules_key, rules_value, is_keymap=False):
     rule_assignment_operator = '=' if is_keymap else '?='
     return f'{rules_key} {rule_assignment_operator} {rules_value}'
 
 
-def process_mapping_rule(kb_info_json, rules_key, info_dict):
+def process_mapping_rule(kb_info_json, rules_key, info_dict, is_keymap=False):
     """Return the rules.mk line(s) for a mapping rule.
     """
     if not info_dict.get('to_c', True):
@@ -35,45 +34,26 @@ def process_mapping_rule(kb_info_json, rules_key, info_dict):
         return None
 
     if key_type in ['array', 'list']:
-        return generate_rule(rules_key, " ".join(rules_value))
+        return generate_rule(rules_key, " ".join(rules_value), is_keymap)
     elif key_type == 'bool':
-        return generate_rule(rules_key, "yes" if rules_value else "no")
+        return generate_rule(rules_key, "yes" if rules_value else "no", is_keymap)
     elif key_type == 'mapping':
-        return '\n'.join([generate_rule(key, value) for key, value in rules_value.items()])
+        return '\n'.join([generate_rule(key, value, is_keymap) for key, value in rules_value.items()])
     elif key_type == 'str':
-        return generate_rule(rules_key, f'"{rules_value}"')
+        return generate_rule(rules_key, f'"{rules_value}"', is_keymap)
 
-    return generate_rule(rules_key, rules_value)
+    return generate_rule(rules_key, rules_value, is_keymap)
 
 
-@cli.argument('filename', nargs='?', arg_only=True, type=FileType('r'), completer=FilesCompleter('.json'), help='A configurator export JSON to be compiled and flashed or a pre-compiled binary firmware file (bin/hex) to be flashed.')
-@cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
-@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
-@cli.argument('-e', '--escape', arg_only=True, action='store_true', help="Escape spaces in quiet mode")
-@cli.argument('-kb', '--keyboard', arg_only=True, type=keyboard_folder, completer=keyboard_completer, help='Keyboard to generate rules.mk for.')
-@cli.subcommand('Used by the make system to generate rules.mk from info.json', hidden=True)
-def generate_rules_mk(cli):
-    """Generates a rules.mk file from info.json.
+def generate_rules_mk_lines(kb_info_json, is_keymap=False, converter=None):
+    """Returns the lines of a rules.mk for a keyboard's info.json, or the `config` of a keymap.json when `is_keymap` is set.
     """
-    converter = None
-    # Determine our keyboard/keymap
-    if cli.args.filename:
-        user_keymap = parse_configurator_json(cli.args.filename)
-        kb_info_json = dotty(user_keymap.get('config', {}))
-        converter = user_keymap.get('converter', None)
-    elif cli.args.keyboard:
-        kb_info_json = dotty(info_json(cli.args.keyboard))
-    else:
-        cli.log.error('You must supply a configurator export or `--keyboard`.')
-        cli.subcommands['generate-rules-mk'].print_help()
-        return False
-
     info_rules_map = json_load(Path('data/mappings/info_rules.hjson'))
     rules_mk_lines = [GPL2_HEADER_SH_LIKE, GENERATED_HEADER_SH_LIKE]
 
     # Iterate through the info_rules map to generate basic rules
     for rules_key, info_dict in info_rules_map.items():
-        new_entry = process_mapping_rule(kb_info_json, rules_key, info_dict)
+        new_entry = process_mapping_rule(kb_info_json, rules_key, info_dict, is_keymap)
 
         if new_entry:
             rules_mk_lines.append(new_entry)
@@ -83,21 +63,48 @@ def generate_rules_mk(cli):
         for feature, enabled in kb_info_json['features'].items():
             feature = feature.upper()
             enabled = 'yes' if enabled else 'no'
-            rules_mk_lines.append(generate_rule(f'{feature}_ENABLE', enabled))
+            rules_mk_lines.append(generate_rule(f'{feature}_ENABLE', enabled, is_keymap))
 
     # Set SPLIT_TRANSPORT, if needed
     if kb_info_json.get('split', {}).get('transport', {}).get('protocol') == 'custom':
-        rules_mk_lines.append(generate_rule('SPLIT_TRANSPORT', 'custom'))
+        rules_mk_lines.append(generate_rule('SPLIT_TRANSPORT', 'custom', is_keymap))
 
     # Set CUSTOM_MATRIX, if needed
     if kb_info_json.get('matrix_pins', {}).get('custom'):
         if kb_info_json.get('matrix_pins', {}).get('custom_lite'):
-            rules_mk_lines.append(generate_rule('CUSTOM_MATRIX', 'lite'))
+            rules_mk_lines.append(generate_rule('CUSTOM_MATRIX', 'lite', is_keymap))
         else:
-            rules_mk_lines.append(generate_rule('CUSTOM_MATRIX', 'yes'))
+            rules_mk_lines.append(generate_rule('CUSTOM_MATRIX', 'yes', is_keymap))
 
     if converter:
-        rules_mk_lines.append(generate_rule('CONVERT_TO', converter))
+        rules_mk_lines.append(generate_rule('CONVERT_TO', converter, is_keymap))
+
+    return rules_mk_lines
+
+
+@cli.argument('filename', nargs='?', arg_only=True, type=FileType('r'), completer=FilesCompleter('.json'), help='A configurator export JSON to be compiled and flashed or a pre-compiled binary firmware file (bin/hex) to be flashed.')
+@cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
+@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
+@cli.argument('-e', '--escape', arg_only=True, action='store_true', help="Escape spaces in quiet mode")
+@cli.argument('-kb', '--keyboard', arg_only=True, type=keyboard_folder, completer=keyboard_completer, help='Keyboard to generate rules.mk for.')
+@cli.subcommand('Used by the make system to generate rules.mk from info.json', hidden=True)
+def generate_rules_mk(cli):
+    """Generates a rules.mk file from info.json.
+    """
+    converter = None
+    # Determine our keyboard/keymap
+    if cli.args.filename:
+        user_keymap = parse_configurator_json(cli.args.filename)
+        kb_info_json = dotty(user_keymap.get('config', {}))
+        converter = user_keymap.get('converter', None)
+    elif cli.args.keyboard:
+        kb_info_json = dotty(info_json(cli.args.keyboard))
+    else:
+        cli.log.error('You must supply a configurator export or `--keyboard`.')
+        cli.subcommands['generate-rules-mk'].print_help()
+        return False
+
+    rules_mk_lines = generate_rules_mk_lines(kb_info_json, bool(cli.args.filename), converter)
 
     # Show the results
     dump_lines(cli.args.output, rules_mk_lines)
@@ -12,23 +12,18 @@ from qmk.constants import GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE
 TIME_FMT = '%Y-%m-%d-%H:%M:%S'
 
 
-@cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
-@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
-@cli.argument('--skip-git', arg_only=True, action='store_true', help='Skip Git operations')
-@cli.argument('--skip-all', arg_only=True, action='store_true', help='Use placeholder values for all defines (implies --skip-git)')
-@cli.subcommand('Used by the make system to generate version.h for use in code', hidden=True)
-def generate_version_h(cli):
-    """Generates the version.h file.
+def generate_version_h_lines(skip_git=False, skip_all=False):
+    """Returns the lines of a version.h, with placeholders for the git derived values if `skip_git` is set, and for all of them if `skip_all` is.
     """
-    if cli.args.skip_all:
-        cli.args.skip_git = True
+    if skip_all:
+        skip_git = True
 
-    if cli.args.skip_all:
+    if skip_all:
         current_time = "1970-01-01-00:00:00"
     else:
         current_time = strftime(TIME_FMT)
 
-    if cli.args.skip_git:
+    if skip_git:
         git_dirty = False
         git_version = "NA"
         git_qmk_hash = "NA"
@@ -54,5 +49,18 @@ def generate_version_h(cli):
 """
     )
 
+    return version_h_lines
+
+
+@cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
+@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
+@cli.argument('--skip-git', arg_only=True, action='store_true', help='Skip Git operations')
+@cli.argument('--skip-all', arg_only=True, action='store_true', help='Use placeholder values for all defines (implies --skip-git)')
+@cli.subcommand('Used by the make system to generate version.h for use in code', hidden=True)
+def generate_version_h(cli):
+    """Generates the version.h file.
+    """
+    version_h_lines = generate_version_h_lines(cli.args.skip_git, cli.args.skip_all)
+
     # Show the results
     dump_lines(cli.args.output, version_h_lines, cli.args.quiet)
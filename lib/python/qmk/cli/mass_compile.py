@@ -11,12 +11,13 @@ import shlex
 
 from qmk.constants import QMK_FIRMWARE
 from qmk.commands import find_make, get_make_parallel_args, build_environment
+from qmk.compiler_cache import read_stats, reset_stats
 from qmk.search import search_keymap_targets, search_make_targets
 from qmk.build_targets import BuildTarget, JsonKeymapBuildTarget
 from qmk.util import maybe_exit_config
 
 
-def mass_compile_targets(targets: List[BuildTarget], clean: bool, dry_run: bool, no_temp: bool, parallel: int, **env):
+def mass_compile_targets(targets: List[BuildTarget], clean: bool, dry_run: bool, no_temp: bool, parallel: int, compiler_cache: bool = True, **env):
     if len(targets) == 0:
         return
 
@@ -33,6 +34,11 @@ def mass_compile_targets(targets: List[BuildTarget], clean: bool, dry_run: bool,
         if clean:
             cli.run([make_cmd, 'clean'], capture_output=False, stdin=DEVNULL)
 
+        if compiler_cache:
+            # Identical translation units across targets are compiled once, and reused by the rest
+            env['COMPILER_CACHE'] = 'yes'
+            reset_stats()
+
         builddir.mkdir(parents=True, exist_ok=True)
         with open(makefile, "w") as f:
             for target in sorted(targets, key=lambda t: (t.keyboard, t.keymap)):
@@ -85,6 +91,11 @@ all: {target_filename}{target_suffix}_binary
 
         cli.run([find_make(), *get_make_parallel_args(parallel), '-f', makefile.as_posix(), 'all'], capture_output=False, stdin=DEVNULL)
 
+        if compiler_cache:
+            hits, misses = read_stats()
+            if hits + misses > 0:
+                cli.log.info('Compiler cache: %d hits, %d misses (%d%% of compiles reused)', hits, misses, 100 * hits // (hits + misses))
+
         # Check for failures
         failures = [f for f in builddir.glob(f'failed.log.{os.getpid()}.*')]
         if len(failures) > 0:
@@ -93,6 +104,7 @@ all: {target_filename}{target_suffix}_binary
 
 @cli.argument('builds', nargs='*', arg_only=True, help="List of builds in form <keyboard>:<keymap> to compile in parallel. Specifying this overrides all other target search options.")
 @cli.argument('-t', '--no-temp', arg_only=True, action='store_true', help="Remove temporary files during build.")
+@cli.argument('--no-compiler-cache', arg_only=True, action='store_true', help="Compile every target from scratch, instead of sharing identical object files between them.")
 @cli.argument('-j', '--parallel', type=int, default=1, help="Set the number of parallel make jobs; 0 means unlimited.")
 @cli.argument('-c', '--clean', arg_only=True, action='store_true', help="Remove object files before compiling.")
 @cli.argument('-n', '--dry-run', arg_only=True, action='store_true', help="Don't actually build, just show the commands to be run.")
@@ -121,4 +133,4 @@ def mass_compile(cli):
     else:
         targets = search_keymap_targets([('all', cli.config.mass_compile.keymap)], cli.args.filter)
 
-    return mass_compile_targets(targets, cli.args.clean, cli.args.dry_run, cli.args.no_temp, cli.config.mass_compile.parallel, **build_environment(cli.args.env))
+    return mass_compile_targets(targets, cli.args.clean, cli.args.dry_run, cli.args.no_temp, cli.config.mass_compile.parallel, not cli.args.no_compiler_cache, **build_environment(cli.args.env))
@@ -0,0 +1,156 @@
+"""Compiler wrapper that shares object files between builds.
+
+Used as `CC_PREFIX` when `COMPILER_CACHE = yes`. Every `-c` compile is keyed on its preprocessed source, with line markers removed, plus the flags that still matter once preprocessing is done. Builds of different keyboards that compile the same translation unit with the same effective config therefore get the same key, even though their generated headers live in different directories.
+
+This runs once per compiled file, so it is kept to the standard library and does not import the rest of the qmk package.
+"""
+import hashlib
+import os
+import shutil
+import subprocess
+import sys
+from pathlib import Path
+
+CACHE_DIR = Path(os.environ.get('QMK_COMPILER_CACHE_DIR', '.build/compiler_cache'))
+STATS_FILE = 'stats.txt'
+SOURCE_SUFFIXES = ('.c', '.cc', '.cpp')
+
+# Options whose effect is fully captured by the preprocessed source, or which only name the output files
+SKIP_WITH_VALUE = ('-o', '-MF', '-MT', '-MQ', '-include', '-imacros', '-I', '-iquote', '-isystem', '-idirafter', '-D', '-U')
+SKIP_PREFIXES = ('-I', '-D', '-U', '-MF', '-MT', '-MQ')
+SKIP_FLAGS = ('-c', '-MMD', '-MD', '-MP')
+
+
+def cache_key(compiler, args, source, preprocessed):
+    """Returns the cache key for a compile, from the compiler binary, the flags that affect code generation, and the preprocessed source.
+    """
+    sha = hashlib.sha256()
+    compiler_path = shutil.which(compiler)
+    if compiler_path:
+        stat = os.stat(compiler_path)
+        sha.update(f'{compiler_path}\0{stat.st_size}\0{stat.st_mtime_ns}\0'.encode())
+    else:
+        sha.update(f'{compiler}\0'.encode())
+
+    skip_next = False
+    for arg in args:
+        if skip_next:
+            skip_next = False
+        elif arg in SKIP_WITH_VALUE:
+            skip_next = True
+        elif arg in SKIP_FLAGS or arg == source or arg.startswith(SKIP_PREFIXES):
+            continue
+        else:
+            sha.update(arg.encode() + b'\0')
+
+    sha.update(preprocessed)
+    return sha.hexdigest()
+
+
+def preprocess_command(compiler, args, output):
+    """Turns a `-c ... -o <output>` command into one that writes the preprocessed source to stdout.
+
+    Any dependency file the original command would have written is still written, with the object file as its target.
+    """
+    command = [compiler]
+    skip_next = False
+    for arg in args:
+        if skip_next:
+            skip_next = False
+        elif arg == '-o':
+            skip_next = True
+        elif arg == '-c':
+            command.append('-E')
+        else:
+            command.append(arg)
+
+    command.extend(['-P', '-o', '-'])
+    if '-MMD' in args or '-MD' in args:
+        command.extend(['-MT', output])
+
+    return command
+
+
+def record(result):
+    """Appends a hit or miss to the stats file. Single short appends are atomic, so parallel compiles do not need to lock.
+    """
+    CACHE_DIR.mkdir(parents=True, exist_ok=True)
+    with open(CACHE_DIR / STATS_FILE, 'a') as f:
+        f.write(f'{result}\n')
+
+
+def read_stats():
+    """Returns the number of hits and misses recorded since the stats were last reset.
+    """
+    try:
+        results = (CACHE_DIR / STATS_FILE).read_text().split()
+    except FileNotFoundError:
+        results = []
+
+    return results.count('hit'), results.count('miss')
+
+
+def reset_stats():
+    """Clears the recorded hits and misses, keeping the cached objects.
+    """
+    try:
+        (CACHE_DIR / STATS_FILE).unlink()
+    except FileNotFoundError:
+        pass
+
+
+def store(entry, output, stderr):
+    """Copies a freshly compiled object, and the diagnostics printed while compiling it, into the cache.
+    """
+    entry.parent.mkdir(parents=True, exist_ok=True)
+    err = entry.with_suffix('.err')
+    temp_object = entry.parent / f'{entry.name}.{os.getpid()}.tmp'
+    temp_err = entry.parent / f'{err.name}.{os.getpid()}.tmp'
+
+    # Written under names of their own and renamed into place, the object last, as its presence marks a complete entry
+    shutil.copyfile(output, temp_object)
+    temp_err.write_bytes(stderr)
+    os.replace(temp_err, err)
+    os.replace(temp_object, entry)
+
+
+def cached_compile(compiler, args):
+    """Runs a compile through the cache, returning the compiler's exit code.
+    """
+    sources = [arg for arg in args if arg.endswith(SOURCE_SUFFIXES)]
+    cacheable = '-c' in args and '-o' in args and len(sources) == 1 and not any(arg.startswith('-Wa,-adhlns') for arg in args)
+    if not cacheable:
+        return subprocess.call([compiler, *args])
+
+    output = args[args.index('-o') + 1]
+    preprocessed = subprocess.run(preprocess_command(compiler, args, output), stdout=subprocess.PIPE, stderr=subprocess.DEVNULL)
+    if preprocessed.returncode != 0:
+        # Let the real compile report the error
+        return subprocess.call([compiler, *args])
+
+    key = cache_key(compiler, args, sources[0], preprocessed.stdout)
+    entry = CACHE_DIR / key[:2] / f'{key}.o'
+
+    if entry.exists():
+        try:
+            shutil.copyfile(entry, output)
+            sys.stderr.buffer.write(entry.with_suffix('.err').read_bytes())
+            record('hit')
+            return 0
+        except OSError:
+            pass
+
+    result = subprocess.run([compiler, *args], stderr=subprocess.PIPE)
+    sys.stderr.buffer.write(result.stderr)
+    if result.returncode == 0:
+        try:
+            store(entry, output, result.stderr)
+        except OSError:
+            pass
+
+    record('miss')
+    return result.returncode
+
+
+if __name__ == '__main__':
+    sys.exit(cached_compile(sys.argv[1], sys.argv[2:]))
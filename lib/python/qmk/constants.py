@@ -136,6 +136,9 @@ ROW_LETTERS = '0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnop'
 BUILD_DIR = environ.get('BUILD_DIR', '.build')
 INTERMEDIATE_OUTPUT_PREFIX = f'{BUILD_DIR}/obj_'
 
+# Where info_json() caches resolved keyboard data
+INFO_CACHE_DIR = Path(BUILD_DIR) / 'info_cache'
+
 # Headers for generated files
 GPL2_HEADER_C_LIKE = f'''\
 // Copyright {date.today().year} QMK
@@ -1,13 +1,18 @@
 """Functions that help us generate and use info.json files.
 """
+import hashlib
+import logging
+import os
+import pickle
 import re
+from functools import lru_cache
 from pathlib import Path
 import jsonschema
 from dotty_dict import dotty
 
 from milc import cli
 
-from qmk.constants import COL_LETTERS, ROW_LETTERS, CHIBIOS_PROCESSORS, LUFA_PROCESSORS, VUSB_PROCESSORS, JOYSTICK_AXES
+from qmk.constants import COL_LETTERS, ROW_LETTERS, CHIBIOS_PROCESSORS, LUFA_PROCESSORS, VUSB_PROCESSORS, JOYSTICK_AXES, INFO_CACHE_DIR
 from qmk.c_parse import find_layouts, parse_config_h_file, find_led_config
 from qmk.json_schema import deep_update, json_load, validate
 from qmk.keyboard import config_h, rules_mk
@@ -212,8 +217,81 @@ def _validate(keyboard, info_data):
         maybe_exit(1)
 
 
+class _LogRecorder(logging.Handler):
+    """Collects the warnings and errors logged while generating info.json data, so they can be repeated for cache hits.
+    """
+    def __init__(self):
+        super().__init__(logging.WARNING)
+        self.records = []
+
+    def emit(self, record):
+        self.records.append((record.levelno, record.getMessage()))
+
+
+@lru_cache(maxsize=1)
+def _info_cache_version():
+    """Returns a hash of the schemas, mappings and code used to generate info.json data.
+    """
+    sha = hashlib.sha256()
+    inputs = [*Path('data/schemas').glob('*.jsonschema'), *Path('data/mappings').glob('**/*.hjson'), *Path(__file__).parent.glob('*.py')]
+
+    for file in sorted(inputs):
+        sha.update(str(file).encode() + b'\0' + file.read_bytes())
+
+    return sha.hexdigest()
+
+
+def _info_cache_file(keyboard, force_layout):
+    """Returns the cache file for a keyboard, named for the hash of every file info_json() could read for it.
+
+    That is every file directly inside each folder from `keyboards/` down to the keyboard: info.json, keyboard.json, config.h, rules.mk, <keyboard>.h and <keyboard>.c, and the names of the community layouts in `layouts/default/`.
+    """
+    sha = hashlib.sha256(f'{_info_cache_version()}\0{keyboard}\0{force_layout}'.encode())
+
+    community_layouts = Path('layouts/default')
+    if community_layouts.is_dir():
+        sha.update(b'\0' + '\0'.join(sorted(layout.name for layout in community_layouts.iterdir())).encode())
+    cur_dir = Path('keyboards')
+
+    for directory in Path(keyboard).parts:
+        cur_dir = cur_dir / directory
+        if not cur_dir.is_dir():
+            break
+
+        for file in sorted(cur_dir.iterdir()):
+            if file.is_file():
+                sha.update(b'\0' + file.name.encode() + b'\0' + file.read_bytes())
+
+    return INFO_CACHE_DIR / f'{sha.hexdigest()}.pickle'
+
+
+def _info_cache_load(cache_file):
+    """Returns the cached info.json data and log records, or None if there is no usable entry.
+    """
+    try:
+        with open(cache_file, 'rb') as f:
+            return pickle.load(f)
+    except (OSError, EOFError, pickle.UnpicklingError):
+        return None
+
+
+def _info_cache_store(cache_file, info_data, records):
+    """Stores info.json data in the cache. The file is written under a temporary name first, as other processes may be reading it.
+    """
+    try:
+        cache_file.parent.mkdir(parents=True, exist_ok=True)
+        temp_file = cache_file.with_name(f'{cache_file.name}.{os.getpid()}')
+        with open(temp_file, 'wb') as f:
+            pickle.dump((info_data, records), f)
+        os.replace(temp_file, cache_file)
+    except OSError as e:
+        cli.log.debug('Could not cache info.json data in %s: %s', cache_file, e)
+
+
 def info_json(keyboard, force_layout=None):
     """Generate the info.json data for a specific keyboard.
+
+    The result is cached in `INFO_CACHE_DIR`, keyed by a hash of all of its input files and the schemas, so an unchanged keyboard is neither parsed nor validated again. Any warnings or errors are logged again for cache hits. Set `SKIP_INFO_CACHE` in the environment to bypass the cache.
     """
     cur_dir = Path('keyboards')
     root_rules_mk = parse_rules_mk_file(cur_dir / keyboard / 'rules.mk')
@@ -221,6 +299,34 @@ def info_json(keyboard, force_layout=None):
     if 'DEFAULT_FOLDER' in root_rules_mk:
         keyboard = root_rules_mk['DEFAULT_FOLDER']
 
+    if os.environ.get('SKIP_INFO_CACHE'):
+        return _info_json(keyboard, force_layout)
+
+    cache_file = _info_cache_file(keyboard, force_layout)
+    cached = _info_cache_load(cache_file)
+
+    if cached:
+        info_data, records = cached
+        for level, message in records:
+            cli.log.log(level, '%s', message)
+
+        return info_data
+
+    recorder = _LogRecorder()
+    cli.log.addHandler(recorder)
+    try:
+        info_data = _info_json(keyboard, force_layout)
+    finally:
+        cli.log.removeHandler(recorder)
+
+    _info_cache_store(cache_file, info_data, recorder.records)
+
+    return info_data
+
+
+def _info_json(keyboard, force_layout):
+    """Parses, merges and validates the info.json data for a keyboard, after DEFAULT_FOLDER has been resolved.
+    """
     info_data = {
         'keyboard_name': str(keyboard),
         'keyboard_folder': str(keyboard),
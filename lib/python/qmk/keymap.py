@@ -29,9 +29,7 @@ __INCLUDES__
  * This file was generated by qmk json2c. You may or may not want to
  * edit it directly.
  */
-const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
 __KEYMAP_GOES_HERE__
-};
 
 #if defined(ENCODER_ENABLE) && defined(ENCODER_MAP_ENABLE)
 const uint16_t PROGMEM encoder_map[][NUM_ENCODERS][NUM_DIRECTIONS] = {
@@ -39,18 +37,110 @@ __ENCODER_MAP_GOES_HERE__
 };
 #endif // defined(ENCODER_ENABLE) && defined(ENCODER_MAP_ENABLE)
 
+__LEADER_SEQUENCES_GOES_HERE__
 __MACRO_OUTPUT_GOES_HERE__
 """
 
 
+# Keycodes left out of sparse keymaps, as they fall through to the layer below
+TRANSPARENT_KEYCODES = ('KC_TRANSPARENT', 'KC_TRNS', '_______')
+
+
 def _generate_keymap_table(keymap_json):
-    lines = []
+    lines = ['const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {']
     for layer_num, layer in enumerate(keymap_json['layers']):
         if layer_num != 0:
             lines[-1] = lines[-1] + ','
         layer = map(_strip_any, layer)
         layer_keys = ', '.join(layer)
         lines.append('    [%s] = %s(%s)' % (layer_num, keymap_json['layout'], layer_keys))
+    lines.append('};')
+    return lines
+
+
+def _matrix_layers(keymap_json):
+    """Rearranges the layers of a keymap from layout order into matrix order.
+
+    Returns the matrix size, and each layer as a flat list of `rows * cols` keycodes, with `None` for matrix positions the layout does not use.
+    """
+    kb_info_json = info_json(keymap_json['keyboard'])
+    layout_name = kb_info_json.get('layout_aliases', {}).get(keymap_json['layout'], keymap_json['layout'])
+    if layout_name not in kb_info_json.get('layouts', {}):
+        raise ValueError(f'Keyboard {keymap_json["keyboard"]} has no layout {keymap_json["layout"]}.')
+
+    layout = kb_info_json['layouts'][layout_name]['layout']
+    rows = kb_info_json['matrix_size']['rows']
+    cols = kb_info_json['matrix_size']['cols']
+
+    matrix_layers = []
+    for layer_num, layer in enumerate(keymap_json['layers']):
+        if len(layer) != len(layout):
+            raise ValueError(f'Layer {layer_num} has {len(layer)} keys, but {layout_name} has {len(layout)}.')
+
+        matrix_layer = [None] * (rows * cols)
+        for key, keycode in zip(layout, layer):
+            row, col = key['matrix']
+            matrix_layer[row * cols + col] = _strip_any(keycode)
+        matrix_layers.append(matrix_layer)
+
+    return rows, cols, matrix_layers
+
+
+def _generate_sparse_keymap_tables(matrix_layers, rows, cols):
+    """Builds the tables of a sparse keymap from layers in matrix order, as returned by `_matrix_layers()`.
+
+    Each layer is stored as a bitmap of the keys that are not transparent, 32 matrix positions per word, plus the keycodes of only those keys. For each bitmap word, the index table holds the number of keycodes stored before it, so a key's keycode is found by adding the set bits below it in its word. Matrix positions the layout does not use are marked in the unused bitmap, and read as `KC_NO` like they do in dense keymaps.
+    """
+    words = (rows * cols + 31) // 32
+    bitmap = []
+    index = []
+    keycodes = []
+    unused = [0] * words
+
+    for layer in matrix_layers:
+        layer_bitmap = [0] * words
+        for word in range(words):
+            index.append(len(keycodes))
+            for bit in range(word * 32, min(word * 32 + 32, rows * cols)):
+                if layer[bit] is None:
+                    unused[word] |= 1 << (bit % 32)
+                elif layer[bit] not in TRANSPARENT_KEYCODES:
+                    layer_bitmap[word] |= 1 << (bit % 32)
+                    keycodes.append(layer[bit])
+        bitmap.append(layer_bitmap)
+
+    return bitmap, index, keycodes, unused
+
+
+def _generate_sparse_keymap(keymap_json):
+    rows, cols, matrix_layers = _matrix_layers(keymap_json)
+    bitmap, index, keycodes, unused = _generate_sparse_keymap_tables(matrix_layers, rows, cols)
+    words = len(unused)
+
+    lines = [
+        '// Sparse keymap, see keycode_at_keymap_location_raw() in keymap_introspection.c',
+        '#define KEYMAP_SPARSE',
+        '',
+        'const uint32_t PROGMEM keymap_sparse_bitmap[] = {',
+    ]
+    for layer_num, layer_bitmap in enumerate(bitmap):
+        lines.append(f'    /* {layer_num} */ ' + ', '.join(f'0x{word:08X}' for word in layer_bitmap) + ',')
+    lines.append('};')
+
+    lines.append('const uint16_t PROGMEM keymap_sparse_index[] = {')
+    for layer_num in range(len(bitmap)):
+        lines.append(f'    /* {layer_num} */ ' + ', '.join(map(str, index[layer_num * words:(layer_num + 1) * words])) + ',')
+    lines.append('};')
+
+    lines.append('const uint16_t PROGMEM keymap_sparse_keycodes[] = {')
+    for layer_num in range(len(bitmap)):
+        start = index[layer_num * words]
+        end = index[(layer_num + 1) * words] if layer_num + 1 < len(bitmap) else len(keycodes)
+        if end > start:
+            lines.append(f'    /* {layer_num} */ ' + ', '.join(keycodes[start:end]) + ',')
+    lines.append('};')
+
+    lines.append('const uint32_t PROGMEM keymap_sparse_unused[] = {' + ', '.join(f'0x{word:08X}' for word in unused) + '};')
     return lines
 
 
@@ -64,6 +154,35 @@ def _generate_encodermap_table(keymap_json):
     return lines
 
 
+def _generate_leader_sequences(keymap_json):
+    """Generates the leader sequence table, keeping sequences that share a prefix next to each other.
+    """
+    trie = {}
+    for leader in keymap_json['leader_sequences']:
+        node = trie
+        for keycode in leader['sequence']:
+            node = node.setdefault(keycode, {})
+        node[None] = leader['keycode']
+
+    sequences = []
+
+    def _walk(node, prefix):
+        for keycode, child in node.items():
+            if keycode is None:
+                sequence_keys = ', '.join(map(_strip_any, prefix))
+                sequences.append(f'    LEADER_SEQUENCE({_strip_any(child)}, {sequence_keys})')
+            else:
+                _walk(child, prefix + [keycode])
+
+    _walk(trie, [])
+
+    lines = ['#ifdef LEADER_ENABLE', 'LEADER_SEQUENCES(']
+    lines.append(',\n'.join(sequences))
+    lines.append(')')
+    lines.append('#endif // LEADER_ENABLE')
+    return lines
+
+
 def _generate_macros_function(keymap_json):
     macro_txt = [
         'bool process_record_user(uint16_t keycode, keyrecord_t *record) {',
@@ -269,9 +388,18 @@ def generate_c(keymap_json):
 
         macros
             A sequence of strings containing macros to implement for this keyboard.
+
+        leader_sequences
+            An array of leader key sequences, and the keycode each of them sends.
+
+        keymap_format
+            `sparse` to store only the keys of each layer that are not `KC_TRNS`, instead of every key.
     """
     new_keymap = DEFAULT_KEYMAP_C
-    layer_txt = _generate_keymap_table(keymap_json)
+    if keymap_json.get('keymap_format') == 'sparse':
+        layer_txt = _generate_sparse_keymap(keymap_json)
+    else:
+        layer_txt = _generate_keymap_table(keymap_json)
     keymap = '\n'.join(layer_txt)
     new_keymap = new_keymap.replace('__KEYMAP_GOES_HERE__', keymap)
 
@@ -281,6 +409,12 @@ def generate_c(keymap_json):
         encodermap = '\n'.join(encoder_txt)
     new_keymap = new_keymap.replace('__ENCODER_MAP_GOES_HERE__', encodermap)
 
+    leader_sequences = ''
+    if keymap_json.get('leader_sequences'):
+        leader_txt = _generate_leader_sequences(keymap_json)
+        leader_sequences = '\n'.join(leader_txt)
+    new_keymap = new_keymap.replace('__LEADER_SEQUENCES_GOES_HERE__', leader_sequences)
+
     macros = ''
     if 'macros' in keymap_json and keymap_json['macros'] is not None:
         macro_txt = _generate_macros_function(keymap_json)
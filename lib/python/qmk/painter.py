@@ -1,11 +1,18 @@
 """Functions that help us work with Quantum Painter's file formats.
 """
 import datetime
+import itertools
 import math
 import re
 from string import Template
 from PIL import Image, ImageOps
 
+# NumPy is used to convert whole images at once, falling back to converting pixel by pixel if it's not installed
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
 # The list of valid formats Quantum Painter supports
 valid_formats = {
     'rgb888': {
@@ -299,6 +306,27 @@ def rgb_to565(r, g, b):
     return [msb, lsb]
 
 
+def pack_pixels(values, pixels_per_byte, shifter, expected_byte_count):
+    """Packs per-pixel values of `shifter` bits each into bytes, first pixel in the least significant bits.
+    """
+    if numpy is not None:
+        packed = numpy.zeros(expected_byte_count * pixels_per_byte, dtype=numpy.uint16)
+        packed[:len(values)] = values
+        packed = packed.reshape(expected_byte_count, pixels_per_byte) << (numpy.arange(pixels_per_byte, dtype=numpy.uint16) * shifter)
+        return numpy.bitwise_or.reduce(packed, axis=1).tolist()
+
+    values_len = len(values)
+    bytearray = []
+    for x in range(expected_byte_count):
+        byte = 0
+        for n in range(pixels_per_byte):
+            byte_offset = x * pixels_per_byte + n
+            if byte_offset < values_len:
+                byte = byte | (values[byte_offset] << int(n * shifter))
+        bytearray.append(byte)
+    return bytearray
+
+
 def convert_image_bytes(im, format):
     """Convert the supplied image to the equivalent bytes required by the QMK firmware.
     """
@@ -318,25 +346,21 @@ def convert_image_bytes(im, format):
     if image_format == 'IMAGE_FORMAT_GRAYSCALE':
         # Take the red channel
         image_bytes = im.tobytes("raw", "R")
-        image_bytes_len = len(image_bytes)
 
         # No palette
         palette = None
 
-        bytearray = []
-        for x in range(expected_byte_count):
-            byte = 0
-            for n in range(pixels_per_byte):
-                byte_offset = x * pixels_per_byte + n
-                if byte_offset < image_bytes_len:
-                    # If mono, each input byte is a grayscale [0,255] pixel -- rescale to the range we want then pack together
-                    byte = byte | (rescale_byte(image_bytes[byte_offset], ncolors - 1) << int(n * shifter))
-            bytearray.append(byte)
+        # If mono, each input byte is a grayscale [0,255] pixel -- rescale to the range we want then pack together
+        rescaled = [rescale_byte(val, ncolors - 1) for val in range(256)]
+        if numpy is not None:
+            values = numpy.array(rescaled, dtype=numpy.uint8)[numpy.frombuffer(image_bytes, dtype=numpy.uint8)]
+        else:
+            values = [rescaled[val] for val in image_bytes]
+        bytearray = pack_pixels(values, pixels_per_byte, shifter, expected_byte_count)
 
     elif image_format == 'IMAGE_FORMAT_PALETTE':
         # Convert each pixel to the palette bytes
         image_bytes = im.tobytes("raw", "P")
-        image_bytes_len = len(image_bytes)
 
         # Export the palette
         palette = []
@@ -344,15 +368,12 @@ def convert_image_bytes(im, format):
         for n in range(0, ncolors * 3, 3):
             palette.append((pal[n + 0], pal[n + 1], pal[n + 2]))
 
-        bytearray = []
-        for x in range(expected_byte_count):
-            byte = 0
-            for n in range(pixels_per_byte):
-                byte_offset = x * pixels_per_byte + n
-                if byte_offset < image_bytes_len:
-                    # If color, each input byte is the index into the color palette -- pack them together
-                    byte = byte | ((image_bytes[byte_offset] & (ncolors - 1)) << int(n * shifter))
-            bytearray.append(byte)
+        # If color, each input byte is the index into the color palette -- pack them together
+        if numpy is not None:
+            values = numpy.frombuffer(image_bytes, dtype=numpy.uint8) & (ncolors - 1)
+        else:
+            values = [val & (ncolors - 1) for val in image_bytes]
+        bytearray = pack_pixels(values, pixels_per_byte, shifter, expected_byte_count)
 
     if image_format == 'IMAGE_FORMAT_RGB565':
         # Take the red, green, and blue channels
@@ -363,18 +384,22 @@ def convert_image_bytes(im, format):
         # No palette
         palette = None
 
-        bytearray = [byte for r, g, b in zip(red, green, blue) for byte in rgb_to565(r, g, b)]
+        if numpy is not None:
+            r, g, b = (numpy.frombuffer(channel, dtype=numpy.uint8) for channel in (red, green, blue))
+            msb = ((r >> 3 & 0x1F) << 3) + (g >> 5 & 0x07)
+            lsb = ((g >> 2 & 0x07) << 5) + (b >> 3 & 0x1F)
+            bytearray = numpy.stack((msb, lsb), axis=1).reshape(-1).tolist()
+        else:
+            bytearray = [byte for r, g, b in zip(red, green, blue) for byte in rgb_to565(r, g, b)]
 
     if image_format == 'IMAGE_FORMAT_RGB888':
-        # Take the red, green, and blue channels
-        red = im.tobytes("raw", "R")
-        green = im.tobytes("raw", "G")
-        blue = im.tobytes("raw", "B")
+        # Take the red, green, and blue channels, already interleaved
+        image_bytes = im.tobytes("raw", "RGB")
 
         # No palette
         palette = None
 
-        bytearray = [byte for r, g, b in zip(red, green, blue) for byte in (r, g, b)]
+        bytearray = list(image_bytes)
 
     if len(bytearray) != expected_byte_count:
         raise Exception(f"Wrong byte count, was {len(bytearray)}, expected {expected_byte_count}")
@@ -382,51 +407,71 @@ def convert_image_bytes(im, format):
     return (palette, bytearray)
 
 
+def byte_runs(bytearray):
+    """Splits the supplied bytes into runs of the same value, as (value, length) pairs.
+    """
+    if numpy is not None:
+        data = numpy.asarray(bytearray, dtype=numpy.uint8)
+        if len(data) == 0:
+            return []
+        starts = numpy.concatenate(([0], numpy.flatnonzero(data[1:] != data[:-1]) + 1))
+        lengths = numpy.diff(numpy.append(starts, len(data)))
+        return zip(data[starts].tolist(), lengths.tolist())
+
+    return ((value, len(list(run))) for value, run in itertools.groupby(bytearray))
+
+
 def compress_bytes_qmk_rle(bytearray):
-    debug_dump = False
+    """Compresses the supplied bytes with QMK's RLE scheme.
+
+    Repeats of 2-127 bytes are written as the count followed by the byte, and up to 128 other bytes are written as 127 plus their count, followed by the bytes themselves. The input is walked a run of equal bytes at a time rather than byte by byte, but produces the same output as the original byte-wise encoder, including its quirks: a repeat of exactly 128 bytes is split 127+1, and input ending on a full literal block gets an empty literal block appended.
+    """
     output = []
-    temp = []
-    repeat = False
-
-    def append_byte(c):
-        if debug_dump:
-            print('Appending byte:', '0x{0:02X}'.format(int(c)), '=', c)
-        output.append(c)
-
-    def append_range(r):
-        append_byte(127 + len(r))
-        if debug_dump:
-            print('Appending {0} byte(s):'.format(len(r)), '[', ', '.join(['{0:02X}'.format(e) for e in r]), ']')
+    literal = []
+    repeat_value = None
+    repeat_count = 0
+
+    def append_literal(r):
+        output.append(127 + len(r))
         output.extend(r)
 
-    for n in range(0, len(bytearray) + 1):
-        end = True if n == len(bytearray) else False
-        if not end:
-            c = bytearray[n]
-            temp.append(c)
-            if len(temp) <= 1:
-                continue
+    for value, length in byte_runs(bytearray):
+        if repeat_count:
+            # A different byte ends the repeat, and starts a new literal block
+            output.extend((repeat_count, repeat_value))
+            repeat_count = 0
+            literal = [value]
+            length -= 1
+
+        while length:
+            if repeat_count:
+                # Extend the repeat as far as it can go, a full one moves the next byte to a new literal block
+                extend = min(length, 127 - repeat_count)
+                repeat_count += extend
+                length -= extend
+                if length:
+                    output.extend((127, value))
+                    repeat_count = 0
+                    literal = [value]
+                    length -= 1
+            elif literal and literal[-1] == value:
+                # The second of two equal bytes starts a repeat, flushing whatever came before them
+                if len(literal) >= 2:
+                    append_literal(literal[:-1])
+                literal = []
+                repeat_value = value
+                repeat_count = 2
+                length -= 1
+            else:
+                literal.append(value)
+                length -= 1
+                if len(literal) == 128:
+                    append_literal(literal)
+                    literal = []
+
+    if repeat_count:
+        output.extend((repeat_count, repeat_value))
+    else:
+        append_literal(literal)
 
-        if debug_dump:
-            print('Temp buffer state {0:3d} bytes:'.format(len(temp)), '[', ', '.join(['{0:02X}'.format(e) for e in temp]), ']')
-
-        if repeat:
-            if temp[-1] != temp[-2]:
-                repeat = False
-            if not repeat or len(temp) == 128 or end:
-                append_byte(len(temp) if end else len(temp) - 1)
-                append_byte(temp[0])
-                temp = [temp[-1]]
-                repeat = False
-        else:
-            if len(temp) >= 2 and temp[-1] == temp[-2]:
-                repeat = True
-                if len(temp) > 2:
-                    append_range(temp[0:(len(temp) - 2)])
-                    temp = [temp[-1], temp[-1]]
-                continue
-            if len(temp) == 128 or end:
-                append_range(temp)
-                temp = []
-                repeat = False
     return output
@@ -11,6 +11,7 @@ from types import FunctionType
 from PIL import Image, ImageFile, ImageChops
 from PIL._binary import o8, o16le as o16, o32le as o32
 import qmk.painter
+from qmk.util import parallel_map
 
 
 def o24(i):
@@ -326,14 +327,14 @@ def _compress_image(frame, last_frame, *, use_rle, use_deltas, format_, **_kwarg
     }
 
 
-# Helper function to save each frame to the output file
-def _write_frame(idx, frame, last_frame, *, fp, frame_offsets, metadata, **kwargs):
-    # Not an argument of the function as it would then not be part of kwargs
-    # This would cause an issue with `_compress_image(**kwargs)` missing an argument
-    format_ = kwargs["format_"]
+# Helper function to compress a frame in a worker process, keeping track of which frame it was
+def _compress_frame(frame_info, **kwargs):
+    idx, frame, last_frame = frame_info
+    return idx, _compress_image(frame, last_frame, **kwargs)
 
-    # (potentially) Apply RLE and/or delta, and work out output image's information
-    outputs = _compress_image(frame, last_frame, **kwargs)
+
+# Helper function to save each (already compressed) frame to the output file
+def _write_frame(idx, frame, outputs, *, fp, frame_offsets, metadata, format_):
     bbox = outputs["bbox"]
     graphic_data = outputs["graphic_data"]
     image_data = outputs["image_data"]
@@ -412,9 +413,10 @@ def _save(im, fp, _filename):
     append_images = list(encoderinfo.get("append_images", []))
     for_all_frames = functools.partial(_for_all_frames, images=[im, *append_images])
 
-    # Collect all the frame sizes
-    frame_sizes = []
-    for_all_frames(lambda _idx, frame, _last_frame: frame_sizes.append(frame.size))
+    # Collect all the frames, and their sizes
+    frames = []
+    for_all_frames(lambda idx, frame, last_frame: frames.append((idx, frame, last_frame)))
+    frame_sizes = [frame.size for _idx, frame, _last_frame in frames]
 
     # Make sure all frames are the same size
     if len(set(frame_sizes)) != 1:
@@ -436,9 +438,15 @@ def _save(im, fp, _filename):
     vprint(f'{"Frame offsets block":26s} {fp.tell():5d}d / {fp.tell():04X}h')
     frame_offsets.write(fp)
 
-    # Iterate over each if the input frames, writing it to the output in the process
-    write_frame = functools.partial(_write_frame, format_=encoderinfo["qmk_format"], fp=fp, use_deltas=encoderinfo.get("use_deltas", True), use_rle=encoderinfo.get("use_rle", True), frame_offsets=frame_offsets, metadata=metadata)
-    for_all_frames(write_frame)
+    # (potentially) Apply RLE and/or delta to each of the input frames -- frames only depend on the one before them, so
+    # animations are compressed in parallel, but a single frame isn't worth starting worker processes for
+    compress_frame = functools.partial(_compress_frame, format_=encoderinfo["qmk_format"], use_deltas=encoderinfo.get("use_deltas", True), use_rle=encoderinfo.get("use_rle", True))
+    compressed = parallel_map(compress_frame, frames) if len(frames) > 1 else map(compress_frame, frames)
+    frame_outputs = dict(compressed)
+
+    # Iterate over each if the input frames in order, writing it to the output in the process
+    for idx, frame, _last_frame in frames:
+        _write_frame(idx, frame, frame_outputs[idx], format_=encoderinfo["qmk_format"], fp=fp, frame_offsets=frame_offsets, metadata=metadata)
 
     # Go back and update the graphics descriptor now that we can determine the final file size
     graphics_descriptor.total_file_size = fp.tell()
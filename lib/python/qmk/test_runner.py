@@ -0,0 +1,110 @@
+"""Runs unit test binaries in parallel and merges their results.
+
+Used by `make test:*` once all the test binaries are built. The output of each binary is printed in one piece as it finishes, so parallel runs do not interleave, and the gtest XML reports of all the binaries are merged into a single `results.xml` next to them.
+
+This is kept to the standard library, as make runs it directly.
+"""
+import os
+import re
+import subprocess
+import sys
+import xml.etree.ElementTree as ET
+from concurrent.futures import ThreadPoolExecutor, as_completed
+from pathlib import Path
+
+BOLD = '\033[1m'
+RED = '\033[31;01m'
+GREEN = '\033[32;01m'
+NO_COLOR = '\033[0m'
+
+
+def parallel_jobs():
+    """Returns the number of tests to run at once, following the `-j` given to make.
+    """
+    match = re.search(r'(?:^|\s)-j\s*(\d*)', os.environ.get('MAKEFLAGS', ''))
+    if match is None:
+        return 1
+
+    return int(match.group(1)) if match.group(1) else os.cpu_count()
+
+
+def run_test(executable, color):
+    """Runs one test binary, returning its exit code and combined output.
+
+    A binary that exits without writing its XML report, e.g. because it crashed before gtest got to it, counts as failed.
+    """
+    report = executable.with_suffix('.xml')
+    # A report left over from an earlier run must not stand in for this one
+    report.unlink(missing_ok=True)
+
+    command = [str(executable), f'--gtest_output=xml:{report}', f'--gtest_color={"yes" if color else "no"}']
+    result = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, stdin=subprocess.DEVNULL)
+
+    if not report.exists():
+        return result.returncode or 1, result.stdout + f'{report.name} was not written\n'.encode()
+
+    return result.returncode, result.stdout
+
+
+def merge_reports(executables, output):
+    """Merges the gtest XML reports of the given binaries into one, skipping any binary that did not write one, which run_test() has counted as failed already.
+    """
+    merged = ET.Element('testsuites', name='AllTests')
+    totals = {'tests': 0, 'failures': 0, 'disabled': 0, 'errors': 0}
+    time = 0.0
+
+    for executable in executables:
+        try:
+            report = ET.parse(executable.with_suffix('.xml')).getroot()
+        except (OSError, ET.ParseError):
+            continue
+
+        for key in totals:
+            totals[key] += int(report.get(key, 0))
+        time += float(report.get('time', '0').rstrip('s') or 0)
+
+        for suite in report:
+            suite.set('binary', executable.stem)
+            merged.append(suite)
+
+    for key, value in totals.items():
+        merged.set(key, str(value))
+    merged.set('time', f'{time:.3f}')
+
+    ET.ElementTree(merged).write(output, encoding='UTF-8', xml_declaration=True)
+    return totals
+
+
+def main(executables):
+    color = sys.stdout.isatty()
+    bold, red, green, no_color = (BOLD, RED, GREEN, NO_COLOR) if color else ('', '', '', '')
+    failed = []
+
+    with ThreadPoolExecutor(max_workers=parallel_jobs()) as executor:
+        runs = {executor.submit(run_test, executable, color): executable for executable in executables}
+        for run in as_completed(runs):
+            executable = runs[run]
+            returncode, output = run.result()
+            sys.stdout.write(f'Testing {bold}{executable.stem}{no_color}\n')
+            sys.stdout.flush()
+            sys.stdout.buffer.write(output)
+            sys.stdout.write('\n')
+            sys.stdout.flush()
+            if returncode != 0:
+                failed.append(executable.stem)
+
+    if not executables:
+        return 0
+
+    totals = merge_reports(executables, executables[0].parent / 'results.xml')
+    summary = f'{len(executables)} test binaries, {totals["tests"]} tests, {totals["failures"]} failures'
+    if failed:
+        print(f'{red}{summary}{no_color}, in: {" ".join(sorted(failed))}')
+        return 1
+
+    print(f'{green}{summary}{no_color}')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main([Path(arg) for arg in sys.argv[1:]]))
@@ -165,6 +165,7 @@ const uint16_t PROGMEM encoder_map[][NUM_ENCODERS][NUM_DIRECTIONS] = {
 
 
 
+
 """
 
 
@@ -176,6 +177,17 @@ def test_json2c_macros():
     assert 'SEND_STRING("Hello, World!"SS_TAP(X_ENTER));' in result.stdout
 
 
+def test_json2c_leader_sequences():
+    result = check_subcommand("json2c", 'keyboards/handwired/pytest/macro/keymaps/leader/keymap.json')
+    check_returncode(result)
+    assert """LEADER_SEQUENCES(
+    LEADER_SEQUENCE(KC_1, KC_A),
+    LEADER_SEQUENCE(KC_2, KC_A, KC_B),
+    LEADER_SEQUENCE(KC_4, KC_A, KC_C),
+    LEADER_SEQUENCE(KC_3, KC_B, KC_C)
+)""" in result.stdout
+
+
 def test_json2c_stdin():
     result = check_subcommand_stdin('keyboards/handwired/pytest/basic/keymaps/default_json/keymap.json', 'json2c', '-')
     check_returncode(result)
@@ -203,6 +215,7 @@ const uint16_t PROGMEM encoder_map[][NUM_ENCODERS][NUM_DIRECTIONS] = {
 
 
 
+
 """
 
 
@@ -319,6 +332,17 @@ def test_generate_rules_mk():
     assert 'MCU ?= atmega32u4' in result.stdout
 
 
+def test_generate_all(tmp_path):
+    result = check_subcommand('generate-all', '-kb', 'handwired/pytest/basic', '-km', 'default_json', '--keymap-json', 'keyboards/handwired/pytest/basic/keymaps/default_json/keymap.json', '--skip-git', '-q', '-o', str(tmp_path))
+    check_returncode(result)
+    assert result.stdout.strip() == str(tmp_path / 'info_rules.mk')
+    assert 'MCU ?= atmega32u4' in (tmp_path / 'info_rules.mk').read_text()
+    assert '#    define PRODUCT "pytest"' in (tmp_path / 'info_config.h').read_text()
+    assert '#define QMK_VERSION' in (tmp_path / 'version.h').read_text()
+    for generated in ['default_keyboard.c', 'default_keyboard.h', 'info_deps.d', 'rules.mk', 'config.h', 'keymap.c', 'keymap.h']:
+        assert (tmp_path / generated).exists()
+
+
 def test_generate_version_h():
     result = check_subcommand('generate-version-h')
     check_returncode(result)
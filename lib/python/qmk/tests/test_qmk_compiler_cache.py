@@ -0,0 +1,31 @@
+from qmk.compiler_cache import cache_key, preprocess_command, store
+
+
+def test_cache_key_ignores_output_paths():
+    source = b'int main(void) { return 0; }\n'
+    first = cache_key('gcc', ['-c', '-Os', '-I.build/obj_a/src', '-include', '.build/obj_a/src/info_config.h', '-MMD', '-MF', 'a.td', 'main.c', '-o', 'a.o'], 'main.c', source)
+    second = cache_key('gcc', ['-c', '-Os', '-I.build/obj_b/src', '-include', '.build/obj_b/src/info_config.h', '-MMD', '-MF', 'b.td', 'main.c', '-o', 'b.o'], 'main.c', source)
+    assert first == second
+
+
+def test_cache_key_follows_flags_and_source():
+    source = b'int main(void) { return 0; }\n'
+    key = cache_key('gcc', ['-c', '-Os', 'main.c', '-o', 'a.o'], 'main.c', source)
+    assert key != cache_key('gcc', ['-c', '-O2', 'main.c', '-o', 'a.o'], 'main.c', source)
+    assert key != cache_key('gcc', ['-c', '-Os', 'main.c', '-o', 'a.o'], 'main.c', source + b'\n')
+
+
+def test_preprocess_command():
+    command = preprocess_command('gcc', ['-c', '-Os', '-MMD', '-MF', 'a.td', 'main.c', '-o', 'a.o'], 'a.o')
+    assert command == ['gcc', '-E', '-Os', '-MMD', '-MF', 'a.td', 'main.c', '-P', '-o', '-', '-MT', 'a.o']
+
+
+def test_store_leaves_only_the_entry(tmp_path):
+    output = tmp_path / 'main.o'
+    output.write_bytes(b'object')
+    entry = tmp_path / 'cache' / 'ab' / 'abcdef.o'
+
+    store(entry, output, b'warning')
+    assert entry.read_bytes() == b'object'
+    assert entry.with_suffix('.err').read_bytes() == b'warning'
+    assert sorted(path.name for path in entry.parent.iterdir()) == ['abcdef.err', 'abcdef.o']
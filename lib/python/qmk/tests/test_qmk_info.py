@@ -0,0 +1,37 @@
+import qmk.info
+
+
+def test_info_json_cache(tmp_path, monkeypatch):
+    monkeypatch.setattr(qmk.info, 'INFO_CACHE_DIR', tmp_path)
+    monkeypatch.delenv('SKIP_INFO_CACHE', raising=False)
+
+    generated = qmk.info.info_json('handwired/pytest/basic')
+    assert len(list(tmp_path.glob('*.pickle'))) == 1
+
+    cached = qmk.info.info_json('handwired/pytest/basic')
+    assert cached == generated
+    # Each call gets its own copy
+    assert cached is not generated
+
+    monkeypatch.setenv('SKIP_INFO_CACHE', '1')
+    assert qmk.info.info_json('handwired/pytest/basic') == generated
+
+
+def test_info_json_cache_key_follows_inputs(tmp_path, monkeypatch):
+    monkeypatch.setattr(qmk.info, 'INFO_CACHE_DIR', tmp_path)
+
+    basic = qmk.info._info_cache_file('handwired/pytest/basic', None)
+    assert basic == qmk.info._info_cache_file('handwired/pytest/basic', None)
+    assert basic != qmk.info._info_cache_file('handwired/pytest/macro', None)
+    assert basic != qmk.info._info_cache_file('handwired/pytest/basic', 'ortho_1x1')
+
+
+def test_info_json_cache_key_follows_community_layouts(tmp_path, monkeypatch):
+    monkeypatch.chdir(tmp_path)
+    (tmp_path / 'keyboards' / 'pytest').mkdir(parents=True)
+    (tmp_path / 'keyboards' / 'pytest' / 'keyboard.json').write_text('{}')
+    (tmp_path / 'layouts' / 'default' / 'ortho_1x1').mkdir(parents=True)
+
+    before = qmk.info._info_cache_file('pytest', None)
+    (tmp_path / 'layouts' / 'default' / 'ortho_2x2').mkdir()
+    assert before != qmk.info._info_cache_file('pytest', None)
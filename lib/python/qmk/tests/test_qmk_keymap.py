@@ -1,3 +1,5 @@
+import random
+
 import qmk.keymap
 
 
@@ -34,6 +36,53 @@ const uint16_t PROGMEM encoder_map[][NUM_ENCODERS][NUM_DIRECTIONS] = {
 """
 
 
+def test_generate_c_sparse_pytest_basic():
+    keymap_json = {
+        'keyboard': 'handwired/pytest/basic',
+        'layout': 'LAYOUT',
+        'layers': [['KC_A'], ['KC_TRNS']],
+        'keymap_format': 'sparse',
+    }
+    templ = qmk.keymap.generate_c(keymap_json)
+    assert 'keymaps[]' not in templ
+    assert """#define KEYMAP_SPARSE
+
+const uint32_t PROGMEM keymap_sparse_bitmap[] = {
+    /* 0 */ 0x00000001,
+    /* 1 */ 0x00000000,
+};
+const uint16_t PROGMEM keymap_sparse_index[] = {
+    /* 0 */ 0,
+    /* 1 */ 1,
+};
+const uint16_t PROGMEM keymap_sparse_keycodes[] = {
+    /* 0 */ KC_A,
+};
+const uint32_t PROGMEM keymap_sparse_unused[] = {0x00000000};
+""" in templ
+
+
+def test_sparse_keymap_tables_match_dense():
+    rows, cols = 5, 15
+    rng = random.Random(rows * cols)
+    # Matrix positions the layout doesn't use are None on every layer
+    used = [rng.random() < 0.8 for _ in range(rows * cols)]
+    layers = [[rng.choice(['KC_NO', 'KC_A', 'KC_B', 'KC_TRNS', 'KC_TRNS', 'KC_TRNS']) if used[position] else None for position in range(rows * cols)] for _ in range(4)]
+
+    bitmap, index, keycodes, unused = qmk.keymap._generate_sparse_keymap_tables(layers, rows, cols)
+
+    # Look every key up the same way keycode_at_keymap_location_raw() does
+    words = len(unused)
+    for layer_num, layer in enumerate(layers):
+        for position, keycode in enumerate(layer):
+            word, mask = position // 32, 1 << (position % 32)
+            if bitmap[layer_num][word] & mask:
+                found = keycodes[index[layer_num * words + word] + bin(bitmap[layer_num][word] & (mask - 1)).count('1')]
+            else:
+                found = 'KC_NO' if unused[word] & mask else 'KC_TRNS'
+            assert found == (keycode or 'KC_NO')
+
+
 def test_generate_json_pytest_basic():
     templ = qmk.keymap.generate_json('default', 'handwired/pytest/basic', 'LAYOUT', [['KC_A']])
     assert templ == {"keyboard": "handwired/pytest/basic", "keymap": "default", "layout": "LAYOUT", "layers": [["KC_A"]]}
@@ -0,0 +1,58 @@
+import random
+import time
+
+import pytest
+from PIL import Image
+
+import qmk.painter
+
+
+def test_compress_bytes_qmk_rle():
+    assert qmk.painter.compress_bytes_qmk_rle([]) == [127]
+    assert qmk.painter.compress_bytes_qmk_rle([1, 2, 3]) == [130, 1, 2, 3]
+    assert qmk.painter.compress_bytes_qmk_rle([7] * 5) == [5, 7]
+    assert qmk.painter.compress_bytes_qmk_rle([1, 2, 2, 2, 3]) == [128, 1, 3, 2, 128, 3]
+    assert qmk.painter.compress_bytes_qmk_rle([9] * 128) == [127, 9, 128, 9]
+    assert qmk.painter.compress_bytes_qmk_rle([4] * 130 + [5]) == [127, 4, 3, 4, 128, 5]
+    assert qmk.painter.compress_bytes_qmk_rle(list(range(128))) == [255, *range(128), 127]
+
+
+@pytest.mark.parametrize('format_name', ['mono2', 'mono16', 'pal4', 'pal256', 'rgb565', 'rgb888'])
+def test_convert_image_bytes_numpy(monkeypatch, format_name):
+    numpy = pytest.importorskip('numpy')
+    format_ = qmk.painter.valid_formats[format_name]
+
+    rng = random.Random(format_name)
+    im = Image.frombytes('RGB', (37, 11), bytes(rng.randrange(4) * 85 for _ in range(37 * 11 * 3)))
+    converted = qmk.painter.convert_requested_format(im, format_)
+
+    monkeypatch.setattr(qmk.painter, 'numpy', numpy)
+    palette, image_bytes = qmk.painter.convert_image_bytes(converted, format_)
+    rle_bytes = qmk.painter.compress_bytes_qmk_rle(image_bytes)
+
+    # The per-pixel fallback must produce exactly the same output
+    monkeypatch.setattr(qmk.painter, 'numpy', None)
+    assert qmk.painter.convert_image_bytes(converted, format_) == (palette, image_bytes)
+    assert qmk.painter.compress_bytes_qmk_rle(image_bytes) == rle_bytes
+
+
+def test_convert_image_bytes_benchmark(monkeypatch):
+    numpy = pytest.importorskip('numpy')
+    format_ = qmk.painter.valid_formats['pal16']
+
+    # One frame of a 240x240 animation, made of runs of 8 gray pixels so RLE has something to do
+    rng = random.Random(240)
+    im = Image.frombytes('RGB', (240, 240), bytes(v for _ in range(240 * 240 // 8) for v in [rng.randrange(16) * 17] * 24))
+    converted = qmk.painter.convert_requested_format(im, format_)
+
+    timings = {}
+    outputs = {}
+    for name, module in (('numpy', numpy), ('python', None)):
+        monkeypatch.setattr(qmk.painter, 'numpy', module)
+        start = time.perf_counter()
+        _, image_bytes = qmk.painter.convert_image_bytes(converted, format_)
+        outputs[name] = (image_bytes, qmk.painter.compress_bytes_qmk_rle(image_bytes))
+        timings[name] = time.perf_counter() - start
+
+    print(f'240x240 pal16 frame: numpy {timings["numpy"] * 1000:.1f}ms, python {timings["python"] * 1000:.1f}ms')
+    assert outputs['numpy'] == outputs['python']
@@ -79,3 +79,11 @@ typedef uint8_t pin_t;
 #define gpio_read_pin(pin) ((PORT->Group[SAMD_PORT(pin)].IN.reg & SAMD_PIN_MASK(pin)) != 0)
 
 #define gpio_toggle_pin(pin) (PORT->Group[SAMD_PORT(pin)].OUTTGL.reg = SAMD_PIN_MASK(pin))
+
+typedef uint8_t  gpio_port_t;
+typedef uint32_t gpio_port_mask_t;
+
+#define gpio_get_pin_port(pin) ((gpio_port_t)SAMD_PORT(pin))
+#define gpio_get_pin_port_mask(pin) ((gpio_port_mask_t)SAMD_PIN_MASK(pin))
+
+#define gpio_read_port(port) ((gpio_port_mask_t)PORT->Group[port].IN.reg)
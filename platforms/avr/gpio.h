@@ -36,3 +36,13 @@ typedef uint8_t pin_t;
 #define gpio_read_pin(pin) ((bool)(PINx_ADDRESS(pin) & _BV((pin)&0xF)))
 
 #define gpio_toggle_pin(pin) (PORTx_ADDRESS(pin) ^= _BV((pin)&0xF))
+
+/* Operation of GPIO by port. */
+
+typedef uint8_t gpio_port_t;
+typedef uint8_t gpio_port_mask_t;
+
+#define gpio_get_pin_port(pin) ((gpio_port_t)((pin)&0xF0))
+#define gpio_get_pin_port_mask(pin) ((gpio_port_mask_t)_BV((pin)&0xF))
+
+#define gpio_read_port(port) ((gpio_port_mask_t)PINx_ADDRESS(port))
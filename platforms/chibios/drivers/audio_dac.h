@@ -145,6 +145,10 @@
 #endif
 
 /**
- *user overridable sample generation/processing
+ * user provided sample generation/processing
+ *
+ * Declared weak without a default implementation: when a keyboard or keymap
+ * implements it, the additive driver calls it once per sample instead of
+ * rendering the active tones through the block mixer.
  */
-uint16_t dac_value_generate(void);
+__attribute__((weak)) uint16_t dac_value_generate(void);
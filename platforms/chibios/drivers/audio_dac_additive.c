@@ -16,6 +16,7 @@
  */
 
 #include "audio.h"
+#include "audio_mixer.h"
 #include "gpio.h"
 #include <math.h>
 #include "util.h"
@@ -29,9 +30,10 @@
 
   which utilizes the dac unit many STM32 are equipped with, to output a modulated waveform from samples stored in the dac_buffer_* array who are passed to the hardware through DMA
 
-  it is also possible to have a custom sample-LUT by implementing/overriding 'dac_value_generate'
+  it is also possible to have a custom sample-LUT by implementing 'dac_value_generate'
 
-  this driver allows for multiple simultaneous tones to be played through one single channel by doing additive wave-synthesis
+  this driver allows for multiple simultaneous tones to be played through one single channel by doing additive wave-synthesis;
+  the mixing itself is done a half-buffer at a time by audio_mixer.c, with fixed-point phase accumulators and ADSR envelopes
 */
 
 #if !defined(AUDIO_PIN)
@@ -88,23 +90,25 @@ static const dacsample_t dac_buffer_trapezoid[] = {
 };
 #endif // AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID
 
-static dacsample_t dac_buffer[AUDIO_DAC_BUFFER_SIZE];
+#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
+#    define AUDIO_DAC_WAVETABLE dac_buffer_sine
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
+#    define AUDIO_DAC_WAVETABLE dac_buffer_triangle
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
+#    define AUDIO_DAC_WAVETABLE dac_buffer_trapezoid
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
+#    define AUDIO_DAC_WAVETABLE dac_buffer_square
+#endif
 
-/* keep track of the sample position for for each frequency */
-static float dac_if[AUDIO_MAX_SIMULTANEOUS_TONES] = {0.0};
+_Static_assert((ARRAY_SIZE(AUDIO_DAC_WAVETABLE) & (ARRAY_SIZE(AUDIO_DAC_WAVETABLE) - 1)) == 0, "The DAC wavetable length must be a power of two");
+_Static_assert(AUDIO_MAX_SIMULTANEOUS_TONES <= AUDIO_MIXER_VOICES, "AUDIO_MAX_SIMULTANEOUS_TONES must not exceed AUDIO_MIXER_VOICES");
 
-static float   active_tones_snapshot[AUDIO_MAX_SIMULTANEOUS_TONES] = {0};
-static uint8_t active_tones_snapshot_length                        = 0;
+static dacsample_t dac_buffer[AUDIO_DAC_BUFFER_SIZE];
 
 typedef enum {
-    OUTPUT_SHOULD_START,
     OUTPUT_RUN_NORMALLY,
-    // path 1: wait for zero, then change/update active tones
-    OUTPUT_TONES_CHANGED,
-    OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE,
-    // path 2: hardware should stop, wait for zero then turn output off = stop the timer
+    // hardware should stop: let the voices release, then turn output off = stop the timer
     OUTPUT_SHOULD_STOP,
-    OUTPUT_REACHED_ZERO_BEFORE_OFF,
     OUTPUT_OFF,
     OUTPUT_OFF_1,
     OUTPUT_OFF_2, // trailing off: giving the DAC two more conversion cycles until the AUDIO_DAC_OFF_VALUE reaches the output, then turn the timer off, which leaves the output at that level
@@ -112,81 +116,27 @@ typedef enum {
 } output_states_t;
 output_states_t state = OUTPUT_OFF_2;
 
+static bool tones_changed = false;
+
 /**
- * Generation of the waveform being passed to the callback. Declared weak so users
- * can override it with their own wave-forms/noises.
+ * Take a snapshot of the currently playing tones and hand it to the mixer.
  */
-__attribute__((weak)) uint16_t dac_value_generate(void) {
-    // DAC is running/asking for values but snapshot length is zero -> must be playing a pause
-    if (active_tones_snapshot_length == 0) {
-        return AUDIO_DAC_OFF_VALUE;
-    }
-
-    /* doing additive wave synthesis over all currently playing tones = adding up
-     * sine-wave-samples for each frequency, scaled by the number of active tones
-     */
-    uint_fast16_t value     = 0;
-    float         frequency = 0.0f;
-
-#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_sine);
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_triangle);
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_trapezoid);
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_square);
-#endif
-
-    for (size_t i = 0; i < active_tones_snapshot_length; i++) {
-        /* Note: a user implementation does not have to rely on the active_tones_snapshot, but
-         * could directly query the active frequencies through audio_get_processed_frequency */
-        frequency = active_tones_snapshot[i];
-
-        float new_dac_if = dac_if[i];
-        new_dac_if += frequency * ((float)wavetable_length / AUDIO_DAC_SAMPLE_RATE * 2.0f / 3.0f);
-        /*Note: the 2/3 are necessary to get the correct frequencies on the
-         *      DAC output (as measured with an oscilloscope), since the gpt
-         *      timer runs with 3*AUDIO_DAC_SAMPLE_RATE; and the DAC callback
-         *      is called twice per conversion.*/
-
-        while (new_dac_if >= wavetable_length)
-            new_dac_if -= wavetable_length;
-        dac_if[i] = new_dac_if;
+static void dac_update_tones(void) {
+    float   frequencies[AUDIO_MAX_SIMULTANEOUS_TONES];
+    uint8_t active_tones = MIN(AUDIO_MAX_SIMULTANEOUS_TONES, audio_get_number_of_active_tones());
 
-        // Wavetable generation/lookup
-        size_t dac_i = (size_t)new_dac_if;
-
-#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
-        value += dac_buffer_sine[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
-        value += dac_buffer_triangle[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
-        value += dac_buffer_trapezoid[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
-        value += dac_buffer_square[dac_i] / active_tones_snapshot_length;
-#endif
-        /*
-        // SINE
-        value += dac_buffer_sine[dac_i] / active_tones_snapshot_length / 3;
-        // TRIANGLE
-        value += dac_buffer_triangle[dac_i] / active_tones_snapshot_length / 3;
-        // SQUARE
-        value += dac_buffer_square[dac_i] / active_tones_snapshot_length / 3;
-        //NOTE: combination of these three wave-forms is more exemplary - and doesn't sound particularly good :-P
-        */
-
-        // STAIRS (mostly usefully as test-pattern)
-        // value_avg = dac_buffer_staircase[dac_i] / active_tones_snapshot_length;
+    for (uint8_t i = 0; i < active_tones; i++) {
+        // 'rest' notes have a frequency of 0.0f and are skipped by the mixer
+        frequencies[i] = audio_get_processed_frequency(i);
     }
-
-    return value;
+    audio_mixer_set_tones(frequencies, active_tones);
 }
 
 /**
  * DAC streaming callback. Does all of the main computing for playing songs.
  *
  * Note: chibios calls this CB twice: during the 'half buffer event', and the 'full buffer event'.
+ * Each call renders the half of the buffer that is not currently being converted, in one go.
  */
 static void dac_end(DACDriver *dacp) {
     dacsample_t *sample_p = (dacp)->samples;
@@ -196,72 +146,35 @@ static void dac_end(DACDriver *dacp) {
         sample_p += AUDIO_DAC_BUFFER_SIZE / 2; // 'half_index'
     }
 
-    for (uint8_t s = 0; s < AUDIO_DAC_BUFFER_SIZE / 2; s++) {
-        if (OUTPUT_OFF <= state) {
+    if (OUTPUT_OFF <= state) {
+        for (uint8_t s = 0; s < AUDIO_DAC_BUFFER_SIZE / 2; s++) {
             sample_p[s] = AUDIO_DAC_OFF_VALUE;
-            continue;
-        } else {
+        }
+    } else if (dac_value_generate) {
+        // user supplied per-sample generator
+        for (uint8_t s = 0; s < AUDIO_DAC_BUFFER_SIZE / 2; s++) {
             sample_p[s] = dac_value_generate();
         }
-
-        /* zero crossing (or approach, whereas zero == DAC_OFF_VALUE, which can be configured to anything from 0 to DAC_SAMPLE_MAX)
-         * ============================*=*========================== AUDIO_DAC_SAMPLE_MAX
-         *                          *       *
-         *                        *           *
-         * ---------------------------------------------------------
-         *                     *                 *                  } AUDIO_DAC_SAMPLE_MAX/100
-         * --------------------------------------------------------- AUDIO_DAC_OFF_VALUE
-         *                  *                       *               } AUDIO_DAC_SAMPLE_MAX/100
-         * ---------------------------------------------------------
-         *               *
-         * *           *
-         *   *       *
-         * =====*=*================================================= 0x0
-         */
-        if (((sample_p[s] + (AUDIO_DAC_SAMPLE_MAX / 100)) > AUDIO_DAC_OFF_VALUE) && // value approaches from below
-            (sample_p[s] < (AUDIO_DAC_OFF_VALUE + (AUDIO_DAC_SAMPLE_MAX / 100)))    // or above
-        ) {
-            if ((OUTPUT_SHOULD_START == state) && (active_tones_snapshot_length > 0)) {
-                state = OUTPUT_RUN_NORMALLY;
-            } else if (OUTPUT_TONES_CHANGED == state) {
-                state = OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE;
-            } else if (OUTPUT_SHOULD_STOP == state) {
-                state = OUTPUT_REACHED_ZERO_BEFORE_OFF;
-            }
+        if (OUTPUT_SHOULD_STOP == state) {
+            state = OUTPUT_OFF;
         }
-
-        // still 'ramping up', reset the output to OFF_VALUE until the generated values reach that value, to do a smooth handover
-        if (OUTPUT_SHOULD_START == state) {
-            sample_p[s] = AUDIO_DAC_OFF_VALUE;
+    } else {
+        if (OUTPUT_SHOULD_STOP == state) {
+            // voices are only ever changed from here, so they can't be released halfway through rendering
+            audio_mixer_release_all();
+        } else if (tones_changed) {
+            dac_update_tones();
         }
+        audio_mixer_render(sample_p, AUDIO_DAC_BUFFER_SIZE / 2);
 
-        if ((OUTPUT_SHOULD_START == state) || (OUTPUT_REACHED_ZERO_BEFORE_OFF == state) || (OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE == state)) {
-            uint8_t active_tones         = MIN(AUDIO_MAX_SIMULTANEOUS_TONES, audio_get_number_of_active_tones());
-            active_tones_snapshot_length = 0;
-            // update the snapshot - once, and only on occasion that something changed;
-            // -> saves cpu cycles (?)
-            for (uint8_t i = 0; i < active_tones; i++) {
-                float freq = audio_get_processed_frequency(i);
-                if (freq > 0) { // disregard 'rest' notes, with valid frequency 0.0f; which would only lower the resulting waveform volume during the additive synthesis step
-                    active_tones_snapshot[active_tones_snapshot_length++] = freq;
-                }
-            }
-
-            if ((0 == active_tones_snapshot_length) && (OUTPUT_REACHED_ZERO_BEFORE_OFF == state)) {
-                state = OUTPUT_OFF;
-            }
-            if (OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE == state) {
-                state = OUTPUT_RUN_NORMALLY;
-            }
+        // the release envelope takes care of a click free stop
+        if (OUTPUT_SHOULD_STOP == state && audio_mixer_is_idle()) {
+            state = OUTPUT_OFF;
         }
     }
 
     // update audio internal state (note position, current_note, ...)
-    if (audio_update_state()) {
-        if (OUTPUT_SHOULD_STOP != state) {
-            state = OUTPUT_TONES_CHANGED;
-        }
-    }
+    tones_changed = audio_update_state();
 
     if (OUTPUT_OFF <= state) {
         if (OUTPUT_OFF_2 == state) {
@@ -325,6 +238,18 @@ void audio_driver_initialize_impl(void) {
     DACD1.params->dac->CR &= ~DAC_CR_BOFF1;
     DACD2.params->dac->CR &= ~DAC_CR_BOFF2;
 
+    /* The timer triggers a conversion every second tick (see gptStartContinuous), so samples are
+     * played back at 3/2 * AUDIO_DAC_SAMPLE_RATE.
+     */
+    audio_mixer_config_t mixer_config = {
+        .wavetable      = AUDIO_DAC_WAVETABLE,
+        .wavetable_bits = __builtin_ctz(ARRAY_SIZE(AUDIO_DAC_WAVETABLE)),
+        .off_value      = AUDIO_DAC_OFF_VALUE,
+        .sample_max     = 0xFFF, // 12 bit DAC
+        .sample_rate    = AUDIO_DAC_SAMPLE_RATE * 3 / 2,
+    };
+    audio_mixer_init(&mixer_config);
+
     /* Start the DAC output with all off values. This buffer will then get fed
      * with samples from dac_end, which will play notes.
      */
@@ -351,18 +276,14 @@ void audio_driver_initialize_impl(void) {
 }
 
 void audio_driver_stop_impl(void) {
+    // the voices are released from dac_end, on the next buffer
     state = OUTPUT_SHOULD_STOP;
 }
 
 void audio_driver_start_impl(void) {
+    tones_changed = true;
+    state         = OUTPUT_RUN_NORMALLY;
     gptStartContinuous(&GPTD6, 2U);
-
-    for (uint8_t i = 0; i < AUDIO_MAX_SIMULTANEOUS_TONES; i++) {
-        dac_if[i]                = 0.0f;
-        active_tones_snapshot[i] = 0.0f;
-    }
-    active_tones_snapshot_length = 0;
-    state                        = OUTPUT_SHOULD_START;
 }
 
 #pragma GCC diagnostic pop
@@ -0,0 +1,85 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "gpio_mock.h"
+
+uint32_t mock_gpio_pin_reads  = 0;
+uint32_t mock_gpio_port_reads = 0;
+
+static gpio_port_t      pin_ports[MOCK_GPIO_PINS];
+static uint8_t          pin_bits[MOCK_GPIO_PINS];
+static mock_gpio_mode_t pin_modes[MOCK_GPIO_PINS];
+static bool             pin_levels[MOCK_GPIO_PINS];
+static bool             switches[MOCK_GPIO_PINS][MOCK_GPIO_PINS];
+
+void mock_gpio_reset(void) {
+    for (pin_t pin = 0; pin < MOCK_GPIO_PINS; pin++) {
+        pin_ports[pin]  = pin / MOCK_GPIO_PORT_WIDTH;
+        pin_bits[pin]   = pin % MOCK_GPIO_PORT_WIDTH;
+        pin_modes[pin]  = MOCK_GPIO_INPUT;
+        pin_levels[pin] = false;
+    }
+    memset(switches, 0, sizeof(switches));
+    mock_gpio_pin_reads  = 0;
+    mock_gpio_port_reads = 0;
+}
+
+void mock_gpio_set_pin_location(pin_t pin, gpio_port_t port, uint8_t bit) {
+    pin_ports[pin] = port;
+    pin_bits[pin]  = bit;
+}
+
+void mock_gpio_set_switch(pin_t from, pin_t to, bool closed) {
+    switches[from][to] = closed;
+}
+
+void mock_gpio_set_pin_mode(pin_t pin, mock_gpio_mode_t mode) {
+    pin_modes[pin] = mode;
+}
+
+void mock_gpio_write_pin(pin_t pin, bool level) {
+    pin_levels[pin] = level;
+}
+
+static bool pin_level(pin_t pin) {
+    if (pin_modes[pin] == MOCK_GPIO_OUTPUT) {
+        return pin_levels[pin];
+    }
+
+    bool driven_high = false;
+    for (pin_t to = 0; to < MOCK_GPIO_PINS; to++) {
+        if (switches[pin][to] && pin_modes[to] == MOCK_GPIO_OUTPUT) {
+            if (!pin_levels[to]) {
+                return false;
+            }
+            driven_high = true;
+        }
+    }
+    return driven_high || pin_modes[pin] != MOCK_GPIO_INPUT_LOW;
+}
+
+bool mock_gpio_read_pin(pin_t pin) {
+    mock_gpio_pin_reads++;
+    return pin_level(pin);
+}
+
+gpio_port_t mock_gpio_get_pin_port(pin_t pin) {
+    return pin_ports[pin];
+}
+
+gpio_port_mask_t mock_gpio_get_pin_port_mask(pin_t pin) {
+    return (gpio_port_mask_t)1 << pin_bits[pin];
+}
+
+gpio_port_mask_t mock_gpio_read_port(gpio_port_t port) {
+    gpio_port_mask_t value = (gpio_port_mask_t)~0;
+
+    mock_gpio_port_reads++;
+    for (pin_t pin = 0; pin < MOCK_GPIO_PINS; pin++) {
+        if (pin_ports[pin] == port && !pin_level(pin)) {
+            value &= ~mock_gpio_get_pin_port_mask(pin);
+        }
+    }
+    return value;
+}
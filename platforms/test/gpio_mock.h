@@ -0,0 +1,73 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Mock GPIO platform for host tests of code that drives pins directly.
+
+There are MOCK_GPIO_PORTS ports of MOCK_GPIO_PORT_WIDTH pins each. Pin numbers map to a port and bit, by default pin
+0 is bit 0 of port 0 and so on, but any pin can be moved to any port and bit to test arbitrary wirings. Switches
+connect two pins, and conduct in one direction only, as with a diode per switch. An input reads the level of an output
+that a closed switch connects it to, low winning over high, and otherwise the level of its pull resistor. Floating
+inputs, and port bits without a pin, read high.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define MOCK_GPIO_PORTS 4
+#define MOCK_GPIO_PORT_WIDTH 16
+#define MOCK_GPIO_PINS (MOCK_GPIO_PORTS * MOCK_GPIO_PORT_WIDTH)
+
+typedef uint8_t  pin_t;
+typedef uint8_t  gpio_port_t;
+typedef uint16_t gpio_port_mask_t;
+
+#define gpio_set_pin_input(pin) mock_gpio_set_pin_mode(pin, MOCK_GPIO_INPUT)
+#define gpio_set_pin_input_high(pin) mock_gpio_set_pin_mode(pin, MOCK_GPIO_INPUT_HIGH)
+#define gpio_set_pin_input_low(pin) mock_gpio_set_pin_mode(pin, MOCK_GPIO_INPUT_LOW)
+#define gpio_set_pin_output_push_pull(pin) mock_gpio_set_pin_mode(pin, MOCK_GPIO_OUTPUT)
+#define gpio_set_pin_output_open_drain(pin) mock_gpio_set_pin_mode(pin, MOCK_GPIO_OUTPUT)
+#define gpio_set_pin_output(pin) gpio_set_pin_output_push_pull(pin)
+
+#define gpio_write_pin_high(pin) mock_gpio_write_pin(pin, true)
+#define gpio_write_pin_low(pin) mock_gpio_write_pin(pin, false)
+#define gpio_write_pin(pin, level) mock_gpio_write_pin(pin, level)
+
+#define gpio_read_pin(pin) mock_gpio_read_pin(pin)
+
+#define gpio_toggle_pin(pin) mock_gpio_write_pin(pin, !mock_gpio_read_pin(pin))
+
+#define gpio_get_pin_port(pin) mock_gpio_get_pin_port(pin)
+#define gpio_get_pin_port_mask(pin) mock_gpio_get_pin_port_mask(pin)
+
+#define gpio_read_port(port) mock_gpio_read_port(port)
+
+typedef enum {
+    MOCK_GPIO_INPUT,
+    MOCK_GPIO_INPUT_HIGH,
+    MOCK_GPIO_INPUT_LOW,
+    MOCK_GPIO_OUTPUT,
+} mock_gpio_mode_t;
+
+/* Number of single pin and whole port reads since the last mock_gpio_reset() */
+extern uint32_t mock_gpio_pin_reads;
+extern uint32_t mock_gpio_port_reads;
+
+/* Puts every pin back to its default port and bit, as a floating input, and opens all switches */
+void mock_gpio_reset(void);
+
+/* Moves a pin to another port and bit. The pin that was there before should be moved too. */
+void mock_gpio_set_pin_location(pin_t pin, gpio_port_t port, uint8_t bit);
+
+/* Opens or closes a switch letting `to` pull `from` to its level */
+void mock_gpio_set_switch(pin_t from, pin_t to, bool closed);
+
+void mock_gpio_set_pin_mode(pin_t pin, mock_gpio_mode_t mode);
+void mock_gpio_write_pin(pin_t pin, bool level);
+bool mock_gpio_read_pin(pin_t pin);
+
+gpio_port_t      mock_gpio_get_pin_port(pin_t pin);
+gpio_port_mask_t mock_gpio_get_pin_port_mask(pin_t pin);
+gpio_port_mask_t mock_gpio_read_port(gpio_port_t port);
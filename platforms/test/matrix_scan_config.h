@@ -0,0 +1,25 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#define MATRIX_ROWS 4
+#define MATRIX_COLS 20
+
+#define DIODE_DIRECTION COL2ROW
+#define MATRIX_ROW_PINS \
+    { 60, 61, 62, 63 }
+#define MATRIX_COL_PINS \
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, NO_PIN }
+
+#define DEBOUNCE 0
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "gpio_mock.h"
+
+#ifdef __cplusplus
+};
+#endif
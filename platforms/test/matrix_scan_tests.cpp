@@ -0,0 +1,142 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Scans a 4x20 COL2ROW matrix on the mock GPIO platform, built once reading each column pin on its own, and once with
+MATRIX_PORT_SCAN (see rules.mk). Both builds must see exactly the keys that are pressed, for any wiring of the pins to
+ports.
+*/
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "matrix.h"
+}
+
+static const pin_t row_pins[MATRIX_ROWS] = MATRIX_ROW_PINS;
+static const pin_t col_pins[MATRIX_COLS] = MATRIX_COL_PINS;
+
+class MatrixScan : public ::testing::Test {
+   protected:
+    matrix_row_t pressed[MATRIX_ROWS] = {0};
+
+    void SetUp() override {
+        mock_gpio_reset();
+    }
+
+    /* Moves the given pins to the given port and bit, and every other pin to one of the locations left */
+    void wire(std::mt19937 &rng, const std::map<pin_t, std::pair<gpio_port_t, uint8_t>> &fixed) {
+        std::vector<std::pair<gpio_port_t, uint8_t>> free;
+        for (gpio_port_t port = 0; port < MOCK_GPIO_PORTS; port++) {
+            for (uint8_t bit = 0; bit < MOCK_GPIO_PORT_WIDTH; bit++) {
+                if (std::none_of(fixed.begin(), fixed.end(), [&](auto &pin) { return pin.second == std::make_pair(port, bit); })) {
+                    free.push_back({port, bit});
+                }
+            }
+        }
+        std::shuffle(free.begin(), free.end(), rng);
+
+        for (pin_t pin = 0; pin < MOCK_GPIO_PINS; pin++) {
+            auto location = fixed.find(pin);
+            if (location == fixed.end()) {
+                mock_gpio_set_pin_location(pin, free.back().first, free.back().second);
+                free.pop_back();
+            } else {
+                mock_gpio_set_pin_location(pin, location->second.first, location->second.second);
+            }
+        }
+    }
+
+    /* Keys on a NO_PIN column can't be pressed */
+    void press(uint8_t row, uint8_t col, bool closed) {
+        if (col_pins[col] == NO_PIN) {
+            return;
+        }
+        mock_gpio_set_switch(col_pins[col], row_pins[row], closed);
+        pressed[row] = closed ? (pressed[row] | (MATRIX_ROW_SHIFTER << col)) : (pressed[row] & ~(MATRIX_ROW_SHIFTER << col));
+    }
+
+    void expect_pressed(void) {
+        matrix_scan();
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            EXPECT_EQ(matrix_get_row(row), pressed[row]) << "row " << +row;
+        }
+    }
+};
+
+TEST_F(MatrixScan, EachKeyOnItsOwn) {
+    matrix_init();
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            press(row, col, true);
+            expect_pressed();
+            press(row, col, false);
+        }
+    }
+    expect_pressed();
+}
+
+TEST_F(MatrixScan, ReadsWholePorts) {
+    matrix_init();
+    press(1, 2, true);
+    press(3, 17, true);
+
+    mock_gpio_pin_reads  = 0;
+    mock_gpio_port_reads = 0;
+    expect_pressed();
+
+#ifdef MATRIX_PORT_SCAN
+    // Columns 0-15 are on port 0 and columns 16-18 on port 1
+    EXPECT_EQ(mock_gpio_pin_reads, 0u);
+    EXPECT_EQ(mock_gpio_port_reads, MATRIX_ROWS * 2u);
+#else
+    EXPECT_EQ(mock_gpio_pin_reads, MATRIX_ROWS * (MATRIX_COLS - 1u));
+    EXPECT_EQ(mock_gpio_port_reads, 0u);
+#endif
+}
+
+TEST_F(MatrixScan, ScatteredColumns) {
+    // Every column on a different port or group of 4 bits, more groups than there are tables for
+    std::mt19937                                     rng(0);
+    std::map<pin_t, std::pair<gpio_port_t, uint8_t>> fixed;
+    for (uint8_t col = 0; col < MATRIX_COLS - 1; col++) {
+        fixed[col_pins[col]] = {col % MOCK_GPIO_PORTS, (col / MOCK_GPIO_PORTS) % 4 * 4 + col / 16};
+    }
+    wire(rng, fixed);
+    matrix_init();
+
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        press(col % MATRIX_ROWS, col, true);
+        expect_pressed();
+    }
+
+#ifdef MATRIX_PORT_SCAN
+    mock_gpio_pin_reads = 0;
+    expect_pressed();
+    EXPECT_GT(mock_gpio_pin_reads, 0u);
+#endif
+}
+
+TEST_F(MatrixScan, RandomWiring) {
+    for (uint32_t seed = 0; seed < 200; seed++) {
+        std::mt19937 rng(seed);
+        wire(rng, {});
+        matrix_init();
+
+        std::bernoulli_distribution closed(0.1);
+        for (uint8_t round = 0; round < 10; round++) {
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                    press(row, col, closed(rng));
+                }
+            }
+            SCOPED_TRACE(testing::Message() << "seed " << seed << ", round " << +round);
+            expect_pressed();
+        }
+    }
+}
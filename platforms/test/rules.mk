@@ -23,3 +23,25 @@ eeprom_legacy_emulated_flash_SRC := \
 	$(PLATFORM_PATH)/chibios/drivers/eeprom/eeprom_legacy_emulated_flash.c
 eeprom_legacy_emulated_flash_tiny_SRC := $(eeprom_legacy_emulated_flash_SRC)
 eeprom_legacy_emulated_flash_large_SRC := $(eeprom_legacy_emulated_flash_SRC)
+
+ws2812_encode_SRC := \
+	$(TOP_DIR)/drivers/ws2812_encode.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/ws2812_encode_tests.cpp
+
+ws2812_encode_rgbw_DEFS := -DWS2812_RGBW
+ws2812_encode_rgbw_SRC := $(ws2812_encode_SRC)
+
+matrix_pin_scan_DEFS := -DIGNORE_ATOMIC_BLOCK
+matrix_pin_scan_CONFIG := $(PLATFORM_PATH)/$(PLATFORM_KEY)/matrix_scan_config.h
+matrix_pin_scan_SRC := \
+	$(QUANTUM_PATH)/matrix.c \
+	$(QUANTUM_PATH)/matrix_common.c \
+	$(QUANTUM_PATH)/bitwise.c \
+	$(QUANTUM_PATH)/debounce/none.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/gpio_mock.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/matrix_scan_tests.cpp
+
+matrix_port_scan_DEFS := $(matrix_pin_scan_DEFS) -DMATRIX_PORT_SCAN
+matrix_port_scan_CONFIG := $(matrix_pin_scan_CONFIG)
+matrix_port_scan_SRC := $(matrix_pin_scan_SRC)
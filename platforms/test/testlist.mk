@@ -1 +1,3 @@
 TEST_LIST += eeprom_legacy_emulated_flash_tiny eeprom_legacy_emulated_flash_large
+TEST_LIST += ws2812_encode ws2812_encode_rgbw
+TEST_LIST += matrix_pin_scan matrix_port_scan
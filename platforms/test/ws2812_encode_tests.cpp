@@ -0,0 +1,149 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "ws2812_encode.h"
+}
+
+#define BENCHMARK_LED_COUNT 128
+#define BENCHMARK_ITERATIONS 2000
+
+/* Bit-by-bit reference encoder, as previously used by the SPI driver */
+static uint8_t get_protocol_eq(uint8_t data, int pos) {
+    uint8_t eq = 0;
+    if (data & (1 << (2 * (3 - pos))))
+        eq = 0b1110;
+    else
+        eq = 0b1000;
+    if (data & (2 << (2 * (3 - pos))))
+        eq += 0b11100000;
+    else
+        eq += 0b10000000;
+    return eq;
+}
+
+static void reference_encode_spi(uint8_t *buffer, const rgb_led_t *ledarray, uint16_t number_of_leds) {
+    const uint8_t *channel = (const uint8_t *)ledarray;
+    for (uint32_t i = 0; i < (uint32_t)number_of_leds * WS2812_CHANNELS; i++) {
+        for (int pos = 0; pos < WS2812_SPI_BYTES_PER_CHANNEL; pos++) {
+            *buffer++ = get_protocol_eq(channel[i], pos);
+        }
+    }
+}
+
+static std::vector<rgb_led_t> make_leds(uint16_t count, uint8_t seed) {
+    std::vector<rgb_led_t> leds(count);
+    uint8_t               *raw = (uint8_t *)leds.data();
+    for (size_t i = 0; i < count * sizeof(rgb_led_t); i++) {
+        seed   = seed * 73 + 41;
+        raw[i] = seed;
+    }
+    return leds;
+}
+
+class WS2812Encode : public ::testing::Test {};
+
+TEST_F(WS2812Encode, SpiMatchesReferenceForEveryByte) {
+    // Consecutive byte values spread over the channels of as many LEDs as fit in 256 bytes
+    std::vector<rgb_led_t> leds(256);
+    for (int i = 0; i < 256; i++) {
+        ((uint8_t *)leds.data())[i] = i;
+    }
+    const uint16_t       count = 256 / WS2812_CHANNELS;
+    std::vector<uint8_t> expected(count * WS2812_SPI_BYTES_PER_LED);
+    std::vector<uint8_t> actual(count * WS2812_SPI_BYTES_PER_LED);
+
+    reference_encode_spi(expected.data(), leds.data(), count);
+    ws2812_encode_spi(actual.data(), leds.data(), count);
+
+    EXPECT_EQ(expected, actual);
+}
+
+TEST_F(WS2812Encode, SpiKnownPatterns) {
+    rgb_led_t led = {};
+    led.r         = 0xFF;
+    led.g         = 0x00;
+    led.b         = 0xA5;
+
+    uint8_t buffer[WS2812_SPI_BYTES_PER_LED];
+    ws2812_encode_spi(buffer, &led, 1);
+
+    // Channels are encoded in wire (memory) order
+    const uint8_t *channel = (const uint8_t *)&led;
+    for (int c = 0; c < WS2812_CHANNELS; c++) {
+        const uint8_t *out = &buffer[c * WS2812_SPI_BYTES_PER_CHANNEL];
+        switch (channel[c]) {
+            case 0xFF:
+                EXPECT_EQ(out[0], 0xEE);
+                EXPECT_EQ(out[3], 0xEE);
+                break;
+            case 0x00:
+                EXPECT_EQ(out[0], 0x88);
+                EXPECT_EQ(out[3], 0x88);
+                break;
+            case 0xA5:
+                EXPECT_EQ(out[0], 0xE8);
+                EXPECT_EQ(out[1], 0xE8);
+                EXPECT_EQ(out[2], 0x8E);
+                EXPECT_EQ(out[3], 0x8E);
+                break;
+        }
+    }
+}
+
+TEST_F(WS2812Encode, SpiDoesNotWritePastBuffer) {
+    auto                 leds = make_leds(3, 7);
+    std::vector<uint8_t> buffer(3 * WS2812_SPI_BYTES_PER_LED + 4, 0x55);
+
+    ws2812_encode_spi(buffer.data(), leds.data(), 3);
+
+    for (size_t i = 3 * WS2812_SPI_BYTES_PER_LED; i < buffer.size(); i++) {
+        EXPECT_EQ(buffer[i], 0x55);
+    }
+}
+
+TEST_F(WS2812Encode, PwmWidthsAgree) {
+    const uint16_t        count = 16;
+    auto                  leds  = make_leds(count, 3);
+    const size_t          bits  = count * WS2812_CHANNELS * 8;
+    std::vector<uint8_t>  out8(bits);
+    std::vector<uint16_t> out16(bits);
+    std::vector<uint32_t> out32(bits);
+
+    ws2812_encode_pwm8(out8.data(), leds.data(), count, 17, 38);
+    ws2812_encode_pwm16(out16.data(), leds.data(), count, 17, 38);
+    ws2812_encode_pwm32(out32.data(), leds.data(), count, 17, 38);
+
+    const uint8_t *channel = (const uint8_t *)leds.data();
+    for (size_t i = 0; i < bits; i++) {
+        bool one = channel[i / 8] & (0x80 >> (i % 8));
+        EXPECT_EQ(out8[i], one ? 38 : 17);
+        EXPECT_EQ(out16[i], out8[i]);
+        EXPECT_EQ(out32[i], out8[i]);
+    }
+}
+
+TEST_F(WS2812Encode, SpiThroughput) {
+    auto                 leds = make_leds(BENCHMARK_LED_COUNT, 11);
+    std::vector<uint8_t> buffer(BENCHMARK_LED_COUNT * WS2812_SPI_BYTES_PER_LED);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        reference_encode_spi(buffer.data(), leds.data(), BENCHMARK_LED_COUNT);
+    }
+    auto reference = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        ws2812_encode_spi(buffer.data(), leds.data(), BENCHMARK_LED_COUNT);
+    }
+    auto table = std::chrono::steady_clock::now() - start;
+
+    RecordProperty("reference_ns_per_led", std::chrono::duration_cast<std::chrono::nanoseconds>(reference).count() / (BENCHMARK_ITERATIONS * BENCHMARK_LED_COUNT));
+    RecordProperty("table_ns_per_led", std::chrono::duration_cast<std::chrono::nanoseconds>(table).count() / (BENCHMARK_ITERATIONS * BENCHMARK_LED_COUNT));
+}
@@ -243,7 +243,7 @@ void process_record_tap_hint(keyrecord_t *record) {
         return;
     }
 
-    action_t action = layer_switch_get_action(record->event.key);
+    action_t action = action_for_keycode(get_record_keycode(record, true));
 
     switch (action.kind.id) {
 #    ifdef SWAP_HANDS_ENABLE
@@ -285,16 +285,8 @@ void process_record(keyrecord_t *record) {
 }
 
 void process_record_handler(keyrecord_t *record) {
-#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
-    action_t action;
-    if (record->keycode) {
-        action = action_for_keycode(record->keycode);
-    } else {
-        action = store_or_get_action(record->event.pressed, record->event.key);
-    }
-#else
-    action_t action = store_or_get_action(record->event.pressed, record->event.key);
-#endif
+    // Same as store_or_get_action(), reusing the keycode already looked up for the record
+    action_t action = action_for_keycode(get_record_keycode(record, true));
     ac_dprintf("ACTION: ");
     debug_action(action);
 #ifndef NO_ACTION_LAYER
@@ -1112,6 +1104,11 @@ bool is_tap_record(keyrecord_t *record) {
         return false;
     }
 
+    // A press resolves against the current layers, reuse the keycode already looked up for it
+    if (record->event.pressed) {
+        return is_tap_action(action_for_keycode(get_record_keycode(record, true)));
+    }
+
 #if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
     action_t action;
     if (record->keycode) {
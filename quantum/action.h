@@ -44,6 +44,13 @@ typedef struct {
     uint8_t count : 4;
 } tap_t;
 
+/* keycode looked up for an event, see get_record_keycode() */
+typedef struct {
+    uint16_t keycode;
+    uint8_t  layer;
+    uint16_t generation; // 0 when not looked up yet
+} keylookup_t;
+
 /* Key event container for recording */
 typedef struct {
     keyevent_t event;
@@ -53,6 +60,7 @@ typedef struct {
 #if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
     uint16_t keycode;
 #endif
+    keylookup_t lookup;
 } keyrecord_t;
 
 /* Execute action per keyevent */
@@ -6,6 +6,7 @@
 #include "encoder.h"
 #include "util.h"
 #include "action_layer.h"
+#include "keymap_common.h"
 
 /** \brief Default Layer State
  */
@@ -39,6 +40,7 @@ static void default_layer_state_set(layer_state_t state) {
     default_layer_state = state;
     default_layer_debug();
     ac_dprintf("\n");
+    keymap_lookup_invalidate();
 #if defined(STRICT_LAYER_RELEASE)
     clear_keyboard_but_mods(); // To avoid stuck keys
 #elif defined(SEMI_STRICT_LAYER_RELEASE)
@@ -119,6 +121,7 @@ void layer_state_set(layer_state_t state) {
     layer_state = state;
     layer_debug();
     ac_dprintf("\n");
+    keymap_lookup_invalidate();
 #    if defined(STRICT_LAYER_RELEASE)
     clear_keyboard_but_mods(); // To avoid stuck keys
 #    elif defined(SEMI_STRICT_LAYER_RELEASE)
@@ -316,30 +319,39 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
 #endif
 }
 
-/** \brief Layer switch get layer
+/** \brief Layer switch get keycode
  *
- * Gets the layer based on key info
+ * Gets the keycode based on key info, along with the layer it was found on
  */
-uint8_t layer_switch_get_layer(keypos_t key) {
+uint16_t layer_switch_get_keycode(keypos_t key, uint8_t *layer) {
 #ifndef NO_ACTION_LAYER
-    action_t action;
-    action.code = ACTION_TRANSPARENT;
-
     layer_state_t layers = layer_state | default_layer_state;
     /* check top layer first */
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
         if (layers & ((layer_state_t)1 << i)) {
-            action = action_for_key(i, key);
-            if (action.code != ACTION_TRANSPARENT) {
-                return i;
+            uint16_t keycode = keymap_key_to_keycode(i, key);
+            if (keycode != KC_TRANSPARENT) {
+                *layer = i;
+                return keycode;
             }
         }
     }
     /* fall back to layer 0 */
-    return 0;
+    *layer = 0;
 #else
-    return get_highest_layer(default_layer_state);
+    *layer = get_highest_layer(default_layer_state);
 #endif
+    return keymap_key_to_keycode(*layer, key);
+}
+
+/** \brief Layer switch get layer
+ *
+ * Gets the layer based on key info
+ */
+uint8_t layer_switch_get_layer(keypos_t key) {
+    uint8_t layer;
+    layer_switch_get_keycode(key, &layer);
+    return layer;
 }
 
 /** \brief Layer switch get layer
@@ -163,6 +163,9 @@ uint8_t read_source_layers_cache(keypos_t key);
 #endif
 action_t store_or_get_action(bool pressed, keypos_t key);
 
+/* return the topmost non-transparent keycode currently associated with key, and the layer it is on */
+uint16_t layer_switch_get_keycode(keypos_t key, uint8_t *layer);
+
 /* return the topmost non-transparent layer currently associated with key */
 uint8_t layer_switch_get_layer(keypos_t key);
 
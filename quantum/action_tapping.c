@@ -1,5 +1,7 @@
+#include <limits.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "action.h"
 #include "action_layer.h"
@@ -59,13 +61,30 @@ __attribute__((weak)) bool get_hold_on_other_key_press(uint16_t keycode, keyreco
 #        include "process_auto_shift.h"
 #    endif
 
+#    if (WAITING_BUFFER_SIZE & (WAITING_BUFFER_SIZE - 1)) != 0 || WAITING_BUFFER_SIZE > 128
+#        error "WAITING_BUFFER_SIZE must be a power of two, no larger than 128"
+#    endif
+#    define WAITING_BUFFER_NEXT(i) (((i) + 1) & (WAITING_BUFFER_SIZE - 1))
+
 static keyrecord_t tapping_key                         = {};
 static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE] = {};
 static uint8_t     waiting_buffer_head                 = 0;
 static uint8_t     waiting_buffer_tail                 = 0;
 
+/* Matrix keys with a press or a release in the waiting buffer. Kept up to date as events are
+ * queued and dequeued, so that looking for a key in the buffer doesn't have to go through it.
+ */
+static uint8_t waiting_keys_pressed[(MATRIX_ROWS * MATRIX_COLS + (CHAR_BIT)-1) / (CHAR_BIT)]  = {0};
+static uint8_t waiting_keys_released[(MATRIX_ROWS * MATRIX_COLS + (CHAR_BIT)-1) / (CHAR_BIT)] = {0};
+/* Queued events already set in the bitmaps by an earlier event */
+static uint8_t waiting_keys_repeated = 0;
+/* Queued events outside of the matrix (encoders, dip switches), which are not tracked */
+static uint8_t waiting_keys_untracked = 0;
+static uint8_t waiting_keys_presses   = 0;
+
 static bool process_tapping(keyrecord_t *record);
 static bool waiting_buffer_enq(keyrecord_t record);
+static void waiting_buffer_deq(keyevent_t event);
 static void waiting_buffer_clear(void);
 static bool waiting_buffer_typed(keyevent_t event);
 static bool waiting_buffer_has_anykey_pressed(void);
@@ -98,11 +117,14 @@ void action_tapping_process(keyrecord_t record) {
     if (IS_EVENT(record.event) && waiting_buffer_head != waiting_buffer_tail) {
         ac_dprintf("---- action_exec: process waiting_buffer -----\n");
     }
-    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
+    while (waiting_buffer_tail != waiting_buffer_head) {
+        // Processing may change the record, e.g. turn a press into a release for one shot layers
+        const keyevent_t event = waiting_buffer[waiting_buffer_tail].event;
         if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
             ac_dprintf("processed: waiting_buffer[%u] =", waiting_buffer_tail);
             debug_record(waiting_buffer[waiting_buffer_tail]);
             ac_dprintf("\n\n");
+            waiting_buffer_deq(event);
         } else {
             break;
         }
@@ -432,59 +454,132 @@ bool process_tapping(keyrecord_t *keyp) {
     }
 }
 
+/* Bitmap index of a key, false for positions outside of the matrix */
+static bool waiting_key_index(keypos_t key, uint16_t *index) {
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        *index = (uint16_t)(key.row * MATRIX_COLS) + key.col;
+        return true;
+    }
+    return false;
+}
+
+static bool waiting_key_is_set(const uint8_t *keys, uint16_t index) {
+    return keys[index / (CHAR_BIT)] & (1U << (index % (CHAR_BIT)));
+}
+
 /** \brief Waiting buffer enq
  *
- * FIXME: Needs docs
+ * Queues an event behind the undecided tapping key.
  */
 bool waiting_buffer_enq(keyrecord_t record) {
     if (IS_NOEVENT(record.event)) {
         return true;
     }
 
-    if ((waiting_buffer_head + 1) % WAITING_BUFFER_SIZE == waiting_buffer_tail) {
+    if (WAITING_BUFFER_NEXT(waiting_buffer_head) == waiting_buffer_tail) {
         ac_dprintf("waiting_buffer_enq: Over flow.\n");
         return false;
     }
 
     waiting_buffer[waiting_buffer_head] = record;
-    waiting_buffer_head                 = (waiting_buffer_head + 1) % WAITING_BUFFER_SIZE;
+    waiting_buffer_head                 = WAITING_BUFFER_NEXT(waiting_buffer_head);
+
+    uint16_t index;
+    if (waiting_key_index(record.event.key, &index)) {
+        uint8_t *keys = record.event.pressed ? waiting_keys_pressed : waiting_keys_released;
+        if (waiting_key_is_set(keys, index)) {
+            waiting_keys_repeated++;
+        }
+        keys[index / (CHAR_BIT)] |= 1U << (index % (CHAR_BIT));
+    } else {
+        waiting_keys_untracked++;
+    }
+    if (record.event.pressed) {
+        waiting_keys_presses++;
+    }
 
     ac_dprintf("waiting_buffer_enq: ");
     debug_waiting_buffer();
     return true;
 }
 
+/** \brief Waiting buffer deq
+ *
+ * Drops the oldest event, `event` being what it was when it was queued.
+ */
+static void waiting_buffer_deq(keyevent_t event) {
+    waiting_buffer_tail = WAITING_BUFFER_NEXT(waiting_buffer_tail);
+
+    uint16_t index;
+    if (waiting_key_index(event.key, &index)) {
+        bool clear = true;
+        // Only go through the buffer when the same key and state may be queued more than once
+        if (waiting_keys_repeated) {
+            for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = WAITING_BUFFER_NEXT(i)) {
+                if (KEYEQ(event.key, waiting_buffer[i].event.key) && event.pressed == waiting_buffer[i].event.pressed) {
+                    waiting_keys_repeated--;
+                    clear = false;
+                    break;
+                }
+            }
+        }
+        if (clear) {
+            uint8_t *keys = event.pressed ? waiting_keys_pressed : waiting_keys_released;
+            keys[index / (CHAR_BIT)] &= ~(1U << (index % (CHAR_BIT)));
+        }
+    } else {
+        waiting_keys_untracked--;
+    }
+    if (event.pressed) {
+        waiting_keys_presses--;
+    }
+}
+
 /** \brief Waiting buffer clear
  *
- * FIXME: Needs docs
+ * Drops all queued events.
  */
 void waiting_buffer_clear(void) {
     waiting_buffer_head = 0;
     waiting_buffer_tail = 0;
+    memset(waiting_keys_pressed, 0, sizeof(waiting_keys_pressed));
+    memset(waiting_keys_released, 0, sizeof(waiting_keys_released));
+    waiting_keys_repeated  = 0;
+    waiting_keys_untracked = 0;
+    waiting_keys_presses   = 0;
 }
 
-/** \brief Waiting buffer typed
- *
- * FIXME: Needs docs
- */
-bool waiting_buffer_typed(keyevent_t event) {
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (KEYEQ(event.key, waiting_buffer[i].event.key) && event.pressed != waiting_buffer[i].event.pressed) {
+/* Whether an event of `key` in the given state is queued */
+static bool waiting_buffer_has(keypos_t key, bool pressed) {
+    uint16_t index;
+    if (waiting_key_index(key, &index)) {
+        return waiting_key_is_set(pressed ? waiting_keys_pressed : waiting_keys_released, index);
+    }
+    if (!waiting_keys_untracked) {
+        return false;
+    }
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = WAITING_BUFFER_NEXT(i)) {
+        if (KEYEQ(key, waiting_buffer[i].event.key) && pressed == waiting_buffer[i].event.pressed) {
             return true;
         }
     }
     return false;
 }
 
+/** \brief Waiting buffer typed
+ *
+ * Whether the opposite of `event` is queued for the same key.
+ */
+bool waiting_buffer_typed(keyevent_t event) {
+    return waiting_buffer_has(event.key, !event.pressed);
+}
+
 /** \brief Waiting buffer has anykey pressed
  *
- * FIXME: Needs docs
+ * Whether any press is queued.
  */
 __attribute__((unused)) bool waiting_buffer_has_anykey_pressed(void) {
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (waiting_buffer[i].event.pressed) return true;
-    }
-    return false;
+    return waiting_keys_presses > 0;
 }
 
 /** \brief Scan buffer for tapping
@@ -499,10 +594,15 @@ void waiting_buffer_scan_tap(void) {
         return;
     }
 
+    // nothing to look for unless the release of the tapping key is queued
+    if (!waiting_buffer_has(tapping_key.event.key, false)) {
+        return;
+    }
+
 #    if (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT))
     TAP_DEFINE_KEYCODE;
 #    endif
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = WAITING_BUFFER_NEXT(i)) {
         keyrecord_t *candidate = &waiting_buffer[i];
         // clang-format off
         if (IS_EVENT(candidate->event) && KEYEQ(candidate->event.key, tapping_key.event.key) && !candidate->event.pressed && (
@@ -536,7 +636,7 @@ static void debug_tapping_key(void) {
  */
 static void debug_waiting_buffer(void) {
     ac_dprintf("{ ");
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = WAITING_BUFFER_NEXT(i)) {
         ac_dprintf("[%u]=", i);
         debug_record(waiting_buffer[i]);
         ac_dprintf(" ");
@@ -0,0 +1,290 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "audio_mixer.h"
+
+/* Envelope levels are 8.24 fixed point, so a full scale voice multiplies its samples by exactly 1.0 */
+#define AUDIO_MIXER_LEVEL_MAX (1UL << 24)
+#define AUDIO_MIXER_LEVEL_SUSTAIN ((uint32_t)((uint64_t)AUDIO_MIXER_LEVEL_MAX * AUDIO_MIXER_SUSTAIN_LEVEL / 255))
+
+/* Each voice contributes at most +/- 4095 (12 bit samples) to the 16 bit accumulator */
+_Static_assert(AUDIO_MIXER_VOICES <= 8, "AUDIO_MIXER_VOICES must not exceed 8");
+
+/* Two tones closer than half a semitone (2^(1/24)) are considered the same voice */
+#define AUDIO_MIXER_MATCH_RATIO 1.0293022f
+
+typedef enum {
+    VOICE_OFF,
+    VOICE_ATTACK,
+    VOICE_DECAY,
+    VOICE_SUSTAIN,
+    VOICE_RELEASE,
+} voice_stage_t;
+
+typedef struct {
+    float    frequency;
+    uint32_t phase;
+    uint32_t increment;
+    uint32_t level;
+    int32_t  slope;
+    uint32_t remaining; // samples left in the current stage
+    uint8_t  stage;
+} audio_mixer_voice_t;
+
+static audio_mixer_config_t config;
+static audio_mixer_voice_t  voices[AUDIO_MIXER_VOICES];
+static uint32_t             attack_step;
+static uint32_t             decay_step;
+static uint32_t             release_step;
+
+static uint32_t ms_to_step(uint32_t ms, uint32_t range) {
+    uint32_t samples = (uint32_t)((uint64_t)ms * config.sample_rate / 1000);
+    if (samples == 0) {
+        return 0;
+    }
+    uint32_t step = range / samples;
+    return step ? step : 1;
+}
+
+/* Ramp from the current level to `target` in steps of `step`; the stage ends exactly on the target */
+static void voice_ramp(audio_mixer_voice_t *voice, voice_stage_t stage, uint32_t target, uint32_t step) {
+    voice->stage = stage;
+    if (step == 0) {
+        voice->level     = target;
+        voice->slope     = 0;
+        voice->remaining = 0;
+    } else if (target >= voice->level) {
+        voice->slope     = (int32_t)step;
+        voice->remaining = (target - voice->level) / step;
+    } else {
+        voice->slope     = -(int32_t)step;
+        voice->remaining = (voice->level - target) / step;
+    }
+}
+
+static void voice_enter(audio_mixer_voice_t *voice, voice_stage_t stage) {
+    switch (stage) {
+        case VOICE_ATTACK:
+            voice_ramp(voice, VOICE_ATTACK, AUDIO_MIXER_LEVEL_MAX, attack_step);
+            break;
+        case VOICE_DECAY:
+            voice_ramp(voice, VOICE_DECAY, AUDIO_MIXER_LEVEL_SUSTAIN, decay_step);
+            break;
+        case VOICE_RELEASE:
+            voice_ramp(voice, VOICE_RELEASE, 0, release_step);
+            break;
+        case VOICE_SUSTAIN:
+            voice->stage     = VOICE_SUSTAIN;
+            voice->slope     = 0;
+            voice->remaining = UINT32_MAX;
+            break;
+        default:
+            voice->stage     = VOICE_OFF;
+            voice->level     = 0;
+            voice->slope     = 0;
+            voice->remaining = 0;
+            break;
+    }
+}
+
+/* Called when the current stage ran out of samples: snap to its target and move on */
+static void voice_advance(audio_mixer_voice_t *voice) {
+    switch (voice->stage) {
+        case VOICE_ATTACK:
+            voice->level = AUDIO_MIXER_LEVEL_MAX;
+            voice_enter(voice, VOICE_DECAY);
+            break;
+        case VOICE_DECAY:
+            voice->level = AUDIO_MIXER_LEVEL_SUSTAIN;
+            voice_enter(voice, VOICE_SUSTAIN);
+            break;
+        case VOICE_RELEASE:
+            voice_enter(voice, VOICE_OFF);
+            break;
+        default:
+            break;
+    }
+}
+
+static bool voice_is_held(audio_mixer_voice_t *voice) {
+    return voice->stage == VOICE_ATTACK || voice->stage == VOICE_DECAY || voice->stage == VOICE_SUSTAIN;
+}
+
+static void voice_set_frequency(audio_mixer_voice_t *voice, float frequency) {
+    voice->frequency = frequency;
+    voice->increment = (uint32_t)(frequency / config.sample_rate * 4294967296.0f);
+}
+
+void audio_mixer_init(const audio_mixer_config_t *mixer_config) {
+    config = *mixer_config;
+
+    attack_step  = ms_to_step(AUDIO_MIXER_ATTACK_MS, AUDIO_MIXER_LEVEL_MAX);
+    decay_step   = ms_to_step(AUDIO_MIXER_DECAY_MS, AUDIO_MIXER_LEVEL_MAX - AUDIO_MIXER_LEVEL_SUSTAIN);
+    release_step = ms_to_step(AUDIO_MIXER_RELEASE_MS, AUDIO_MIXER_LEVEL_MAX);
+
+    for (uint8_t i = 0; i < AUDIO_MIXER_VOICES; i++) {
+        voices[i].phase = 0;
+        voice_enter(&voices[i], VOICE_OFF);
+    }
+}
+
+void audio_mixer_set_tones(const float *frequencies, uint8_t count) {
+    uint32_t matched_voices = 0;
+    uint32_t matched_tones  = 0;
+
+    // keep voices that are still requested, allowing for small pitch changes
+    for (uint8_t t = 0; t < count && t < 32; t++) {
+        if (frequencies[t] <= 0.0f) {
+            matched_tones |= 1UL << t;
+            continue;
+        }
+        int8_t best       = -1;
+        float  best_ratio = AUDIO_MIXER_MATCH_RATIO;
+        for (uint8_t v = 0; v < AUDIO_MIXER_VOICES; v++) {
+            if (!voice_is_held(&voices[v]) || (matched_voices & (1UL << v))) {
+                continue;
+            }
+            float ratio = frequencies[t] > voices[v].frequency ? frequencies[t] / voices[v].frequency : voices[v].frequency / frequencies[t];
+            if (ratio < best_ratio) {
+                best       = v;
+                best_ratio = ratio;
+            }
+        }
+        if (best >= 0) {
+            matched_voices |= 1UL << best;
+            matched_tones |= 1UL << t;
+            voice_set_frequency(&voices[best], frequencies[t]);
+        }
+    }
+
+    for (uint8_t v = 0; v < AUDIO_MIXER_VOICES; v++) {
+        if (voice_is_held(&voices[v]) && !(matched_voices & (1UL << v))) {
+            voice_enter(&voices[v], VOICE_RELEASE);
+        }
+    }
+
+    // start the remaining tones on free voices, or steal the quietest releasing one
+    for (uint8_t t = 0; t < count && t < 32; t++) {
+        if (matched_tones & (1UL << t)) {
+            continue;
+        }
+        audio_mixer_voice_t *voice = NULL;
+        for (uint8_t v = 0; v < AUDIO_MIXER_VOICES; v++) {
+            if (voices[v].stage == VOICE_OFF) {
+                voice = &voices[v];
+                break;
+            }
+            if (voices[v].stage == VOICE_RELEASE && (voice == NULL || voices[v].level < voice->level)) {
+                voice = &voices[v];
+            }
+        }
+        if (voice == NULL) {
+            break;
+        }
+        voice->phase = 0;
+        voice->level = 0;
+        voice_set_frequency(voice, frequencies[t]);
+        voice_enter(voice, VOICE_ATTACK);
+    }
+}
+
+void audio_mixer_release_all(void) {
+    for (uint8_t v = 0; v < AUDIO_MIXER_VOICES; v++) {
+        if (voice_is_held(&voices[v])) {
+            voice_enter(&voices[v], VOICE_RELEASE);
+        }
+    }
+}
+
+static void render_voice(audio_mixer_voice_t *voice, int16_t *accumulator, size_t count) {
+    const uint16_t *wavetable = config.wavetable;
+    const int32_t   offset    = config.off_value;
+    const uint8_t   shift     = 32 - config.wavetable_bits;
+    uint32_t        phase     = voice->phase;
+    const uint32_t  increment = voice->increment;
+    size_t          i         = 0;
+
+    while (i < count && voice->stage != VOICE_OFF) {
+        size_t   segment = count - i;
+        uint32_t level   = voice->level;
+        int32_t  slope   = voice->slope;
+
+        if (voice->remaining < segment) {
+            segment = voice->remaining;
+        }
+
+        if (slope == 0) {
+            const int32_t gain = level >> 8;
+            for (size_t s = 0; s < segment; s++) {
+                accumulator[i + s] += ((int32_t)wavetable[phase >> shift] - offset) * gain >> 16;
+                phase += increment;
+            }
+        } else {
+            for (size_t s = 0; s < segment; s++) {
+                accumulator[i + s] += ((int32_t)wavetable[phase >> shift] - offset) * (int32_t)(level >> 8) >> 16;
+                phase += increment;
+                level += slope;
+            }
+        }
+
+        i += segment;
+        voice->level = level;
+        if (voice->stage != VOICE_SUSTAIN) {
+            voice->remaining -= segment;
+            if (voice->remaining == 0) {
+                voice_advance(voice);
+            }
+        }
+    }
+
+    voice->phase = phase;
+}
+
+void audio_mixer_render(uint16_t *buffer, size_t count) {
+    // the output buffer doubles as signed accumulator, every voice contributes at most +/- sample_max
+    int16_t *accumulator = (int16_t *)buffer;
+    uint8_t  sounding    = audio_mixer_active_voices();
+
+    for (size_t i = 0; i < count; i++) {
+        accumulator[i] = 0;
+    }
+
+    if (sounding == 0) {
+        for (size_t i = 0; i < count; i++) {
+            buffer[i] = config.off_value;
+        }
+        return;
+    }
+
+    for (uint8_t v = 0; v < AUDIO_MIXER_VOICES; v++) {
+        if (voices[v].stage != VOICE_OFF) {
+            render_voice(&voices[v], accumulator, count);
+        }
+    }
+
+    // scale the sum by the number of voices, with a reciprocal instead of a division per sample
+    const int32_t gain = 65536 / sounding;
+    for (size_t i = 0; i < count; i++) {
+        int32_t value = (int32_t)config.off_value + ((accumulator[i] * gain) >> 16);
+        if (value < 0) {
+            value = 0;
+        } else if (value > config.sample_max) {
+            value = config.sample_max;
+        }
+        buffer[i] = value;
+    }
+}
+
+uint8_t audio_mixer_active_voices(void) {
+    uint8_t count = 0;
+    for (uint8_t v = 0; v < AUDIO_MIXER_VOICES; v++) {
+        if (voices[v].stage != VOICE_OFF) {
+            count++;
+        }
+    }
+    return count;
+}
+
+bool audio_mixer_is_idle(void) {
+    return audio_mixer_active_voices() == 0;
+}
@@ -0,0 +1,92 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Block based wavetable mixer.
+ *
+ * Voices are taken from a fixed pool, each with a 32 bit fixed-point phase
+ * accumulator and a linear ADSR amplitude envelope, and are rendered a whole
+ * block of samples at a time. No floating point math happens while rendering;
+ * frequencies are only converted to phase increments when the tones change.
+ */
+
+/* Size of the voice pool, including voices that are still in their release phase. */
+#ifndef AUDIO_MIXER_VOICES
+#    define AUDIO_MIXER_VOICES 8
+#endif
+
+/* Envelope timing, in milliseconds. Zero disables the respective stage. */
+#ifndef AUDIO_MIXER_ATTACK_MS
+#    define AUDIO_MIXER_ATTACK_MS 2
+#endif
+#ifndef AUDIO_MIXER_DECAY_MS
+#    define AUDIO_MIXER_DECAY_MS 0
+#endif
+#ifndef AUDIO_MIXER_RELEASE_MS
+#    define AUDIO_MIXER_RELEASE_MS 5
+#endif
+
+/* Sustain level, 0 to 255. */
+#ifndef AUDIO_MIXER_SUSTAIN_LEVEL
+#    define AUDIO_MIXER_SUSTAIN_LEVEL 255
+#endif
+
+typedef struct {
+    /* One period of the waveform, 2^wavetable_bits samples long. */
+    const uint16_t *wavetable;
+    uint8_t         wavetable_bits;
+    /* Output value while silent, the envelope scales each voice towards it. */
+    uint16_t off_value;
+    /* Largest value the output is clamped to. */
+    uint16_t sample_max;
+    /* Rate at which the rendered samples are played back, in Hz. */
+    uint32_t sample_rate;
+} audio_mixer_config_t;
+
+/**
+ * \brief Set up the mixer and silence all voices.
+ */
+void audio_mixer_init(const audio_mixer_config_t *config);
+
+/**
+ * \brief Update the set of tones that should be sounding.
+ *
+ * Voices whose frequency is within half a semitone of a requested tone keep
+ * their phase and envelope (so vibrato and glides stay continuous), voices
+ * that are no longer requested enter their release phase, and new tones are
+ * started on free voices. When the pool is exhausted, the quietest releasing
+ * voice is stolen.
+ *
+ * \param frequencies tones in Hz, zero entries are rests and are ignored
+ * \param count number of entries in `frequencies`
+ */
+void audio_mixer_set_tones(const float *frequencies, uint8_t count);
+
+/**
+ * \brief Move every voice into its release phase.
+ *
+ * Like audio_mixer_set_tones(), this must be called from the same context as audio_mixer_render(),
+ * as it rewrites the envelope of voices that may be halfway through rendering.
+ */
+void audio_mixer_release_all(void);
+
+/**
+ * \brief Render the next `count` samples into `buffer`.
+ */
+void audio_mixer_render(uint16_t *buffer, size_t count);
+
+/**
+ * \brief Number of voices currently producing output, including releasing ones.
+ */
+uint8_t audio_mixer_active_voices(void);
+
+/**
+ * \brief True once every voice has finished its release phase.
+ */
+bool audio_mixer_is_idle(void);
@@ -0,0 +1,258 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "audio_mixer.h"
+}
+
+/* Matches the default 'sane minimum' DAC configuration, 3/2 * 16384Hz */
+#define SAMPLE_RATE 24576
+#define OFF_VALUE 2047
+#define SAMPLE_MAX 4095
+#define BLOCK_SIZE 32
+
+/* At this frequency a voice advances exactly one wavetable entry per sample */
+#define UNITY_FREQUENCY ((float)SAMPLE_RATE / 256)
+
+#define MS_TO_SAMPLES(ms) ((ms) * SAMPLE_RATE / 1000)
+
+static std::vector<uint16_t> make_sine_table(void) {
+    std::vector<uint16_t> table(256);
+    for (size_t i = 0; i < table.size(); i++) {
+        table[i] = (uint16_t)lround((1.0 - cos(2.0 * M_PI * i / table.size())) / 2.0 * SAMPLE_MAX);
+    }
+    return table;
+}
+
+static const uint16_t dc_table[] = {SAMPLE_MAX, SAMPLE_MAX};
+
+/**
+ * Host side renderer: writes mono 16 bit PCM, with the 12 bit DAC samples centered around zero.
+ */
+static bool write_wav(const std::string &path, const std::vector<uint16_t> &samples, uint32_t sample_rate) {
+    FILE *file = fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+
+    auto put16 = [file](uint16_t v) {
+        fputc(v & 0xFF, file);
+        fputc(v >> 8, file);
+    };
+    auto put32 = [&put16](uint32_t v) {
+        put16(v & 0xFFFF);
+        put16(v >> 16);
+    };
+
+    uint32_t data_size = samples.size() * 2;
+    fwrite("RIFF", 1, 4, file);
+    put32(36 + data_size);
+    fwrite("WAVEfmt ", 1, 8, file);
+    put32(16);              // fmt chunk size
+    put16(1);               // PCM
+    put16(1);               // mono
+    put32(sample_rate);     // sample rate
+    put32(sample_rate * 2); // byte rate
+    put16(2);               // block align
+    put16(16);              // bits per sample
+    fwrite("data", 1, 4, file);
+    put32(data_size);
+    for (uint16_t sample : samples) {
+        put16((uint16_t)(((int16_t)sample - 2048) * 16));
+    }
+
+    fclose(file);
+    return true;
+}
+
+static std::string wav_path(const char *name) {
+    const char *dir = getenv("AUDIO_MIXER_WAV_DIR");
+    return std::string(dir ? dir : ::testing::TempDir().c_str()) + "/" + name + ".wav";
+}
+
+class AudioMixer : public ::testing::Test {
+   protected:
+    std::vector<uint16_t> sine = make_sine_table();
+
+    void init(const uint16_t *wavetable, uint8_t bits) {
+        audio_mixer_config_t config = {
+            .wavetable      = wavetable,
+            .wavetable_bits = bits,
+            .off_value      = OFF_VALUE,
+            .sample_max     = SAMPLE_MAX,
+            .sample_rate    = SAMPLE_RATE,
+        };
+        audio_mixer_init(&config);
+    }
+
+    void SetUp() override {
+        init(sine.data(), 8);
+    }
+
+    std::vector<uint16_t> render(size_t count) {
+        std::vector<uint16_t> out(count);
+        for (size_t i = 0; i < count; i += BLOCK_SIZE) {
+            audio_mixer_render(&out[i], std::min<size_t>(BLOCK_SIZE, count - i));
+        }
+        return out;
+    }
+};
+
+TEST_F(AudioMixer, SilentWhenIdle) {
+    EXPECT_TRUE(audio_mixer_is_idle());
+    for (uint16_t sample : render(256)) {
+        EXPECT_EQ(sample, OFF_VALUE);
+    }
+}
+
+TEST_F(AudioMixer, SustainedVoiceReproducesWavetableExactly) {
+    float tone = UNITY_FREQUENCY;
+    audio_mixer_set_tones(&tone, 1);
+
+    const size_t attack = MS_TO_SAMPLES(AUDIO_MIXER_ATTACK_MS) + 1;
+    auto         out    = render(attack + 1024);
+
+    for (size_t i = attack; i < out.size(); i++) {
+        ASSERT_EQ(out[i], sine[i % 256]) << "sample " << i;
+    }
+}
+
+TEST_F(AudioMixer, EnvelopeRampsUpHoldsAndReleases) {
+    init(dc_table, 1);
+    float tone = 440.0f;
+    audio_mixer_set_tones(&tone, 1);
+
+    auto attack = render(MS_TO_SAMPLES(AUDIO_MIXER_ATTACK_MS) + BLOCK_SIZE);
+    EXPECT_LT(attack.front(), OFF_VALUE + 16);
+    for (size_t i = 1; i < attack.size(); i++) {
+        ASSERT_GE(attack[i], attack[i - 1]) << "sample " << i;
+    }
+    EXPECT_EQ(attack.back(), SAMPLE_MAX);
+
+    for (uint16_t sample : render(1024)) {
+        ASSERT_EQ(sample, SAMPLE_MAX);
+    }
+
+    audio_mixer_set_tones(nullptr, 0);
+    auto release = render(MS_TO_SAMPLES(AUDIO_MIXER_RELEASE_MS) + BLOCK_SIZE);
+    for (size_t i = 1; i < release.size(); i++) {
+        ASSERT_LE(release[i], release[i - 1]) << "sample " << i;
+    }
+    EXPECT_EQ(release.back(), OFF_VALUE);
+    EXPECT_TRUE(audio_mixer_is_idle());
+}
+
+TEST_F(AudioMixer, SmallPitchChangeKeepsVoice) {
+    float tone = 440.0f;
+    audio_mixer_set_tones(&tone, 1);
+    render(256);
+
+    // vibrato sized change: same voice, no release tail
+    tone = 445.0f;
+    audio_mixer_set_tones(&tone, 1);
+    EXPECT_EQ(audio_mixer_active_voices(), 1);
+
+    // a whole tone up is a new note, the old one releases
+    tone = 495.0f;
+    audio_mixer_set_tones(&tone, 1);
+    EXPECT_EQ(audio_mixer_active_voices(), 2);
+}
+
+TEST_F(AudioMixer, RestsAreIgnored) {
+    float tones[] = {0.0f, 440.0f, 0.0f};
+    audio_mixer_set_tones(tones, 3);
+    EXPECT_EQ(audio_mixer_active_voices(), 1);
+}
+
+TEST_F(AudioMixer, ExhaustedPoolStealsReleasingVoices) {
+    float first[AUDIO_MIXER_VOICES];
+    float second[AUDIO_MIXER_VOICES];
+    for (int i = 0; i < AUDIO_MIXER_VOICES; i++) {
+        first[i]  = 110.0f * (i + 1);
+        second[i] = 107.0f * (i + 1) + 1000.0f;
+    }
+
+    audio_mixer_set_tones(first, AUDIO_MIXER_VOICES);
+    render(256);
+    audio_mixer_set_tones(second, AUDIO_MIXER_VOICES);
+    EXPECT_EQ(audio_mixer_active_voices(), AUDIO_MIXER_VOICES);
+
+    for (uint16_t sample : render(1024)) {
+        ASSERT_LE(sample, SAMPLE_MAX);
+    }
+}
+
+TEST_F(AudioMixer, RenderingIsDeterministic) {
+    // C major arpeggio into a chord, then release
+    const float notes[] = {261.63f, 329.63f, 392.00f, 523.25f};
+
+    auto play = [&]() {
+        std::vector<uint16_t> out;
+        init(sine.data(), 8);
+        for (uint8_t n = 1; n <= 4; n++) {
+            audio_mixer_set_tones(notes, n);
+            auto block = render(MS_TO_SAMPLES(150));
+            out.insert(out.end(), block.begin(), block.end());
+        }
+        audio_mixer_set_tones(nullptr, 0);
+        auto block = render(MS_TO_SAMPLES(50));
+        out.insert(out.end(), block.begin(), block.end());
+        return out;
+    };
+
+    auto first  = play();
+    auto second = play();
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(first.back(), OFF_VALUE);
+
+    // the WAV file holds exactly the rendered samples
+    auto path = wav_path("audio_mixer_arpeggio");
+    ASSERT_TRUE(write_wav(path, first, SAMPLE_RATE));
+
+    FILE *file = fopen(path.c_str(), "rb");
+    ASSERT_NE(file, nullptr);
+    std::vector<uint8_t> wav(44 + first.size() * 2);
+    ASSERT_EQ(fread(wav.data(), 1, wav.size(), file), wav.size());
+    EXPECT_EQ(fgetc(file), EOF);
+    fclose(file);
+
+    EXPECT_EQ(std::string(wav.begin(), wav.begin() + 4), "RIFF");
+    EXPECT_EQ(std::string(wav.begin() + 8, wav.begin() + 16), "WAVEfmt ");
+    EXPECT_EQ(wav[24] | wav[25] << 8 | wav[26] << 16 | wav[27] << 24, SAMPLE_RATE);
+    for (size_t i = 0; i < first.size(); i++) {
+        int16_t pcm = (int16_t)(wav[44 + 2 * i] | wav[45 + 2 * i] << 8);
+        ASSERT_EQ(pcm / 16 + 2048, first[i]) << "sample " << i;
+    }
+}
+
+TEST_F(AudioMixer, RenderCostPerVoiceCount) {
+    const size_t iterations = 2000;
+
+    for (uint8_t voices = 1; voices <= AUDIO_MIXER_VOICES; voices++) {
+        std::vector<float> tones;
+        for (uint8_t v = 0; v < voices; v++) {
+            tones.push_back(220.0f * (v + 2) / 2);
+        }
+        init(sine.data(), 8);
+        audio_mixer_set_tones(tones.data(), voices);
+        render(MS_TO_SAMPLES(AUDIO_MIXER_ATTACK_MS) + BLOCK_SIZE);
+
+        uint16_t block[BLOCK_SIZE];
+        auto     start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; i++) {
+            audio_mixer_render(block, BLOCK_SIZE);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        RecordProperty("ns_per_block_" + std::to_string(voices) + "_voices", std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / iterations);
+    }
+}
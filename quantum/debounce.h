@@ -18,4 +18,12 @@ bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool
 
 void debounce_init(uint8_t num_rows);
 
+/**
+ * @brief How long the choosen debounce algorithm holds back a key change once the key has settled.
+ *
+ * @param pressed True for a press, false for a release
+ * @return The delay in milliseconds
+ */
+uint16_t debounce_delay(bool pressed);
+
 void debounce_free(void);
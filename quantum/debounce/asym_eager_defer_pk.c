@@ -174,6 +174,10 @@ static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], ui
     }
 }
 
+uint16_t debounce_delay(bool pressed) {
+    return pressed ? 0 : DEBOUNCE;
+}
+
 #else
 #    include "none.c"
 #endif
@@ -34,3 +34,7 @@ bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool
 }
 
 void debounce_free(void) {}
+
+uint16_t debounce_delay(bool pressed) {
+    return 0;
+}
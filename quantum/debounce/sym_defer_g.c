@@ -55,6 +55,10 @@ bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool
 }
 
 void debounce_free(void) {}
+
+uint16_t debounce_delay(bool pressed) {
+    return DEBOUNCE;
+}
 #else // no debouncing.
 #    include "none.c"
 #endif
@@ -139,6 +139,10 @@ static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], u
     }
 }
 
+uint16_t debounce_delay(bool pressed) {
+    return DEBOUNCE;
+}
+
 #else
 #    include "none.c"
 #endif
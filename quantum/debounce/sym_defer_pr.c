@@ -75,3 +75,7 @@ bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool
 bool debounce_active(void) {
     return true;
 }
+
+uint16_t debounce_delay(bool pressed) {
+    return DEBOUNCE;
+}
@@ -137,6 +137,10 @@ static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], ui
     }
 }
 
+uint16_t debounce_delay(bool pressed) {
+    return 0;
+}
+
 #else
 #    include "none.c"
 #endif
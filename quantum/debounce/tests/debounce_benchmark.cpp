@@ -0,0 +1,281 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Debounce benchmark, built once per algorithm (see rules.mk).
+
+Types on a simulated matrix with switches that bounce, and reports how well the algorithm turns that back into the
+key presses and releases that were actually made:
+- latency: time from the physical transition to the debounced one, p50 and p99
+- missed: physical transitions that never came out of debounce
+- spurious: debounced transitions that didn't happen physically, i.e. chatter that got through
+- ns/scan: time of a debounce() call, minus the cost of reading the clock around it. This is measured natively on
+  the host, so it's only useful for comparing algorithms with each other.
+
+Each bounce profile describes how long a switch bounces after changing state, how fast it chatters while doing so,
+and how often a worn switch briefly opens while it is held down. Set DEBOUNCE_BENCHMARK_SECONDS in the environment to
+simulate longer than the default 10 seconds per run.
+*/
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+extern "C" {
+#include "debounce.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+}
+
+#define STR_(x) #x
+#define STR(x) STR_(x)
+
+namespace {
+
+struct BounceProfile {
+    const char *name;
+    uint32_t    bounce_us;       // Longest bounce after a transition
+    uint32_t    chatter_hz;      // Average rate of contact changes while bouncing
+    double      glitches_per_s;  // Average rate of brief opens while held, from contact degradation
+    uint32_t    glitch_us;       // Longest of those opens
+};
+
+const BounceProfile profiles[] = {
+    {"clean", 500, 20000, 0, 0},
+    {"typical", 2000, 10000, 0, 0},
+    {"worn", 4000, 5000, 0.5, 300},
+    {"chattering", 8000, 2000, 5, 1000},
+};
+
+const uint8_t row_counts[] = {4, 8, MATRIX_ROWS};
+
+const uint32_t scan_interval_us = 500;  // 2kHz scan rate
+const double   keystrokes_per_s = 20;
+const uint32_t min_hold_us      = 40000;
+const uint32_t max_hold_us      = 150000;
+const uint32_t min_release_us   = 30000;
+
+struct KeyEvent {
+    uint32_t time_us;
+    uint8_t  row;
+    uint8_t  col;
+    bool     pressed;
+
+    bool operator<(const KeyEvent &other) const {
+        return time_us < other.time_us;
+    }
+};
+
+struct Result {
+    std::vector<uint32_t> latencies_us;
+    uint32_t              transitions = 0;
+    uint32_t              missed      = 0;
+    uint32_t              spurious    = 0;
+    double                ns_per_scan = 0;
+
+    uint32_t percentile(uint32_t p) const {
+        if (latencies_us.empty()) {
+            return 0;
+        }
+        return latencies_us[std::min(latencies_us.size() - 1, latencies_us.size() * p / 100)];
+    }
+};
+
+uint32_t benchmark_duration_us(void) {
+    const char *seconds = getenv("DEBOUNCE_BENCHMARK_SECONDS");
+    return (seconds ? atoi(seconds) : 10) * 1000000;
+}
+
+/* Adds the raw contact changes for one physical transition, ending up in the new state */
+void add_bounce(std::mt19937 &rng, const BounceProfile &profile, std::vector<KeyEvent> &raw, KeyEvent transition) {
+    uint32_t bounce_us = std::uniform_int_distribution<uint32_t>(profile.bounce_us / 4, profile.bounce_us)(rng);
+    uint32_t end_us    = transition.time_us + bounce_us;
+
+    std::exponential_distribution<double> chatter(profile.chatter_hz / 1e6);
+    KeyEvent                              contact = transition;
+    while (contact.time_us < end_us) {
+        raw.push_back(contact);
+        contact.pressed = !contact.pressed;
+        contact.time_us += 1 + (uint32_t)chatter(rng);
+    }
+    // Settle in the new state, unless the last bounce already did
+    if (raw.back().pressed != transition.pressed) {
+        contact.time_us = end_us;
+        contact.pressed = transition.pressed;
+        raw.push_back(contact);
+    }
+}
+
+/* Simulates typing, returning the physical transitions and the raw contact changes they cause */
+void generate_typing(std::mt19937 &rng, const BounceProfile &profile, uint8_t num_rows, uint32_t duration_us, std::vector<KeyEvent> &physical, std::vector<KeyEvent> &raw) {
+    std::vector<uint32_t>                   available_us(num_rows * MATRIX_COLS, 0);
+    std::exponential_distribution<double>   keystroke(keystrokes_per_s / 1e6);
+    std::uniform_int_distribution<uint32_t> key(0, num_rows * MATRIX_COLS - 1);
+    std::uniform_int_distribution<uint32_t> hold(min_hold_us, max_hold_us);
+
+    for (uint32_t time_us = 10000 + (uint32_t)keystroke(rng); time_us + max_hold_us < duration_us; time_us += 1 + (uint32_t)keystroke(rng)) {
+        uint32_t k = key(rng);
+        if (available_us[k] > time_us) {
+            // Still held, or only just released
+            continue;
+        }
+
+        uint8_t  row        = k / MATRIX_COLS;
+        uint8_t  col        = k % MATRIX_COLS;
+        uint32_t release_us = time_us + hold(rng);
+        available_us[k]     = release_us + min_release_us;
+
+        physical.push_back({time_us, row, col, true});
+        physical.push_back({release_us, row, col, false});
+        add_bounce(rng, profile, raw, {time_us, row, col, true});
+
+        // Contact degradation while held
+        if (profile.glitches_per_s > 0) {
+            std::exponential_distribution<double>   glitch(profile.glitches_per_s / 1e6);
+            std::uniform_int_distribution<uint32_t> glitch_length(profile.glitch_us / 4, profile.glitch_us);
+            for (uint32_t glitch_us = time_us + profile.bounce_us + (uint32_t)glitch(rng); glitch_us + profile.glitch_us < release_us; glitch_us += profile.glitch_us + (uint32_t)glitch(rng)) {
+                raw.push_back({glitch_us, row, col, false});
+                raw.push_back({glitch_us + glitch_length(rng), row, col, true});
+            }
+        }
+
+        add_bounce(rng, profile, raw, {release_us, row, col, false});
+    }
+
+    std::stable_sort(physical.begin(), physical.end());
+    std::stable_sort(raw.begin(), raw.end());
+}
+
+Result run_benchmark(const BounceProfile &profile, uint8_t num_rows, uint32_t seed) {
+    static uint32_t time_base_ms = 1000;
+
+    std::mt19937          rng(seed);
+    uint32_t              duration_us = benchmark_duration_us();
+    std::vector<KeyEvent> physical;
+    std::vector<KeyEvent> raw_events;
+    generate_typing(rng, profile, num_rows, duration_us, physical, raw_events);
+
+    // Sample the raw matrix at every scan first, so only debounce() itself is timed
+    size_t                    num_scans = duration_us / scan_interval_us;
+    std::vector<matrix_row_t> raw_scans(num_scans * num_rows);
+    std::vector<bool>         raw_changed(num_scans);
+    matrix_row_t              raw[MATRIX_ROWS] = {0};
+    auto                      next             = raw_events.begin();
+    for (size_t scan = 0; scan < num_scans; scan++) {
+        bool changed = false;
+        for (; next != raw_events.end() && next->time_us <= scan * scan_interval_us; next++) {
+            matrix_row_t mask = (matrix_row_t)1 << next->col;
+            matrix_row_t row  = next->pressed ? (raw[next->row] | mask) : (raw[next->row] & ~mask);
+            changed |= row != raw[next->row];
+            raw[next->row] = row;
+        }
+        std::copy(raw, raw + num_rows, raw_scans.begin() + scan * num_rows);
+        raw_changed[scan] = changed;
+    }
+
+    std::vector<matrix_row_t> cooked_scans(num_scans * num_rows);
+    matrix_row_t              cooked[MATRIX_ROWS] = {0};
+    std::chrono::nanoseconds  elapsed(0);
+    std::chrono::nanoseconds  overhead(0);
+
+    for (size_t scan = 0; scan < num_scans; scan++) {
+        auto start = std::chrono::steady_clock::now();
+        overhead += std::chrono::steady_clock::now() - start;
+    }
+
+    debounce_init(num_rows);
+    for (size_t scan = 0; scan < num_scans; scan++) {
+        set_time(time_base_ms + scan * scan_interval_us / 1000);
+        std::copy(raw_scans.begin() + scan * num_rows, raw_scans.begin() + (scan + 1) * num_rows, raw);
+
+        auto start = std::chrono::steady_clock::now();
+        debounce(raw, cooked, num_rows, raw_changed[scan]);
+        elapsed += std::chrono::steady_clock::now() - start;
+
+        std::copy(cooked, cooked + num_rows, cooked_scans.begin() + scan * num_rows);
+    }
+    debounce_free();
+    time_base_ms += duration_us / 1000 + 1000;
+
+    // Match each key's debounced transitions against its physical ones
+    Result result;
+    result.ns_per_scan = (double)std::max(elapsed - overhead, std::chrono::nanoseconds(0)).count() / num_scans;
+    for (uint8_t row = 0; row < num_rows; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            matrix_row_t          mask = (matrix_row_t)1 << col;
+            std::vector<KeyEvent> debounced;
+            bool                  state = false;
+            for (size_t scan = 0; scan < num_scans; scan++) {
+                bool pressed = cooked_scans[scan * num_rows + row] & mask;
+                if (pressed != state) {
+                    debounced.push_back({(uint32_t)(scan * scan_interval_us), row, col, pressed});
+                    state = pressed;
+                }
+            }
+
+            std::vector<KeyEvent> key_physical;
+            for (auto &event : physical) {
+                if (event.row == row && event.col == col) {
+                    key_physical.push_back(event);
+                }
+            }
+
+            // Each physical transition is matched with the first debounced transition to the same state before the
+            // next physical transition. Everything else that came out of debounce is spurious.
+            auto out = debounced.begin();
+            for (; out != debounced.end() && (key_physical.empty() || out->time_us < key_physical.front().time_us); out++) {
+                result.spurious++;
+            }
+            for (size_t i = 0; i < key_physical.size(); i++) {
+                uint32_t window_end_us = i + 1 < key_physical.size() ? key_physical[i + 1].time_us : duration_us;
+                bool     matched       = false;
+                result.transitions++;
+                for (; out != debounced.end() && out->time_us < window_end_us; out++) {
+                    if (!matched && out->pressed == key_physical[i].pressed) {
+                        result.latencies_us.push_back(out->time_us - key_physical[i].time_us);
+                        matched = true;
+                    } else {
+                        result.spurious++;
+                    }
+                }
+                if (!matched) {
+                    result.missed++;
+                }
+            }
+        }
+    }
+
+    std::sort(result.latencies_us.begin(), result.latencies_us.end());
+    return result;
+}
+
+} // namespace
+
+TEST(DebounceBenchmark, BounceProfiles) {
+    printf("%-20s %-6s %-10s %11s %11s %8s %9s %10s\n", "algorithm", "matrix", "profile", "p50", "p99", "missed", "spurious", "ns/scan");
+
+    for (auto &profile : profiles) {
+        for (uint8_t num_rows : row_counts) {
+            // The same seed for every algorithm, so they all debounce the exact same typing
+            Result result = run_benchmark(profile, num_rows, num_rows * 1000 + (&profile - profiles));
+
+            printf("%-20s %2ux%-3u %-10s %8.2f ms %8.2f ms %8u %9u %10.0f\n", STR(DEBOUNCE_BENCHMARK_ALGORITHM), num_rows, MATRIX_COLS, profile.name, result.percentile(50) / 1000.0, result.percentile(99) / 1000.0, result.missed, result.spurious, result.ns_per_scan);
+
+            EXPECT_GT(result.transitions, 0u);
+            EXPECT_EQ(result.latencies_us.size() + result.missed, result.transitions);
+
+            // Bounce that is over within DEBOUNCE must never get through
+            if (strcmp(STR(DEBOUNCE_BENCHMARK_ALGORITHM), "none") != 0 && profile.bounce_us < DEBOUNCE * 1000 && profile.glitches_per_s == 0) {
+                EXPECT_EQ(result.missed, 0u) << profile.name << ", " << +num_rows << " rows";
+                EXPECT_EQ(result.spurious, 0u) << profile.name << ", " << +num_rows << " rows";
+            }
+        }
+    }
+}
@@ -52,3 +52,37 @@ debounce_asym_eager_defer_pk_DEFS := $(DEBOUNCE_COMMON_DEFS)
 debounce_asym_eager_defer_pk_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/asym_eager_defer_pk.c \
 	$(QUANTUM_PATH)/debounce/tests/asym_eager_defer_pk_tests.cpp
+
+# Benchmarks, comparing the algorithms on simulated switch bounce
+DEBOUNCE_BENCHMARK_DEFS := -DMATRIX_ROWS=16 -DMATRIX_COLS=16 -DDEBOUNCE=5
+
+DEBOUNCE_BENCHMARK_SRC := $(QUANTUM_PATH)/debounce/tests/debounce_benchmark.cpp \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+debounce_none_benchmark_DEFS := $(DEBOUNCE_BENCHMARK_DEFS) -DDEBOUNCE_BENCHMARK_ALGORITHM=none
+debounce_none_benchmark_SRC := $(DEBOUNCE_BENCHMARK_SRC) \
+	$(QUANTUM_PATH)/debounce/none.c
+
+debounce_sym_defer_g_benchmark_DEFS := $(DEBOUNCE_BENCHMARK_DEFS) -DDEBOUNCE_BENCHMARK_ALGORITHM=sym_defer_g
+debounce_sym_defer_g_benchmark_SRC := $(DEBOUNCE_BENCHMARK_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_g.c
+
+debounce_sym_defer_pk_benchmark_DEFS := $(DEBOUNCE_BENCHMARK_DEFS) -DDEBOUNCE_BENCHMARK_ALGORITHM=sym_defer_pk
+debounce_sym_defer_pk_benchmark_SRC := $(DEBOUNCE_BENCHMARK_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_pk.c
+
+debounce_sym_defer_pr_benchmark_DEFS := $(DEBOUNCE_BENCHMARK_DEFS) -DDEBOUNCE_BENCHMARK_ALGORITHM=sym_defer_pr
+debounce_sym_defer_pr_benchmark_SRC := $(DEBOUNCE_BENCHMARK_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_pr.c
+
+debounce_sym_eager_pk_benchmark_DEFS := $(DEBOUNCE_BENCHMARK_DEFS) -DDEBOUNCE_BENCHMARK_ALGORITHM=sym_eager_pk
+debounce_sym_eager_pk_benchmark_SRC := $(DEBOUNCE_BENCHMARK_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_eager_pk.c
+
+debounce_sym_eager_pr_benchmark_DEFS := $(DEBOUNCE_BENCHMARK_DEFS) -DDEBOUNCE_BENCHMARK_ALGORITHM=sym_eager_pr
+debounce_sym_eager_pr_benchmark_SRC := $(DEBOUNCE_BENCHMARK_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_eager_pr.c
+
+debounce_asym_eager_defer_pk_benchmark_DEFS := $(DEBOUNCE_BENCHMARK_DEFS) -DDEBOUNCE_BENCHMARK_ALGORITHM=asym_eager_defer_pk
+debounce_asym_eager_defer_pk_benchmark_SRC := $(DEBOUNCE_BENCHMARK_SRC) \
+	$(QUANTUM_PATH)/debounce/asym_eager_defer_pk.c
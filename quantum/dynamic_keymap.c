@@ -16,6 +16,7 @@
 
 #include "dynamic_keymap.h"
 #include "keymap_introspection.h"
+#include "keymap_common.h"
 #include "action.h"
 #include "eeprom.h"
 #include "progmem.h"
@@ -125,6 +126,7 @@ void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address, (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+    keymap_lookup_invalidate();
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -147,6 +149,7 @@ void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwis
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
+    keymap_lookup_invalidate();
 }
 #endif // ENCODER_MAP_ENABLE
 
@@ -193,6 +196,7 @@ void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
         source++;
         target++;
     }
+    keymap_lookup_invalidate();
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
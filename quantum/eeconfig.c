@@ -63,6 +63,11 @@ void eeconfig_init_quantum(void) {
     eeprom_update_byte(EECONFIG_STENOMODE, 0);
     eeprom_write_qword(EECONFIG_RGB_MATRIX, 0);
     eeprom_update_dword(EECONFIG_HAPTIC, 0);
+#if defined(AUTO_SHIFT_ADAPTIVE_EEPROM)
+    for (uint8_t i = 0; i < sizeof(((eeprom_core_t *)0)->autoshift); i++) {
+        eeprom_update_byte(EECONFIG_AUTO_SHIFT + i, 0);
+    }
+#endif
 #if defined(HAPTIC_ENABLE)
     haptic_reset();
 #endif
@@ -22,6 +22,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <stddef.h> // offsetof
 #include "eeprom.h"
 #include "util.h"
+#ifdef AUTO_SHIFT_ADAPTIVE_EEPROM
+#    include "keycodes.h"
+#endif
 
 #ifndef EECONFIG_MAGIC_NUMBER
 #    define EECONFIG_MAGIC_NUMBER (uint16_t)0xFEE5 // When changing, decrement this value to avoid future re-init issues
@@ -48,6 +51,9 @@ typedef struct PACKED {
     };
     uint32_t haptic;
     uint8_t  rgblight_ext;
+#ifdef AUTO_SHIFT_ADAPTIVE_EEPROM
+    uint8_t autoshift[KC_SLASH - KC_A + 1];
+#endif
 } eeprom_core_t;
 
 /* EEPROM parameter address */
@@ -67,6 +73,9 @@ typedef struct PACKED {
 #define EECONFIG_RGB_MATRIX (uint64_t *)(offsetof(eeprom_core_t, rgb_matrix))
 #define EECONFIG_HAPTIC (uint32_t *)(offsetof(eeprom_core_t, haptic))
 #define EECONFIG_RGBLIGHT_EXTENDED (uint8_t *)(offsetof(eeprom_core_t, rgblight_ext))
+#ifdef AUTO_SHIFT_ADAPTIVE_EEPROM
+#    define EECONFIG_AUTO_SHIFT (uint8_t *)(offsetof(eeprom_core_t, autoshift))
+#endif
 
 // Size of EEPROM being used for core data storage
 #define EECONFIG_BASE_SIZE ((uint8_t)sizeof(eeprom_core_t))
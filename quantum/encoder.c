@@ -3,8 +3,10 @@
 
 #include <string.h>
 #include "action.h"
+#include "atomic_util.h"
 #include "encoder.h"
 #include "wait.h"
+#include "timer.h"
 
 #ifndef ENCODER_MAP_KEY_DELAY
 #    define ENCODER_MAP_KEY_DELAY TAP_CODE_DELAY
@@ -14,42 +16,77 @@ __attribute__((weak)) bool should_process_encoder(void) {
     return is_keyboard_master();
 }
 
-static encoder_events_t encoder_events;
-static bool             signal_queue_drain = false;
+// Written by the driver, possibly from an interrupt
+static volatile encoder_counts_t encoder_counts;
+// What encoder_task() has handled so far
+static encoder_counts_t encoder_handled;
+static uint32_t         encoder_last_movement[NUM_ENCODERS];
+static uint16_t         encoder_velocity[NUM_ENCODERS];
 
 void encoder_init(void) {
-    memset(&encoder_events, 0, sizeof(encoder_events));
+    ATOMIC_BLOCK_RESTORESTATE {
+        for (uint8_t i = 0; i < NUM_ENCODERS; i++) {
+            encoder_counts.detents[i] = 0;
+        }
+    }
+    memset(&encoder_handled, 0, sizeof(encoder_handled));
+    memset(encoder_velocity, 0, sizeof(encoder_velocity));
     encoder_driver_init();
 }
 
-static void encoder_queue_drain(void) {
-    encoder_events.tail     = encoder_events.head;
-    encoder_events.dequeued = encoder_events.enqueued;
+static void encoder_update_velocity(uint8_t index, uint16_t detents) {
+    uint32_t elapsed = timer_elapsed32(encoder_last_movement[index]);
+    if (elapsed > ENCODER_VELOCITY_TIMEOUT || encoder_velocity[index] == 0) {
+        // Starting from rest, there's no previous detent to measure against
+        elapsed                 = ENCODER_VELOCITY_TIMEOUT;
+        encoder_velocity[index] = 0;
+    } else if (elapsed == 0) {
+        elapsed = 1;
+    }
+    uint32_t velocity = ((uint32_t)detents * 1000) / elapsed;
+    // Average with the previous estimate, so a single late task doesn't halve the speed
+    velocity                     = encoder_velocity[index] ? (velocity + encoder_velocity[index]) / 2 : velocity;
+    encoder_velocity[index]      = MIN(velocity, UINT16_MAX);
+    encoder_last_movement[index] = timer_read32();
 }
 
-static bool encoder_handle_queue(void) {
-    bool    changed = false;
-    uint8_t index;
-    bool    clockwise;
-    while (encoder_dequeue_event(&index, &clockwise)) {
+static void encoder_exec_detent(uint8_t index, bool clockwise) {
 #ifdef ENCODER_MAP_ENABLE
 
-        // The delays below cater for Windows and its wonderful requirements.
-        action_exec(clockwise ? MAKE_ENCODER_CW_EVENT(index, true) : MAKE_ENCODER_CCW_EVENT(index, true));
+    // The delays below cater for Windows and its wonderful requirements.
+    action_exec(clockwise ? MAKE_ENCODER_CW_EVENT(index, true) : MAKE_ENCODER_CCW_EVENT(index, true));
 #    if ENCODER_MAP_KEY_DELAY > 0
-        wait_ms(ENCODER_MAP_KEY_DELAY);
+    wait_ms(ENCODER_MAP_KEY_DELAY);
 #    endif // ENCODER_MAP_KEY_DELAY > 0
 
-        action_exec(clockwise ? MAKE_ENCODER_CW_EVENT(index, false) : MAKE_ENCODER_CCW_EVENT(index, false));
+    action_exec(clockwise ? MAKE_ENCODER_CW_EVENT(index, false) : MAKE_ENCODER_CCW_EVENT(index, false));
 #    if ENCODER_MAP_KEY_DELAY > 0
-        wait_ms(ENCODER_MAP_KEY_DELAY);
+    wait_ms(ENCODER_MAP_KEY_DELAY);
 #    endif // ENCODER_MAP_KEY_DELAY > 0
 
 #else // ENCODER_MAP_ENABLE
 
-        encoder_update_kb(index, clockwise);
+    encoder_update_kb(index, clockwise);
 
 #endif // ENCODER_MAP_ENABLE
+}
+
+static bool encoder_handle_counts(void) {
+    bool changed = false;
+    for (uint8_t index = 0; index < NUM_ENCODERS; index++) {
+        int16_t detents = encoder_pending_detents(index);
+        if (detents == 0) {
+            continue;
+        }
+        encoder_handled.detents[index] += detents;
+
+        uint16_t steps = detents > 0 ? detents : -detents;
+        encoder_update_velocity(index, steps);
+        if (encoder_update_bulk_kb(index, detents)) {
+            for (; steps > 0; steps--) {
+                encoder_exec_detent(index, detents > 0);
+            }
+        }
 
         changed = true;
     }
@@ -60,92 +97,66 @@ bool encoder_task(void) {
     bool changed = false;
 
 #ifdef SPLIT_KEYBOARD
-    // Attempt to process existing encoder events in case split handling has already enqueued events
+    // Attempt to process existing encoder counts in case split handling has already added to them
     if (should_process_encoder()) {
-        changed |= encoder_handle_queue();
+        changed |= encoder_handle_counts();
     }
 #endif // SPLIT_KEYBOARD
 
-    if (signal_queue_drain) {
-        signal_queue_drain = false;
-        encoder_queue_drain();
-    }
-
-    // Let the encoder driver produce events
+    // Let the encoder driver count detents
     encoder_driver_task();
 
-    // Process any events that were enqueued
+    // Process anything that was counted
     if (should_process_encoder()) {
-        changed |= encoder_handle_queue();
+        changed |= encoder_handle_counts();
     }
 
     return changed;
 }
 
-bool encoder_queue_full_advanced(encoder_events_t *events) {
-    return events->tail == (events->head + 1) % MAX_QUEUED_ENCODER_EVENTS;
-}
-
-bool encoder_queue_full(void) {
-    return encoder_queue_full_advanced(&encoder_events);
-}
-
-bool encoder_queue_empty_advanced(encoder_events_t *events) {
-    return events->head == events->tail;
-}
-
-bool encoder_queue_empty(void) {
-    return encoder_queue_empty_advanced(&encoder_events);
-}
-
-bool encoder_queue_event_advanced(encoder_events_t *events, uint8_t index, bool clockwise) {
-    // Drop out if we're full
-    if (encoder_queue_full_advanced(events)) {
+bool encoder_queue_detents(uint8_t index, int16_t detents) {
+    if (index >= NUM_ENCODERS) {
         return false;
     }
-
-    // Append the event
-    encoder_event_t new_event   = {.index = index, .clockwise = clockwise ? 1 : 0};
-    events->queue[events->head] = new_event;
-
-    // Increment the head index
-    events->head = (events->head + 1) % MAX_QUEUED_ENCODER_EVENTS;
-    events->enqueued++;
-
+    ATOMIC_BLOCK_RESTORESTATE {
+        encoder_counts.detents[index] += detents;
+    }
     return true;
 }
 
-bool encoder_dequeue_event_advanced(encoder_events_t *events, uint8_t *index, bool *clockwise) {
-    if (encoder_queue_empty_advanced(events)) {
-        return false;
-    }
-
-    // Retrieve the event
-    encoder_event_t event = events->queue[events->tail];
-    *index                = event.index;
-    *clockwise            = event.clockwise;
-
-    // Increment the tail index
-    events->tail = (events->tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
-    events->dequeued++;
+bool encoder_queue_event(uint8_t index, bool clockwise) {
+    return encoder_queue_detents(index, clockwise ? 1 : -1);
+}
 
-    return true;
+int16_t encoder_pending_detents(uint8_t index) {
+    uint16_t counted;
+    ATOMIC_BLOCK_RESTORESTATE {
+        counted = encoder_counts.detents[index];
+    }
+    return (int16_t)(counted - encoder_handled.detents[index]);
 }
 
-bool encoder_queue_event(uint8_t index, bool clockwise) {
-    return encoder_queue_event_advanced(&encoder_events, index, clockwise);
+uint16_t encoder_get_velocity(uint8_t index) {
+    if (index >= NUM_ENCODERS || timer_elapsed32(encoder_last_movement[index]) > ENCODER_VELOCITY_TIMEOUT) {
+        return 0;
+    }
+    return encoder_velocity[index];
 }
 
-bool encoder_dequeue_event(uint8_t *index, bool *clockwise) {
-    return encoder_dequeue_event_advanced(&encoder_events, index, clockwise);
+void encoder_retrieve_counts(encoder_counts_t *counts) {
+    ATOMIC_BLOCK_RESTORESTATE {
+        for (uint8_t i = 0; i < NUM_ENCODERS; i++) {
+            counts->detents[i] = encoder_counts.detents[i];
+        }
+    }
 }
 
-void encoder_retrieve_events(encoder_events_t *events) {
-    memcpy(events, &encoder_events, sizeof(encoder_events));
+__attribute__((weak)) bool encoder_update_bulk_user(uint8_t index, int16_t detents) {
+    return true;
 }
 
-void encoder_signal_queue_drain(void) {
-    signal_queue_drain = true;
+__attribute__((weak)) bool encoder_update_bulk_kb(uint8_t index, int16_t detents) {
+    return encoder_update_bulk_user(index, detents);
 }
 
 __attribute__((weak)) bool encoder_update_user(uint8_t index, bool clockwise) {
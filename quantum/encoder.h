@@ -44,7 +44,6 @@ __attribute__((weak)) bool should_process_encoder(void);
 void encoder_init(void);
 bool encoder_task(void);
 bool encoder_queue_event(uint8_t index, bool clockwise);
-bool encoder_dequeue_event(uint8_t *index, bool *clockwise);
 
 bool encoder_update_kb(uint8_t index, bool clockwise);
 bool encoder_update_user(uint8_t index, bool clockwise);
@@ -82,32 +81,38 @@ bool encoder_update_user(uint8_t index, bool clockwise);
 
 #    define NUM_ENCODERS_MAX_PER_SIDE MAX(NUM_ENCODERS_LEFT, NUM_ENCODERS_RIGHT)
 
-#    ifndef MAX_QUEUED_ENCODER_EVENTS
-#        define MAX_QUEUED_ENCODER_EVENTS MAX(4, ((NUM_ENCODERS_MAX_PER_SIDE) + 1))
-#    endif // MAX_QUEUED_ENCODER_EVENTS
+#    ifndef ENCODER_VELOCITY_TIMEOUT
+#        define ENCODER_VELOCITY_TIMEOUT 200
+#    endif // ENCODER_VELOCITY_TIMEOUT
 
-typedef struct encoder_event_t {
-    uint8_t index : 7;
-    uint8_t clockwise : 1;
-} encoder_event_t;
+/**
+ * \brief Running detent counts, one per encoder.
+ *
+ * Drivers only ever add to these, and the counts wrap around. Whoever consumes
+ * them keeps its own copy of what it has seen already, and treats the signed
+ * 16-bit difference as the detents that happened since. Drivers may add to them
+ * from an interrupt, so they are read and written with interrupts disabled.
+ */
+typedef struct encoder_counts_t {
+    uint16_t detents[NUM_ENCODERS];
+} encoder_counts_t;
+
+// Get the current running counts
+void encoder_retrieve_counts(encoder_counts_t *counts);
 
-typedef struct encoder_events_t {
-    uint8_t         enqueued;
-    uint8_t         dequeued;
-    uint8_t         head;
-    uint8_t         tail;
-    encoder_event_t queue[MAX_QUEUED_ENCODER_EVENTS];
-} encoder_events_t;
+// Add a number of detents to an encoder, positive is clockwise
+bool encoder_queue_detents(uint8_t index, int16_t detents);
 
-// Get the current queued events
-void encoder_retrieve_events(encoder_events_t *events);
+// Detents counted but not handled yet by `encoder_task()`, positive is clockwise
+int16_t encoder_pending_detents(uint8_t index);
 
-// Encoder event queue management
-bool encoder_queue_event_advanced(encoder_events_t *events, uint8_t index, bool clockwise);
-bool encoder_dequeue_event_advanced(encoder_events_t *events, uint8_t *index, bool *clockwise);
+// Estimated speed in detents per second, 0 once the encoder has been still for `ENCODER_VELOCITY_TIMEOUT`
+uint16_t encoder_get_velocity(uint8_t index);
 
-// Reset the queue to be empty
-void encoder_signal_queue_drain(void);
+// All detents of an encoder since the last task at once, positive is clockwise.
+// Returning true lets them through to `encoder_update_kb()` or the encoder map one by one.
+bool encoder_update_bulk_kb(uint8_t index, int16_t detents);
+bool encoder_update_bulk_user(uint8_t index, int16_t detents);
 
 #    ifdef ENCODER_MAP_ENABLE
 #        define NUM_DIRECTIONS 2
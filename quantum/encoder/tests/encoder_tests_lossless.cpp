@@ -0,0 +1,148 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include "encoder.h"
+#include "encoder/tests/mock.h"
+
+void encoder_quadrature_sample(void);
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+struct bulk_update {
+    uint8_t index;
+    int16_t detents;
+};
+
+static int                      detents_seen[NUM_ENCODERS];
+static std::vector<bulk_update> bulk_updates;
+static bool                     bulk_passthrough = true;
+
+bool encoder_update_kb(uint8_t index, bool clockwise) {
+    detents_seen[index] += clockwise ? 1 : -1;
+    return true;
+}
+
+bool encoder_update_bulk_kb(uint8_t index, int16_t detents) {
+    bulk_updates.push_back({index, detents});
+    return bulk_passthrough;
+}
+
+/* Quadrature phases for a clockwise detent, starting from both pins pulled high */
+static const bool phase_a[4] = {false, false, true, true};
+static const bool phase_b[4] = {true, false, false, true};
+
+class EncoderLosslessTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(0);
+        memset(detents_seen, 0, sizeof(detents_seen));
+        bulk_updates.clear();
+        bulk_passthrough = true;
+        encoder_init();
+    }
+
+    /* Moves encoder `index` by `detents`, sampling every edge as a pin interrupt would, without running the task */
+    void spin(uint8_t index, int detents) {
+        for (int step = 0; step < abs(detents) * 4; step++) {
+            int phase = detents > 0 ? step % 4 : 3 - ((step + 1) % 4);
+            setPin(index * 2, phase_a[phase]);
+            setPin(index * 2 + 1, phase_b[phase]);
+            encoder_quadrature_sample();
+        }
+    }
+};
+
+TEST_F(EncoderLosslessTest, HighRateSpinLosesNoSteps) {
+    int expected[NUM_ENCODERS] = {0};
+
+    // Far more detents between two tasks than the old event queue could hold
+    for (int task = 0; task < 50; task++) {
+        int forward  = 20 + task % 80;
+        int backward = -(10 + task % 60);
+        spin(0, forward);
+        spin(1, backward);
+        expected[0] += forward;
+        expected[1] += backward;
+        encoder_task();
+    }
+
+    EXPECT_EQ(detents_seen[0], expected[0]);
+    EXPECT_EQ(detents_seen[1], expected[1]);
+    EXPECT_EQ(encoder_pending_detents(0), 0);
+    EXPECT_EQ(encoder_pending_detents(1), 0);
+}
+
+TEST_F(EncoderLosslessTest, DirectionChangesBetweenTasksNetOut) {
+    spin(0, 30);
+    spin(0, -12);
+    EXPECT_EQ(encoder_pending_detents(0), 18);
+    encoder_task();
+
+    EXPECT_EQ(detents_seen[0], 18);
+}
+
+TEST_F(EncoderLosslessTest, DetentsAreDeliveredInBulk) {
+    bulk_passthrough = false;
+
+    spin(0, 7);
+    spin(1, -3);
+    encoder_task();
+    // Nothing new, so no callbacks
+    encoder_task();
+
+    ASSERT_EQ(bulk_updates.size(), 2);
+    EXPECT_EQ(bulk_updates[0].index, 0);
+    EXPECT_EQ(bulk_updates[0].detents, 7);
+    EXPECT_EQ(bulk_updates[1].index, 1);
+    EXPECT_EQ(bulk_updates[1].detents, -3);
+    // The bulk handler returned false, so no single detent callbacks
+    EXPECT_EQ(detents_seen[0], 0);
+    EXPECT_EQ(detents_seen[1], 0);
+}
+
+TEST_F(EncoderLosslessTest, MoreDetentsThanFitInAByte) {
+    bulk_passthrough = false;
+
+    spin(0, 300);
+    spin(1, -200);
+    EXPECT_EQ(encoder_pending_detents(0), 300);
+    EXPECT_EQ(encoder_pending_detents(1), -200);
+    encoder_task();
+
+    ASSERT_EQ(bulk_updates.size(), 2);
+    EXPECT_EQ(bulk_updates[0].detents, 300);
+    EXPECT_EQ(bulk_updates[1].detents, -200);
+}
+
+TEST_F(EncoderLosslessTest, VelocityFollowsTheRotationSpeed) {
+    EXPECT_EQ(encoder_get_velocity(0), 0);
+
+    // One detent every 10ms
+    for (int i = 0; i < 10; i++) {
+        advance_time(10);
+        spin(0, 1);
+        encoder_task();
+    }
+    EXPECT_NEAR(encoder_get_velocity(0), 100, 10);
+
+    // Four detents every 8ms
+    for (int i = 0; i < 10; i++) {
+        advance_time(8);
+        spin(0, -4);
+        encoder_task();
+    }
+    EXPECT_NEAR(encoder_get_velocity(0), 500, 25);
+    EXPECT_EQ(encoder_get_velocity(1), 0);
+
+    // Left alone, the encoder is at rest again
+    advance_time(ENCODER_VELOCITY_TIMEOUT + 1);
+    EXPECT_EQ(encoder_get_velocity(0), 0);
+}
@@ -113,12 +113,9 @@ TEST_F(EncoderSplitTestLeftEqRight, TestOneClockwiseLeftMaster) {
     EXPECT_EQ(updates[0].index, 0);
     EXPECT_EQ(updates[0].clockwise, true);
 
-    int              events_queued = 0;
-    encoder_events_t events;
-    encoder_retrieve_events(&events);
-    while (events.tail != events.head) {
-        events.tail = (events.tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
-        ++events_queued;
+    int events_queued = 0;
+    for (uint8_t i = 0; i < NUM_ENCODERS; i++) {
+        events_queued += abs(encoder_pending_detents(i));
     }
     EXPECT_EQ(events_queued, 0); // No events should be queued on master
 }
@@ -137,12 +134,9 @@ TEST_F(EncoderSplitTestLeftEqRight, TestOneClockwiseRightMaster) {
     EXPECT_EQ(updates[0].index, 3);
     EXPECT_EQ(updates[0].clockwise, true);
 
-    int              events_queued = 0;
-    encoder_events_t events;
-    encoder_retrieve_events(&events);
-    while (events.tail != events.head) {
-        events.tail = (events.tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
-        ++events_queued;
+    int events_queued = 0;
+    for (uint8_t i = 0; i < NUM_ENCODERS; i++) {
+        events_queued += abs(encoder_pending_detents(i));
     }
     EXPECT_EQ(events_queued, 0); // No events should be queued on master
 }
@@ -159,12 +153,9 @@ TEST_F(EncoderSplitTestLeftEqRight, TestOneClockwiseLeftSlave) {
 
     EXPECT_EQ(updates_array_idx, 0); // no updates received
 
-    int              events_queued = 0;
-    encoder_events_t events;
-    encoder_retrieve_events(&events);
-    while (events.tail != events.head) {
-        events.tail = (events.tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
-        ++events_queued;
+    int events_queued = 0;
+    for (uint8_t i = 0; i < NUM_ENCODERS; i++) {
+        events_queued += abs(encoder_pending_detents(i));
     }
     EXPECT_EQ(events_queued, 1); // One event should be queued on slave
 }
@@ -181,12 +172,9 @@ TEST_F(EncoderSplitTestLeftEqRight, TestOneClockwiseRightSlave) {
 
     EXPECT_EQ(updates_array_idx, 0); // no updates received
 
-    int              events_queued = 0;
-    encoder_events_t events;
-    encoder_retrieve_events(&events);
-    while (events.tail != events.head) {
-        events.tail = (events.tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
-        ++events_queued;
+    int events_queued = 0;
+    for (uint8_t i = 0; i < NUM_ENCODERS; i++) {
+        events_queued += abs(encoder_pending_detents(i));
     }
     EXPECT_EQ(events_queued, 1); // One event should be queued on slave
 }
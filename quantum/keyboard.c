@@ -83,6 +83,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef SECURE_ENABLE
 #    include "secure.h"
 #endif
+#ifdef SEND_STRING_ASYNC_ENABLE
+#    include "send_string.h"
+#endif
 #ifdef POINTING_DEVICE_ENABLE
 #    include "pointing_device.h"
 #endif
@@ -131,6 +134,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef LEADER_ENABLE
 #    include "leader.h"
 #endif
+#ifdef DYNAMIC_MACRO_ENABLE
+#    include "process_dynamic_macro.h"
+#endif
 #ifdef UNICODE_COMMON_ENABLE
 #    include "unicode.h"
 #endif
@@ -140,6 +146,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef OS_DETECTION_ENABLE
 #    include "os_detection.h"
 #endif
+#ifdef REPORT_QUEUE_ENABLE
+#    include "report_queue.h"
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) {
@@ -272,6 +281,42 @@ static inline bool has_ghost_in_row(uint8_t row, matrix_row_t rowdata) {
  */
 __attribute__((weak)) void matrix_setup(void) {}
 
+static uint16_t last_scan_time = 0;
+static uint16_t last_key_time  = 0;
+
+/** \brief matrix_get_scan_time
+ *
+ * Time at which matrix_task() started the latest scan.
+ */
+uint16_t matrix_get_scan_time(void) {
+    return last_scan_time;
+}
+
+/** \brief matrix_get_key_time
+ *
+ * Time at which a key changed state. Matrices that do not timestamp changes report them as happening during the scan.
+ */
+__attribute__((weak)) uint16_t matrix_get_key_time(uint8_t row, uint8_t col) {
+    return matrix_get_scan_time();
+}
+
+/** \brief matrix_get_time_horizon
+ *
+ * Time up to which every key change has been reported. Matrices that report changes late, e.g. deferred by
+ * debouncing, return a time that far in the past.
+ */
+__attribute__((weak)) uint16_t matrix_get_time_horizon(void) {
+    return timer_read();
+}
+
+uint16_t keyboard_event_horizon(void) {
+    const uint16_t now     = timer_read();
+    const uint16_t horizon = matrix_get_time_horizon();
+
+    // Never before a key event that has already been processed
+    return TIMER_DIFF_16(now, last_key_time) < TIMER_DIFF_16(now, horizon) ? last_key_time : horizon;
+}
+
 /** \brief keyboard_pre_init_user
  *
  * FIXME: needs doc
@@ -426,6 +471,9 @@ void keyboard_init(void) {
 #ifdef AUDIO_ENABLE
     audio_init();
 #endif
+#ifdef DYNAMIC_MACRO_ENABLE
+    dynamic_macro_init();
+#endif
 #ifdef LED_MATRIX_ENABLE
     led_matrix_init();
 #endif
@@ -507,6 +555,21 @@ void switch_events(uint8_t row, uint8_t col, bool pressed) {
 #endif
 }
 
+/**
+ * @brief Passes a matrix event on to the action layer, unless it has to be
+ * held back for now.
+ *
+ * @return false The event could not be taken, and has to be tried again later
+ */
+static inline bool matrix_action_exec(keyevent_t event) {
+#ifdef UNICODE_ASYNC_ENABLE
+    return unicode_async_action_exec(event);
+#else
+    action_exec(event);
+    return true;
+#endif
+}
+
 /**
  * @brief Generates a tick event at a maximum rate of 1KHz that drives the
  * internal QMK state machine.
@@ -515,7 +578,9 @@ static inline void generate_tick_event(void) {
     static uint16_t last_tick = 0;
     const uint16_t  now       = timer_read();
     if (TIMER_DIFF_16(now, last_tick) != 0) {
-        action_exec(MAKE_TICK_EVENT);
+        keyevent_t tick_event = MAKE_TICK_EVENT;
+        tick_event.time       = keyboard_event_horizon();
+        matrix_action_exec(tick_event);
         last_tick = now;
     }
 }
@@ -535,6 +600,7 @@ static bool matrix_task(void) {
 
     static matrix_row_t matrix_previous[MATRIX_ROWS];
 
+    last_scan_time = timer_read();
     matrix_scan();
     bool matrix_changed = false;
     for (uint8_t row = 0; row < MATRIX_ROWS && !matrix_changed; row++) {
@@ -555,28 +621,59 @@ static bool matrix_task(void) {
 
     const bool process_keypress = should_process_keypress();
 
+    matrix_row_t pending[MATRIX_ROWS];
     for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
         const matrix_row_t current_row = matrix_get_row(row);
-        const matrix_row_t row_changes = current_row ^ matrix_previous[row];
 
-        if (!row_changes || has_ghost_in_row(row, current_row)) {
-            continue;
+        pending[row] = has_ghost_in_row(row, current_row) ? 0 : current_row ^ matrix_previous[row];
+    }
+
+    // Process changes oldest first, so keys reported late (e.g. from the other half of a split keyboard) keep their
+    // real order. Changes with the same time are processed in matrix order.
+    const uint16_t now = timer_read();
+    while (true) {
+        uint8_t  next_row = MATRIX_ROWS;
+        uint8_t  next_col = 0;
+        uint16_t next_age = 0;
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            matrix_row_t col_mask = 1;
+            for (uint8_t col = 0; pending[row] >= col_mask && col < MATRIX_COLS; col++, col_mask <<= 1) {
+                if (pending[row] & col_mask) {
+                    uint16_t age = TIMER_DIFF_16(now, matrix_get_key_time(row, col));
+                    if (age > UINT16_MAX / 2) {
+                        // Reported as slightly in the future
+                        age = 0;
+                    }
+                    if (next_row == MATRIX_ROWS || age > next_age) {
+                        next_row = row;
+                        next_col = col;
+                        next_age = age;
+                    }
+                }
+            }
+        }
+        if (next_row == MATRIX_ROWS) {
+            break;
         }
 
-        matrix_row_t col_mask = 1;
-        for (uint8_t col = 0; col < MATRIX_COLS; col++, col_mask <<= 1) {
-            if (row_changes & col_mask) {
-                const bool key_pressed = current_row & col_mask;
+        // Never go back in time from an earlier event, as tapping relies on event times increasing
+        if (next_age > TIMER_DIFF_16(now, last_key_time)) {
+            next_age = TIMER_DIFF_16(now, last_key_time);
+        }
+        last_key_time = now - next_age;
 
-                if (process_keypress) {
-                    action_exec(MAKE_KEYEVENT(row, col, key_pressed));
-                }
+        const matrix_row_t col_mask    = MATRIX_ROW_SHIFTER << next_col;
+        const bool         key_pressed = matrix_get_row(next_row) & col_mask;
 
-                switch_events(row, col, key_pressed);
-            }
+        if (process_keypress && !matrix_action_exec(MAKE_KEYEVENT_AT(next_row, next_col, key_pressed, last_key_time))) {
+            // Picked up again by a later scan
+            break;
         }
 
-        matrix_previous[row] = current_row;
+        switch_events(next_row, next_col, key_pressed);
+
+        pending[next_row] &= ~col_mask;
+        matrix_previous[next_row] ^= col_mask;
     }
 
     return matrix_changed;
@@ -636,6 +733,22 @@ void quantum_task(void) {
     leader_task();
 #endif
 
+#ifdef STENO_ENABLE
+    steno_task();
+#endif
+
+#ifdef DYNAMIC_MACRO_ENABLE
+    dynamic_macro_task();
+#endif
+
+#ifdef SEND_STRING_ASYNC_ENABLE
+    send_string_async_task();
+#endif
+
+#ifdef UNICODE_ASYNC_ENABLE
+    unicode_async_task();
+#endif
+
 #ifdef WPM_ENABLE
     decay_wpm();
 #endif
@@ -748,4 +861,8 @@ void keyboard_task(void) {
 #ifdef OS_DETECTION_ENABLE
     os_detection_task();
 #endif
+
+#ifdef REPORT_QUEUE_ENABLE
+    report_queue_task();
+#endif
 }
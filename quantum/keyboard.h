@@ -81,6 +81,11 @@ static inline bool IS_DIPSWITCHEVENT(const keyevent_t event) {
  */
 #define MAKE_KEYEVENT(row_num, col_num, press) MAKE_EVENT((row_num), (col_num), (press), KEY_EVENT)
 
+/**
+ * @brief Constructs a key event for a key that was pressed or released at `event_time`.
+ */
+#define MAKE_KEYEVENT_AT(row_num, col_num, press, event_time) ((keyevent_t){.key = MAKE_KEYPOS((row_num), (col_num)), .pressed = (press), .time = (event_time), .type = KEY_EVENT})
+
 /**
  * @brief Constructs a combo event.
  */
@@ -123,6 +128,8 @@ void housekeeping_task(void);      // To be executed by the main loop in each ba
 void housekeeping_task_kb(void);   // To be overridden by keyboard-level code
 void housekeeping_task_user(void); // To be overridden by user/keymap-level code
 
+uint16_t keyboard_event_horizon(void); // Time up to which key events have been processed, for timeouts measured against key event times
+
 uint32_t last_input_activity_time(void);    // Timestamp of the last matrix or encoder or pointing device activity
 uint32_t last_input_activity_elapsed(void); // Number of milliseconds since the last matrix or encoder or pointing device activity
 
@@ -196,6 +196,19 @@ action_t action_for_keycode(uint16_t keycode) {
     return action;
 }
 
+static uint16_t lookup_generation = 1;
+
+uint16_t keymap_lookup_generation(void) {
+    return lookup_generation;
+}
+
+void keymap_lookup_invalidate(void) {
+    // 0 is left for records that have not been resolved yet
+    if (++lookup_generation == 0) {
+        lookup_generation = 1;
+    }
+}
+
 // translates key to keycode
 __attribute__((weak)) uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key) {
     if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
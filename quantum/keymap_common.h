@@ -8,3 +8,19 @@
 
 // translates key to keycode
 uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key);
+
+/**
+ * \brief Changes whenever looking up a key may give a different keycode.
+ *
+ * Keycodes resolved for a key record are reused for as long as this stays the same,
+ * see get_record_keycode(). It is wide enough that no record stays buffered for as
+ * long as it takes to wrap around.
+ */
+uint16_t keymap_lookup_generation(void);
+
+/**
+ * \brief Marks the keycodes already resolved for key records as stale.
+ *
+ * Called whenever the active layers or the keymap itself change.
+ */
+void keymap_lookup_invalidate(void);
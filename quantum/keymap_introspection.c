@@ -15,7 +15,18 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Key mapping
 
-#define NUM_KEYMAP_LAYERS_RAW ((uint8_t)(sizeof(keymaps) / ((MATRIX_ROWS) * (MATRIX_COLS) * sizeof(uint16_t))))
+#ifdef KEYMAP_SPARSE
+// Sparse keymaps store a bitmap of the keys that are not KC_TRNS, 32 matrix positions per word, and the keycodes of only
+// those keys. keymap_sparse_index holds the number of keycodes stored before each bitmap word.
+#    define KEYMAP_SPARSE_WORDS (((MATRIX_ROWS) * (MATRIX_COLS) + 31) / 32)
+#    define NUM_KEYMAP_LAYERS_RAW ((uint8_t)(ARRAY_SIZE(keymap_sparse_bitmap) / (KEYMAP_SPARSE_WORDS)))
+
+_Static_assert(ARRAY_SIZE(keymap_sparse_bitmap) % (KEYMAP_SPARSE_WORDS) == 0, "Sparse keymap bitmap does not match the matrix size");
+_Static_assert(ARRAY_SIZE(keymap_sparse_index) == ARRAY_SIZE(keymap_sparse_bitmap), "Sparse keymap index does not match its bitmap");
+_Static_assert(ARRAY_SIZE(keymap_sparse_unused) == (KEYMAP_SPARSE_WORDS), "Sparse keymap unused bitmap does not match the matrix size");
+#else
+#    define NUM_KEYMAP_LAYERS_RAW ((uint8_t)(sizeof(keymaps) / ((MATRIX_ROWS) * (MATRIX_COLS) * sizeof(uint16_t))))
+#endif // KEYMAP_SPARSE
 
 uint8_t keymap_layer_count_raw(void) {
     return NUM_KEYMAP_LAYERS_RAW;
@@ -33,7 +44,19 @@ _Static_assert(NUM_KEYMAP_LAYERS_RAW <= MAX_LAYER, "Number of keymap layers exce
 
 uint16_t keycode_at_keymap_location_raw(uint8_t layer_num, uint8_t row, uint8_t column) {
     if (layer_num < NUM_KEYMAP_LAYERS_RAW && row < MATRIX_ROWS && column < MATRIX_COLS) {
+#ifdef KEYMAP_SPARSE
+        uint16_t position = (uint16_t)row * (MATRIX_COLS) + column;
+        uint16_t word     = (uint16_t)layer_num * (KEYMAP_SPARSE_WORDS) + position / 32;
+        uint32_t mask     = (uint32_t)1 << (position % 32);
+        uint32_t bitmap   = pgm_read_dword(&keymap_sparse_bitmap[word]);
+        if (bitmap & mask) {
+            return pgm_read_word(&keymap_sparse_keycodes[pgm_read_word(&keymap_sparse_index[word]) + __builtin_popcountl(bitmap & (mask - 1))]);
+        }
+        // Positions the layout doesn't use are KC_NO in dense keymaps
+        return (pgm_read_dword(&keymap_sparse_unused[position / 32]) & mask) ? KC_NO : KC_TRNS;
+#else
         return pgm_read_word(&keymaps[layer_num][row][column]);
+#endif // KEYMAP_SPARSE
     }
     return KC_TRNS;
 }
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "leader.h"
+#include "quantum.h"
 #include "timer.h"
 #include "util.h"
 
@@ -12,15 +13,96 @@
 #endif
 
 // Leader key stuff
-bool     leading              = false;
-uint16_t leader_time          = 0;
-uint16_t leader_sequence[5]   = {0, 0, 0, 0, 0};
-uint8_t  leader_sequence_size = 0;
+bool     leading                              = false;
+uint16_t leader_time                          = 0;
+uint16_t leader_sequence[LEADER_SEQUENCE_MAX] = {0};
+uint8_t  leader_sequence_size                 = 0;
+
+// Sequences of the table still matching what has been typed are all within [first, last), and there are count of them
+static uint16_t leader_match_first = 0;
+static uint16_t leader_match_last  = 0;
+static uint16_t leader_match_count = 0;
+static bool     leader_matched     = false;
 
 __attribute__((weak)) void leader_start_user(void) {}
 
 __attribute__((weak)) void leader_end_user(void) {}
 
+__attribute__((weak)) uint16_t leader_sequences_count(void) {
+    return 0;
+}
+
+__attribute__((weak)) const leader_sequence_t *leader_sequences_get(void) {
+    return NULL;
+}
+
+__attribute__((weak)) bool leader_sequence_matched_user(uint16_t keycode) {
+    return true;
+}
+
+static inline uint16_t leader_table_key(const leader_sequence_t *table, uint16_t index, uint8_t position) {
+    return pgm_read_word(&table[index].keys[position]);
+}
+
+static bool leader_table_complete(const leader_sequence_t *table, uint16_t index) {
+    return leader_sequence_size == LEADER_SEQUENCE_MAX || leader_table_key(table, index, leader_sequence_size) == KC_NO;
+}
+
+static bool leader_table_matches(const leader_sequence_t *table, uint16_t index) {
+    for (uint8_t position = 0; position < leader_sequence_size; position++) {
+        if (leader_table_key(table, index, position) != leader_sequence[position]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void leader_table_narrow(void) {
+    const leader_sequence_t *table = leader_sequences_get();
+    uint16_t                 first = leader_match_last;
+    uint16_t                 last  = leader_match_last;
+    uint16_t                 count = 0;
+
+    // In a table grouped by prefix the matches are next to each other, otherwise this only has more to skip over
+    for (uint16_t i = leader_match_first; i < leader_match_last; i++) {
+        if (leader_table_matches(table, i)) {
+            if (count == 0) {
+                first = i;
+            }
+            last = i + 1;
+            count++;
+        }
+    }
+
+    leader_match_first = first;
+    leader_match_last  = last;
+    leader_match_count = count;
+}
+
+static void leader_table_fire(uint16_t index) {
+    uint16_t keycode = pgm_read_word(&leader_sequences_get()[index].keycode);
+
+    leader_matched = true;
+    if (leader_sequence_matched_user(keycode)) {
+        tap_code16(keycode);
+    }
+}
+
+// Fires the sequence matching exactly what has been typed, if there is one
+static void leader_table_resolve(void) {
+    const leader_sequence_t *table = leader_sequences_get();
+
+    if (leader_matched || leader_sequence_size == 0) {
+        return;
+    }
+    for (uint16_t i = leader_match_first; i < leader_match_last; i++) {
+        if (leader_table_matches(table, i) && leader_table_complete(table, i)) {
+            leader_table_fire(i);
+            return;
+        }
+    }
+}
+
 void leader_start(void) {
     if (leading) {
         return;
@@ -30,9 +112,14 @@ void leader_start(void) {
     leader_time          = timer_read();
     leader_sequence_size = 0;
     memset(leader_sequence, 0, sizeof(leader_sequence));
+    leader_match_first = 0;
+    leader_match_last  = leader_sequences_count();
+    leader_match_count = leader_match_last;
+    leader_matched     = false;
 }
 
 void leader_end(void) {
+    leader_table_resolve();
     leading = false;
     leader_end_user();
 }
@@ -61,6 +148,15 @@ bool leader_sequence_add(uint16_t keycode) {
     leader_sequence[leader_sequence_size] = keycode;
     leader_sequence_size++;
 
+    if (leader_match_count > 0) {
+        leader_table_narrow();
+        // Nothing longer could still match, no need to wait for the timeout
+        if (leader_match_count == 1 && leader_table_complete(leader_sequences_get(), leader_match_first)) {
+            leader_table_fire(leader_match_first);
+            leader_end();
+        }
+    }
+
     return true;
 }
 
@@ -77,7 +173,7 @@ void leader_reset_timer(void) {
 }
 
 bool leader_sequence_is(uint16_t kc1, uint16_t kc2, uint16_t kc3, uint16_t kc4, uint16_t kc5) {
-    return leader_sequence[0] == kc1 && leader_sequence[1] == kc2 && leader_sequence[2] == kc3 && leader_sequence[3] == kc4 && leader_sequence[4] == kc5;
+    return leader_sequence_size <= 5 && leader_sequence[0] == kc1 && leader_sequence[1] == kc2 && leader_sequence[2] == kc3 && leader_sequence[3] == kc4 && leader_sequence[4] == kc5;
 }
 
 bool leader_sequence_one_key(uint16_t kc) {
@@ -1,8 +1,20 @@
 // Copyright 2023 QMK
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#pragma once
+
 #include <stdbool.h>
 #include <stdint.h>
+#include "progmem.h"
+#include "util.h"
+
+#ifndef LEADER_SEQUENCE_MAX
+#    define LEADER_SEQUENCE_MAX 5
+#endif
+
+#if LEADER_SEQUENCE_MAX < 5
+#    error "LEADER_SEQUENCE_MAX must be at least 5"
+#endif
 
 /**
  * \file
@@ -11,6 +23,54 @@
  * \{
  */
 
+/**
+ * \brief A sequence in the leader sequence table, and the keycode it sends.
+ *
+ * Unused trailing keys are `KC_NO`.
+ */
+typedef struct {
+    uint16_t keys[LEADER_SEQUENCE_MAX];
+    uint16_t keycode;
+} leader_sequence_t;
+
+#define LEADER_SEQUENCE(kc, ...) \
+    { .keys = {__VA_ARGS__}, .keycode = (kc) }
+
+/**
+ * \brief Declare the leader sequence table of a keymap.
+ *
+ * Sequences starting with the same keys have to be next to each other, which
+ * makes the table a flattened trie: each key typed narrows the matching
+ * sequences down to a contiguous run of the previous ones.
+ */
+#define LEADER_SEQUENCES(...)                                                       \
+    static const leader_sequence_t PROGMEM leader_sequence_table[] = {__VA_ARGS__}; \
+    uint16_t leader_sequences_count(void) {                                         \
+        return ARRAY_SIZE(leader_sequence_table);                                   \
+    }                                                                               \
+    const leader_sequence_t *leader_sequences_get(void) {                           \
+        return leader_sequence_table;                                               \
+    }
+
+/**
+ * \brief Number of sequences in the leader sequence table.
+ */
+uint16_t leader_sequences_count(void);
+
+/**
+ * \brief The leader sequence table, in PROGMEM.
+ */
+const leader_sequence_t *leader_sequences_get(void);
+
+/**
+ * \brief User callback, invoked when a sequence from the table matches.
+ *
+ * \param keycode The keycode of the matched sequence.
+ *
+ * \return `true` to tap the keycode, `false` if it has been handled.
+ */
+bool leader_sequence_matched_user(uint16_t keycode);
+
 /**
  * \brief User callback, invoked when the leader sequence begins.
  */
@@ -42,6 +102,8 @@ bool leader_sequence_active(void);
  * Add the given keycode to the sequence buffer.
  *
  * If `LEADER_NO_TIMEOUT` is defined, the timer is reset if the buffer is empty.
+ * If the sequence so far only matches one complete sequence of the table, that
+ * sequence fires and the leader sequence ends straight away.
  *
  * \param keycode The keycode to add.
  *
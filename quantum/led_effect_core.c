@@ -0,0 +1,153 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "led_effect_core.h"
+#include "sync_timer.h"
+#include <string.h>
+
+#ifdef LED_EFFECT_KEYREACTIVE_ENABLED
+last_hit_t g_last_hit_tracker;
+#endif // LED_EFFECT_KEYREACTIVE_ENABLED
+
+static void led_effect_task_timers(led_effect_core_t *core) {
+#ifdef LED_EFFECT_KEYREACTIVE_ENABLED
+    uint32_t deltaTime = sync_timer_elapsed32(core->timer_buffer);
+#endif // LED_EFFECT_KEYREACTIVE_ENABLED
+    core->timer_buffer = sync_timer_read32();
+
+    // Update double buffer last hit timers
+#ifdef LED_EFFECT_KEYREACTIVE_ENABLED
+    uint8_t count = core->hit_buffer.count;
+    for (uint8_t i = 0; i < count; ++i) {
+        if (UINT16_MAX - deltaTime < core->hit_buffer.tick[i]) {
+            core->hit_buffer.count--;
+            continue;
+        }
+        core->hit_buffer.tick[i] += deltaTime;
+    }
+#endif // LED_EFFECT_KEYREACTIVE_ENABLED
+}
+
+static void led_effect_task_sync(led_effect_core_t *core) {
+    core->ops->sync();
+    // next task
+    if (sync_timer_elapsed32(*core->timer) >= core->flush_limit) core->state = STARTING;
+}
+
+static void led_effect_task_start(led_effect_core_t *core) {
+    // reset iter
+    core->params.iter = 0;
+
+    // update double buffers
+    *core->timer = core->timer_buffer;
+#ifdef LED_EFFECT_KEYREACTIVE_ENABLED
+    g_last_hit_tracker = core->hit_buffer;
+#endif // LED_EFFECT_KEYREACTIVE_ENABLED
+
+    // next task
+    core->state = RENDERING;
+}
+
+static void led_effect_task_render(led_effect_core_t *core, uint8_t effect, uint8_t enable, led_flags_t flags) {
+    core->params.init = (effect != core->last_effect) || (enable != core->last_enable);
+    if (core->params.flags != flags) {
+        core->params.flags = flags;
+        core->ops->clear();
+    }
+
+    // each effect can opt to do calculations
+    // and/or request PWM buffer updates.
+    bool rendering = core->ops->render(effect, &core->params);
+
+    core->params.iter++;
+
+    // next task
+    if (!rendering) {
+        core->state = FLUSHING;
+        if (!core->params.init && effect == LED_EFFECT_NONE) {
+            // We only need to flush once if we are LED_EFFECT_NONE
+            core->state = SYNCING;
+        }
+    }
+}
+
+static void led_effect_task_flush(led_effect_core_t *core, uint8_t effect, uint8_t enable) {
+    // update last trackers after the first full render so we can init over several frames
+    core->last_effect = effect;
+    core->last_enable = enable;
+
+    // update pwm buffers
+    core->ops->flush();
+
+    // next task
+    core->state = SYNCING;
+}
+
+void led_effect_core_task(led_effect_core_t *core, uint8_t effect, uint8_t enable, led_flags_t flags) {
+    led_effect_task_timers(core);
+
+    switch (core->state) {
+        case STARTING:
+            led_effect_task_start(core);
+            break;
+        case RENDERING:
+            led_effect_task_render(core, effect, enable, flags);
+            if (effect) {
+                // ensure we only draw basic indicators once rendering is finished
+                core->ops->indicators(&core->params, core->state == FLUSHING);
+            }
+            break;
+        case FLUSHING:
+            led_effect_task_flush(core, effect, enable);
+            break;
+        case SYNCING:
+            led_effect_task_sync(core);
+            break;
+    }
+}
+
+void led_effect_core_restart(led_effect_core_t *core) {
+    core->state = STARTING;
+}
+
+void led_effect_core_blank(led_effect_core_t *core, uint8_t enable, led_flags_t flags) {
+    led_effect_task_render(core, LED_EFFECT_NONE, enable, flags);
+    led_effect_task_flush(core, LED_EFFECT_NONE, enable);
+}
+
+void led_effect_core_clear_hits(led_effect_core_t *core) {
+#ifdef LED_EFFECT_KEYREACTIVE_ENABLED
+    g_last_hit_tracker.count = 0;
+    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
+        g_last_hit_tracker.tick[i] = UINT16_MAX;
+    }
+
+    core->hit_buffer.count = 0;
+    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
+        core->hit_buffer.tick[i] = UINT16_MAX;
+    }
+#endif // LED_EFFECT_KEYREACTIVE_ENABLED
+}
+
+void led_effect_core_add_hits(led_effect_core_t *core, const uint8_t *leds, uint8_t count, const led_point_t *points) {
+#ifdef LED_EFFECT_KEYREACTIVE_ENABLED
+    last_hit_t *hits = &core->hit_buffer;
+
+    if (hits->count + count > LED_HITS_TO_REMEMBER) {
+        memcpy(&hits->x[0], &hits->x[count], LED_HITS_TO_REMEMBER - count);
+        memcpy(&hits->y[0], &hits->y[count], LED_HITS_TO_REMEMBER - count);
+        memcpy(&hits->tick[0], &hits->tick[count], (LED_HITS_TO_REMEMBER - count) * 2); // 16 bit
+        memcpy(&hits->index[0], &hits->index[count], LED_HITS_TO_REMEMBER - count);
+        hits->count = LED_HITS_TO_REMEMBER - count;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t index      = hits->count;
+        hits->x[index]     = points[leds[i]].x;
+        hits->y[index]     = points[leds[i]].y;
+        hits->index[index] = leds[i];
+        hits->tick[index]  = 0;
+        hits->count++;
+    }
+#endif // LED_EFFECT_KEYREACTIVE_ENABLED
+}
@@ -0,0 +1,127 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "util.h"
+
+/*
+ * Effect scheduling shared by LED Matrix and RGB Matrix.
+ *
+ * Both run the same STARTING -> RENDERING -> FLUSHING -> SYNCING frame state machine and
+ * track recent key hits for reactive effects the same way. Only the pixel type differs,
+ * so each of them supplies a led_effect_ops_t for what touches pixels, and this core
+ * does the rest.
+ */
+
+#if defined(LED_MATRIX_KEYPRESSES) || defined(LED_MATRIX_KEYRELEASES) || defined(RGB_MATRIX_KEYPRESSES) || defined(RGB_MATRIX_KEYRELEASES)
+#    define LED_EFFECT_KEYREACTIVE_ENABLED
+#endif
+
+// Last led hit
+#ifndef LED_HITS_TO_REMEMBER
+#    define LED_HITS_TO_REMEMBER 8
+#endif // LED_HITS_TO_REMEMBER
+
+typedef struct PACKED {
+    uint8_t  count;
+    uint8_t  x[LED_HITS_TO_REMEMBER];
+    uint8_t  y[LED_HITS_TO_REMEMBER];
+    uint8_t  index[LED_HITS_TO_REMEMBER];
+    uint16_t tick[LED_HITS_TO_REMEMBER];
+} last_hit_t;
+
+typedef enum led_task_states { STARTING, RENDERING, FLUSHING, SYNCING } led_task_states;
+
+typedef uint8_t led_flags_t;
+
+typedef struct PACKED {
+    uint8_t     iter;
+    led_flags_t flags;
+    bool        init;
+} effect_params_t;
+
+typedef struct PACKED {
+    uint8_t x;
+    uint8_t y;
+} led_point_t;
+
+#define HAS_FLAGS(bits, flags) ((bits & flags) == flags)
+#define HAS_ANY_FLAGS(bits, flags) ((bits & flags) != 0x00)
+
+#define LED_FLAG_ALL 0xFF
+#define LED_FLAG_NONE 0x00
+#define LED_FLAG_MODIFIER 0x01
+#define LED_FLAG_UNDERGLOW 0x02
+#define LED_FLAG_KEYLIGHT 0x04
+#define LED_FLAG_INDICATOR 0x08
+
+#define NO_LED 255
+
+/* Effect 0 turns every LED off, and only has to be flushed once */
+#define LED_EFFECT_NONE 0
+
+typedef struct {
+    /* Renders the next slice of `effect`, returning true while there are LEDs left to render */
+    bool (*render)(uint8_t effect, effect_params_t *params);
+    /* Turns every LED off */
+    void (*clear)(void);
+    /* Sends the rendered frame to the LED driver */
+    void (*flush)(void);
+    /* Draws indicators over the slice just rendered, `finished` once the whole frame is */
+    void (*indicators)(effect_params_t *params, bool finished);
+    /* Writes any pending configuration to EEPROM */
+    void (*sync)(void);
+} led_effect_ops_t;
+
+typedef struct {
+    const led_effect_ops_t *ops;
+    uint32_t *              timer;       // Frame timer the effects animate against
+    uint16_t                flush_limit; // Minimum time between two frames, in milliseconds
+    led_task_states         state;
+    uint8_t                 last_enable;
+    uint8_t                 last_effect;
+    effect_params_t         params;
+    uint32_t                timer_buffer;
+#ifdef LED_EFFECT_KEYREACTIVE_ENABLED
+    last_hit_t hit_buffer;
+#endif
+} led_effect_core_t;
+
+#define LED_EFFECT_CORE(effect_ops, frame_timer, limit) \
+    { .ops = (effect_ops), .timer = (frame_timer), .flush_limit = (limit), .state = SYNCING, .last_enable = UINT8_MAX, .last_effect = UINT8_MAX, .params = {0, LED_FLAG_ALL, false} }
+
+#ifdef LED_EFFECT_KEYREACTIVE_ENABLED
+extern last_hit_t g_last_hit_tracker;
+#endif
+
+/**
+ * \brief Runs one step of the frame state machine.
+ *
+ * \param effect The effect to render, LED_EFFECT_NONE while disabled or suspended
+ * \param enable Whether the matrix is enabled, a change re-initialises the effect
+ * \param flags  LED flags the effect should be rendered for
+ */
+void led_effect_core_task(led_effect_core_t *core, uint8_t effect, uint8_t enable, led_flags_t flags);
+
+/**
+ * \brief Starts a new frame on the next step, e.g. after the effect or its settings changed.
+ */
+void led_effect_core_restart(led_effect_core_t *core);
+
+/**
+ * \brief Renders and flushes a blank frame straight away.
+ */
+void led_effect_core_blank(led_effect_core_t *core, uint8_t enable, led_flags_t flags);
+
+/**
+ * \brief Forgets every key hit.
+ */
+void led_effect_core_clear_hits(led_effect_core_t *core);
+
+/**
+ * \brief Records hits on `count` LEDs, dropping the oldest ones once more than LED_HITS_TO_REMEMBER are tracked.
+ */
+void led_effect_core_add_hits(led_effect_core_t *core, const uint8_t *leds, uint8_t count, const led_point_t *points);
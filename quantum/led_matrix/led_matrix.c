@@ -64,22 +64,24 @@ uint32_t       g_led_timer;
 #ifdef LED_MATRIX_FRAMEBUFFER_EFFECTS
 uint8_t g_led_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #endif // LED_MATRIX_FRAMEBUFFER_EFFECTS
-#ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-last_hit_t g_last_hit_tracker;
-#endif // LED_MATRIX_KEYREACTIVE_ENABLED
 
 // internals
-static bool            suspend_state     = false;
-static uint8_t         led_last_enable   = UINT8_MAX;
-static uint8_t         led_last_effect   = UINT8_MAX;
-static effect_params_t led_effect_params = {0, LED_FLAG_ALL, false};
-static led_task_states led_task_state    = SYNCING;
-
-// double buffers
-static uint32_t led_timer_buffer;
-#ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-static last_hit_t last_hit_buffer;
-#endif // LED_MATRIX_KEYREACTIVE_ENABLED
+static bool suspend_state = false;
+
+void        led_matrix_update_pwm_buffers(void);
+static bool led_task_render(uint8_t effect, effect_params_t *params);
+static void led_task_clear(void);
+static void led_task_indicators(effect_params_t *params, bool finished);
+static void led_task_sync(void);
+
+static const led_effect_ops_t led_effect_ops = {
+    .render     = led_task_render,
+    .clear      = led_task_clear,
+    .flush      = led_matrix_update_pwm_buffers,
+    .indicators = led_task_indicators,
+    .sync       = led_task_sync,
+};
+static led_effect_core_t led_effect_core = LED_EFFECT_CORE(&led_effect_ops, &g_led_timer, LED_MATRIX_LED_FLUSH_LIMIT);
 
 // split led matrix
 #if defined(LED_MATRIX_SPLIT)
@@ -177,22 +179,7 @@ void led_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
         led_count = led_matrix_map_row_column_to_led(row, col, led);
     }
 
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
-    }
-
-    for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
-        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
-        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
-        last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
-        last_hit_buffer.count++;
-    }
+    led_effect_core_add_hits(&led_effect_core, led, led_count, g_led_config.point);
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
 
 #if defined(LED_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_LED_MATRIX_TYPING_HEATMAP)
@@ -211,73 +198,35 @@ static bool led_matrix_none(effect_params_t *params) {
     return false;
 }
 
-static void led_task_timers(void) {
-#if defined(LED_MATRIX_KEYREACTIVE_ENABLED)
-    uint32_t deltaTime = sync_timer_elapsed32(led_timer_buffer);
-#endif // defined(LED_MATRIX_KEYREACTIVE_ENABLED)
-    led_timer_buffer = sync_timer_read32();
-
-    // Update double buffer last hit timers
-#ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-    uint8_t count = last_hit_buffer.count;
-    for (uint8_t i = 0; i < count; ++i) {
-        if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
-            last_hit_buffer.count--;
-            continue;
-        }
-        last_hit_buffer.tick[i] += deltaTime;
-    }
-#endif // LED_MATRIX_KEYREACTIVE_ENABLED
+static void led_task_clear(void) {
+    led_matrix_set_value_all(0);
 }
 
 static void led_task_sync(void) {
     eeconfig_flush_led_matrix(false);
-    // next task
-    if (sync_timer_elapsed32(g_led_timer) >= LED_MATRIX_LED_FLUSH_LIMIT) led_task_state = STARTING;
 }
 
-static void led_task_start(void) {
-    // reset iter
-    led_effect_params.iter = 0;
+static bool led_task_render(uint8_t effect, effect_params_t *params) {
+    bool rendering = false;
 
-    // update double buffers
-    g_led_timer = led_timer_buffer;
-#ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker = last_hit_buffer;
-#endif // LED_MATRIX_KEYREACTIVE_ENABLED
-
-    // next task
-    led_task_state = RENDERING;
-}
-
-static void led_task_render(uint8_t effect) {
-    bool rendering         = false;
-    led_effect_params.init = (effect != led_last_effect) || (led_matrix_eeconfig.enable != led_last_enable);
-    if (led_effect_params.flags != led_matrix_eeconfig.flags) {
-        led_effect_params.flags = led_matrix_eeconfig.flags;
-        led_matrix_set_value_all(0);
-    }
-
-    // each effect can opt to do calculations
-    // and/or request PWM buffer updates.
     switch (effect) {
         case LED_MATRIX_NONE:
-            rendering = led_matrix_none(&led_effect_params);
+            rendering = led_matrix_none(params);
             break;
 
 // ---------------------------------------------
 // -----Begin led effect switch case macros-----
-#define LED_MATRIX_EFFECT(name, ...)          \
-    case LED_MATRIX_##name:                   \
-        rendering = name(&led_effect_params); \
+#define LED_MATRIX_EFFECT(name, ...) \
+    case LED_MATRIX_##name:          \
+        rendering = name(params);    \
         break;
 #include "led_matrix_effects.inc"
 #undef LED_MATRIX_EFFECT
 
 #if defined(LED_MATRIX_CUSTOM_KB) || defined(LED_MATRIX_CUSTOM_USER)
-#    define LED_MATRIX_EFFECT(name, ...)          \
-        case LED_MATRIX_CUSTOM_##name:            \
-            rendering = name(&led_effect_params); \
+#    define LED_MATRIX_EFFECT(name, ...) \
+        case LED_MATRIX_CUSTOM_##name:   \
+            rendering = name(params);    \
             break;
 #    ifdef LED_MATRIX_CUSTOM_KB
 #        include "led_matrix_kb.inc"
@@ -291,33 +240,17 @@ static void led_task_render(uint8_t effect) {
             // ---------------------------------------------
     }
 
-    led_effect_params.iter++;
-
-    // next task
-    if (!rendering) {
-        led_task_state = FLUSHING;
-        if (!led_effect_params.init && effect == LED_MATRIX_NONE) {
-            // We only need to flush once if we are LED_MATRIX_NONE
-            led_task_state = SYNCING;
-        }
-    }
+    return rendering;
 }
 
-static void led_task_flush(uint8_t effect) {
-    // update last trackers after the first full render so we can init over several frames
-    led_last_effect = effect;
-    led_last_enable = led_matrix_eeconfig.enable;
-
-    // update pwm buffers
-    led_matrix_update_pwm_buffers();
-
-    // next task
-    led_task_state = SYNCING;
+static void led_task_indicators(effect_params_t *params, bool finished) {
+    if (finished) {
+        led_matrix_indicators();
+    }
+    led_matrix_indicators_advanced(params);
 }
 
 void led_matrix_task(void) {
-    led_task_timers();
-
     // Ideally we would also stop sending zeros to the LED driver PWM buffers
     // while suspended and just do a software shutdown. This is a cheap hack for now.
     bool suspend_backlight = suspend_state ||
@@ -328,26 +261,7 @@ void led_matrix_task(void) {
 
     uint8_t effect = suspend_backlight || !led_matrix_eeconfig.enable ? 0 : led_matrix_eeconfig.mode;
 
-    switch (led_task_state) {
-        case STARTING:
-            led_task_start();
-            break;
-        case RENDERING:
-            led_task_render(effect);
-            if (effect) {
-                if (led_task_state == FLUSHING) {
-                    led_matrix_indicators(); // ensure we only draw basic indicators once rendering is finished
-                }
-                led_matrix_indicators_advanced(&led_effect_params);
-            }
-            break;
-        case FLUSHING:
-            led_task_flush(effect);
-            break;
-        case SYNCING:
-            led_task_sync();
-            break;
-    }
+    led_effect_core_task(&led_effect_core, effect, led_matrix_eeconfig.enable, led_matrix_eeconfig.flags);
 }
 
 void led_matrix_indicators(void) {
@@ -366,7 +280,7 @@ void led_matrix_indicators_advanced(effect_params_t *params) {
     /* special handling is needed for "params->iter", since it's already been incremented.
      * Could move the invocations to led_task_render, but then it's missing a few checks
      * and not sure which would be better. Otherwise, this should be called from
-     * led_task_render, right before the iter++ line.
+     * the effect core, right before the iter++ line.
      */
     LED_MATRIX_USE_LIMITS_ITER(min, max, params->iter - 1);
     led_matrix_indicators_advanced_kb(min, max);
@@ -413,17 +327,7 @@ struct led_matrix_limits_t led_matrix_get_limits(uint8_t iter) {
 void led_matrix_init(void) {
     led_matrix_driver.init();
 
-#ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        g_last_hit_tracker.tick[i] = UINT16_MAX;
-    }
-
-    last_hit_buffer.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        last_hit_buffer.tick[i] = UINT16_MAX;
-    }
-#endif // LED_MATRIX_KEYREACTIVE_ENABLED
+    led_effect_core_clear_hits(&led_effect_core);
 
     eeconfig_init_led_matrix();
     if (!led_matrix_eeconfig.mode) {
@@ -436,8 +340,8 @@ void led_matrix_init(void) {
 void led_matrix_set_suspend_state(bool state) {
 #ifdef LED_MATRIX_SLEEP
     if (state && !suspend_state && is_keyboard_master()) { // only run if turning off, and only once
-        led_task_render(0);                                // turn off all LEDs when suspending
-        led_task_flush(0);                                 // and actually flash led state to LEDs
+        // turn off all LEDs when suspending, and actually flash led state to LEDs
+        led_effect_core_blank(&led_effect_core, led_matrix_eeconfig.enable, led_matrix_eeconfig.flags);
     }
     suspend_state = state;
 #endif
@@ -449,7 +353,7 @@ bool led_matrix_get_suspend_state(void) {
 
 void led_matrix_toggle_eeprom_helper(bool write_to_eeprom) {
     led_matrix_eeconfig.enable ^= 1;
-    led_task_state = STARTING;
+    led_effect_core_restart(&led_effect_core);
     eeconfig_flag_led_matrix(write_to_eeprom);
     dprintf("led matrix toggle [%s]: led_matrix_eeconfig.enable = %u\n", (write_to_eeprom) ? "EEPROM" : "NOEEPROM", led_matrix_eeconfig.enable);
 }
@@ -466,7 +370,7 @@ void led_matrix_enable(void) {
 }
 
 void led_matrix_enable_noeeprom(void) {
-    if (!led_matrix_eeconfig.enable) led_task_state = STARTING;
+    if (!led_matrix_eeconfig.enable) led_effect_core_restart(&led_effect_core);
     led_matrix_eeconfig.enable = 1;
 }
 
@@ -476,7 +380,7 @@ void led_matrix_disable(void) {
 }
 
 void led_matrix_disable_noeeprom(void) {
-    if (led_matrix_eeconfig.enable) led_task_state = STARTING;
+    if (led_matrix_eeconfig.enable) led_effect_core_restart(&led_effect_core);
     led_matrix_eeconfig.enable = 0;
 }
 
@@ -495,7 +399,7 @@ void led_matrix_mode_eeprom_helper(uint8_t mode, bool write_to_eeprom) {
     } else {
         led_matrix_eeconfig.mode = mode;
     }
-    led_task_state = STARTING;
+    led_effect_core_restart(&led_effect_core);
     eeconfig_flag_led_matrix(write_to_eeprom);
     dprintf("led matrix mode [%s]: %u\n", (write_to_eeprom) ? "EEPROM" : "NOEEPROM", led_matrix_eeconfig.mode);
 }
@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "matrix.h"
 #include "debounce.h"
 #include "atomic_util.h"
+#include "timer.h"
 
 #ifdef SPLIT_KEYBOARD
 #    include "split_common/split_util.h"
@@ -51,6 +52,18 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define MATRIX_INPUT_PRESSED_STATE 0
 #endif
 
+#ifdef MATRIX_PORT_SCAN
+#    if defined(DIRECT_PINS) || !defined(DIODE_DIRECTION) || (DIODE_DIRECTION != COL2ROW)
+#        error MATRIX_PORT_SCAN requires DIODE_DIRECTION COL2ROW
+#    endif
+#    ifndef gpio_read_port
+#        error MATRIX_PORT_SCAN is not supported on this platform
+#    endif
+#    ifndef MATRIX_PORT_SCAN_GROUPS
+#        define MATRIX_PORT_SCAN_GROUPS ((MATRIX_COLS + 3) / 4 + 2)
+#    endif
+#endif
+
 #ifdef DIRECT_PINS
 static SPLIT_MUTABLE pin_t direct_pins[ROWS_PER_HAND][MATRIX_COLS] = DIRECT_PINS;
 #elif (DIODE_DIRECTION == ROW2COL) || (DIODE_DIRECTION == COL2ROW)
@@ -65,6 +78,7 @@ static SPLIT_MUTABLE_COL pin_t col_pins[MATRIX_COLS]   = MATRIX_COL_PINS;
 /* matrix state(1:on, 0:off) */
 extern matrix_row_t raw_matrix[MATRIX_ROWS]; // raw values
 extern matrix_row_t matrix[MATRIX_ROWS];     // debounced values
+extern uint16_t     matrix_scan_time;        // timer_read() time at which the latest scan started
 
 #ifdef SPLIT_KEYBOARD
 // row offsets for each hand
@@ -163,6 +177,102 @@ static void unselect_rows(void) {
     }
 }
 
+#            ifdef MATRIX_PORT_SCAN
+// Column pins are read a whole GPIO port at a time. The pins are split into groups of 4 neighbouring port bits, and
+// each group has a table that maps the state of those 4 bits to the matrix columns they are wired to.
+typedef struct {
+    gpio_port_t port;
+    uint8_t     shift;    // Position of the group in the port
+    bool        new_port; // First group on its port, which is where the port is read
+} col_group_t;
+
+static col_group_t  col_groups[MATRIX_PORT_SCAN_GROUPS];
+static matrix_row_t col_group_tables[MATRIX_PORT_SCAN_GROUPS][16];
+static uint8_t      col_group_count;
+static matrix_row_t col_pin_scan_mask; // Columns that didn't fit in a group, read one pin at a time
+
+static uint8_t col_group_add(gpio_port_t port, uint8_t shift, bool new_port) {
+    for (uint8_t i = 0; i < col_group_count; i++) {
+        if (col_groups[i].port == port && col_groups[i].shift == shift) {
+            return i;
+        }
+    }
+    if (col_group_count < MATRIX_PORT_SCAN_GROUPS) {
+        col_groups[col_group_count] = (col_group_t){.port = port, .shift = shift, .new_port = new_port};
+        return col_group_count++;
+    }
+    return MATRIX_PORT_SCAN_GROUPS;
+}
+
+static void col_groups_init(void) {
+    matrix_row_t grouped = 0;
+
+    col_group_count   = 0;
+    col_pin_scan_mask = 0;
+    memset(col_group_tables, 0, sizeof(col_group_tables));
+
+    // Handle the columns one port at a time, so that the groups of a port are next to each other
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        if (col_pins[col] == NO_PIN || (grouped & (MATRIX_ROW_SHIFTER << col))) {
+            continue;
+        }
+
+        gpio_port_t port     = gpio_get_pin_port(col_pins[col]);
+        bool        new_port = true;
+        for (uint8_t x = col; x < MATRIX_COLS; x++) {
+            if (col_pins[x] == NO_PIN || gpio_get_pin_port(col_pins[x]) != port) {
+                continue;
+            }
+            grouped |= MATRIX_ROW_SHIFTER << x;
+
+            uint8_t bit = 0;
+            for (gpio_port_mask_t mask = gpio_get_pin_port_mask(col_pins[x]); mask > 1; mask >>= 1) {
+                bit++;
+            }
+
+            uint8_t group = col_group_add(port, bit & ~3, new_port);
+            if (group == MATRIX_PORT_SCAN_GROUPS) {
+                col_pin_scan_mask |= MATRIX_ROW_SHIFTER << x;
+                continue;
+            }
+            new_port = false;
+
+            for (uint8_t state = 0; state < 16; state++) {
+                if (state & (1 << (bit & 3))) {
+                    col_group_tables[group][state] |= MATRIX_ROW_SHIFTER << x;
+                }
+            }
+        }
+    }
+}
+
+static matrix_row_t read_cols(void) {
+    matrix_row_t     current_row_value = 0;
+    gpio_port_mask_t pressed           = 0;
+
+    for (uint8_t i = 0; i < col_group_count; i++) {
+        if (col_groups[i].new_port) {
+            pressed = gpio_read_port(col_groups[i].port);
+#                if MATRIX_INPUT_PRESSED_STATE == 0
+            pressed = ~pressed;
+#                endif
+        }
+        current_row_value |= col_group_tables[i][(pressed >> col_groups[i].shift) & 0xF];
+    }
+
+    if (col_pin_scan_mask) {
+        matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
+        for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++, row_shifter <<= 1) {
+            if (col_pin_scan_mask & row_shifter) {
+                current_row_value |= readMatrixPin(col_pins[col_index]) ? 0 : row_shifter;
+            }
+        }
+    }
+
+    return current_row_value;
+}
+#            endif
+
 __attribute__((weak)) void matrix_init_pins(void) {
     unselect_rows();
     for (uint8_t x = 0; x < MATRIX_COLS; x++) {
@@ -181,6 +291,9 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     }
     matrix_output_select_delay();
 
+#            ifdef MATRIX_PORT_SCAN
+    current_row_value = read_cols();
+#            else
     // For each col...
     matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
     for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++, row_shifter <<= 1) {
@@ -189,6 +302,7 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
         // Populate the matrix row with the state of the col pin
         current_row_value |= pin_state ? 0 : row_shifter;
     }
+#            endif
 
     // Unselect row
     unselect_row(current_row);
@@ -302,6 +416,9 @@ void matrix_init(void) {
 
     // initialize key pins
     matrix_init_pins();
+#ifdef MATRIX_PORT_SCAN
+    col_groups_init();
+#endif
 
     // initialize matrix state: all keys off
     memset(matrix, 0, sizeof(matrix));
@@ -323,6 +440,8 @@ __attribute__((weak)) bool transport_master_if_connected(matrix_row_t master_mat
 uint8_t matrix_scan(void) {
     matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
 
+    matrix_scan_time = timer_read();
+
 #if defined(DIRECT_PINS) || (DIODE_DIRECTION == COL2ROW)
     // Set row, read cols
     for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
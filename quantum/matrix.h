@@ -57,6 +57,12 @@ bool matrix_can_read(void);
 bool matrix_is_on(uint8_t row, uint8_t col);
 /* matrix state on row */
 matrix_row_t matrix_get_row(uint8_t row);
+/* timer_read() time at which the latest matrix scan started */
+uint16_t matrix_get_scan_time(void);
+/* timer_read() time at which a switch last changed state, for switches that changed in the latest scan */
+uint16_t matrix_get_key_time(uint8_t row, uint8_t col);
+/* timer_read() time up to which every switch change has been reported */
+uint16_t matrix_get_time_horizon(void);
 /* print matrix for debug */
 void matrix_print(void);
 /* delay between changing matrix pin state and reading values */
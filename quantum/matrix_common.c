@@ -1,5 +1,6 @@
 #include "matrix.h"
 #include "debounce.h"
+#include "timer.h"
 #include "wait.h"
 #include "print.h"
 #include "debug.h"
@@ -18,9 +19,17 @@
 #    define MATRIX_IO_DELAY 30
 #endif
 
+#ifdef DEBOUNCE_COMPENSATION
+#    define KEY_DEBOUNCE_DELAY(pressed) debounce_delay(pressed)
+#else
+#    define KEY_DEBOUNCE_DELAY(pressed) 0
+#endif
+
 /* matrix state(1:on, 0:off) */
 matrix_row_t raw_matrix[MATRIX_ROWS];
 matrix_row_t matrix[MATRIX_ROWS];
+/* timer_read() time at which the latest scan started */
+uint16_t matrix_scan_time;
 
 #ifdef SPLIT_KEYBOARD
 // row offsets for each hand
@@ -166,7 +175,8 @@ __attribute__((weak)) void matrix_init(void) {
 }
 
 __attribute__((weak)) uint8_t matrix_scan(void) {
-    bool changed = matrix_scan_custom(raw_matrix);
+    matrix_scan_time = timer_read();
+    bool changed     = matrix_scan_custom(raw_matrix);
 
 #ifdef SPLIT_KEYBOARD
     changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed) | matrix_post_scan();
@@ -178,6 +188,33 @@ __attribute__((weak)) uint8_t matrix_scan(void) {
     return changed;
 }
 
+uint16_t matrix_get_key_time(uint8_t row, uint8_t col) {
+    const uint16_t delay = KEY_DEBOUNCE_DELAY(matrix_is_on(row, col));
+
+#if defined(SPLIT_MATRIX_EVENTS_ENABLE) && defined(SPLIT_COMMON_TRANSACTIONS)
+    if (is_keyboard_master() && row >= thatHand && row < thatHand + ROWS_PER_HAND) {
+        return transactions_get_slave_key_time(row - thatHand, col) - delay;
+    }
+#endif
+
+    return matrix_scan_time - delay;
+}
+
+uint16_t matrix_get_time_horizon(void) {
+    const uint16_t press_delay   = KEY_DEBOUNCE_DELAY(true);
+    const uint16_t release_delay = KEY_DEBOUNCE_DELAY(false);
+    uint16_t       horizon       = timer_read();
+
+#if defined(SPLIT_MATRIX_EVENTS_ENABLE) && defined(SPLIT_COMMON_TRANSACTIONS)
+    // Changes on the slave half are only known up to the last time it was polled
+    if (is_keyboard_master() && is_transport_connected()) {
+        horizon = transactions_get_slave_poll_time();
+    }
+#endif
+
+    return horizon - (press_delay > release_delay ? press_delay : release_delay);
+}
+
 __attribute__((weak)) bool peek_matrix(uint8_t row_index, uint8_t col_index, bool raw) {
     return 0 != ((raw ? raw_matrix[row_index] : matrix[row_index]) & (MATRIX_ROW_SHIFTER << col_index));
 }
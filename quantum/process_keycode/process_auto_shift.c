@@ -19,6 +19,9 @@
 #include "action_util.h"
 #include "timer.h"
 #include "keycodes.h"
+#ifdef AUTO_SHIFT_ADAPTIVE_EEPROM
+#    include "eeconfig.h"
+#endif
 
 #ifndef AUTO_SHIFT_DISABLED_AT_STARTUP
 #    define AUTO_SHIFT_STARTUP_STATE true /* enabled */
@@ -28,6 +31,8 @@
 
 // Stores the last Auto Shift key's up or down time, for evaluation or keyrepeat.
 static uint16_t autoshift_time = 0;
+// When the key being evaluated turns into a shifted press, fixed when it is pressed.
+static uint16_t autoshift_deadline = 0;
 #if defined(RETRO_SHIFT) && !defined(NO_ACTION_TAPPING)
 // Stores the last key's up or down time, to replace autoshift_time so that Tap Hold times are accurate.
 static uint16_t retroshift_time = 0;
@@ -61,6 +66,26 @@ static struct {
 } autoshift_flags = {AUTO_SHIFT_STARTUP_STATE, false, false, false, false, false};
 // clang-format on
 
+#ifdef AUTO_SHIFT_ADAPTIVE
+_Static_assert(AUTO_SHIFT_ADAPTIVE_WINDOW <= UINT8_MAX, "AUTO_SHIFT_ADAPTIVE_WINDOW must fit a histogram bin.");
+_Static_assert(AUTO_SHIFT_ADAPTIVE_WINDOW / 2 - AUTO_SHIFT_ADAPTIVE_BINS / 2 >= AUTO_SHIFT_ADAPTIVE_MIN_SAMPLES, "AUTO_SHIFT_ADAPTIVE_WINDOW is too small to keep AUTO_SHIFT_ADAPTIVE_MIN_SAMPLES once halved.");
+#    ifdef AUTO_SHIFT_ADAPTIVE_EEPROM
+// Learned timeouts are stored halved, in a byte per key.
+_Static_assert(AUTO_SHIFT_ADAPTIVE_TIMEOUT_MAX / 2 <= UINT8_MAX, "AUTO_SHIFT_ADAPTIVE_TIMEOUT_MAX must not exceed 511 with AUTO_SHIFT_ADAPTIVE_EEPROM.");
+#    endif
+
+#    define AUTO_SHIFT_ADAPTIVE_HELD 4
+
+// How long each key is held when tapped, bucketed by AUTO_SHIFT_ADAPTIVE_BIN_WIDTH.
+static uint8_t autoshift_histogram[AUTO_SHIFT_ADAPTIVE_KEYS][AUTO_SHIFT_ADAPTIVE_BINS];
+// Auto Shift keys that are down, so their hold can be timed on release.
+static struct {
+    uint8_t  key; // Index into autoshift_histogram plus one, zero when free
+    uint16_t time;
+} autoshift_held[AUTO_SHIFT_ADAPTIVE_HELD];
+static uint8_t autoshift_held_next = 0;
+#endif
+
 /** \brief Called on physical press, returns whether key should be added to Auto Shift */
 __attribute__((weak)) bool get_custom_auto_shifted_key(uint16_t keycode, keyrecord_t *record) {
     return false;
@@ -148,6 +173,140 @@ static void autoshift_flush_shift(void) {
     send_keyboard_report();
 }
 
+#ifdef AUTO_SHIFT_ADAPTIVE
+/** \brief Returns the histogram a keycode is tracked in, or -1 */
+static int8_t autoshift_adaptive_index(uint16_t keycode) {
+    if (IS_RETRO(keycode)) {
+        keycode &= 0xFF;
+    }
+    if (keycode < KC_A || keycode > KC_SLASH) {
+        return -1;
+    }
+    return keycode - KC_A;
+}
+
+/** \brief Derives a timeout that AUTO_SHIFT_ADAPTIVE_PERCENTILE of the key's taps stay under */
+static uint16_t autoshift_adaptive_timeout(uint8_t index, uint16_t fallback) {
+    const uint8_t *bins  = autoshift_histogram[index];
+    uint16_t       total = 0;
+    for (uint8_t b = 0; b < AUTO_SHIFT_ADAPTIVE_BINS; b++) {
+        total += bins[b];
+    }
+    if (total < AUTO_SHIFT_ADAPTIVE_MIN_SAMPLES) {
+#    ifdef AUTO_SHIFT_ADAPTIVE_EEPROM
+        const uint8_t stored = eeprom_read_byte(EECONFIG_AUTO_SHIFT + index);
+        if (stored) {
+            return stored * 2;
+        }
+#    endif
+        return fallback;
+    }
+
+    const uint16_t wanted = ((uint32_t)total * AUTO_SHIFT_ADAPTIVE_PERCENTILE + 99) / 100;
+    uint16_t       seen   = 0;
+    uint8_t        b      = 0;
+    for (; b < AUTO_SHIFT_ADAPTIVE_BINS - 1; b++) {
+        seen += bins[b];
+        if (seen >= wanted) {
+            break;
+        }
+    }
+    const uint16_t timeout = (b + 1) * AUTO_SHIFT_ADAPTIVE_BIN_WIDTH + AUTO_SHIFT_ADAPTIVE_MARGIN;
+    if (timeout < AUTO_SHIFT_ADAPTIVE_TIMEOUT_MIN) {
+        return AUTO_SHIFT_ADAPTIVE_TIMEOUT_MIN;
+    }
+    if (timeout > AUTO_SHIFT_ADAPTIVE_TIMEOUT_MAX) {
+        return AUTO_SHIFT_ADAPTIVE_TIMEOUT_MAX;
+    }
+    return timeout;
+}
+
+/** \brief Adds the hold duration of a tap to the key's histogram */
+static void autoshift_adaptive_record(uint8_t index, uint16_t duration) {
+    uint8_t *bins = autoshift_histogram[index];
+    uint8_t  bin  = duration / AUTO_SHIFT_ADAPTIVE_BIN_WIDTH;
+    if (bin >= AUTO_SHIFT_ADAPTIVE_BINS) {
+        bin = AUTO_SHIFT_ADAPTIVE_BINS - 1;
+    }
+    bins[bin]++;
+
+    uint16_t total = 0;
+    for (uint8_t b = 0; b < AUTO_SHIFT_ADAPTIVE_BINS; b++) {
+        total += bins[b];
+    }
+    if (total >= AUTO_SHIFT_ADAPTIVE_WINDOW) {
+#    ifdef AUTO_SHIFT_ADAPTIVE_EEPROM
+        // Once per window keeps the writes rare, and update skips unchanged values.
+        eeprom_update_byte(EECONFIG_AUTO_SHIFT + index, autoshift_adaptive_timeout(index, 0) / 2);
+#    endif
+        for (uint8_t b = 0; b < AUTO_SHIFT_ADAPTIVE_BINS; b++) {
+            bins[b] /= 2;
+        }
+    }
+}
+
+/** \brief Starts timing the hold of a key that has been pressed */
+static void autoshift_adaptive_press(uint16_t keycode, uint16_t now) {
+    const int8_t index = autoshift_adaptive_index(keycode);
+    if (index < 0) {
+        return;
+    }
+    // Overwrites the oldest entry if more keys than that are held at once.
+    autoshift_held[autoshift_held_next].key  = index + 1;
+    autoshift_held[autoshift_held_next].time = now;
+    autoshift_held_next                      = (autoshift_held_next + 1) % AUTO_SHIFT_ADAPTIVE_HELD;
+}
+
+/** \brief Learns from the hold of a key that has been released, if it was a tap */
+static void autoshift_adaptive_release(uint16_t keycode, uint16_t now) {
+    const int8_t index = autoshift_adaptive_index(keycode);
+    if (index < 0) {
+        return;
+    }
+    for (uint8_t i = 0; i < AUTO_SHIFT_ADAPTIVE_HELD; i++) {
+        if (autoshift_held[i].key == index + 1) {
+            autoshift_held[i].key = 0;
+            // Shifted presses are either wanted or can't be told apart from wanted ones.
+            if (!get_autoshift_shift_state(keycode)) {
+                autoshift_adaptive_record(index, TIMER_DIFF_16(now, autoshift_held[i].time));
+            }
+            return;
+        }
+    }
+}
+
+uint16_t get_autoshift_adaptive_timeout(uint16_t keycode) {
+    const int8_t index = autoshift_adaptive_index(keycode);
+    return index < 0 ? autoshift_timeout : autoshift_adaptive_timeout(index, autoshift_timeout);
+}
+
+void autoshift_adaptive_reset(void) {
+    memset(autoshift_histogram, 0, sizeof(autoshift_histogram));
+    memset(autoshift_held, 0, sizeof(autoshift_held));
+#    ifdef AUTO_SHIFT_ADAPTIVE_EEPROM
+    for (uint8_t i = 0; i < AUTO_SHIFT_ADAPTIVE_KEYS; i++) {
+        eeprom_update_byte(EECONFIG_AUTO_SHIFT + i, 0);
+    }
+#    endif
+}
+#endif
+
+/** \brief Returns how long the key has to be held to be shifted */
+static uint16_t autoshift_get_timeout(uint16_t keycode, keyrecord_t *record) {
+#ifdef AUTO_SHIFT_TIMEOUT_PER_KEY
+    const uint16_t timeout = get_autoshift_timeout(keycode, record);
+#else
+    const uint16_t timeout = autoshift_timeout;
+#endif
+#ifdef AUTO_SHIFT_ADAPTIVE
+    const int8_t index = autoshift_adaptive_index(keycode);
+    if (index >= 0) {
+        return autoshift_adaptive_timeout(index, timeout);
+    }
+#endif
+    return timeout;
+}
+
 /** \brief Record the press of an autoshiftable key
  *
  *  \return Whether the record should be further processed.
@@ -222,7 +381,11 @@ static bool autoshift_press(uint16_t keycode, uint16_t now, keyrecord_t *record)
     // Record the keycode so we can simulate it later.
     autoshift_lastkey           = keycode;
     autoshift_time              = now;
+    autoshift_deadline          = now + autoshift_get_timeout(keycode, record);
     autoshift_flags.in_progress = true;
+#ifdef AUTO_SHIFT_ADAPTIVE
+    autoshift_adaptive_press(keycode, now);
+#endif
 
 #if !defined(NO_ACTION_ONESHOT) && !defined(NO_ACTION_TAPPING)
     clear_oneshot_layer_state(ONESHOT_OTHER_KEY_PRESSED);
@@ -243,17 +406,7 @@ static void autoshift_end(uint16_t keycode, uint16_t now, bool matrix_trigger, k
     if (autoshift_flags.in_progress && (keycode == autoshift_lastkey || keycode == KC_NO)) {
         // Process the auto-shiftable key.
         autoshift_flags.in_progress = false;
-        // clang-format off
-        autoshift_flags.lastshifted =
-            autoshift_flags.lastshifted
-            || TIMER_DIFF_16(now, autoshift_time) >=
-#ifdef AUTO_SHIFT_TIMEOUT_PER_KEY
-                get_autoshift_timeout(autoshift_lastkey, record)
-#else
-                autoshift_timeout
-#endif
-        ;
-        // clang-format on
+        autoshift_flags.lastshifted = autoshift_flags.lastshifted || timer_expired(now, autoshift_deadline);
         set_autoshift_shift_state(autoshift_lastkey, autoshift_flags.lastshifted);
         if (get_mods() & MOD_BIT(KC_LSFT)) {
             autoshift_flags.cancelling_lshift = true;
@@ -308,14 +461,8 @@ static void autoshift_end(uint16_t keycode, uint16_t now, bool matrix_trigger, k
  */
 void autoshift_matrix_scan(void) {
     if (autoshift_flags.in_progress) {
-        const uint16_t now = timer_read();
-        if (TIMER_DIFF_16(now, autoshift_time) >=
-#ifdef AUTO_SHIFT_TIMEOUT_PER_KEY
-            get_autoshift_timeout(autoshift_lastkey, &autoshift_lastrecord)
-#else
-            autoshift_timeout
-#endif
-        ) {
+        const uint16_t now = keyboard_event_horizon();
+        if (timer_expired(now, autoshift_deadline)) {
             autoshift_end(autoshift_lastkey, now, true, &autoshift_lastrecord);
         }
     }
@@ -364,12 +511,13 @@ void set_autoshift_timeout(uint16_t timeout) {
 }
 
 bool process_auto_shift(uint16_t keycode, keyrecord_t *record) {
-    // Note that record->event.time isn't reliable, see:
+    // Key events carry the time the key changed state, see matrix_get_key_time(). With Retro Shift, records can be
+    // held back by tapping, and their release time isn't reliable, see:
     // https://github.com/qmk/qmk_firmware/pull/9826#issuecomment-733559550
     // clang-format off
     const uint16_t now =
 #if !defined(RETRO_SHIFT) || defined(NO_ACTION_TAPPING)
-        timer_read()
+        record->event.time
 #else
         (record->event.pressed) ? retroshift_time : timer_read()
 #endif
@@ -475,6 +623,9 @@ bool process_auto_shift(uint16_t keycode, keyrecord_t *record) {
             return autoshift_press(keycode, now, record);
         } else {
             autoshift_end(keycode, now, false, record);
+#ifdef AUTO_SHIFT_ADAPTIVE
+            autoshift_adaptive_release(keycode, now);
+#endif
             return false;
         }
     }
@@ -491,12 +642,13 @@ bool process_auto_shift(uint16_t keycode, keyrecord_t *record) {
 // Called to record time before possible delays by action_tapping_process.
 void retroshift_poll_time(keyevent_t *event) {
     last_retroshift_time = retroshift_time;
-    retroshift_time      = timer_read();
+    retroshift_time      = event->time;
 }
 // Used to swap the times of Retro Shifted key and Auto Shift key that interrupted it.
 void retroshift_swap_times(void) {
     if (autoshift_flags.in_progress) {
-        autoshift_time = last_retroshift_time;
+        autoshift_deadline += last_retroshift_time - autoshift_time;
+        autoshift_time      = last_retroshift_time;
     }
 }
 #endif
@@ -26,6 +26,42 @@
 #    define AUTO_SHIFT_TIMEOUT 175
 #endif
 
+#ifdef AUTO_SHIFT_ADAPTIVE
+// Width in ms of each bin of the per-key hold duration histograms
+#    ifndef AUTO_SHIFT_ADAPTIVE_BIN_WIDTH
+#        define AUTO_SHIFT_ADAPTIVE_BIN_WIDTH 25
+#    endif
+// Number of bins per key, the last one counts every longer hold
+#    ifndef AUTO_SHIFT_ADAPTIVE_BINS
+#        define AUTO_SHIFT_ADAPTIVE_BINS 10
+#    endif
+// Samples a key needs before its learned timeout replaces AUTO_SHIFT_TIMEOUT
+#    ifndef AUTO_SHIFT_ADAPTIVE_MIN_SAMPLES
+#        define AUTO_SHIFT_ADAPTIVE_MIN_SAMPLES 16
+#    endif
+// Samples after which a key's histogram is halved, so old habits fade out
+#    ifndef AUTO_SHIFT_ADAPTIVE_WINDOW
+#        define AUTO_SHIFT_ADAPTIVE_WINDOW 64
+#    endif
+// Share of taps that must be shorter than the learned timeout
+#    ifndef AUTO_SHIFT_ADAPTIVE_PERCENTILE
+#        define AUTO_SHIFT_ADAPTIVE_PERCENTILE 95
+#    endif
+// Added on top of the percentile
+#    ifndef AUTO_SHIFT_ADAPTIVE_MARGIN
+#        define AUTO_SHIFT_ADAPTIVE_MARGIN 10
+#    endif
+#    ifndef AUTO_SHIFT_ADAPTIVE_TIMEOUT_MIN
+#        define AUTO_SHIFT_ADAPTIVE_TIMEOUT_MIN 100
+#    endif
+#    ifndef AUTO_SHIFT_ADAPTIVE_TIMEOUT_MAX
+#        define AUTO_SHIFT_ADAPTIVE_TIMEOUT_MAX 300
+#    endif
+
+// Keys with a learned timeout, KC_A to KC_SLASH
+#    define AUTO_SHIFT_ADAPTIVE_KEYS (KC_SLASH - KC_A + 1)
+#endif
+
 #define IS_RETRO(kc) (IS_QK_MOD_TAP(kc) || IS_QK_LAYER_TAP(kc))
 
 #define DO_GET_AUTOSHIFT_TIMEOUT(keycode, record, ...) record
@@ -58,3 +94,8 @@ void     autoshift_matrix_scan(void);
 bool     get_custom_auto_shifted_key(uint16_t keycode, keyrecord_t *record);
 bool     get_auto_shifted_key(uint16_t keycode, keyrecord_t *record);
 // clang-format on
+
+#ifdef AUTO_SHIFT_ADAPTIVE
+uint16_t get_autoshift_adaptive_timeout(uint16_t keycode);
+void     autoshift_adaptive_reset(void);
+#endif
@@ -447,7 +447,7 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
 
 #ifndef COMBO_NO_TIMER
             /* Don't buffer this combo if its combo term has passed. */
-            if (timer && timer_elapsed(timer) > time) {
+            if (timer && TIMER_DIFF_16(record->event.time, timer) > time) {
                 DISABLE_COMBO(combo);
                 return true;
             } else
@@ -575,10 +575,10 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
 #    ifdef COMBO_STRICT_TIMER
         if (!timer) {
             // timer is set only on the first key
-            timer = timer_read();
+            timer = record->event.time;
         }
 #    else
-        timer = timer_read();
+        timer = record->event.time;
 #    endif
 #endif
 
@@ -611,7 +611,7 @@ void combo_task(void) {
     }
 
 #ifndef COMBO_NO_TIMER
-    if (timer && timer_elapsed(timer) > longest_term) {
+    if (timer && TIMER_DIFF_16(keyboard_event_horizon(), timer) > longest_term) {
         if (combo_buffer_read != combo_buffer_write) {
             apply_combos();
             longest_term = 0;
@@ -0,0 +1,209 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "process_dispatch.h"
+#include "quantum.h"
+#include "progmem.h"
+
+#ifdef BACKLIGHT_ENABLE
+#    include "process_backlight.h"
+#endif
+#ifdef GRAVE_ESC_ENABLE
+#    include "process_grave_esc.h"
+#endif
+#ifdef HAPTIC_ENABLE
+#    include "process_haptic.h"
+#endif
+#ifdef JOYSTICK_ENABLE
+#    include "process_joystick.h"
+#endif
+#ifdef LEADER_ENABLE
+#    include "process_leader.h"
+#endif
+#ifdef LED_MATRIX_ENABLE
+#    include "process_led_matrix.h"
+#endif
+#ifdef MAGIC_ENABLE
+#    include "process_magic.h"
+#endif
+#ifdef MIDI_ENABLE
+#    include "process_midi.h"
+#endif
+#ifdef PROGRAMMABLE_BUTTON_ENABLE
+#    include "process_programmable_button.h"
+#endif
+#if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
+#    include "process_rgb.h"
+#endif
+#ifdef SECURE_ENABLE
+#    include "process_secure.h"
+#endif
+#ifdef TRI_LAYER_ENABLE
+#    include "process_tri_layer.h"
+#endif
+#ifdef UNICODE_COMMON_ENABLE
+#    include "process_unicode_common.h"
+#endif
+
+#ifdef KEY_OVERRIDE_ENABLE
+static bool process_key_override_handler(uint16_t keycode, keyrecord_t *record) {
+    return process_key_override(keycode, record);
+}
+#endif
+
+#if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
+static bool process_rgb_handler(uint16_t keycode, keyrecord_t *record) {
+    return process_rgb(keycode, record);
+}
+#endif
+
+// clang-format off
+
+/* Every handler behind process_record_quantum(), in the order they have always been called in.
+ * Handlers that need to observe all keys come with PROCESS_ALL_KEYCODES, the others only list
+ * the keycodes they act on. The whole table, page masks included, is built by the compiler and
+ * lives in flash. */
+static const process_handler_t process_handlers[] PROGMEM = {
+#if defined(DYNAMIC_MACRO_ENABLE) && !defined(DYNAMIC_MACRO_USER_CALL)
+    // Must run asap to ensure all keypresses are recorded.
+    PROCESS_HANDLER(PROCESS_ALL_KEYCODES, PROCESS_EVENT_ALL, process_dynamic_macro),
+#endif
+#ifdef REPEAT_KEY_ENABLE
+    PROCESS_HANDLER(PROCESS_ALL_KEYCODES, PROCESS_EVENT_ALL, process_last_key),
+    PROCESS_HANDLER(QK_REPEAT_KEY, QK_ALT_REPEAT_KEY, PROCESS_EVENT_ALL, process_repeat_key),
+#endif
+#if defined(AUDIO_ENABLE) && defined(AUDIO_CLICKY)
+    PROCESS_HANDLER(PROCESS_ALL_KEYCODES, PROCESS_EVENT_PRESS, process_clicky),
+#endif
+#ifdef HAPTIC_ENABLE
+    PROCESS_HANDLER(PROCESS_ALL_KEYCODES, PROCESS_EVENT_ALL, process_haptic),
+#endif
+#if defined(VIA_ENABLE)
+    PROCESS_HANDLER(QK_MACRO, QK_MACRO_MAX, PROCESS_EVENT_PRESS, process_record_via),
+#endif
+#if defined(POINTING_DEVICE_ENABLE) && defined(POINTING_DEVICE_AUTO_MOUSE_ENABLE)
+    PROCESS_HANDLER(PROCESS_ALL_KEYCODES, PROCESS_EVENT_ALL, process_auto_mouse),
+#endif
+    PROCESS_HANDLER(PROCESS_ALL_KEYCODES, PROCESS_EVENT_ALL, process_record_kb),
+#if defined(SECURE_ENABLE)
+    PROCESS_HANDLER(PROCESS_ALL_KEYCODES, PROCESS_EVENT_ALL, process_secure),
+#endif
+#if defined(SEQUENCER_ENABLE)
+    PROCESS_HANDLER(QK_SEQUENCER, QK_SEQUENCER_MAX, PROCESS_EVENT_PRESS, process_sequencer),
+#endif
+#if defined(MIDI_ENABLE) && defined(MIDI_ADVANCED)
+    PROCESS_HANDLER(QK_MIDI, QK_MIDI_MAX, PROCESS_EVENT_ALL, process_midi),
+#endif
+#ifdef AUDIO_ENABLE
+    PROCESS_HANDLER(QK_AUDIO, QK_AUDIO_MAX, PROCESS_EVENT_PRESS, process_audio),
+#endif
+#if defined(BACKLIGHT_ENABLE)
+    PROCESS_HANDLER(QK_BACKLIGHT_ON, QK_BACKLIGHT_TOGGLE_BREATHING, PROCESS_EVENT_PRESS, process_backlight),
+#endif
+#if defined(LED_MATRIX_ENABLE)
+    PROCESS_HANDLER(QK_BACKLIGHT_ON, QK_LED_MATRIX_SPEED_DOWN, PROCESS_EVENT_PRESS, process_led_matrix),
+#endif
+#ifdef STENO_ENABLE
+    PROCESS_HANDLER(QK_STENO, QK_STENO_MAX, PROCESS_EVENT_ALL, process_steno),
+#endif
+#if (defined(AUDIO_ENABLE) || (defined(MIDI_ENABLE) && defined(MIDI_BASIC))) && !defined(NO_MUSIC_MODE)
+    PROCESS_HANDLER(PROCESS_ALL_KEYCODES, PROCESS_EVENT_ALL, process_music),
+#endif
+#ifdef CAPS_WORD_ENABLE
+    PROCESS_HANDLER(PROCESS_ALL_KEYCODES, PROCESS_EVENT_ALL, process_caps_word),
+#endif
+#ifdef KEY_OVERRIDE_ENABLE
+    PROCESS_HANDLER(PROCESS_ALL_KEYCODES, PROCESS_EVENT_ALL, process_key_override_handler),
+#endif
+#ifdef TAP_DANCE_ENABLE
+    PROCESS_HANDLER(PROCESS_ALL_KEYCODES, PROCESS_EVENT_ALL, process_tap_dance),
+#endif
+#if defined(UNICODE_COMMON_ENABLE)
+#    if defined(UNICODE_ENABLE) || defined(UNICODEMAP_ENABLE)
+    PROCESS_HANDLER(QK_UNICODE_MODE_NEXT, QK_UNICODE_MODE_EMACS, PROCESS_EVENT_PRESS, process_unicode_common),
+    PROCESS_HANDLER(QK_UNICODE, QK_UNICODE_MAX, PROCESS_EVENT_PRESS, process_unicode_common),
+#    else
+    // UCIS captures every key while active
+    PROCESS_HANDLER(PROCESS_ALL_KEYCODES, PROCESS_EVENT_ALL, process_unicode_common),
+#    endif
+#endif
+#ifdef LEADER_ENABLE
+    PROCESS_HANDLER(PROCESS_ALL_KEYCODES, PROCESS_EVENT_ALL, process_leader),
+#endif
+#ifdef AUTO_SHIFT_ENABLE
+    PROCESS_HANDLER(PROCESS_ALL_KEYCODES, PROCESS_EVENT_ALL, process_auto_shift),
+#endif
+#ifdef DYNAMIC_TAPPING_TERM_ENABLE
+    PROCESS_HANDLER(QK_DYNAMIC_TAPPING_TERM_PRINT, QK_DYNAMIC_TAPPING_TERM_DOWN, PROCESS_EVENT_PRESS, process_dynamic_tapping_term),
+#endif
+#ifdef SPACE_CADET_ENABLE
+    PROCESS_HANDLER(PROCESS_ALL_KEYCODES, PROCESS_EVENT_ALL, process_space_cadet),
+#endif
+#ifdef MAGIC_ENABLE
+    PROCESS_HANDLER(QK_MAGIC, QK_MAGIC_MAX, PROCESS_EVENT_PRESS, process_magic),
+#endif
+#ifdef GRAVE_ESC_ENABLE
+    PROCESS_HANDLER(QK_GRAVE_ESCAPE, QK_GRAVE_ESCAPE, PROCESS_EVENT_ALL, process_grave_esc),
+#endif
+#if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
+    PROCESS_HANDLER(QK_UNDERGLOW_TOGGLE, QK_RGB_MATRIX_SPEED_DOWN, PROCESS_EVENT_ALL, process_rgb_handler),
+#endif
+#ifdef JOYSTICK_ENABLE
+    PROCESS_HANDLER(QK_JOYSTICK, QK_JOYSTICK_MAX, PROCESS_EVENT_ALL, process_joystick),
+#endif
+#ifdef PROGRAMMABLE_BUTTON_ENABLE
+    PROCESS_HANDLER(QK_PROGRAMMABLE_BUTTON, QK_PROGRAMMABLE_BUTTON_MAX, PROCESS_EVENT_ALL, process_programmable_button),
+#endif
+#ifdef AUTOCORRECT_ENABLE
+    PROCESS_HANDLER(PROCESS_ALL_KEYCODES, PROCESS_EVENT_ALL, process_autocorrect),
+#endif
+#ifdef TRI_LAYER_ENABLE
+    PROCESS_HANDLER(QK_TRI_LAYER_LOWER, QK_TRI_LAYER_UPPER, PROCESS_EVENT_ALL, process_tri_layer),
+#endif
+};
+
+// clang-format on
+
+#define PROCESS_HANDLER_COUNT (sizeof(process_handlers) / sizeof(process_handler_t))
+
+_Static_assert(PROCESS_HANDLER_COUNT <= UINT8_MAX, "Too many process handlers");
+
+/* The page mask settles most handlers, only those sharing the keycode's page need their range checked */
+static bool handler_routes(uint16_t keycode, uint8_t index) {
+    if (!(pgm_read_word(&process_handlers[index].pages) & PROCESS_PAGE(keycode))) {
+        return false;
+    }
+    return keycode >= pgm_read_word(&process_handlers[index].first) && keycode <= pgm_read_word(&process_handlers[index].last);
+}
+
+bool process_dispatch(uint16_t keycode, keyrecord_t *record) {
+    const uint8_t event = record->event.pressed ? PROCESS_EVENT_PRESS : PROCESS_EVENT_RELEASE;
+
+    for (uint8_t h = 0; h < PROCESS_HANDLER_COUNT; h++) {
+        if (!handler_routes(keycode, h) || !(pgm_read_byte(&process_handlers[h].events) & event)) {
+            continue;
+        }
+        bool (*process)(uint16_t, keyrecord_t *) = pgm_read_ptr(&process_handlers[h].process);
+        if (!process(keycode, record)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint8_t process_dispatch_count(void) {
+    return PROCESS_HANDLER_COUNT;
+}
+
+process_handler_t process_dispatch_get(uint8_t index) {
+    process_handler_t handler;
+    memcpy_P(&handler, &process_handlers[index], sizeof(process_handler_t));
+    return handler;
+}
+
+bool process_dispatch_routes(uint16_t keycode, uint8_t index) {
+    if (index >= PROCESS_HANDLER_COUNT) {
+        return false;
+    }
+    return handler_routes(keycode, index);
+}
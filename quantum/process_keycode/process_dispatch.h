@@ -0,0 +1,67 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "action.h"
+
+/* Event classes a handler is called for. */
+#define PROCESS_EVENT_PRESS 0x01
+#define PROCESS_EVENT_RELEASE 0x02
+#define PROCESS_EVENT_ALL (PROCESS_EVENT_PRESS | PROCESS_EVENT_RELEASE)
+
+/* Range for handlers that need to see every keycode, e.g. to track state across keys. */
+#define PROCESS_ALL_KEYCODES 0x0000, 0xFFFF
+
+/* The keycode space is indexed in 16 pages of 4096 keycodes, one bit each. */
+#define PROCESS_PAGE(keycode) (1U << ((keycode) >> 12))
+#define PROCESS_PAGES(first, last) ((uint16_t)((0xFFFFU << ((first) >> 12)) & (0xFFFFU >> (15 - ((last) >> 12)))))
+
+/**
+ * \brief Table entry for a handler, computing its page mask at build time.
+ *
+ * Takes `first, last, events, process`, where the range can be given as PROCESS_ALL_KEYCODES.
+ */
+#define PROCESS_HANDLER(...) PROCESS_HANDLER_ENTRY(__VA_ARGS__)
+#define PROCESS_HANDLER_ENTRY(first, last, events, process) \
+    { (first), (last), PROCESS_PAGES(first, last), (events), (process) }
+
+/**
+ * \brief A `process_*` handler, along with the keycodes and events it acts on.
+ *
+ * The handler is only called for keycodes within `first` and `last` (inclusive),
+ * and for the event classes set in `events`. Outside of those it has to behave
+ * as if it returned true without doing anything. `pages` holds the pages the range
+ * touches, so that most handlers can be skipped with a single read.
+ */
+typedef struct {
+    uint16_t first;
+    uint16_t last;
+    uint16_t pages;
+    uint8_t  events;
+    bool (*process)(uint16_t keycode, keyrecord_t *record);
+} process_handler_t;
+
+/**
+ * \brief Run the handlers registered for `keycode`, in registration order.
+ *
+ * \return false as soon as a handler returns false, true otherwise
+ */
+bool process_dispatch(uint16_t keycode, keyrecord_t *record);
+
+/**
+ * \brief Number of registered handlers.
+ */
+uint8_t process_dispatch_count(void);
+
+/**
+ * \brief Copy of the handler registered at `index`.
+ */
+process_handler_t process_dispatch_get(uint8_t index);
+
+/**
+ * \brief Whether `process_dispatch()` would consider the handler at `index` for `keycode`.
+ */
+bool process_dispatch_routes(uint16_t keycode, uint8_t index);
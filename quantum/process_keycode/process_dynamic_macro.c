@@ -21,11 +21,16 @@
 #include "action_layer.h"
 #include "keycodes.h"
 #include "debug.h"
+#include "timer.h"
 #include "wait.h"
 
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
 #endif
+#ifdef DYNAMIC_MACRO_EEPROM_STORAGE
+#    include "eeprom.h"
+#    include "eeconfig.h"
+#endif
 
 // default feedback method
 void dynamic_macro_led_blink(void) {
@@ -82,166 +87,415 @@ __attribute__((weak)) bool dynamic_macro_valid_key_user(uint16_t keycode, keyrec
     return true;
 }
 
-/* Convenience macros used for retrieving the debug info. All of them
- * need a `direction` variable accessible at the call site.
+/* Both macros use the same buffer but read/write on different
+ * ends of it.
+ *
+ * Macro1 is written left-to-right starting from the beginning of
+ * the buffer.
+ *
+ * Macro2 is written right-to-left starting from the end of the
+ * buffer.
+ *
+ *  macro_buffer    macro_length[0]
+ *  v                   v
+ * +------------------------------------------------------------+
+ * |>>>>>> MACRO1 >>>>>>      <<<<<<<<<<<<< MACRO2 <<<<<<<<<<<<<|
+ * +------------------------------------------------------------+
+ *                           ^
+ *                         macro_length[1] (counted from the end)
+ *
+ * During the recording when one macro encounters the end of the
+ * other macro, the recording is stopped. Apart from this, there
+ * are no arbitrary limits for the macros' length in relation to
+ * each other: for example one can either have two medium sized
+ * macros or one long macro and one short macro. Or even one empty
+ * and one using the whole buffer.
+ *
+ * Each macro is a stream of variable length events, which both
+ * macros store in the same logical byte order:
+ *
+ *   header    pressed (7), tap state follows (6), extension follows (5),
+ *             ms since the previous event (4..0, 31 = more follows)
+ *   [tap]     tap.interrupted (4), tap.count (3..0)
+ *   [ext]     event type (2..0), keycode follows (3), row and col follow (4)
+ *   key       row * MATRIX_COLS + col, or row and col
+ *   [keycode] little endian, for events that carry their own keycode
+ *   [delta]   the rest of a long delta, 7 bits per byte, LSB first
+ *
+ * A plain key event takes 2 or 3 bytes instead of a whole keyrecord_t.
  */
-#define DYNAMIC_MACRO_CURRENT_SLOT() (direction > 0 ? 1 : 2)
-#define DYNAMIC_MACRO_CURRENT_LENGTH(BEGIN, POINTER) ((int)(direction * ((POINTER) - (BEGIN))))
-#define DYNAMIC_MACRO_CURRENT_CAPACITY(BEGIN, END2) ((int)(direction * ((END2) - (BEGIN)) + 1))
+#define DYNAMIC_MACRO_HEADER_PRESSED 0x80
+#define DYNAMIC_MACRO_HEADER_TAP 0x40
+#define DYNAMIC_MACRO_HEADER_EXT 0x20
+#define DYNAMIC_MACRO_HEADER_DELTA_MASK 0x1F
+#define DYNAMIC_MACRO_TAP_INTERRUPTED 0x10
+#define DYNAMIC_MACRO_TAP_COUNT_MASK 0x0F
+#define DYNAMIC_MACRO_EXT_TYPE_MASK 0x07
+#define DYNAMIC_MACRO_EXT_KEYCODE 0x08
+#define DYNAMIC_MACRO_EXT_POSITION 0x10
+
+#define DYNAMIC_MACRO_MAX_EVENT_SIZE 10
+
+static uint8_t macro_buffer[DYNAMIC_MACRO_BUFFER_SIZE];
+
+/* Length in bytes of the two macros. */
+static uint16_t macro_length[2] = {0, 0};
+
+/* Length of the macro currently being recorded, and the time of its last event. */
+static uint16_t record_length    = 0;
+static uint16_t record_last_time = 0;
+
+/* 0   - no macro is being recorded right now
+ * 1,2 - either macro 1 or 2 is being recorded */
+static uint8_t macro_id = 0;
+
+/* Macros being played back. Playing a macro from within a macro pushes
+ * it on top, so at most both macros can be in progress at once. */
+typedef struct {
+    uint8_t       id;
+    uint16_t      offset;
+    uint16_t      last_time;
+    layer_state_t saved_layer_state;
+} dynamic_macro_playback_t;
+
+static dynamic_macro_playback_t playback[2];
+static uint8_t                  playback_depth = 0;
+
+#define DYNAMIC_MACRO_DIRECTION(id) ((id) == 1 ? +1 : -1)
 
 /**
- * Start recording of the dynamic macro.
+ * Address of a byte of either macro, counted from that macro's start.
+ */
+static inline uint8_t *macro_byte(uint8_t id, uint16_t offset) {
+    return id == 1 ? &macro_buffer[offset] : &macro_buffer[DYNAMIC_MACRO_BUFFER_SIZE - 1 - offset];
+}
+
+/**
+ * Encode a key event.
  *
- * @param[out] macro_pointer The new macro buffer iterator.
- * @param[in]  macro_buffer  The macro buffer used to initialize macro_pointer.
+ * @param[out] out   At least DYNAMIC_MACRO_MAX_EVENT_SIZE bytes.
+ * @param[in]  record The event to encode.
+ * @param[in]  delta  Time since the previous event.
+ * @return The number of bytes used.
  */
-void dynamic_macro_record_start(keyrecord_t **macro_pointer, keyrecord_t *macro_buffer, int8_t direction) {
-    dprintln("dynamic macro recording: started");
+static uint8_t dynamic_macro_encode(uint8_t *out, keyrecord_t *record, uint16_t delta) {
+    uint8_t  size    = 1;
+    uint8_t  header  = record->event.pressed ? DYNAMIC_MACRO_HEADER_PRESSED : 0;
+    uint8_t  ext     = record->event.type & DYNAMIC_MACRO_EXT_TYPE_MASK;
+    uint16_t keycode = 0;
+    uint8_t  row     = record->event.key.row;
+    uint8_t  col     = record->event.key.col;
+
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+    keycode = record->keycode;
+#endif
+    if (keycode) {
+        ext |= DYNAMIC_MACRO_EXT_KEYCODE;
+    }
+    if (record->event.type != KEY_EVENT || row >= MATRIX_ROWS || col >= MATRIX_COLS || row * MATRIX_COLS + col > UINT8_MAX) {
+        ext |= DYNAMIC_MACRO_EXT_POSITION;
+    }
 
-    dynamic_macro_record_start_kb(direction);
+#ifndef NO_ACTION_TAPPING
+    if (record->tap.count || record->tap.interrupted) {
+        header |= DYNAMIC_MACRO_HEADER_TAP;
+        out[size++] = (record->tap.interrupted ? DYNAMIC_MACRO_TAP_INTERRUPTED : 0) | record->tap.count;
+    }
+#endif
+    if (ext != KEY_EVENT) {
+        header |= DYNAMIC_MACRO_HEADER_EXT;
+        out[size++] = ext;
+    }
+    if (ext & DYNAMIC_MACRO_EXT_POSITION) {
+        out[size++] = row;
+        out[size++] = col;
+    } else {
+        out[size++] = row * MATRIX_COLS + col;
+    }
+    if (keycode) {
+        out[size++] = keycode & 0xFF;
+        out[size++] = keycode >> 8;
+    }
+    if (delta < DYNAMIC_MACRO_HEADER_DELTA_MASK) {
+        header |= delta;
+    } else {
+        header |= DYNAMIC_MACRO_HEADER_DELTA_MASK;
+        delta -= DYNAMIC_MACRO_HEADER_DELTA_MASK;
+        do {
+            out[size++] = (delta & 0x7F) | (delta > 0x7F ? 0x80 : 0);
+            delta >>= 7;
+        } while (delta);
+    }
+    out[0] = header;
 
-    clear_keyboard();
-    layer_clear();
-    *macro_pointer = macro_buffer;
+    return size;
 }
 
 /**
- * Play the dynamic macro.
+ * Decode the event stored at `offset` of a macro.
  *
- * @param macro_buffer[in] The beginning of the macro buffer being played.
- * @param macro_end[in]    The element after the last macro buffer element.
- * @param direction[in]    Either +1 or -1, which way to iterate the buffer.
+ * @return The offset of the following event.
  */
-void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_t direction) {
-    dprintf("dynamic macro: slot %d playback\n", DYNAMIC_MACRO_CURRENT_SLOT());
+static uint16_t dynamic_macro_decode(uint8_t id, uint16_t offset, keyrecord_t *record, uint16_t *delta) {
+    uint8_t header = *macro_byte(id, offset++);
+    uint8_t tap    = (header & DYNAMIC_MACRO_HEADER_TAP) ? *macro_byte(id, offset++) : 0;
+    uint8_t ext    = (header & DYNAMIC_MACRO_HEADER_EXT) ? *macro_byte(id, offset++) : KEY_EVENT;
+
+    *record = (keyrecord_t){0};
+
+    record->event.pressed = header & DYNAMIC_MACRO_HEADER_PRESSED;
+    record->event.type    = ext & DYNAMIC_MACRO_EXT_TYPE_MASK;
+    if (ext & DYNAMIC_MACRO_EXT_POSITION) {
+        record->event.key.row = *macro_byte(id, offset++);
+        record->event.key.col = *macro_byte(id, offset++);
+    } else {
+        uint8_t index         = *macro_byte(id, offset++);
+        record->event.key.row = index / MATRIX_COLS;
+        record->event.key.col = index % MATRIX_COLS;
+    }
+    if (ext & DYNAMIC_MACRO_EXT_KEYCODE) {
+        uint16_t keycode = *macro_byte(id, offset++);
+        keycode |= *macro_byte(id, offset++) << 8;
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+        record->keycode = keycode;
+#endif
+    }
+#ifndef NO_ACTION_TAPPING
+    record->tap.interrupted = tap & DYNAMIC_MACRO_TAP_INTERRUPTED;
+    record->tap.count       = tap & DYNAMIC_MACRO_TAP_COUNT_MASK;
+#else
+    (void)tap;
+#endif
 
-    layer_state_t saved_layer_state = layer_state;
+    *delta = header & DYNAMIC_MACRO_HEADER_DELTA_MASK;
+    if (*delta == DYNAMIC_MACRO_HEADER_DELTA_MASK) {
+        uint8_t shift = 0;
+        uint8_t byte;
+        do {
+            byte = *macro_byte(id, offset++);
+            *delta += (uint16_t)(byte & 0x7F) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+    }
 
-    clear_keyboard();
-    layer_clear();
+    return offset;
+}
+
+#ifdef DYNAMIC_MACRO_EEPROM_STORAGE
+#    ifndef DYNAMIC_MACRO_EEPROM_ADDR
+#        if defined(VIA_ENABLE) || defined(DYNAMIC_KEYMAP_ENABLE)
+#            error "DYNAMIC_MACRO_EEPROM_ADDR has to be set when the dynamic keymap is enabled, as both default to the end of EECONFIG"
+#        endif
+#        define DYNAMIC_MACRO_EEPROM_ADDR (EECONFIG_SIZE)
+#    endif
+#    define DYNAMIC_MACRO_EEPROM_MAGIC 0xD3AC
+
+typedef struct PACKED {
+    uint16_t magic;
+    uint16_t buffer_size;
+    uint16_t length[2];
+} dynamic_macro_eeprom_header_t;
+
+static void dynamic_macro_save(void) {
+    dynamic_macro_eeprom_header_t header = {
+        .magic       = DYNAMIC_MACRO_EEPROM_MAGIC,
+        .buffer_size = DYNAMIC_MACRO_BUFFER_SIZE,
+        .length      = {macro_length[0], macro_length[1]},
+    };
+    uint8_t *addr = (uint8_t *)(DYNAMIC_MACRO_EEPROM_ADDR);
+
+    // only the bytes that actually changed get written
+    eeprom_update_block(macro_buffer, addr + sizeof(header), DYNAMIC_MACRO_BUFFER_SIZE);
+    eeprom_update_block(&header, addr, sizeof(header));
+}
+
+static void dynamic_macro_load(void) {
+    dynamic_macro_eeprom_header_t header;
+    uint8_t                      *addr = (uint8_t *)(DYNAMIC_MACRO_EEPROM_ADDR);
 
-    while (macro_buffer != macro_end) {
-        process_record(macro_buffer);
-        macro_buffer += direction;
-#ifdef DYNAMIC_MACRO_DELAY
-        wait_ms(DYNAMIC_MACRO_DELAY);
+    eeprom_read_block(&header, addr, sizeof(header));
+    if (header.magic != DYNAMIC_MACRO_EEPROM_MAGIC || header.buffer_size != DYNAMIC_MACRO_BUFFER_SIZE || header.length[0] + header.length[1] > DYNAMIC_MACRO_BUFFER_SIZE) {
+        dprintln("dynamic macro: no stored macros");
+        return;
+    }
+
+    macro_length[0] = header.length[0];
+    macro_length[1] = header.length[1];
+    eeprom_read_block(macro_buffer, addr + sizeof(header), DYNAMIC_MACRO_BUFFER_SIZE);
+}
 #endif
+
+/**
+ * Start recording of the dynamic macro.
+ */
+static void dynamic_macro_record_start(uint8_t id) {
+    int8_t direction = DYNAMIC_MACRO_DIRECTION(id);
+
+    for (uint8_t i = 0; i < playback_depth; i++) {
+        if (playback[i].id == id) {
+            dprintln("dynamic macro: ignoring recording of a macro that is being played");
+            return;
+        }
     }
 
+    dprintln("dynamic macro recording: started");
+
+    dynamic_macro_record_start_kb(direction);
+
     clear_keyboard();
+    layer_clear();
+    macro_id      = id;
+    record_length = 0;
+}
 
-    layer_state_set(saved_layer_state);
+/**
+ * Start playing the dynamic macro. The events are sent from
+ * dynamic_macro_task(), one at a time.
+ */
+static void dynamic_macro_play(uint8_t id) {
+    dprintf("dynamic macro: slot %d playback\n", id);
 
-    dynamic_macro_play_kb(direction);
+    for (uint8_t i = 0; i < playback_depth; i++) {
+        if (playback[i].id == id) {
+            dprintln("dynamic macro: ignoring recursive playback");
+            return;
+        }
+    }
+
+    dynamic_macro_playback_t *current = &playback[playback_depth++];
+
+    current->id                = id;
+    current->offset            = 0;
+    current->last_time         = timer_read();
+    current->saved_layer_state = layer_state;
+
+    clear_keyboard();
+    layer_clear();
 }
 
 /**
  * Record a single key in a dynamic macro.
- *
- * @param macro_buffer[in] The start of the used macro buffer.
- * @param macro_pointer[in,out] The current buffer position.
- * @param macro2_end[in] The end of the other macro.
- * @param direction[in]  Either +1 or -1, which way to iterate the buffer.
- * @param record[in]     The current keypress.
  */
-void dynamic_macro_record_key(keyrecord_t *macro_buffer, keyrecord_t **macro_pointer, keyrecord_t *macro2_end, int8_t direction, keyrecord_t *record) {
+static void dynamic_macro_record_key(keyrecord_t *record) {
+    int8_t direction = DYNAMIC_MACRO_DIRECTION(macro_id);
+
     /* If we've just started recording, ignore all the key releases. */
-    if (!record->event.pressed && *macro_pointer == macro_buffer) {
+    if (!record->event.pressed && record_length == 0) {
         dprintln("dynamic macro: ignoring a leading key-up event");
         return;
     }
 
-    /* The other end of the other macro is the last buffer element it
-     * is safe to use before overwriting the other macro.
-     */
-    if (*macro_pointer - direction != macro2_end) {
-        **macro_pointer = *record;
-        *macro_pointer += direction;
+    uint8_t  event[DYNAMIC_MACRO_MAX_EVENT_SIZE];
+    uint16_t delta = record_length ? TIMER_DIFF_16(record->event.time, record_last_time) : 0;
+    uint8_t  size  = dynamic_macro_encode(event, record, delta);
+
+    /* Stop short of the start of the other macro. */
+    if (record_length + size + macro_length[2 - macro_id] <= DYNAMIC_MACRO_BUFFER_SIZE) {
+        for (uint8_t i = 0; i < size; i++) {
+            *macro_byte(macro_id, record_length + i) = event[i];
+        }
+        record_length += size;
+        record_last_time = record->event.time;
     }
     dynamic_macro_record_key_kb(direction, record);
 
-    dprintf("dynamic macro: slot %d length: %d/%d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, *macro_pointer), DYNAMIC_MACRO_CURRENT_CAPACITY(macro_buffer, macro2_end));
+    dprintf("dynamic macro: slot %d length: %d/%d bytes\n", macro_id, record_length, DYNAMIC_MACRO_BUFFER_SIZE - macro_length[2 - macro_id]);
 }
 
 /**
  * End recording of the dynamic macro. Essentially just update the
- * pointer to the end of the macro.
+ * length of the macro.
  */
-void dynamic_macro_record_end(keyrecord_t *macro_buffer, keyrecord_t *macro_pointer, int8_t direction, keyrecord_t **macro_end) {
+static void dynamic_macro_record_end(void) {
+    int8_t direction = DYNAMIC_MACRO_DIRECTION(macro_id);
+
     dynamic_macro_record_end_kb(direction);
 
     /* Do not save the keys being held when stopping the recording,
      * i.e. the keys used to access the layer DM_RSTP is on.
      */
-    while (macro_pointer != macro_buffer && (macro_pointer - direction)->event.pressed) {
-        dprintln("dynamic macro: trimming a trailing key-down event");
-        macro_pointer -= direction;
+    uint16_t    offset = 0;
+    uint16_t    end    = 0;
+    keyrecord_t record;
+    uint16_t    delta;
+    while (offset < record_length) {
+        offset = dynamic_macro_decode(macro_id, offset, &record, &delta);
+        if (!record.event.pressed) {
+            end = offset;
+        }
+    }
+    if (end != record_length) {
+        dprintln("dynamic macro: trimming trailing key-down events");
     }
 
-    dprintf("dynamic macro: slot %d saved, length: %d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, macro_pointer));
+    dprintf("dynamic macro: slot %d saved, length: %d bytes\n", macro_id, end);
 
-    *macro_end = macro_pointer;
+    macro_length[macro_id - 1] = end;
+
+#ifdef DYNAMIC_MACRO_EEPROM_STORAGE
+    dynamic_macro_save();
+#endif
 }
 
-/* Both macros use the same buffer but read/write on different
- * ends of it.
- *
- * Macro1 is written left-to-right starting from the beginning of
- * the buffer.
- *
- * Macro2 is written right-to-left starting from the end of the
- * buffer.
- *
- * &macro_buffer   macro_end
- *  v                   v
- * +------------------------------------------------------------+
- * |>>>>>> MACRO1 >>>>>>      <<<<<<<<<<<<< MACRO2 <<<<<<<<<<<<<|
- * +------------------------------------------------------------+
- *                           ^                                 ^
- *                         r_macro_end                  r_macro_buffer
- *
- * During the recording when one macro encounters the end of the
- * other macro, the recording is stopped. Apart from this, there
- * are no arbitrary limits for the macros' length in relation to
- * each other: for example one can either have two medium sized
- * macros or one long macro and one short macro. Or even one empty
- * and one using the whole buffer.
+/**
+ * If a dynamic macro is currently being recorded, stop recording.
+ */
+void dynamic_macro_stop_recording(void) {
+    if (macro_id != 0) {
+        dynamic_macro_record_end();
+    }
+    macro_id = 0;
+}
+
+bool dynamic_macro_is_playing(void) {
+    return playback_depth > 0;
+}
+
+void dynamic_macro_init(void) {
+#ifdef DYNAMIC_MACRO_EEPROM_STORAGE
+    dynamic_macro_load();
+#endif
+}
+
+/**
+ * Send the next event of the macro being played back, once it is due.
  */
-static keyrecord_t macro_buffer[DYNAMIC_MACRO_SIZE];
+void dynamic_macro_task(void) {
+    if (playback_depth == 0) {
+        return;
+    }
 
-/* Pointer to the first buffer element after the first macro.
- * Initially points to the very beginning of the buffer since the
- * macro is empty. */
-static keyrecord_t *macro_end = macro_buffer;
+    dynamic_macro_playback_t *current = &playback[playback_depth - 1];
 
-/* The other end of the macro buffer. Serves as the beginning of
- * the second macro. */
-static keyrecord_t *const r_macro_buffer = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
+    if (current->offset >= macro_length[current->id - 1]) {
+        int8_t direction = DYNAMIC_MACRO_DIRECTION(current->id);
 
-/* Like macro_end but for the second macro. */
-static keyrecord_t *r_macro_end = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
+        clear_keyboard();
+        layer_state_set(current->saved_layer_state);
+        playback_depth--;
 
-/* A persistent pointer to the current macro position (iterator)
- * used during the recording. */
-static keyrecord_t *macro_pointer = NULL;
+        dynamic_macro_play_kb(direction);
+        return;
+    }
 
-/* 0   - no macro is being recorded right now
- * 1,2 - either macro 1 or 2 is being recorded */
-static uint8_t macro_id = 0;
+    keyrecord_t record;
+    uint16_t    delta;
+    uint16_t    next = dynamic_macro_decode(current->id, current->offset, &record, &delta);
 
-/**
- * If a dynamic macro is currently being recorded, stop recording.
- */
-void dynamic_macro_stop_recording(void) {
-    switch (macro_id) {
-        case 1:
-            dynamic_macro_record_end(macro_buffer, macro_pointer, +1, &macro_end);
-            break;
-        case 2:
-            dynamic_macro_record_end(r_macro_buffer, macro_pointer, -1, &r_macro_end);
-            break;
+#if defined(DYNAMIC_MACRO_DELAY)
+    delta = current->offset ? DYNAMIC_MACRO_DELAY : 0;
+#elif !defined(DYNAMIC_MACRO_REALTIME_PLAYBACK)
+    delta = 0;
+#endif
+    if (timer_elapsed(current->last_time) < delta) {
+        return;
     }
-    macro_id = 0;
+
+    current->offset    = next;
+    current->last_time = timer_read();
+
+    record.event.time = current->last_time;
+    process_record(&record);
 }
 
 /* Handle the key events related to the dynamic macros.
@@ -252,18 +506,16 @@ bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
         if (!record->event.pressed) {
             switch (keycode) {
                 case QK_DYNAMIC_MACRO_RECORD_START_1:
-                    dynamic_macro_record_start(&macro_pointer, macro_buffer, +1);
-                    macro_id = 1;
+                    dynamic_macro_record_start(1);
                     return false;
                 case QK_DYNAMIC_MACRO_RECORD_START_2:
-                    dynamic_macro_record_start(&macro_pointer, r_macro_buffer, -1);
-                    macro_id = 2;
+                    dynamic_macro_record_start(2);
                     return false;
                 case QK_DYNAMIC_MACRO_PLAY_1:
-                    dynamic_macro_play(macro_buffer, macro_end, +1);
+                    dynamic_macro_play(1);
                     return false;
                 case QK_DYNAMIC_MACRO_PLAY_2:
-                    dynamic_macro_play(r_macro_buffer, r_macro_end, -1);
+                    dynamic_macro_play(2);
                     return false;
             }
         }
@@ -289,14 +541,7 @@ bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
             default:
                 if (dynamic_macro_valid_key_kb(keycode, record)) {
                     /* Store the key in the macro buffer and process it normally. */
-                    switch (macro_id) {
-                        case 1:
-                            dynamic_macro_record_key(macro_buffer, &macro_pointer, r_macro_end, +1, record);
-                            break;
-                        case 2:
-                            dynamic_macro_record_key(r_macro_buffer, &macro_pointer, macro_end, -1, record);
-                            break;
-                    }
+                    dynamic_macro_record_key(record);
                 }
                 return true;
                 break;
@@ -22,10 +22,12 @@
 #include <stdbool.h>
 #include "action.h"
 
-/* May be overridden with a custom value. Be aware that the effective
- * macro length is half of this value: each keypress is recorded twice
- * because of the down-event and up-event. This is not a bug, it's the
- * intended behavior.
+/* May be overridden with a custom value. This is the number of
+ * keyrecord_t the macro buffer has room for, which older versions
+ * stored verbatim; the actual buffer holds DYNAMIC_MACRO_BUFFER_SIZE
+ * bytes of compactly encoded events instead, so it fits about three
+ * to four times as many events in the same amount of RAM. Each
+ * keypress is recorded twice because of the down-event and up-event.
  *
  * Usually it should be fine to set the macro size to at least 256 but
  * there have been reports of it being too much in some users' cases,
@@ -35,6 +37,11 @@
 #    define DYNAMIC_MACRO_SIZE 128
 #endif
 
+/* Size of the macro buffer in bytes, shared by both macros. */
+#ifndef DYNAMIC_MACRO_BUFFER_SIZE
+#    define DYNAMIC_MACRO_BUFFER_SIZE (DYNAMIC_MACRO_SIZE * sizeof(keyrecord_t))
+#endif
+
 void dynamic_macro_led_blink(void);
 bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record);
 bool dynamic_macro_record_start_kb(int8_t direction);
@@ -48,3 +55,6 @@ bool dynamic_macro_record_end_user(int8_t direction);
 bool dynamic_macro_valid_key_kb(uint16_t keycode, keyrecord_t *record);
 bool dynamic_macro_valid_key_user(uint16_t keycode, keyrecord_t *record);
 void dynamic_macro_stop_recording(void);
+bool dynamic_macro_is_playing(void);
+void dynamic_macro_init(void);
+void dynamic_macro_task(void);
@@ -35,6 +35,38 @@ static uint8_t chord[MAX_STROKE_SIZE] = {0};
 // `n_pressed_keys` would be set to 2 because there are only two keys currently being pressed down.
 static int8_t n_pressed_keys = 0;
 
+#ifdef STENO_CHORD_FIRST_UP
+// Steno keys currently held down, indexed by `keycode - QK_STENO`.
+static uint8_t held_keys[(STN__MAX - STN__MIN + 8) / 8] = {0};
+// Whether the chord was sent on the first release, while some of its keys are still held.
+static bool chord_sent = false;
+#endif
+
+#ifdef VIRTSER_ENABLE
+#    ifndef STENO_CHORD_QUEUE_SIZE
+#        define STENO_CHORD_QUEUE_SIZE 8
+#    endif
+// Bytes handed to the virtual serial port at once, less than its endpoint takes
+#    ifndef STENO_TRANSFER_SIZE
+#        define STENO_TRANSFER_SIZE 15
+#    endif
+
+#    define STENO_PACKET_SIZE (MAX_STROKE_SIZE + 1)
+
+// steno_task() sends whole chords only, a transfer smaller than one would never go out
+_Static_assert(STENO_TRANSFER_SIZE >= STENO_PACKET_SIZE, "STENO_TRANSFER_SIZE must hold at least one steno packet");
+
+typedef struct {
+    uint8_t length;
+    uint8_t data[STENO_PACKET_SIZE];
+} steno_packet_t;
+
+// Completed chords waiting to be sent by steno_task()
+static steno_packet_t steno_queue[STENO_CHORD_QUEUE_SIZE];
+static uint8_t        steno_queue_head  = 0;
+static uint8_t        steno_queue_count = 0;
+#endif // VIRTSER_ENABLE
+
 #ifdef STENO_ENABLE_ALL
 static steno_mode_t mode;
 #elif defined(STENO_ENABLE_GEMINI)
@@ -50,12 +82,11 @@ static inline void steno_clear_chord(void) {
 #ifdef STENO_ENABLE_GEMINI
 
 #    ifdef VIRTSER_ENABLE
-void send_steno_chord_gemini(void) {
+static void pack_steno_chord_gemini(steno_packet_t *packet) {
+    memcpy(packet->data, chord, GEMINI_STROKE_SIZE);
     // Set MSB to 1 to indicate the start of packet
-    chord[0] |= 0x80;
-    for (uint8_t i = 0; i < GEMINI_STROKE_SIZE; ++i) {
-        virtser_send(chord[i]);
-    }
+    packet->data[0] |= 0x80;
+    packet->length = GEMINI_STROKE_SIZE;
 }
 #    else
 #        pragma message "VIRTSER_ENABLE = yes is required for Gemini PR to work properly out of the box!"
@@ -92,19 +123,20 @@ bool add_gemini_key_to_chord(uint8_t key) {
 static const uint8_t boltmap[64] PROGMEM = {TXB_NUL, TXB_NUM, TXB_NUM, TXB_NUM, TXB_NUM, TXB_NUM, TXB_NUM, TXB_S_L, TXB_S_L, TXB_T_L, TXB_K_L, TXB_P_L, TXB_W_L, TXB_H_L, TXB_R_L, TXB_A_L, TXB_O_L, TXB_STR, TXB_STR, TXB_NUL, TXB_NUL, TXB_NUL, TXB_STR, TXB_STR, TXB_E_R, TXB_U_R, TXB_F_R, TXB_R_R, TXB_P_R, TXB_B_R, TXB_L_R, TXB_G_R, TXB_T_R, TXB_S_R, TXB_D_R, TXB_NUM, TXB_NUM, TXB_NUM, TXB_NUM, TXB_NUM, TXB_NUM, TXB_Z_R};
 
 #    ifdef VIRTSER_ENABLE
-static void send_steno_chord_bolt(void) {
+static void pack_steno_chord_bolt(steno_packet_t *packet) {
+    packet->length = 0;
     for (uint8_t i = 0; i < BOLT_STROKE_SIZE; ++i) {
         // TX Bolt uses variable length packets where each byte corresponds to a bit array of certain keys.
         // If a user chorded the keys of the first group with keys of the last group, for example, there
         // would be bytes of 0x00 in `chord` for the middle groups which we mustn't send.
         if (chord[i]) {
-            virtser_send(chord[i]);
+            packet->data[packet->length++] = chord[i];
         }
     }
     // Sending a null packet is not always necessary, but it is simpler and more reliable
     // to unconditionally send it every time instead of keeping track of more states and
     // creating more branches in the execution of the program.
-    virtser_send(0);
+    packet->data[packet->length++] = 0;
 }
 #    else
 #        pragma message "VIRTSER_ENABLE = yes is required for TX Bolt to work properly out of the box!"
@@ -126,6 +158,94 @@ static const uint16_t combinedmap_first[] PROGMEM  = {STN_S1, STN_TL, STN_PL, ST
 static const uint16_t combinedmap_second[] PROGMEM = {STN_S2, STN_KL, STN_WL, STN_RL, STN_RR, STN_BR, STN_GR, STN_SR, STN_ZR, STN_O, STN_U};
 #endif
 
+#ifdef VIRTSER_ENABLE
+void steno_task(void) {
+    uint8_t buffer[STENO_CHORD_QUEUE_SIZE * STENO_PACKET_SIZE];
+
+    while (steno_queue_count > 0) {
+        // Batch as many whole chords as fit into one transfer
+        uint8_t length = 0;
+        uint8_t chords = 0;
+        for (uint8_t i = 0; i < steno_queue_count; i++) {
+            steno_packet_t *packet = &steno_queue[(steno_queue_head + i) % STENO_CHORD_QUEUE_SIZE];
+            if (length + packet->length > STENO_TRANSFER_SIZE) {
+                break;
+            }
+            memcpy(&buffer[length], packet->data, packet->length);
+            length += packet->length;
+            chords++;
+        }
+
+        if (!virtser_send_buffer(buffer, length)) {
+            // Not ready for more yet, leave the rest for the next task
+            return;
+        }
+        steno_queue_head = (steno_queue_head + chords) % STENO_CHORD_QUEUE_SIZE;
+        steno_queue_count -= chords;
+    }
+}
+
+static void steno_queue_chord(void) {
+    if (steno_queue_count == STENO_CHORD_QUEUE_SIZE) {
+        steno_task();
+    }
+    if (steno_queue_count == STENO_CHORD_QUEUE_SIZE) {
+        // The host isn't reading, so the oldest chord goes
+        steno_queue_head = (steno_queue_head + 1) % STENO_CHORD_QUEUE_SIZE;
+        steno_queue_count--;
+    }
+
+    steno_packet_t *packet = &steno_queue[(steno_queue_head + steno_queue_count) % STENO_CHORD_QUEUE_SIZE];
+    switch (mode) {
+#    ifdef STENO_ENABLE_BOLT
+        case STENO_MODE_BOLT:
+            pack_steno_chord_bolt(packet);
+            break;
+#    endif // STENO_ENABLE_BOLT
+#    ifdef STENO_ENABLE_GEMINI
+        case STENO_MODE_GEMINI:
+            pack_steno_chord_gemini(packet);
+            break;
+#    endif // STENO_ENABLE_GEMINI
+        default:
+            return;
+    }
+    steno_queue_count++;
+}
+#else
+void steno_task(void) {}
+#endif // VIRTSER_ENABLE
+
+static bool add_key_to_chord(uint8_t key) {
+    switch (mode) {
+#ifdef STENO_ENABLE_BOLT
+        case STENO_MODE_BOLT:
+            add_bolt_key_to_chord(key);
+            return true;
+#endif // STENO_ENABLE_BOLT
+#ifdef STENO_ENABLE_GEMINI
+        case STENO_MODE_GEMINI:
+            add_gemini_key_to_chord(key);
+            return true;
+#endif // STENO_ENABLE_GEMINI
+        default:
+            return false;
+    }
+}
+
+#ifdef STENO_CHORD_FIRST_UP
+// Starts the next chord from the keys that are still held after the previous one was sent
+static void steno_restart_chord(void) {
+    steno_clear_chord();
+    for (uint8_t key = 0; key <= STN__MAX - STN__MIN; key++) {
+        if (held_keys[key / 8] & (1 << (key % 8))) {
+            add_key_to_chord(key);
+        }
+    }
+    chord_sent = false;
+}
+#endif // STENO_CHORD_FIRST_UP
+
 #ifdef STENO_ENABLE_ALL
 void steno_init(void) {
     mode = eeprom_read_byte(EECONFIG_STENOMODE);
@@ -192,52 +312,51 @@ bool process_steno(uint16_t keycode, keyrecord_t *record) {
         case STN__MIN ... STN__MAX:
             if (record->event.pressed) {
                 n_pressed_keys++;
-                switch (mode) {
-#ifdef STENO_ENABLE_BOLT
-                    case STENO_MODE_BOLT:
-                        add_bolt_key_to_chord(keycode - QK_STENO);
-                        break;
-#endif // STENO_ENABLE_BOLT
-#ifdef STENO_ENABLE_GEMINI
-                    case STENO_MODE_GEMINI:
-                        add_gemini_key_to_chord(keycode - QK_STENO);
-                        break;
-#endif // STENO_ENABLE_GEMINI
-                    default:
-                        return false;
+#ifdef STENO_CHORD_FIRST_UP
+                if (chord_sent) {
+                    steno_restart_chord();
+                }
+                held_keys[(keycode - QK_STENO) / 8] |= 1 << ((keycode - QK_STENO) % 8);
+#endif
+                if (!add_key_to_chord(keycode - QK_STENO)) {
+                    return false;
                 }
                 if (!post_process_steno_user(keycode, record, mode, chord, n_pressed_keys)) {
                     return false;
                 }
             } else { // is released
                 n_pressed_keys--;
+#ifdef STENO_CHORD_FIRST_UP
+                held_keys[(keycode - QK_STENO) / 8] &= ~(1 << ((keycode - QK_STENO) % 8));
+#endif
                 if (!post_process_steno_user(keycode, record, mode, chord, n_pressed_keys)) {
                     return false;
                 }
+#ifdef STENO_CHORD_FIRST_UP
+                if (n_pressed_keys < 0) {
+                    n_pressed_keys = 0;
+                }
+                if (chord_sent) {
+                    // Already sent when the first key of the chord came up
+                    return false;
+                }
+                // Send now, the keys still held down start the next chord if more are pressed
+                chord_sent = n_pressed_keys > 0;
+#else
                 if (n_pressed_keys > 0) {
                     // User hasn't released all keys yet,
                     // so the chord cannot be sent
                     return false;
                 }
                 n_pressed_keys = 0;
+#endif
                 if (!send_steno_chord_user(mode, chord)) {
                     steno_clear_chord();
                     return false;
                 }
-                switch (mode) {
-#if defined(STENO_ENABLE_BOLT) && defined(VIRTSER_ENABLE)
-                    case STENO_MODE_BOLT:
-                        send_steno_chord_bolt();
-                        break;
-#endif // STENO_ENABLE_BOLT && VIRTSER_ENABLE
-#if defined(STENO_ENABLE_GEMINI) && defined(VIRTSER_ENABLE)
-                    case STENO_MODE_GEMINI:
-                        send_steno_chord_gemini();
-                        break;
-#endif // STENO_ENABLE_GEMINI && VIRTSER_ENABLE
-                    default:
-                        break;
-                }
+#ifdef VIRTSER_ENABLE
+                steno_queue_chord();
+#endif
                 steno_clear_chord();
             }
             break;
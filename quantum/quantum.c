@@ -15,63 +15,20 @@
  */
 
 #include "quantum.h"
-
-#ifdef BACKLIGHT_ENABLE
-#    include "process_backlight.h"
-#endif
+#include "process_dispatch.h"
 
 #ifdef BLUETOOTH_ENABLE
 #    include "outputselect.h"
 #endif
 
-#ifdef GRAVE_ESC_ENABLE
-#    include "process_grave_esc.h"
-#endif
-
-#ifdef HAPTIC_ENABLE
-#    include "process_haptic.h"
-#endif
-
-#ifdef JOYSTICK_ENABLE
-#    include "process_joystick.h"
-#endif
-
-#ifdef LEADER_ENABLE
-#    include "process_leader.h"
-#endif
-
-#ifdef LED_MATRIX_ENABLE
-#    include "process_led_matrix.h"
-#endif
-
-#ifdef MAGIC_ENABLE
-#    include "process_magic.h"
-#endif
-
 #ifdef MIDI_ENABLE
 #    include "process_midi.h"
 #endif
 
-#ifdef PROGRAMMABLE_BUTTON_ENABLE
-#    include "process_programmable_button.h"
-#endif
-
-#if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
-#    include "process_rgb.h"
-#endif
-
 #ifdef SECURE_ENABLE
 #    include "process_secure.h"
 #endif
 
-#ifdef TRI_LAYER_ENABLE
-#    include "process_tri_layer.h"
-#endif
-
-#ifdef UNICODE_COMMON_ENABLE
-#    include "process_unicode_common.h"
-#endif
-
 #ifdef AUDIO_ENABLE
 #    ifndef GOODBYE_SONG
 #        define GOODBYE_SONG SONG(GOODBYE_SOUND)
@@ -210,14 +167,74 @@ void soft_reset_keyboard(void) {
     mcu_reset();
 }
 
-/* Convert record into usable keycode via the contained event. */
+#if !defined(NO_ACTION_LAYER) && !defined(STRICT_LAYER_RELEASE)
+/* Whether the lookup goes through the source layer cache rather than the active layers */
+#    define LOOKUP_READS_LAYER_CACHE(event, update_layer_cache) (!disable_action_cache && (!(event).pressed || !(update_layer_cache)))
+#else
+#    define LOOKUP_READS_LAYER_CACHE(event, update_layer_cache) false
+#endif
+
+/* Look the keycode for an event up in the keymap, along with the layer it is on.
+ * Checks the layer cache to ensure that it retains the correct keycode after a
+ * layer change, if the key is still pressed.
+ */
+static uint16_t lookup_event_keycode(keyevent_t event, bool update_layer_cache, uint8_t *layer) {
+#if !defined(NO_ACTION_LAYER) && !defined(STRICT_LAYER_RELEASE)
+    if (LOOKUP_READS_LAYER_CACHE(event, update_layer_cache)) {
+        *layer = read_source_layers_cache(event.key);
+        return keymap_key_to_keycode(*layer, event.key);
+    }
+    uint16_t keycode = layer_switch_get_keycode(event.key, layer);
+    if (!disable_action_cache) {
+        update_source_layers_cache(event.key, *layer);
+    }
+    return keycode;
+#else
+    return layer_switch_get_keycode(event.key, layer);
+#endif
+}
+
+/* Convert record into usable keycode via the contained event.
+ *
+ * The keymap is only looked up once per event, the result is kept in the
+ * record. It is reused as long as nothing that affects the lookup changed,
+ * and looked up again otherwise, e.g. for a press replayed from the tapping
+ * waiting buffer once a layer tap turned into a hold.
+ */
 uint16_t get_record_keycode(keyrecord_t *record, bool update_layer_cache) {
 #if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
     if (record->keycode) {
         return record->keycode;
     }
 #endif
-    return get_event_keycode(record->event, update_layer_cache);
+#if !defined(NO_ACTION_LAYER) && !defined(STRICT_LAYER_RELEASE)
+    if (disable_action_cache) {
+        uint8_t layer;
+        return lookup_event_keycode(record->event, update_layer_cache, &layer);
+    }
+#endif
+    uint16_t generation  = keymap_lookup_generation();
+    bool     reads_cache = LOOKUP_READS_LAYER_CACHE(record->event, update_layer_cache);
+
+    if (record->lookup.generation == generation) {
+        return record->lookup.keycode;
+    }
+#if !defined(NO_ACTION_LAYER) && !defined(STRICT_LAYER_RELEASE)
+    // Layer changes don't matter to lookups through the layer cache, only whether it still points at the same layer
+    if (reads_cache && record->lookup.generation && record->lookup.layer == read_source_layers_cache(record->event.key)) {
+        return record->lookup.keycode;
+    }
+#endif
+
+    uint8_t  layer;
+    uint16_t keycode = lookup_event_keycode(record->event, update_layer_cache, &layer);
+    // A press looked up through the layer cache may not match what processing the press resolves to
+    if (!record->event.pressed || !reads_cache) {
+        record->lookup.keycode    = keycode;
+        record->lookup.layer      = layer;
+        record->lookup.generation = generation;
+    }
+    return keycode;
 }
 
 /* Convert event into usable keycode. Checks the layer cache to ensure that it
@@ -227,21 +244,8 @@ uint16_t get_record_keycode(keyrecord_t *record, bool update_layer_cache) {
  * from triggering properly.
  */
 uint16_t get_event_keycode(keyevent_t event, bool update_layer_cache) {
-#if !defined(NO_ACTION_LAYER) && !defined(STRICT_LAYER_RELEASE)
-    /* TODO: Use store_or_get_action() or a similar function. */
-    if (!disable_action_cache) {
-        uint8_t layer;
-
-        if (event.pressed && update_layer_cache) {
-            layer = layer_switch_get_layer(event.key);
-            update_source_layers_cache(event.key, layer);
-        } else {
-            layer = read_source_layers_cache(event.key);
-        }
-        return keymap_key_to_keycode(layer, event.key);
-    } else
-#endif
-        return keymap_key_to_keycode(layer_switch_get_layer(event.key), event.key);
+    uint8_t layer;
+    return lookup_event_keycode(event, update_layer_cache, &layer);
 }
 
 /* Get keycode, and then process pre tapping functionality */
@@ -300,101 +304,15 @@ bool process_record_quantum(keyrecord_t *record) {
     }
 #endif
 
-    if (!(
 #if defined(KEY_LOCK_ENABLE)
-            // Must run first to be able to mask key_up events.
-            process_key_lock(&keycode, record) &&
-#endif
-#if defined(DYNAMIC_MACRO_ENABLE) && !defined(DYNAMIC_MACRO_USER_CALL)
-            // Must run asap to ensure all keypresses are recorded.
-            process_dynamic_macro(keycode, record) &&
-#endif
-#ifdef REPEAT_KEY_ENABLE
-            process_last_key(keycode, record) && process_repeat_key(keycode, record) &&
-#endif
-#if defined(AUDIO_ENABLE) && defined(AUDIO_CLICKY)
-            process_clicky(keycode, record) &&
-#endif
-#ifdef HAPTIC_ENABLE
-            process_haptic(keycode, record) &&
-#endif
-#if defined(VIA_ENABLE)
-            process_record_via(keycode, record) &&
-#endif
-#if defined(POINTING_DEVICE_ENABLE) && defined(POINTING_DEVICE_AUTO_MOUSE_ENABLE)
-            process_auto_mouse(keycode, record) &&
-#endif
-            process_record_kb(keycode, record) &&
-#if defined(SECURE_ENABLE)
-            process_secure(keycode, record) &&
-#endif
-#if defined(SEQUENCER_ENABLE)
-            process_sequencer(keycode, record) &&
-#endif
-#if defined(MIDI_ENABLE) && defined(MIDI_ADVANCED)
-            process_midi(keycode, record) &&
-#endif
-#ifdef AUDIO_ENABLE
-            process_audio(keycode, record) &&
-#endif
-#if defined(BACKLIGHT_ENABLE)
-            process_backlight(keycode, record) &&
-#endif
-#if defined(LED_MATRIX_ENABLE)
-            process_led_matrix(keycode, record) &&
-#endif
-#ifdef STENO_ENABLE
-            process_steno(keycode, record) &&
-#endif
-#if (defined(AUDIO_ENABLE) || (defined(MIDI_ENABLE) && defined(MIDI_BASIC))) && !defined(NO_MUSIC_MODE)
-            process_music(keycode, record) &&
-#endif
-#ifdef CAPS_WORD_ENABLE
-            process_caps_word(keycode, record) &&
-#endif
-#ifdef KEY_OVERRIDE_ENABLE
-            process_key_override(keycode, record) &&
-#endif
-#ifdef TAP_DANCE_ENABLE
-            process_tap_dance(keycode, record) &&
-#endif
-#if defined(UNICODE_COMMON_ENABLE)
-            process_unicode_common(keycode, record) &&
-#endif
-#ifdef LEADER_ENABLE
-            process_leader(keycode, record) &&
-#endif
-#ifdef AUTO_SHIFT_ENABLE
-            process_auto_shift(keycode, record) &&
-#endif
-#ifdef DYNAMIC_TAPPING_TERM_ENABLE
-            process_dynamic_tapping_term(keycode, record) &&
-#endif
-#ifdef SPACE_CADET_ENABLE
-            process_space_cadet(keycode, record) &&
-#endif
-#ifdef MAGIC_ENABLE
-            process_magic(keycode, record) &&
-#endif
-#ifdef GRAVE_ESC_ENABLE
-            process_grave_esc(keycode, record) &&
-#endif
-#if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
-            process_rgb(keycode, record) &&
-#endif
-#ifdef JOYSTICK_ENABLE
-            process_joystick(keycode, record) &&
-#endif
-#ifdef PROGRAMMABLE_BUTTON_ENABLE
-            process_programmable_button(keycode, record) &&
-#endif
-#ifdef AUTOCORRECT_ENABLE
-            process_autocorrect(keycode, record) &&
-#endif
-#ifdef TRI_LAYER_ENABLE
-            process_tri_layer(keycode, record) &&
+    // Must run first to be able to mask key_up events.
+    if (!process_key_lock(&keycode, record)) {
+        return false;
+    }
 #endif
-            true)) {
+
+    // Runs the feature handlers registered for this keycode, see process_dispatch.c
+    if (!process_dispatch(keycode, record)) {
         return false;
     }
 
@@ -66,22 +66,24 @@ uint32_t     g_rgb_timer;
 #ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
 uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #endif // RGB_MATRIX_FRAMEBUFFER_EFFECTS
-#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-last_hit_t g_last_hit_tracker;
-#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
 // internals
-static bool            suspend_state     = false;
-static uint8_t         rgb_last_enable   = UINT8_MAX;
-static uint8_t         rgb_last_effect   = UINT8_MAX;
-static effect_params_t rgb_effect_params = {0, LED_FLAG_ALL, false};
-static rgb_task_states rgb_task_state    = SYNCING;
-
-// double buffers
-static uint32_t rgb_timer_buffer;
-#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-static last_hit_t last_hit_buffer;
-#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+static bool suspend_state = false;
+
+void        rgb_matrix_update_pwm_buffers(void);
+static bool rgb_task_render(uint8_t effect, effect_params_t *params);
+static void rgb_task_clear(void);
+static void rgb_task_indicators(effect_params_t *params, bool finished);
+static void rgb_task_sync(void);
+
+static const led_effect_ops_t rgb_effect_ops = {
+    .render     = rgb_task_render,
+    .clear      = rgb_task_clear,
+    .flush      = rgb_matrix_update_pwm_buffers,
+    .indicators = rgb_task_indicators,
+    .sync       = rgb_task_sync,
+};
+static led_effect_core_t rgb_effect_core = LED_EFFECT_CORE(&rgb_effect_ops, &g_rgb_timer, RGB_MATRIX_LED_FLUSH_LIMIT);
 
 // split rgb matrix
 #if defined(RGB_MATRIX_SPLIT)
@@ -174,22 +176,7 @@ void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
         led_count = rgb_matrix_map_row_column_to_led(row, col, led);
     }
 
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
-    }
-
-    for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
-        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
-        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
-        last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
-        last_hit_buffer.count++;
-    }
+    led_effect_core_add_hits(&rgb_effect_core, led, led_count, g_led_config.point);
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
 #if defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP)
@@ -239,73 +226,35 @@ static bool rgb_matrix_none(effect_params_t *params) {
     return false;
 }
 
-static void rgb_task_timers(void) {
-#if defined(RGB_MATRIX_KEYREACTIVE_ENABLED)
-    uint32_t deltaTime = sync_timer_elapsed32(rgb_timer_buffer);
-#endif // defined(RGB_MATRIX_KEYREACTIVE_ENABLED)
-    rgb_timer_buffer = sync_timer_read32();
-
-    // Update double buffer last hit timers
-#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    uint8_t count = last_hit_buffer.count;
-    for (uint8_t i = 0; i < count; ++i) {
-        if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
-            last_hit_buffer.count--;
-            continue;
-        }
-        last_hit_buffer.tick[i] += deltaTime;
-    }
-#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+static void rgb_task_clear(void) {
+    rgb_matrix_set_color_all(0, 0, 0);
 }
 
 static void rgb_task_sync(void) {
     eeconfig_flush_rgb_matrix(false);
-    // next task
-    if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
-}
-
-static void rgb_task_start(void) {
-    // reset iter
-    rgb_effect_params.iter = 0;
-
-    // update double buffers
-    g_rgb_timer = rgb_timer_buffer;
-#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker = last_hit_buffer;
-#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
-
-    // next task
-    rgb_task_state = RENDERING;
 }
 
-static void rgb_task_render(uint8_t effect) {
-    bool rendering         = false;
-    rgb_effect_params.init = (effect != rgb_last_effect) || (rgb_matrix_config.enable != rgb_last_enable);
-    if (rgb_effect_params.flags != rgb_matrix_config.flags) {
-        rgb_effect_params.flags = rgb_matrix_config.flags;
-        rgb_matrix_set_color_all(0, 0, 0);
-    }
+static bool rgb_task_render(uint8_t effect, effect_params_t *params) {
+    bool rendering = false;
 
-    // each effect can opt to do calculations
-    // and/or request PWM buffer updates.
     switch (effect) {
         case RGB_MATRIX_NONE:
-            rendering = rgb_matrix_none(&rgb_effect_params);
+            rendering = rgb_matrix_none(params);
             break;
 
 // ---------------------------------------------
 // -----Begin rgb effect switch case macros-----
-#define RGB_MATRIX_EFFECT(name, ...)          \
-    case RGB_MATRIX_##name:                   \
-        rendering = name(&rgb_effect_params); \
+#define RGB_MATRIX_EFFECT(name, ...) \
+    case RGB_MATRIX_##name:          \
+        rendering = name(params);    \
         break;
 #include "rgb_matrix_effects.inc"
 #undef RGB_MATRIX_EFFECT
 
 #if defined(RGB_MATRIX_CUSTOM_KB) || defined(RGB_MATRIX_CUSTOM_USER)
-#    define RGB_MATRIX_EFFECT(name, ...)          \
-        case RGB_MATRIX_CUSTOM_##name:            \
-            rendering = name(&rgb_effect_params); \
+#    define RGB_MATRIX_EFFECT(name, ...) \
+        case RGB_MATRIX_CUSTOM_##name:   \
+            rendering = name(params);    \
             break;
 #    ifdef RGB_MATRIX_CUSTOM_KB
 #        include "rgb_matrix_kb.inc"
@@ -319,40 +268,22 @@ static void rgb_task_render(uint8_t effect) {
             // ---------------------------------------------
 
         // Factory default magic value
-        case UINT8_MAX: {
+        case UINT8_MAX:
             rgb_matrix_test();
-            rgb_task_state = FLUSHING;
-        }
-            return;
+            break;
     }
 
-    rgb_effect_params.iter++;
-
-    // next task
-    if (!rendering) {
-        rgb_task_state = FLUSHING;
-        if (!rgb_effect_params.init && effect == RGB_MATRIX_NONE) {
-            // We only need to flush once if we are RGB_MATRIX_NONE
-            rgb_task_state = SYNCING;
-        }
-    }
+    return rendering;
 }
 
-static void rgb_task_flush(uint8_t effect) {
-    // update last trackers after the first full render so we can init over several frames
-    rgb_last_effect = effect;
-    rgb_last_enable = rgb_matrix_config.enable;
-
-    // update pwm buffers
-    rgb_matrix_update_pwm_buffers();
-
-    // next task
-    rgb_task_state = SYNCING;
+static void rgb_task_indicators(effect_params_t *params, bool finished) {
+    if (finished) {
+        rgb_matrix_indicators();
+    }
+    rgb_matrix_indicators_advanced(params);
 }
 
 void rgb_matrix_task(void) {
-    rgb_task_timers();
-
     // Ideally we would also stop sending zeros to the LED driver PWM buffers
     // while suspended and just do a software shutdown. This is a cheap hack for now.
     bool suspend_backlight = suspend_state ||
@@ -363,26 +294,7 @@ void rgb_matrix_task(void) {
 
     uint8_t effect = suspend_backlight || !rgb_matrix_config.enable ? 0 : rgb_matrix_config.mode;
 
-    switch (rgb_task_state) {
-        case STARTING:
-            rgb_task_start();
-            break;
-        case RENDERING:
-            rgb_task_render(effect);
-            if (effect) {
-                if (rgb_task_state == FLUSHING) { // ensure we only draw basic indicators once rendering is finished
-                    rgb_matrix_indicators();
-                }
-                rgb_matrix_indicators_advanced(&rgb_effect_params);
-            }
-            break;
-        case FLUSHING:
-            rgb_task_flush(effect);
-            break;
-        case SYNCING:
-            rgb_task_sync();
-            break;
-    }
+    led_effect_core_task(&rgb_effect_core, effect, rgb_matrix_config.enable, rgb_matrix_config.flags);
 }
 
 void rgb_matrix_indicators(void) {
@@ -431,7 +343,7 @@ void rgb_matrix_indicators_advanced(effect_params_t *params) {
     /* special handling is needed for "params->iter", since it's already been incremented.
      * Could move the invocations to rgb_task_render, but then it's missing a few checks
      * and not sure which would be better. Otherwise, this should be called from
-     * rgb_task_render, right before the iter++ line.
+     * the effect core, right before the iter++ line.
      */
     RGB_MATRIX_USE_LIMITS_ITER(min, max, params->iter - 1);
     rgb_matrix_indicators_advanced_kb(min, max);
@@ -448,17 +360,7 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
 
-#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        g_last_hit_tracker.tick[i] = UINT16_MAX;
-    }
-
-    last_hit_buffer.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        last_hit_buffer.tick[i] = UINT16_MAX;
-    }
-#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+    led_effect_core_clear_hits(&rgb_effect_core);
 
     eeconfig_init_rgb_matrix();
     if (!rgb_matrix_config.mode) {
@@ -471,8 +373,8 @@ void rgb_matrix_init(void) {
 void rgb_matrix_set_suspend_state(bool state) {
 #ifdef RGB_MATRIX_SLEEP
     if (state && !suspend_state) { // only run if turning off, and only once
-        rgb_task_render(0);        // turn off all LEDs when suspending
-        rgb_task_flush(0);         // and actually flash led state to LEDs
+        // turn off all LEDs when suspending, and actually flash led state to LEDs
+        led_effect_core_blank(&rgb_effect_core, rgb_matrix_config.enable, rgb_matrix_config.flags);
     }
     suspend_state = state;
 #endif
@@ -484,7 +386,7 @@ bool rgb_matrix_get_suspend_state(void) {
 
 void rgb_matrix_toggle_eeprom_helper(bool write_to_eeprom) {
     rgb_matrix_config.enable ^= 1;
-    rgb_task_state = STARTING;
+    led_effect_core_restart(&rgb_effect_core);
     eeconfig_flag_rgb_matrix(write_to_eeprom);
     dprintf("rgb matrix toggle [%s]: rgb_matrix_config.enable = %u\n", (write_to_eeprom) ? "EEPROM" : "NOEEPROM", rgb_matrix_config.enable);
 }
@@ -501,7 +403,7 @@ void rgb_matrix_enable(void) {
 }
 
 void rgb_matrix_enable_noeeprom(void) {
-    if (!rgb_matrix_config.enable) rgb_task_state = STARTING;
+    if (!rgb_matrix_config.enable) led_effect_core_restart(&rgb_effect_core);
     rgb_matrix_config.enable = 1;
 }
 
@@ -511,7 +413,7 @@ void rgb_matrix_disable(void) {
 }
 
 void rgb_matrix_disable_noeeprom(void) {
-    if (rgb_matrix_config.enable) rgb_task_state = STARTING;
+    if (rgb_matrix_config.enable) led_effect_core_restart(&rgb_effect_core);
     rgb_matrix_config.enable = 0;
 }
 
@@ -530,7 +432,7 @@ void rgb_matrix_mode_eeprom_helper(uint8_t mode, bool write_to_eeprom) {
     } else {
         rgb_matrix_config.mode = mode;
     }
-    rgb_task_state = STARTING;
+    led_effect_core_restart(&rgb_effect_core);
     eeconfig_flag_rgb_matrix(write_to_eeprom);
     dprintf("rgb matrix mode [%s]: %u\n", (write_to_eeprom) ? "EEPROM" : "NOEEPROM", rgb_matrix_config.mode);
 }
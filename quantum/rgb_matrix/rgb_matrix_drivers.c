@@ -156,7 +156,8 @@ static void init(void) {
 }
 
 static void flush(void) {
-    if (ws2812_dirty) {
+    // Leave the frame dirty while the previous one is still being sent, it is picked up by the next flush
+    if (ws2812_dirty && !ws2812_busy()) {
         ws2812_setleds(rgb_matrix_ws2812_array, WS2812_LED_COUNT);
         ws2812_dirty = false;
     }
@@ -124,13 +124,34 @@ rgb_led_t led[RGBLIGHT_LED_COUNT];
 rgblight_segment_t const *const *rgblight_layers = NULL;
 
 static bool deferred_set_layer_state = false;
+
+/* LEDs covered by each layer, computed from rgblight_layers when it is first used */
+typedef struct {
+    uint8_t first;
+    uint8_t last; // one past the last LED, same as first for a layer without segments
+    uint8_t segments;
+} rgblight_layer_span_t;
+
+static rgblight_segment_t const *const *layer_spans_source = NULL;
+static rgblight_layer_span_t            layer_spans[RGBLIGHT_MAX_LAYERS];
+static uint8_t                          layer_count = 0;
+
+/* What was last sent to the driver: led[] with the enabled layers on top */
+static rgb_led_t             layer_frame[RGBLIGHT_LED_COUNT];
+static rgblight_layer_mask_t layer_frame_mask  = 0;
+static bool                  layer_frame_valid = false;
 #endif
 
 rgblight_ranges_t rgblight_ranges = {0, RGBLIGHT_LED_COUNT, 0, RGBLIGHT_LED_COUNT, RGBLIGHT_LED_COUNT};
 
+static bool deferred_set = false;
+
 void rgblight_set_clipping_range(uint8_t start_pos, uint8_t num_leds) {
     rgblight_ranges.clipping_start_pos = start_pos;
     rgblight_ranges.clipping_num_leds  = num_leds;
+#ifdef RGBLIGHT_LAYERS
+    layer_frame_valid = false;
+#endif
 }
 
 void rgblight_set_effect_range(uint8_t start_pos, uint8_t num_leds) {
@@ -244,6 +265,9 @@ void rgblight_init(void) {
     rgblight_timer_init(); // setup the timer
 
     rgblight_driver.init();
+#ifdef RGBLIGHT_LAYERS
+    layer_frame_valid = false;
+#endif
 
     if (rgblight_config.enable) {
         rgblight_mode_noeeprom(rgblight_config.mode);
@@ -533,7 +557,7 @@ void rgblight_sethsv_eeprom_helper(uint8_t hue, uint8_t sat, uint8_t val, bool w
             // same static color
             rgb_led_t tmp_led;
 #ifdef RGBLIGHT_LAYERS_RETAIN_VAL
-            // needed for rgblight_layers_write() to get the new val, since it reads rgblight_config.val
+            // needed for rgblight_layers_compose() to get the new val, since it reads rgblight_config.val
             rgblight_config.val = val;
 #endif
             sethsv(hue, sat, val, &tmp_led);
@@ -578,7 +602,7 @@ void rgblight_sethsv_eeprom_helper(uint8_t hue, uint8_t sat, uint8_t val, bool w
                     sethsv(_hue, sat, val, (rgb_led_t *)&led[i + rgblight_ranges.effect_start_pos]);
                 }
 #    ifdef RGBLIGHT_LAYERS_RETAIN_VAL
-                // needed for rgblight_layers_write() to get the new val, since it reads rgblight_config.val
+                // needed for rgblight_layers_compose() to get the new val, since it reads rgblight_config.val
                 rgblight_config.val = val;
 #    endif
                 rgblight_set();
@@ -762,40 +786,134 @@ bool rgblight_get_layer_state(uint8_t layer) {
     return (rgblight_status.enabled_layer_mask & mask) != 0;
 }
 
-// Write any enabled LED layers into the buffer
-static void rgblight_layers_write(void) {
-#    ifdef RGBLIGHT_LAYERS_RETAIN_VAL
-    uint8_t current_val = rgblight_get_val();
-#    endif
-    uint8_t i = 0;
-    // For each layer
-    for (const rgblight_segment_t *const *layer_ptr = rgblight_layers; i < RGBLIGHT_MAX_LAYERS; layer_ptr++, i++) {
-        if (!rgblight_get_layer_state(i)) {
-            continue; // Layer is disabled
-        }
-        const rgblight_segment_t *segment_ptr = pgm_read_ptr(layer_ptr);
+// Work out which LEDs each layer covers, whenever rgblight_layers points somewhere new
+static void rgblight_layers_prepare(void) {
+    if (layer_spans_source == rgblight_layers) {
+        return;
+    }
+    layer_spans_source = rgblight_layers;
+    layer_frame_valid  = false;
+    layer_count        = 0;
+    if (rgblight_layers == NULL) {
+        return;
+    }
+
+    for (; layer_count < RGBLIGHT_MAX_LAYERS; layer_count++) {
+        const rgblight_segment_t *segment_ptr = pgm_read_ptr(&rgblight_layers[layer_count]);
         if (segment_ptr == NULL) {
             break; // No more layers
         }
-        // For each segment
-        while (1) {
+        rgblight_layer_span_t span = {RGBLIGHT_LED_COUNT, 0, 0};
+        for (;; segment_ptr++, span.segments++) {
             rgblight_segment_t segment;
             memcpy_P(&segment, segment_ptr, sizeof(rgblight_segment_t));
             if (segment.index == RGBLIGHT_END_SEGMENT_INDEX) {
                 break; // No more segments
             }
-            // Write segment.count LEDs
-            rgb_led_t *const limit = &led[MIN(segment.index + segment.count, RGBLIGHT_LED_COUNT)];
-            for (rgb_led_t *led_ptr = &led[segment.index]; led_ptr < limit; led_ptr++) {
+            uint8_t last = MIN(segment.index + segment.count, RGBLIGHT_LED_COUNT);
+            if (segment.index < last) {
+                span.first = MIN(span.first, segment.index);
+                span.last  = MAX(span.last, last);
+            }
+        }
+        if (span.first >= span.last) {
+            span.first = span.last = span.segments = 0;
+        }
+        layer_spans[layer_count] = span;
+    }
+}
+
+// Whether enabled layers are drawn on top of the underlying effect at all
+static bool rgblight_layers_visible(void) {
+    return rgblight_layers != NULL
+#    if !defined(RGBLIGHT_LAYERS_OVERRIDE_RGB_OFF)
+           && rgblight_config.enable
+#    elif defined(RGBLIGHT_SLEEP)
+           && !is_suspended
+#    endif
+        ;
+}
+
+// Store one LED of the frame, returning whether it has to be sent to the driver again
+static bool rgblight_layers_paint(uint8_t index, const rgb_led_t *color) {
+    if (memcmp(&layer_frame[index], color, sizeof(rgb_led_t)) == 0) {
+        return false;
+    }
+    layer_frame[index] = *color;
+#    ifdef RGBLIGHT_LED_MAP
+    return true; // The clipping range applies to mapped positions
+#    else
+    return index >= rgblight_ranges.clipping_start_pos && index < rgblight_ranges.clipping_start_pos + rgblight_ranges.clipping_num_leds;
+#    endif
+}
+
+// Compose LEDs [first, last) of the frame, returning whether any of the LEDs sent to the driver changed.
+// Segments are resolved once each, from the topmost layer and its last segment down, and only paint
+// the LEDs that nothing above them covers.
+static bool rgblight_layers_compose(uint8_t first, uint8_t last) {
+    rgblight_layer_mask_t layers                                = rgblight_layers_visible() ? rgblight_status.enabled_layer_mask : 0;
+    uint8_t               painted[(RGBLIGHT_LED_COUNT + 7) / 8] = {0};
+    bool                  changed                               = !layer_frame_valid;
+
+    for (uint8_t l = layer_count; l-- > 0;) {
+        if (!(layers & ((rgblight_layer_mask_t)1 << l)) || layer_spans[l].last <= first || layer_spans[l].first >= last) {
+            continue;
+        }
+        const rgblight_segment_t *segments = pgm_read_ptr(&rgblight_layers[l]);
+        for (uint8_t s = layer_spans[l].segments; s-- > 0;) {
+            rgblight_segment_t segment;
+            memcpy_P(&segment, &segments[s], sizeof(rgblight_segment_t));
+            uint8_t segment_first = MAX(segment.index, first);
+            uint8_t segment_last  = MIN(segment.index + segment.count, last);
+            if (segment_first >= segment_last) {
+                continue;
+            }
+
+            rgb_led_t color = {0};
 #    ifdef RGBLIGHT_LAYERS_RETAIN_VAL
-                sethsv(segment.hue, segment.sat, current_val, led_ptr);
+            sethsv(segment.hue, segment.sat, rgblight_get_val(), &color);
 #    else
-                sethsv(segment.hue, segment.sat, segment.val, led_ptr);
+            sethsv(segment.hue, segment.sat, segment.val, &color);
 #    endif
+            for (uint8_t i = segment_first; i < segment_last; i++) {
+                if (!(painted[i / 8] & (1 << (i % 8)))) {
+                    painted[i / 8] |= 1 << (i % 8);
+                    changed |= rgblight_layers_paint(i, &color);
+                }
             }
-            segment_ptr++;
         }
     }
+
+    for (uint8_t i = first; i < last; i++) {
+        if (!(painted[i / 8] & (1 << (i % 8)))) {
+            changed |= rgblight_layers_paint(i, &led[i]);
+        }
+    }
+    layer_frame_mask = rgblight_status.enabled_layer_mask;
+    return changed;
+}
+
+static void rgblight_flush(void);
+
+// Redraw the LEDs of the layers that were switched on or off since the last frame
+static void rgblight_layers_update(void) {
+    rgblight_layers_prepare();
+    if (!layer_frame_valid || (rgblight_driver.busy != NULL && rgblight_driver.busy())) {
+        rgblight_set();
+        return;
+    }
+
+    rgblight_layer_mask_t changed_layers = rgblight_status.enabled_layer_mask ^ layer_frame_mask;
+    bool                  changed        = false;
+    for (uint8_t i = 0; i < layer_count; i++) {
+        if (changed_layers & ((rgblight_layer_mask_t)1 << i)) {
+            changed |= rgblight_layers_compose(layer_spans[i].first, layer_spans[i].last);
+        }
+    }
+    layer_frame_mask = rgblight_status.enabled_layer_mask;
+    if (changed) {
+        rgblight_flush();
+    }
 }
 
 #    ifdef RGBLIGHT_LAYER_BLINK
@@ -880,6 +998,9 @@ void rgblight_suspend(void) {
 
 void rgblight_wakeup(void) {
     is_suspended = false;
+#    ifdef RGBLIGHT_LAYERS
+    layer_frame_valid = false;
+#    endif
 
     if (pre_suspend_enabled) {
         rgblight_enable_noeeprom();
@@ -896,41 +1017,30 @@ void rgblight_wakeup(void) {
 
 #endif
 
-void rgblight_set(void) {
+// Send the clipping range of the current frame to the driver
+static void rgblight_flush(void) {
     rgb_led_t *start_led;
     uint8_t    num_leds = rgblight_ranges.clipping_num_leds;
-
-    if (!rgblight_config.enable) {
-        for (uint8_t i = rgblight_ranges.effect_start_pos; i < rgblight_ranges.effect_end_pos; i++) {
-            led[i].r = 0;
-            led[i].g = 0;
-            led[i].b = 0;
-#ifdef WS2812_RGBW
-            led[i].w = 0;
-#endif
-        }
-    }
-
 #ifdef RGBLIGHT_LAYERS
-    if (rgblight_layers != NULL
-#    if !defined(RGBLIGHT_LAYERS_OVERRIDE_RGB_OFF)
-        && rgblight_config.enable
-#    elif defined(RGBLIGHT_SLEEP)
-        && !is_suspended
-#    endif
-    ) {
-        rgblight_layers_write();
-    }
+    rgb_led_t *frame  = layer_frame;
+    layer_frame_valid = true;
+#else
+    rgb_led_t *frame = led;
 #endif
 
-#ifdef RGBLIGHT_LED_MAP
+#if defined(RGBLIGHT_LED_MAP) || (defined(RGBLIGHT_LAYERS) && defined(WS2812_RGBW))
+    // Converted in a copy, layer_frame has to stay as composed for the next comparison
     rgb_led_t led0[RGBLIGHT_LED_COUNT];
     for (uint8_t i = 0; i < RGBLIGHT_LED_COUNT; i++) {
-        led0[i] = led[pgm_read_byte(&led_map[i])];
+#    ifdef RGBLIGHT_LED_MAP
+        led0[i] = frame[pgm_read_byte(&led_map[i])];
+#    else
+        led0[i] = frame[i];
+#    endif
     }
     start_led = led0 + rgblight_ranges.clipping_start_pos;
 #else
-    start_led = led + rgblight_ranges.clipping_start_pos;
+    start_led = frame + rgblight_ranges.clipping_start_pos;
 #endif
 
 #ifdef WS2812_RGBW
@@ -941,6 +1051,35 @@ void rgblight_set(void) {
     rgblight_driver.setleds(start_led, num_leds);
 }
 
+void rgblight_set(void) {
+    // Coalesce with the next frame rather than queueing behind one still in flight
+    if (rgblight_driver.busy != NULL && rgblight_driver.busy()) {
+        deferred_set = true;
+        return;
+    }
+    deferred_set = false;
+
+    if (!rgblight_config.enable) {
+        for (uint8_t i = rgblight_ranges.effect_start_pos; i < rgblight_ranges.effect_end_pos; i++) {
+            led[i].r = 0;
+            led[i].g = 0;
+            led[i].b = 0;
+#ifdef WS2812_RGBW
+            led[i].w = 0;
+#endif
+        }
+    }
+
+#ifdef RGBLIGHT_LAYERS
+    rgblight_layers_prepare();
+    // Layers are composed over led[] rather than written into it, so an unchanged frame needs no transfer
+    if (!rgblight_layers_compose(0, RGBLIGHT_LED_COUNT)) {
+        return;
+    }
+#endif
+    rgblight_flush();
+}
+
 #ifdef RGBLIGHT_SPLIT
 /* for split keyboard master side */
 uint8_t rgblight_get_change_flags(void) {
@@ -961,6 +1100,7 @@ void rgblight_update_sync(rgblight_syncinfo_t *syncinfo, bool write_to_eeprom) {
 #    ifdef RGBLIGHT_LAYERS
     if (syncinfo->status.change_flags & RGBLIGHT_STATUS_CHANGE_LAYERS) {
         rgblight_status.enabled_layer_mask = syncinfo->status.enabled_layer_mask;
+        deferred_set_layer_state           = true;
     }
 #    endif
     if (syncinfo->status.change_flags & RGBLIGHT_STATUS_CHANGE_MODE) {
@@ -1151,17 +1291,9 @@ void rgblight_timer_task(void) {
     if (deferred_set_layer_state) {
         deferred_set_layer_state = false;
 
-        // Static modes don't have a ticker running to update the LEDs
-        if (rgblight_status.timer_enabled == false) {
-            rgblight_mode_noeeprom(rgblight_config.mode);
-        }
-
-#        ifdef RGBLIGHT_LAYERS_OVERRIDE_RGB_OFF
-        // If not enabled, then nothing else will actually set the LEDs...
-        if (!rgblight_config.enable) {
-            rgblight_set();
-        }
-#        endif
+        // Only the LEDs of the layers that were switched on or off are redrawn,
+        // so static modes don't need to be rendered again
+        rgblight_layers_update();
     }
 #    endif
 }
@@ -1525,6 +1657,10 @@ void rgblight_task(void) {
     rgblight_timer_task();
 #endif
 
+    if (deferred_set) {
+        rgblight_set();
+    }
+
 #ifdef VELOCIKEY_ENABLE
     if (rgblight_velocikey_enabled()) {
         rgblight_velocikey_decelerate();
@@ -9,6 +9,7 @@
 const rgblight_driver_t rgblight_driver = {
     .init    = ws2812_init,
     .setleds = ws2812_setleds,
+    .busy    = ws2812_busy,
 };
 
 #elif defined(RGBLIGHT_APA102)
@@ -4,11 +4,13 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "color.h"
 
 typedef struct {
     void (*init)(void);
     void (*setleds)(rgb_led_t *ledarray, uint16_t number_of_leds);
+    bool (*busy)(void); // optional, true while the previous frame is still being sent
 } rgblight_driver_t;
 
 extern const rgblight_driver_t rgblight_driver;
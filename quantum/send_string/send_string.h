@@ -24,6 +24,7 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #include "progmem.h"
 #include "send_string_keycodes.h"
@@ -161,4 +162,98 @@ void send_string_with_delay_P(const char *string, uint8_t interval);
  */
 #define SEND_STRING_DELAY(string, interval) send_string_with_delay_P(PSTR(string), interval)
 
+#if defined(SEND_STRING_ASYNC_ENABLE) || defined(__DOXYGEN__)
+/* Size of the ring buffer that RAM strings are copied into, must be a power of two. */
+#    ifndef SEND_STRING_ASYNC_BUFFER_SIZE
+#        define SEND_STRING_ASYNC_BUFFER_SIZE 64
+#    endif
+
+/* Number of strings that can be queued at once, must be a power of two. */
+#    ifndef SEND_STRING_ASYNC_QUEUE_SIZE
+#        define SEND_STRING_ASYNC_QUEUE_SIZE 4
+#    endif
+
+/**
+ * \brief Queue a string of ASCII characters to be typed out in the background.
+ *
+ * The string is copied, and typed out by `send_string_async_task()` one report at a time, for as fast as the host accepts
+ * them. Strings queued one after another are typed out in order.
+ *
+ * \param string The string to type out.
+ *
+ * \return false if there is not enough room in the queue, in which case nothing was queued.
+ */
+bool send_string_async(const char *string);
+
+/**
+ * \brief Queue a string of ASCII characters to be typed out in the background, with a delay between each report.
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait before sending the next report.
+ *
+ * \return false if there is not enough room in the queue, in which case nothing was queued.
+ */
+bool send_string_async_with_delay(const char *string, uint8_t interval);
+
+/**
+ * \brief Queue a PROGMEM string of ASCII characters to be typed out in the background.
+ *
+ * Only a pointer to the string is queued, so it has to stay valid until it has been typed out.
+ *
+ * \param string The string to type out.
+ *
+ * \return false if the queue is full, in which case nothing was queued.
+ */
+bool send_string_async_P(const char *string);
+
+/**
+ * \brief Queue a PROGMEM string of ASCII characters to be typed out in the background, with a delay between each report.
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait before sending the next report.
+ *
+ * \return false if the queue is full, in which case nothing was queued.
+ */
+bool send_string_async_with_delay_P(const char *string, uint8_t interval);
+
+/**
+ * \brief Queue an ASCII character to be typed out in the background.
+ *
+ * \param ascii_code The character to type.
+ *
+ * \return false if there is not enough room in the queue, in which case nothing was queued.
+ */
+bool send_char_async(char ascii_code);
+
+/**
+ * \brief Whether any queued characters have not been fully typed out yet.
+ */
+bool send_string_async_is_busy(void);
+
+/**
+ * \brief The number of queued bytes that have not been typed out yet.
+ */
+uint16_t send_string_async_remaining(void);
+
+/**
+ * \brief Discard everything that is queued and release any keys held by the string being typed out.
+ */
+void send_string_async_cancel(void);
+
+/**
+ * \brief Type out the next part of the queued strings. Called from the keyboard task.
+ */
+void send_string_async_task(void);
+
+/**
+ * \brief Shortcut macro for send_string_async_with_delay_P(PSTR(string), 0).
+ */
+#    define SEND_STRING_ASYNC(string) send_string_async_with_delay_P(PSTR(string), 0)
+
+/**
+ * \brief Shortcut macro for send_string_async_with_delay_P(PSTR(string), interval).
+ */
+#    define SEND_STRING_ASYNC_DELAY(string, interval) send_string_async_with_delay_P(PSTR(string), interval)
+#endif
+
 /** \} */
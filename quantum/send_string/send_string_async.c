@@ -0,0 +1,398 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "send_string.h"
+
+#include <ctype.h>
+#include <string.h>
+
+#include "keycode.h"
+#include "action.h"
+#include "action_util.h"
+#include "host.h"
+#include "timer.h"
+
+#if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+#    include "audio.h"
+extern float bell_song[][2];
+#endif
+
+_Static_assert((SEND_STRING_ASYNC_BUFFER_SIZE & (SEND_STRING_ASYNC_BUFFER_SIZE - 1)) == 0 && SEND_STRING_ASYNC_BUFFER_SIZE <= 32768, "SEND_STRING_ASYNC_BUFFER_SIZE must be a power of two no larger than 32768");
+_Static_assert((SEND_STRING_ASYNC_QUEUE_SIZE & (SEND_STRING_ASYNC_QUEUE_SIZE - 1)) == 0 && SEND_STRING_ASYNC_QUEUE_SIZE <= 128, "SEND_STRING_ASYNC_QUEUE_SIZE must be a power of two no larger than 128");
+
+#define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
+
+#define HELD_SHIFT 0x01
+#define HELD_ALTGR 0x02
+
+/* A queued string: either a pointer to a (PROGMEM) string that outlives the send, or a run of characters copied into the ring buffer */
+typedef struct {
+    const char *string;
+    uint16_t    remaining;
+    uint8_t     interval;
+    bool        progmem;
+} send_string_segment_t;
+
+typedef enum {
+    ACTION_CHAR,
+    ACTION_TAP,
+    ACTION_DOWN,
+    ACTION_UP,
+    ACTION_DELAY,
+    ACTION_BELL,
+} send_string_action_type_t;
+
+typedef struct {
+    uint8_t  type;
+    uint8_t  keycode;
+    uint8_t  mods;
+    bool     dead;
+    uint8_t  interval;
+    uint16_t delay;
+} send_string_action_t;
+
+static char                  buffer[SEND_STRING_ASYNC_BUFFER_SIZE];
+static uint16_t              buffer_head = 0;
+static uint16_t              buffer_tail = 0;
+static send_string_segment_t segments[SEND_STRING_ASYNC_QUEUE_SIZE];
+static uint8_t               segment_head = 0;
+static uint8_t               segment_tail = 0;
+
+static send_string_action_t pending;
+static bool                 has_pending = false;
+static uint8_t              held_key    = KC_NO;
+static uint8_t              held_mods   = 0;
+static bool                 held_batchable;
+static uint8_t              last_interval = 0;
+static uint32_t             next_step     = 0;
+
+/* ---------------------------------------------------------------------------
+ * Queue
+ * ------------------------------------------------------------------------ */
+
+static bool enqueue(const char *string, uint16_t length, uint8_t interval, bool progmem, bool copy) {
+    if (length == 0) {
+        return true;
+    }
+    if ((uint8_t)(segment_head - segment_tail) >= SEND_STRING_ASYNC_QUEUE_SIZE) {
+        return false;
+    }
+    if (!send_string_async_is_busy()) {
+        next_step = timer_read32();
+    }
+
+    send_string_segment_t *segment = &segments[segment_head & (SEND_STRING_ASYNC_QUEUE_SIZE - 1)];
+    if (copy) {
+        if (length > SEND_STRING_ASYNC_BUFFER_SIZE - (uint16_t)(buffer_head - buffer_tail)) {
+            return false;
+        }
+        for (uint16_t i = 0; i < length; i++) {
+            buffer[(buffer_head++) & (SEND_STRING_ASYNC_BUFFER_SIZE - 1)] = string[i];
+        }
+        segment->string = NULL;
+    } else {
+        segment->string = string;
+    }
+    segment->remaining = length;
+    segment->interval  = interval;
+    segment->progmem   = progmem;
+    segment_head++;
+    return true;
+}
+
+static send_string_segment_t *current_segment(void) {
+    while (segment_head != segment_tail) {
+        send_string_segment_t *segment = &segments[segment_tail & (SEND_STRING_ASYNC_QUEUE_SIZE - 1)];
+        if (segment->remaining) {
+            return segment;
+        }
+        segment_tail++;
+    }
+    return NULL;
+}
+
+static char read_byte(send_string_segment_t *segment) {
+    if (segment->remaining == 0) {
+        return 0;
+    }
+    segment->remaining--;
+    if (segment->string == NULL) {
+        return buffer[(buffer_tail++) & (SEND_STRING_ASYNC_BUFFER_SIZE - 1)];
+    }
+    return segment->progmem ? pgm_read_byte(segment->string++) : *segment->string++;
+}
+
+/* Decode the next thing to do from the queued strings, skipping characters that have no keycode */
+static bool decode_action(send_string_action_t *action) {
+    send_string_segment_t *segment;
+
+    while ((segment = current_segment()) != NULL) {
+        char ascii_code = read_byte(segment);
+
+        action->interval = segment->interval;
+        action->mods     = 0;
+        action->dead     = false;
+
+        if (ascii_code == SS_QMK_PREFIX) {
+            char code = read_byte(segment);
+            switch (code) {
+                case SS_TAP_CODE:
+                    action->type    = ACTION_TAP;
+                    action->keycode = read_byte(segment);
+                    return true;
+                case SS_DOWN_CODE:
+                    action->type    = ACTION_DOWN;
+                    action->keycode = read_byte(segment);
+                    return true;
+                case SS_UP_CODE:
+                    action->type    = ACTION_UP;
+                    action->keycode = read_byte(segment);
+                    return true;
+                case SS_DELAY_CODE: {
+                    uint16_t ms    = 0;
+                    char     digit = read_byte(segment);
+                    while (isdigit(digit)) {
+                        ms *= 10;
+                        ms += digit - '0';
+                        digit = read_byte(segment);
+                    }
+                    action->type  = ACTION_DELAY;
+                    action->delay = ms;
+                    return true;
+                }
+                default:
+                    continue;
+            }
+        }
+
+#if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+        if (ascii_code == '\a') {
+            action->type = ACTION_BELL;
+            return true;
+        }
+#endif
+
+        if ((uint8_t)ascii_code >= 128) {
+            continue;
+        }
+        action->keycode = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+        if (action->keycode == KC_NO) {
+            continue;
+        }
+        action->type = ACTION_CHAR;
+        if (PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code)) {
+            action->mods |= HELD_SHIFT;
+        }
+        if (PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code)) {
+            action->mods |= HELD_ALTGR;
+        }
+        action->dead = PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code);
+        return true;
+    }
+
+    return false;
+}
+
+/* ---------------------------------------------------------------------------
+ * Scheduler
+ * ------------------------------------------------------------------------ */
+
+static void release_held_key(void) {
+    unregister_code(held_key);
+    held_key = KC_NO;
+}
+
+/* Modifiers are pressed shift first and released AltGr first, like send_char() does */
+static void release_one_mod(uint8_t keep) {
+    if ((held_mods & HELD_ALTGR) && !(keep & HELD_ALTGR)) {
+        unregister_code(KC_RIGHT_ALT);
+        held_mods &= ~HELD_ALTGR;
+    } else {
+        unregister_code(KC_LEFT_SHIFT);
+        held_mods &= ~HELD_SHIFT;
+    }
+}
+
+static void press_one_mod(uint8_t wanted) {
+    if ((wanted & HELD_SHIFT) && !(held_mods & HELD_SHIFT)) {
+        register_code(KC_LEFT_SHIFT);
+        held_mods |= HELD_SHIFT;
+    } else {
+        register_code(KC_RIGHT_ALT);
+        held_mods |= HELD_ALTGR;
+    }
+}
+
+static void press_key(uint8_t keycode, bool batchable) {
+    register_code(keycode);
+    held_key       = keycode;
+    held_batchable = batchable;
+}
+
+/* The character has been pressed, a dead key still needs a space tapped after it */
+static void char_pressed(void) {
+    if (pending.dead) {
+        pending.type    = ACTION_TAP;
+        pending.keycode = KC_SPACE;
+        pending.mods    = 0;
+    } else {
+        has_pending = false;
+    }
+}
+
+/**
+ * Produce at most one report. Returns false if nothing was sent, e.g. because
+ * a delay was started.
+ */
+static bool step(void) {
+    if (!has_pending) {
+        has_pending = decode_action(&pending);
+    }
+
+    if (!has_pending) {
+        // Done, let go of whatever the last character held down
+        if (held_key != KC_NO) {
+            release_held_key();
+            return true;
+        }
+        if (held_mods) {
+            release_one_mod(0);
+            return true;
+        }
+        return false;
+    }
+
+    last_interval = pending.interval;
+
+    if (pending.type == ACTION_CHAR) {
+        if (held_key != KC_NO) {
+#ifdef SEND_STRING_ASYNC_BATCHING
+            // Release the previous character and press this one in the same report
+            if (held_batchable && pending.keycode != held_key && pending.mods == held_mods) {
+                del_key(held_key);
+                add_key(pending.keycode);
+                send_keyboard_report();
+                held_key       = pending.keycode;
+                held_batchable = !pending.dead;
+                char_pressed();
+                return true;
+            }
+#endif
+            release_held_key();
+            return true;
+        }
+        if (held_mods & ~pending.mods) {
+            release_one_mod(pending.mods);
+            return true;
+        }
+        if (pending.mods & ~held_mods) {
+            press_one_mod(pending.mods);
+            return true;
+        }
+        press_key(pending.keycode, !pending.dead);
+        char_pressed();
+        return true;
+    }
+
+    // Keycode injections and delays act on a clean slate
+    if (held_key != KC_NO) {
+        release_held_key();
+        return true;
+    }
+    if (held_mods) {
+        release_one_mod(0);
+        return true;
+    }
+
+    has_pending = false;
+    switch (pending.type) {
+        case ACTION_TAP:
+            press_key(pending.keycode, false);
+            return true;
+        case ACTION_DOWN:
+            register_code(pending.keycode);
+            return true;
+        case ACTION_UP:
+            unregister_code(pending.keycode);
+            return true;
+        case ACTION_DELAY:
+            next_step = timer_read32() + pending.delay;
+            return false;
+#if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+        case ACTION_BELL:
+            PLAY_SONG(bell_song);
+            return false;
+#endif
+        default:
+            return false;
+    }
+}
+
+void send_string_async_task(void) {
+    if (!send_string_async_is_busy()) {
+        return;
+    }
+    if (!timer_expired32(timer_read32(), next_step) || !host_keyboard_is_ready()) {
+        return;
+    }
+    if (step()) {
+        next_step = timer_read32() + last_interval;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * API
+ * ------------------------------------------------------------------------ */
+
+bool send_string_async(const char *string) {
+    return send_string_async_with_delay(string, TAP_CODE_DELAY);
+}
+
+bool send_string_async_with_delay(const char *string, uint8_t interval) {
+    size_t length = strlen(string);
+    if (length > UINT16_MAX) {
+        return false;
+    }
+    return enqueue(string, length, interval, false, true);
+}
+
+bool send_string_async_P(const char *string) {
+    return send_string_async_with_delay_P(string, TAP_CODE_DELAY);
+}
+
+bool send_string_async_with_delay_P(const char *string, uint8_t interval) {
+    size_t length = strlen_P(string);
+    if (length > UINT16_MAX) {
+        return false;
+    }
+    return enqueue(string, length, interval, true, false);
+}
+
+bool send_char_async(char ascii_code) {
+    return enqueue(&ascii_code, 1, TAP_CODE_DELAY, false, true);
+}
+
+bool send_string_async_is_busy(void) {
+    return has_pending || held_key != KC_NO || held_mods || current_segment() != NULL;
+}
+
+uint16_t send_string_async_remaining(void) {
+    uint16_t remaining = has_pending ? 1 : 0;
+    for (uint8_t i = segment_tail; i != segment_head; i++) {
+        remaining += segments[i & (SEND_STRING_ASYNC_QUEUE_SIZE - 1)].remaining;
+    }
+    return remaining;
+}
+
+void send_string_async_cancel(void) {
+    segment_tail = segment_head;
+    buffer_tail  = buffer_head;
+    has_pending  = false;
+    if (held_key != KC_NO) {
+        release_held_key();
+    }
+    while (held_mods) {
+        release_one_mod(0);
+    }
+    next_step = timer_read32();
+}
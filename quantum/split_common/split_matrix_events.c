@@ -0,0 +1,40 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "split_matrix_events.h"
+
+void split_matrix_events_record(split_matrix_events_t *queue, const matrix_row_t previous[], const matrix_row_t current[], uint8_t rows, uint16_t time) {
+    for (uint8_t row = 0; row < rows; row++) {
+        matrix_row_t changes = previous[row] ^ current[row];
+        for (uint8_t col = 0; changes; col++, changes >>= 1) {
+            if (changes & 1) {
+                split_matrix_event_t *event = &queue->events[queue->head.count % SPLIT_MATRIX_EVENTS_SIZE];
+
+                event->row  = row;
+                event->col  = col | ((current[row] & ((matrix_row_t)1 << col)) ? SPLIT_MATRIX_EVENT_PRESSED : 0);
+                event->time = time;
+                queue->head.count++;
+            }
+        }
+    }
+}
+
+bool split_matrix_events_apply(const split_matrix_events_t *queue, uint8_t tail, matrix_row_t matrix[], uint16_t times[][MATRIX_COLS]) {
+    if ((uint8_t)(queue->head.count - tail) > SPLIT_MATRIX_EVENTS_SIZE) {
+        return false;
+    }
+
+    for (; tail != queue->head.count; tail++) {
+        const split_matrix_event_t *event = &queue->events[tail % SPLIT_MATRIX_EVENTS_SIZE];
+        uint8_t                     col   = event->col & ~SPLIT_MATRIX_EVENT_PRESSED;
+        matrix_row_t                mask  = (matrix_row_t)1 << col;
+
+        if (event->col & SPLIT_MATRIX_EVENT_PRESSED) {
+            matrix[event->row] |= mask;
+        } else {
+            matrix[event->row] &= ~mask;
+        }
+        times[event->row][col] = event->time;
+    }
+    return true;
+}
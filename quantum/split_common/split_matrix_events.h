@@ -0,0 +1,60 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#ifdef __cplusplus
+#    define _Static_assert static_assert
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "matrix.h"
+
+#ifndef SPLIT_MATRIX_EVENTS_SIZE
+#    define SPLIT_MATRIX_EVENTS_SIZE 8
+#endif // SPLIT_MATRIX_EVENTS_SIZE
+
+// The event count wraps at 256, so the ring has to fit evenly into it
+_Static_assert(SPLIT_MATRIX_EVENTS_SIZE > 0 && SPLIT_MATRIX_EVENTS_SIZE <= 128 && (SPLIT_MATRIX_EVENTS_SIZE & (SPLIT_MATRIX_EVENTS_SIZE - 1)) == 0, "SPLIT_MATRIX_EVENTS_SIZE must be a power of two, no larger than 128");
+
+#define SPLIT_MATRIX_EVENT_PRESSED 0x80
+
+/**
+ * @brief A key on the slave half changing state, once debounced.
+ */
+typedef struct split_matrix_event_t {
+    uint8_t  row;  // Row within the slave half
+    uint8_t  col;  // Column, with SPLIT_MATRIX_EVENT_PRESSED set for a press
+    uint16_t time; // sync_timer_read() time of the change
+} split_matrix_event_t;
+
+/**
+ * @brief What the master polls every cycle. While idle, this is all that is transferred.
+ */
+typedef struct split_matrix_events_head_t {
+    uint8_t count;    // Number of events ever recorded, wrapping at 256
+    uint8_t checksum; // crc8 of the slave matrix after the last event
+} split_matrix_events_head_t;
+
+typedef struct split_matrix_events_t {
+    split_matrix_events_head_t head;
+    split_matrix_event_t       events[SPLIT_MATRIX_EVENTS_SIZE]; // Ring, indexed by event count
+} split_matrix_events_t;
+
+/**
+ * @brief Records every key that differs between `previous` and `current` as an event, in row and column order.
+ *
+ * Only the event count is updated, the checksum is left to the caller.
+ */
+void split_matrix_events_record(split_matrix_events_t *queue, const matrix_row_t previous[], const matrix_row_t current[], uint8_t rows, uint16_t time);
+
+/**
+ * @brief Applies the events recorded since `tail` to `matrix`, storing the time of each key change in `times`.
+ *
+ * Events carry the new state of the key, so applying an event twice is harmless.
+ *
+ * @return false if events since `tail` have already been overwritten, and the matrix has to be read in full instead
+ */
+bool split_matrix_events_apply(const split_matrix_events_t *queue, uint8_t tail, matrix_row_t matrix[], uint16_t times[][MATRIX_COLS]);
@@ -0,0 +1,15 @@
+split_matrix_events_DEFS := -DMATRIX_ROWS=8 -DMATRIX_COLS=16 -DSPLIT_MATRIX_EVENTS_SIZE=4
+
+split_matrix_events_SRC := \
+    $(QUANTUM_PATH)/split_common/tests/split_matrix_events_tests.cpp \
+    $(QUANTUM_PATH)/split_common/split_matrix_events.c
+
+split_matrix_key_time_DEFS := -DMATRIX_ROWS=4 -DMATRIX_COLS=8 -DDEBOUNCE=5 \
+    -DSPLIT_KEYBOARD -DSPLIT_COMMON_TRANSACTIONS -DSPLIT_MATRIX_EVENTS_ENABLE -DDEBOUNCE_COMPENSATION
+
+split_matrix_key_time_SRC := \
+    $(QUANTUM_PATH)/split_common/tests/split_matrix_key_time_tests.cpp \
+    $(QUANTUM_PATH)/matrix_common.c \
+    $(QUANTUM_PATH)/bitwise.c \
+    $(QUANTUM_PATH)/debounce/asym_eager_defer_pk.c \
+    $(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
@@ -0,0 +1,93 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "split_common/split_matrix_events.h"
+}
+
+#define ROWS_PER_HAND ((MATRIX_ROWS) / 2)
+
+class SplitMatrixEvents : public testing::Test {
+   protected:
+    split_matrix_events_t queue = {};
+
+    matrix_row_t slave_matrix[ROWS_PER_HAND]      = {0};
+    matrix_row_t master_matrix[ROWS_PER_HAND]     = {0};
+    uint16_t     times[ROWS_PER_HAND][MATRIX_COLS] = {{0}};
+
+    /* Changes the slave's matrix, the way the slave handler records it */
+    void slave_scan(const matrix_row_t (&matrix)[ROWS_PER_HAND], uint16_t time) {
+        split_matrix_events_record(&queue, slave_matrix, matrix, ROWS_PER_HAND, time);
+        memcpy(slave_matrix, matrix, sizeof(slave_matrix));
+    }
+};
+
+TEST_F(SplitMatrixEvents, idle_scans_record_nothing) {
+    slave_scan({0, 0, 0, 0}, 10);
+    slave_scan({0, 0, 0, 0}, 11);
+    EXPECT_EQ(queue.head.count, 0);
+}
+
+TEST_F(SplitMatrixEvents, records_each_change_in_matrix_order) {
+    slave_scan({0b101, 0, 0, 0}, 10);
+    slave_scan({0b100, 0, 0, 0b1000000000000000}, 12);
+
+    ASSERT_EQ(queue.head.count, 4);
+    EXPECT_EQ(queue.events[0].row, 0);
+    EXPECT_EQ(queue.events[0].col, 0 | SPLIT_MATRIX_EVENT_PRESSED);
+    EXPECT_EQ(queue.events[0].time, 10);
+    EXPECT_EQ(queue.events[1].col, 2 | SPLIT_MATRIX_EVENT_PRESSED);
+    EXPECT_EQ(queue.events[2].row, 0);
+    EXPECT_EQ(queue.events[2].col, 0);
+    EXPECT_EQ(queue.events[2].time, 12);
+    EXPECT_EQ(queue.events[3].row, 3);
+    EXPECT_EQ(queue.events[3].col, 15 | SPLIT_MATRIX_EVENT_PRESSED);
+}
+
+TEST_F(SplitMatrixEvents, apply_replays_slave_matrix_and_times) {
+    slave_scan({0b11, 0, 0, 0}, 100);
+    slave_scan({0b10, 0b1, 0, 0}, 103);
+
+    EXPECT_TRUE(split_matrix_events_apply(&queue, 0, master_matrix, times));
+    EXPECT_EQ(memcmp(master_matrix, slave_matrix, sizeof(slave_matrix)), 0);
+    EXPECT_EQ(times[0][0], 103);
+    EXPECT_EQ(times[0][1], 100);
+    EXPECT_EQ(times[1][0], 103);
+}
+
+TEST_F(SplitMatrixEvents, apply_continues_from_tail) {
+    slave_scan({0b1, 0, 0, 0}, 100);
+    ASSERT_TRUE(split_matrix_events_apply(&queue, 0, master_matrix, times));
+    uint8_t tail = queue.head.count;
+
+    // Replaying an event that was already applied is harmless
+    slave_scan({0b1, 0b10, 0, 0}, 105);
+    EXPECT_TRUE(split_matrix_events_apply(&queue, tail - 1, master_matrix, times));
+    EXPECT_EQ(memcmp(master_matrix, slave_matrix, sizeof(slave_matrix)), 0);
+    EXPECT_EQ(times[0][0], 100);
+    EXPECT_EQ(times[1][1], 105);
+}
+
+TEST_F(SplitMatrixEvents, apply_fails_once_events_are_overwritten) {
+    slave_scan({0b1111, 0, 0, 0}, 100);
+    EXPECT_TRUE(split_matrix_events_apply(&queue, 0, master_matrix, times));
+
+    slave_scan({0b11111, 0, 0, 0}, 101);
+    EXPECT_FALSE(split_matrix_events_apply(&queue, 0, master_matrix, times));
+}
+
+TEST_F(SplitMatrixEvents, count_wraps_around) {
+    uint8_t tail = 0;
+    for (int i = 0; i < 300; i++) {
+        matrix_row_t matrix[ROWS_PER_HAND] = {0};
+        memcpy(matrix, slave_matrix, sizeof(matrix));
+        matrix[i % ROWS_PER_HAND] ^= 1 << (i % MATRIX_COLS);
+        slave_scan({matrix[0], matrix[1], matrix[2], matrix[3]}, i);
+
+        ASSERT_TRUE(split_matrix_events_apply(&queue, tail, master_matrix, times)) << i;
+        ASSERT_EQ(memcmp(master_matrix, slave_matrix, sizeof(slave_matrix)), 0) << i;
+        tail = queue.head.count;
+    }
+}
@@ -0,0 +1,164 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Key times and the time horizon that quantum/matrix_common.c reports on the master half of a split keyboard, built with
+asym_eager_defer_pk debouncing so that presses and releases are reported with different delays.
+*/
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "matrix.h"
+#include "debounce.h"
+#include "timer.h"
+#include "split_common/split_util.h"
+#include "split_common/transactions.h"
+
+void set_time(uint32_t t);
+}
+
+#define ROWS_PER_HAND ((MATRIX_ROWS) / 2)
+
+static bool         master;
+static bool         connected;
+static matrix_row_t local_matrix[ROWS_PER_HAND];
+static matrix_row_t remote_matrix[ROWS_PER_HAND];
+static uint16_t     remote_key_times[ROWS_PER_HAND][MATRIX_COLS];
+static uint16_t     remote_poll_time;
+
+extern "C" {
+volatile bool isLeftHand;
+
+bool is_keyboard_master(void) {
+    return master;
+}
+
+bool is_transport_connected(void) {
+    return connected;
+}
+
+bool transport_master_if_connected(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    if (connected) {
+        memcpy(slave_matrix, remote_matrix, sizeof(remote_matrix));
+    }
+    return connected;
+}
+
+void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {}
+
+uint16_t transactions_get_slave_key_time(uint8_t row, uint8_t col) {
+    return remote_key_times[row][col];
+}
+
+uint16_t transactions_get_slave_poll_time(void) {
+    return remote_poll_time;
+}
+
+bool matrix_scan_custom(matrix_row_t current_matrix[]) {
+    bool changed = memcmp(current_matrix, local_matrix, sizeof(local_matrix)) != 0;
+    memcpy(current_matrix, local_matrix, sizeof(local_matrix));
+    return changed;
+}
+}
+
+class SplitMatrixKeyTime : public testing::Test {
+   protected:
+    void SetUp() override {
+        master    = true;
+        connected = true;
+        memset(local_matrix, 0, sizeof(local_matrix));
+        memset(remote_matrix, 0, sizeof(remote_matrix));
+        memset(remote_key_times, 0, sizeof(remote_key_times));
+        remote_poll_time = 0;
+        set_time(1000);
+    }
+
+    void TearDown() override {
+        debounce_free();
+    }
+
+    void init(bool left) {
+        isLeftHand = left;
+        matrix_init();
+    }
+
+    /* Scans at the given time, with the slave polled at the same time */
+    void scan_at(uint16_t time) {
+        set_time(time);
+        remote_poll_time = time;
+        matrix_scan();
+    }
+};
+
+TEST_F(SplitMatrixKeyTime, local_presses_are_reported_when_scanned) {
+    init(true);
+    local_matrix[1] = 0b100;
+    scan_at(1010);
+
+    EXPECT_TRUE(matrix_is_on(1, 2));
+    EXPECT_EQ(matrix_get_key_time(1, 2), 1010);
+}
+
+TEST_F(SplitMatrixKeyTime, local_releases_are_compensated_for_debouncing) {
+    init(true);
+    local_matrix[0] = 0b1;
+    scan_at(1010);
+    local_matrix[0] = 0;
+    scan_at(1020);
+    ASSERT_TRUE(matrix_is_on(0, 0));
+
+    // The release is only reported DEBOUNCE ms after it happened
+    scan_at(1020 + DEBOUNCE);
+    EXPECT_FALSE(matrix_is_on(0, 0));
+    EXPECT_EQ(matrix_get_key_time(0, 0), 1020);
+}
+
+TEST_F(SplitMatrixKeyTime, slave_keys_use_the_slave_times) {
+    init(true);
+    remote_matrix[1]       = 0b1000;
+    remote_key_times[1][3] = 1003;
+    scan_at(1010);
+
+    // The left half is the master, so the slave's rows come after its own
+    ASSERT_TRUE(matrix_is_on(ROWS_PER_HAND + 1, 3));
+    EXPECT_EQ(matrix_get_key_time(ROWS_PER_HAND + 1, 3), 1003);
+
+    remote_matrix[1]       = 0;
+    remote_key_times[1][3] = 1007;
+    scan_at(1020);
+    ASSERT_FALSE(matrix_is_on(ROWS_PER_HAND + 1, 3));
+    EXPECT_EQ(matrix_get_key_time(ROWS_PER_HAND + 1, 3), 1007 - DEBOUNCE);
+}
+
+TEST_F(SplitMatrixKeyTime, slave_rows_come_first_on_a_right_hand_master) {
+    init(false);
+    remote_matrix[0]       = 0b1;
+    remote_key_times[0][0] = 1003;
+    local_matrix[0]        = 0b1;
+    scan_at(1010);
+
+    ASSERT_TRUE(matrix_is_on(0, 0));
+    ASSERT_TRUE(matrix_is_on(ROWS_PER_HAND, 0));
+    EXPECT_EQ(matrix_get_key_time(0, 0), 1003);
+    EXPECT_EQ(matrix_get_key_time(ROWS_PER_HAND, 0), 1010);
+}
+
+TEST_F(SplitMatrixKeyTime, horizon_waits_for_the_slave_poll) {
+    init(true);
+    scan_at(1010);
+    EXPECT_EQ(matrix_get_time_horizon(), 1010 - DEBOUNCE);
+
+    // Slave changes since the last poll are not known yet
+    set_time(1030);
+    EXPECT_EQ(matrix_get_time_horizon(), 1010 - DEBOUNCE);
+}
+
+TEST_F(SplitMatrixKeyTime, horizon_ignores_a_disconnected_slave) {
+    init(true);
+    scan_at(1010);
+    connected = false;
+
+    set_time(1030);
+    EXPECT_EQ(matrix_get_time_horizon(), 1030 - DEBOUNCE);
+}
@@ -0,0 +1 @@
+TEST_LIST += split_matrix_events split_matrix_key_time
@@ -16,6 +16,10 @@
 
 #pragma once
 
+#ifdef __cplusplus
+#    define _Static_assert static_assert
+#endif
+
 enum serial_transaction_id {
 #ifdef USE_I2C
     I2C_EXECUTE_CALLBACK,
@@ -24,6 +28,11 @@ enum serial_transaction_id {
     GET_SLAVE_MATRIX_CHECKSUM,
     GET_SLAVE_MATRIX_DATA,
 
+#ifdef SPLIT_MATRIX_EVENTS_ENABLE
+    GET_SLAVE_MATRIX_EVENTS_HEAD,
+    GET_SLAVE_MATRIX_EVENTS,
+#endif // SPLIT_MATRIX_EVENTS_ENABLE
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     PUT_MASTER_MATRIX,
 #endif // SPLIT_TRANSPORT_MIRROR
@@ -31,7 +40,6 @@ enum serial_transaction_id {
 #ifdef ENCODER_ENABLE
     GET_ENCODERS_CHECKSUM,
     GET_ENCODERS_DATA,
-    CMD_ENCODER_DRAIN,
 #endif // ENCODER_ENABLE
 
 #ifndef DISABLE_SYNC_TIMER
@@ -178,6 +178,90 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
 ////////////////////////////////////////////////////
 // Slave matrix
 
+#ifdef SPLIT_MATRIX_EVENTS_ENABLE
+
+#    ifdef DISABLE_SYNC_TIMER
+#        error "SPLIT_MATRIX_EVENTS_ENABLE needs the sync timer for its event timestamps"
+#    endif // DISABLE_SYNC_TIMER
+
+static uint16_t slave_key_times[(MATRIX_ROWS) / 2][MATRIX_COLS] = {0};
+static uint16_t slave_poll_time                                 = 0;
+
+static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint32_t       last_update                    = 0;
+    static uint8_t        tail                           = 0; // count of the last event applied
+    static matrix_row_t   last_matrix[(MATRIX_ROWS) / 2] = {0};
+    matrix_row_t          temp_matrix[(MATRIX_ROWS) / 2];
+    split_matrix_events_t events;
+    uint16_t              poll_time = timer_read();
+
+    bool okay = transport_read(GET_SLAVE_MATRIX_EVENTS_HEAD, &events.head, sizeof(events.head));
+    if (okay && (timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS || events.head.count != tail || events.head.checksum != crc8(last_matrix, sizeof(last_matrix)))) {
+        memcpy(temp_matrix, last_matrix, sizeof(last_matrix));
+
+        // Replay what happened since the last poll, in order and with the slave's timestamps
+        bool synced = false;
+        if (events.head.count != tail && timer_elapsed32(last_update) < FORCED_SYNC_THROTTLE_MS) {
+            synced = transport_read(GET_SLAVE_MATRIX_EVENTS, events.events, sizeof(events.events)) && split_matrix_events_apply(&events, tail, temp_matrix, slave_key_times) && events.head.checksum == crc8(temp_matrix, sizeof(temp_matrix));
+        }
+
+        // Events were lost or this is a periodic resync, so fall back to the whole matrix
+        if (!synced) {
+            memcpy(temp_matrix, last_matrix, sizeof(last_matrix));
+            okay &= transport_read(GET_SLAVE_MATRIX_DATA, temp_matrix, sizeof(temp_matrix));
+            okay &= events.head.checksum == crc8(temp_matrix, sizeof(temp_matrix));
+            if (okay) {
+                uint16_t now = timer_read();
+                for (uint8_t row = 0; row < (MATRIX_ROWS) / 2; row++) {
+                    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                        if ((temp_matrix[row] ^ last_matrix[row]) & ((matrix_row_t)1 << col)) {
+                            slave_key_times[row][col] = now;
+                        }
+                    }
+                }
+                last_update = timer_read32();
+            }
+        }
+
+        if (okay) {
+            tail = events.head.count;
+            memcpy(last_matrix, temp_matrix, sizeof(temp_matrix));
+        }
+    }
+    if (okay) {
+        slave_poll_time = poll_time;
+    }
+    // Copy out the last-known-good matrix state to the slave matrix
+    memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
+    return okay;
+}
+
+static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_matrix_events_record(&split_shmem->smatrix_events, split_shmem->smatrix.matrix, slave_matrix, (MATRIX_ROWS) / 2, sync_timer_read());
+    memcpy(split_shmem->smatrix.matrix, slave_matrix, sizeof(split_shmem->smatrix.matrix));
+    split_shmem->smatrix.checksum             = crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
+    split_shmem->smatrix_events.head.checksum = split_shmem->smatrix.checksum;
+}
+
+uint16_t transactions_get_slave_key_time(uint8_t row, uint8_t col) {
+    return slave_key_times[row][col];
+}
+
+uint16_t transactions_get_slave_poll_time(void) {
+    return slave_poll_time;
+}
+
+// clang-format off
+#    define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
+    [GET_SLAVE_MATRIX_DATA]        = trans_target2initiator_initializer(smatrix.matrix), \
+    [GET_SLAVE_MATRIX_EVENTS_HEAD] = trans_target2initiator_initializer(smatrix_events.head), \
+    [GET_SLAVE_MATRIX_EVENTS]      = trans_target2initiator_initializer(smatrix_events.events),
+// clang-format on
+
+#else // SPLIT_MATRIX_EVENTS_ENABLE
+
 static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t     last_update                    = 0;
     static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
@@ -199,13 +283,15 @@ static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row
 }
 
 // clang-format off
-#define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
-#define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
-#define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
+#    define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
     [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum), \
     [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix),
 // clang-format on
 
+#endif // SPLIT_MATRIX_EVENTS_ENABLE
+
 ////////////////////////////////////////////////////
 // Master matrix
 
@@ -239,39 +325,33 @@ static void master_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_ro
 #ifdef ENCODER_ENABLE
 
 static bool encoder_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    static uint32_t  last_update   = 0;
-    static uint8_t   last_checksum = 0;
-    encoder_events_t temp_events;
+    static uint32_t         last_update = 0;
+    static encoder_counts_t last_counts = {0};
+    static bool             last_valid  = false;
+    encoder_counts_t        temp_counts;
 
-    bool okay = read_if_checksum_mismatch(GET_ENCODERS_CHECKSUM, GET_ENCODERS_DATA, &last_update, &temp_events, &split_shmem->encoders.events, sizeof(temp_events));
+    bool okay = read_if_checksum_mismatch(GET_ENCODERS_CHECKSUM, GET_ENCODERS_DATA, &last_update, &temp_counts, &split_shmem->encoders.counts, sizeof(temp_counts));
     if (okay) {
-        if (last_checksum != split_shmem->encoders.checksum) {
-            bool    actioned = false;
-            uint8_t index;
-            bool    clockwise;
-            while (okay && encoder_dequeue_event_advanced(&split_shmem->encoders.events, &index, &clockwise)) {
-                okay &= encoder_queue_event(index, clockwise);
-                actioned = true;
+        // The slave only ever adds to its running counts, so a missed or repeated read loses nothing.
+        // The first read after the link comes up only sets the baseline, the slave's counts may be anything by then.
+        for (uint8_t i = 0; last_valid && i < NUM_ENCODERS; i++) {
+            int16_t detents = split_shmem->encoders.counts.detents[i] - last_counts.detents[i];
+            if (detents != 0) {
+                encoder_queue_detents(i, detents);
             }
-
-            if (actioned) {
-                okay &= transport_exec(CMD_ENCODER_DRAIN);
-            }
-            last_checksum = split_shmem->encoders.checksum;
         }
+        memcpy(&last_counts, &split_shmem->encoders.counts, sizeof(last_counts));
     }
+    // The slave may have been reset while the link was down
+    last_valid = okay;
     return okay;
 }
 
 static void encoder_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     // Always prepare the encoder state for read.
-    encoder_retrieve_events(&split_shmem->encoders.events);
+    encoder_retrieve_counts(&split_shmem->encoders.counts);
     // Now update the checksum given that the encoders has been written to
-    split_shmem->encoders.checksum = crc8(&split_shmem->encoders.events, sizeof(split_shmem->encoders.events));
-}
-
-static void encoder_handlers_slave_drain(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
-    encoder_signal_queue_drain();
+    split_shmem->encoders.checksum = crc8(&split_shmem->encoders.counts, sizeof(split_shmem->encoders.counts));
 }
 
 // clang-format off
@@ -279,8 +359,7 @@ static void encoder_handlers_slave_drain(uint8_t initiator2target_buffer_size, c
 #    define TRANSACTIONS_ENCODERS_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(encoder)
 #    define TRANSACTIONS_ENCODERS_REGISTRATIONS \
     [GET_ENCODERS_CHECKSUM] = trans_target2initiator_initializer(encoders.checksum), \
-    [GET_ENCODERS_DATA]     = trans_target2initiator_initializer(encoders.events), \
-    [CMD_ENCODER_DRAIN]     = trans_initiator2target_cb(encoder_handlers_slave_drain),
+    [GET_ENCODERS_DATA]     = trans_target2initiator_initializer(encoders.counts),
 // clang-format on
 
 #else // ENCODER_ENABLE
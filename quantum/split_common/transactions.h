@@ -45,6 +45,13 @@ extern split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS];
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
+#ifdef SPLIT_MATRIX_EVENTS_ENABLE
+// sync_timer_read() time at which a key on the slave half last changed state, by row within the slave half
+uint16_t transactions_get_slave_key_time(uint8_t row, uint8_t col);
+// timer_read() time at which the slave matrix was last read successfully
+uint16_t transactions_get_slave_poll_time(void);
+#endif // SPLIT_MATRIX_EVENTS_ENABLE
+
 void transaction_register_rpc(int8_t transaction_id, slave_callback_t callback);
 
 bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
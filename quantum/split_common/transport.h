@@ -52,6 +52,10 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
 #    include "rgblight.h"
 #endif // RGBLIGHT_ENABLE
 
+#ifdef SPLIT_MATRIX_EVENTS_ENABLE
+#    include "split_matrix_events.h"
+#endif // SPLIT_MATRIX_EVENTS_ENABLE
+
 typedef struct _split_slave_matrix_sync_t {
     uint8_t      checksum;
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
@@ -66,7 +70,7 @@ typedef struct _split_master_matrix_sync_t {
 #ifdef ENCODER_ENABLE
 typedef struct _split_slave_encoder_sync_t {
     uint8_t          checksum;
-    encoder_events_t events;
+    encoder_counts_t counts;
 } split_slave_encoder_sync_t;
 #endif // ENCODER_ENABLE
 
@@ -154,6 +158,10 @@ typedef struct _split_shared_memory_t {
 
     split_slave_matrix_sync_t smatrix;
 
+#ifdef SPLIT_MATRIX_EVENTS_ENABLE
+    split_matrix_events_t smatrix_events;
+#endif // SPLIT_MATRIX_EVENTS_ENABLE
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     split_master_matrix_sync_t mmatrix;
 #endif // SPLIT_TRANSPORT_MIRROR
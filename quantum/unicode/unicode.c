@@ -36,17 +36,6 @@
 #    error "Cannot enable more than one Unicode method (UNICODE, UNICODEMAP, UCIS) at the same time"
 #endif
 
-// Keycodes used for starting Unicode input on different platforms
-#ifndef UNICODE_KEY_MAC
-#    define UNICODE_KEY_MAC KC_LEFT_ALT
-#endif
-#ifndef UNICODE_KEY_LNX
-#    define UNICODE_KEY_LNX LCTL(LSFT(KC_U))
-#endif
-#ifndef UNICODE_KEY_WINC
-#    define UNICODE_KEY_WINC KC_RIGHT_ALT
-#endif
-
 // Comma-delimited, ordered list of input modes selected for use (e.g. in cycle)
 // Example: #define UNICODE_SELECTED_MODES UNICODE_MODE_WINCOMPOSE, UNICODE_MODE_LINUX
 #ifndef UNICODE_SELECTED_MODES
@@ -58,11 +47,6 @@
 #    define UNICODE_CYCLE_PERSIST true
 #endif
 
-// Delay between starting Unicode input and sending a sequence, in ms
-#ifndef UNICODE_TYPE_DELAY
-#    define UNICODE_TYPE_DELAY 10
-#endif
-
 unicode_config_t unicode_config;
 uint8_t          unicode_saved_mods;
 led_t            unicode_saved_led_state;
@@ -332,9 +316,10 @@ void register_hex(uint16_t hex) {
     }
 }
 
-void register_hex32(uint32_t hex) {
-    bool first_digit        = true;
-    bool needs_leading_zero = (unicode_config.input_mode == UNICODE_MODE_WINCOMPOSE);
+uint8_t unicode_hex_digits(uint32_t hex, uint8_t *digits) {
+    uint8_t count              = 0;
+    bool    first_digit        = true;
+    bool    needs_leading_zero = (unicode_config.input_mode == UNICODE_MODE_WINCOMPOSE);
     for (int i = 7; i >= 0; i--) {
         // Work out the digit we're going to transmit
         uint8_t digit = ((hex >> (i * 4)) & 0xF);
@@ -342,7 +327,7 @@ void register_hex32(uint32_t hex) {
         // If we're still searching for the first digit, and found one
         // that needs a leading zero sent out, send the zero.
         if (first_digit && needs_leading_zero && digit > 9) {
-            send_nibble_wrapper(0);
+            digits[count++] = 0;
         }
 
         // Always send digits (including zero) if we're down to the last
@@ -351,27 +336,50 @@ void register_hex32(uint32_t hex) {
 
         // If we've found a digit worth transmitting, do so.
         if (digit != 0 || !first_digit || must_send) {
-            send_nibble_wrapper(digit);
-            first_digit = false;
+            digits[count++] = digit;
+            first_digit     = false;
         }
     }
+    return count;
 }
 
-void register_unicode(uint32_t code_point) {
+void register_hex32(uint32_t hex) {
+    uint8_t digits[9];
+    uint8_t count = unicode_hex_digits(hex, digits);
+    for (uint8_t i = 0; i < count; i++) {
+        send_nibble_wrapper(digits[i]);
+    }
+}
+
+uint8_t unicode_code_units(uint32_t code_point, uint32_t *units) {
     if (code_point > 0x10FFFF || (code_point > 0xFFFF && unicode_config.input_mode == UNICODE_MODE_WINDOWS)) {
-        // Code point out of range, do nothing
-        return;
+        // Code point out of range
+        return 0;
     }
 
-    unicode_input_start();
     if (code_point > 0xFFFF && unicode_config.input_mode == UNICODE_MODE_MACOS) {
         // Convert code point to UTF-16 surrogate pair on macOS
         code_point -= 0x10000;
         uint32_t lo = code_point & 0x3FF, hi = (code_point & 0xFFC00) >> 10;
-        register_hex32(hi + 0xD800);
-        register_hex32(lo + 0xDC00);
-    } else {
-        register_hex32(code_point);
+        units[0]    = hi + 0xD800;
+        units[1]    = lo + 0xDC00;
+        return 2;
+    }
+    units[0] = code_point;
+    return 1;
+}
+
+void register_unicode(uint32_t code_point) {
+    uint32_t units[2];
+    uint8_t  count = unicode_code_units(code_point, units);
+    if (count == 0) {
+        // Code point out of range, do nothing
+        return;
+    }
+
+    unicode_input_start();
+    for (uint8_t i = 0; i < count; i++) {
+        register_hex32(units[i]);
     }
     unicode_input_finish();
 }
@@ -17,6 +17,8 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "keyboard.h"
 #include "unicode_keycodes.h"
 
 /**
@@ -26,6 +28,22 @@
  * \{
  */
 
+// Keycodes used for starting Unicode input on different platforms
+#ifndef UNICODE_KEY_MAC
+#    define UNICODE_KEY_MAC KC_LEFT_ALT
+#endif
+#ifndef UNICODE_KEY_LNX
+#    define UNICODE_KEY_LNX LCTL(LSFT(KC_U))
+#endif
+#ifndef UNICODE_KEY_WINC
+#    define UNICODE_KEY_WINC KC_RIGHT_ALT
+#endif
+
+// Delay between starting Unicode input and sending a sequence, in ms
+#ifndef UNICODE_TYPE_DELAY
+#    define UNICODE_TYPE_DELAY 10
+#endif
+
 typedef union {
     uint8_t raw;
     struct {
@@ -117,6 +135,26 @@ void register_hex(uint16_t hex);
  */
 void register_hex32(uint32_t hex);
 
+/**
+ * \brief Work out the digits `register_hex32()` sends for a number in the current input mode.
+ *
+ * \param hex The number to send.
+ * \param digits Filled with the digits to send, most significant first. Must have room for 9 of them.
+ *
+ * \return The number of digits.
+ */
+uint8_t unicode_hex_digits(uint32_t hex, uint8_t *digits);
+
+/**
+ * \brief Work out the numbers to send for a code point in the current input mode.
+ *
+ * \param code_point The code point of the character to send.
+ * \param units Filled with the code point, or its surrogate pair if the input mode needs one. Must have room for 2 of them.
+ *
+ * \return The number of units, or 0 if the code point can't be sent in the current input mode.
+ */
+uint8_t unicode_code_units(uint32_t code_point, uint32_t *units);
+
 /**
  * \brief Input a single Unicode character. A surrogate pair will be sent if required by the input mode.
  *
@@ -131,4 +169,67 @@ void register_unicode(uint32_t code_point);
  */
 void send_unicode_string(const char *str);
 
+#if defined(UNICODE_ASYNC_ENABLE) || defined(__DOXYGEN__)
+/* Number of code points that can be queued at once, must be a power of two. */
+#    ifndef UNICODE_ASYNC_QUEUE_SIZE
+#        define UNICODE_ASYNC_QUEUE_SIZE 32
+#    endif
+
+/* Number of key events that can be held back while characters are being sent, must be a power of two. */
+#    ifndef UNICODE_ASYNC_EVENT_QUEUE_SIZE
+#        define UNICODE_ASYNC_EVENT_QUEUE_SIZE 8
+#    endif
+
+/**
+ * \brief Queue a single Unicode character to be sent in the background.
+ *
+ * \param code_point The code point of the character to send.
+ *
+ * \return false if the queue is full, in which case nothing was queued.
+ */
+bool register_unicode_async(uint32_t code_point);
+
+/**
+ * \brief Queue a string containing Unicode characters to be sent in the background.
+ *
+ * Consecutive characters are sent in a single input session: modifiers and lock keys are only saved and restored
+ * around the whole string, and on macOS the Unicode Hex Input key stays held down in between.
+ *
+ * \param str The string to send.
+ *
+ * \return false if there is not enough room in the queue, in which case nothing was queued.
+ */
+bool send_unicode_string_async(const char *str);
+
+/**
+ * \brief Whether any queued characters have not been fully sent yet.
+ */
+bool unicode_async_is_busy(void);
+
+/**
+ * \brief The number of queued characters that have not been fully sent yet.
+ */
+uint16_t unicode_async_remaining(void);
+
+/**
+ * \brief Discard everything that is queued, cancelling the character being sent.
+ */
+void unicode_async_cancel(void);
+
+/**
+ * \brief Pass a key event on to action_exec(), or hold it back while characters are being sent.
+ *
+ * Held back events are passed on once the input session is over, so keys typed in the meantime don't end up in the
+ * middle of it. Tick events are dropped in the meantime. Called from the matrix task.
+ *
+ * \return false if the event had to be held back but there was no room for it.
+ */
+bool unicode_async_action_exec(keyevent_t event);
+
+/**
+ * \brief Send the next part of the queued characters. Called from the keyboard task.
+ */
+void unicode_async_task(void);
+#endif
+
 /** \} */
@@ -0,0 +1,386 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "unicode.h"
+
+#include "action.h"
+#include "action_util.h"
+#include "host.h"
+#include "keycode.h"
+#include "send_string.h"
+#include "timer.h"
+#include "utf8.h"
+#include "quantum.h"
+
+_Static_assert((UNICODE_ASYNC_QUEUE_SIZE & (UNICODE_ASYNC_QUEUE_SIZE - 1)) == 0 && UNICODE_ASYNC_QUEUE_SIZE <= 128, "UNICODE_ASYNC_QUEUE_SIZE must be a power of two no larger than 128");
+_Static_assert((UNICODE_ASYNC_EVENT_QUEUE_SIZE & (UNICODE_ASYNC_EVENT_QUEUE_SIZE - 1)) == 0 && UNICODE_ASYNC_EVENT_QUEUE_SIZE <= 128, "UNICODE_ASYNC_EVENT_QUEUE_SIZE must be a power of two no larger than 128");
+
+#define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
+
+// Enough for starting a session, then a surrogate pair or a code point with its prefix and suffix
+#define SCRIPT_SIZE 24
+
+typedef enum {
+    STEP_TAP,
+    STEP_DOWN,
+    STEP_UP,
+    STEP_WAIT,
+    STEP_SAVE_MODS,
+    STEP_RESTORE_MODS,
+} unicode_step_type_t;
+
+typedef struct {
+    uint8_t  type;
+    uint16_t keycode;
+} unicode_step_t;
+
+static uint32_t queue[UNICODE_ASYNC_QUEUE_SIZE];
+static uint8_t  queue_head = 0;
+static uint8_t  queue_tail = 0;
+
+// Key events held back until the session is over, so the user's keys and mods don't mix with the sequence
+static keyevent_t events[UNICODE_ASYNC_EVENT_QUEUE_SIZE];
+static uint8_t    events_head = 0;
+static uint8_t    events_tail = 0;
+
+static unicode_step_t script[SCRIPT_SIZE];
+static uint8_t        script_length      = 0;
+static uint8_t        script_position    = 0;
+static bool           sending_code_point = false;
+static uint16_t       held_key           = KC_NO;
+static uint32_t       next_step          = 0;
+
+// Modifiers and lock keys are saved once per session, which spans as many queued characters as there are in a row
+static bool     in_session = false;
+static uint8_t  session_mode;
+static uint8_t  saved_mods;
+static led_t    saved_led_state;
+static uint16_t hex_keycodes[16];
+
+/* ---------------------------------------------------------------------------
+ * Scripts
+ * ------------------------------------------------------------------------ */
+
+static void add_step(uint8_t type, uint16_t keycode) {
+    script[script_length].type    = type;
+    script[script_length].keycode = keycode;
+    script_length++;
+}
+
+/* Look the digit keys up once per session rather than once per digit, as send_nibble() does */
+static void cache_hex_keycodes(void) {
+    for (uint8_t digit = 0; digit < 16; digit++) {
+        if (session_mode == UNICODE_MODE_WINDOWS) {
+            // For increased reliability, use numpad keys for inputting digits
+            hex_keycodes[digit] = digit < 10 ? KC_KP_1 + (10 + digit - 1) % 10 : KC_A + (digit - 10);
+            continue;
+        }
+
+        uint8_t  ascii_code = digit < 10 ? '0' + digit : 'a' + (digit - 10);
+        uint16_t keycode    = pgm_read_byte(&ascii_to_keycode_lut[ascii_code]);
+        if (PGM_LOADBIT(ascii_to_shift_lut, ascii_code)) {
+            keycode = LSFT(keycode);
+        }
+        if (PGM_LOADBIT(ascii_to_altgr_lut, ascii_code)) {
+            keycode = RALT(keycode);
+        }
+        hex_keycodes[digit] = keycode;
+    }
+}
+
+/* What unicode_input_start() does, apart from the parts that are repeated for every character */
+static void build_session_start(void) {
+    in_session      = true;
+    session_mode    = unicode_config.input_mode;
+    saved_led_state = host_keyboard_led_state();
+    cache_hex_keycodes();
+
+    // Caps Lock has to go before the mods are cleared, or else UNICODE_KEY_LNX might not work in the shifted case
+    if (session_mode == UNICODE_MODE_LINUX && saved_led_state.caps_lock) {
+        add_step(STEP_TAP, KC_CAPS_LOCK);
+    }
+    add_step(STEP_SAVE_MODS, KC_NO);
+
+    switch (session_mode) {
+        case UNICODE_MODE_MACOS:
+            // Unicode Hex Input takes any number of characters while the key is held down
+            add_step(STEP_DOWN, UNICODE_KEY_MAC);
+            add_step(STEP_WAIT, KC_NO);
+            break;
+        case UNICODE_MODE_WINDOWS:
+            if (!saved_led_state.num_lock) {
+                add_step(STEP_TAP, KC_NUM_LOCK);
+            }
+            break;
+    }
+}
+
+static void build_code_point(const uint32_t *units, uint8_t count) {
+    switch (session_mode) {
+        case UNICODE_MODE_LINUX:
+            add_step(STEP_TAP, UNICODE_KEY_LNX);
+            break;
+        case UNICODE_MODE_WINDOWS:
+            add_step(STEP_DOWN, KC_LEFT_ALT);
+            add_step(STEP_WAIT, KC_NO);
+            add_step(STEP_TAP, KC_KP_PLUS);
+            break;
+        case UNICODE_MODE_WINCOMPOSE:
+            add_step(STEP_TAP, UNICODE_KEY_WINC);
+            add_step(STEP_TAP, KC_U);
+            break;
+        case UNICODE_MODE_EMACS:
+            add_step(STEP_TAP, LCTL(KC_X));
+            add_step(STEP_TAP, KC_8);
+            add_step(STEP_TAP, KC_ENTER);
+            break;
+    }
+    if (session_mode != UNICODE_MODE_MACOS) {
+        add_step(STEP_WAIT, KC_NO);
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t digits[9];
+        uint8_t digit_count = unicode_hex_digits(units[i], digits);
+        for (uint8_t j = 0; j < digit_count; j++) {
+            add_step(STEP_TAP, hex_keycodes[digits[j]]);
+        }
+    }
+
+    switch (session_mode) {
+        case UNICODE_MODE_LINUX:
+            add_step(STEP_TAP, KC_SPACE);
+            break;
+        case UNICODE_MODE_WINDOWS:
+            add_step(STEP_UP, KC_LEFT_ALT);
+            break;
+        case UNICODE_MODE_WINCOMPOSE:
+        case UNICODE_MODE_EMACS:
+            add_step(STEP_TAP, KC_ENTER);
+            break;
+    }
+}
+
+/* The per character part of unicode_input_cancel() */
+static void build_cancel(void) {
+    switch (session_mode) {
+        case UNICODE_MODE_LINUX:
+        case UNICODE_MODE_WINCOMPOSE:
+            add_step(STEP_TAP, KC_ESCAPE);
+            break;
+        case UNICODE_MODE_WINDOWS:
+            add_step(STEP_UP, KC_LEFT_ALT);
+            break;
+        case UNICODE_MODE_EMACS:
+            add_step(STEP_TAP, LCTL(KC_G));
+            break;
+    }
+}
+
+/* What unicode_input_finish() does, apart from the parts that are repeated for every character */
+static void build_session_end(void) {
+    in_session = false;
+
+    switch (session_mode) {
+        case UNICODE_MODE_MACOS:
+            add_step(STEP_UP, UNICODE_KEY_MAC);
+            break;
+        case UNICODE_MODE_LINUX:
+            if (saved_led_state.caps_lock) {
+                add_step(STEP_TAP, KC_CAPS_LOCK);
+            }
+            break;
+        case UNICODE_MODE_WINDOWS:
+            if (!saved_led_state.num_lock) {
+                add_step(STEP_TAP, KC_NUM_LOCK);
+            }
+            break;
+    }
+    add_step(STEP_RESTORE_MODS, KC_NO);
+}
+
+static bool load_script(void) {
+    script_length      = 0;
+    script_position    = 0;
+    sending_code_point = false;
+
+    while (queue_tail != queue_head) {
+        uint32_t units[2];
+        uint8_t  count = unicode_code_units(queue[queue_tail & (UNICODE_ASYNC_QUEUE_SIZE - 1)], units);
+        if (count == 0) {
+            // Can't be sent in this input mode
+            queue_tail++;
+            continue;
+        }
+        if (in_session && session_mode != unicode_config.input_mode) {
+            // The input mode was changed, finish off the old one first
+            break;
+        }
+
+        queue_tail++;
+        if (!in_session) {
+            build_session_start();
+        }
+        build_code_point(units, count);
+        sending_code_point = true;
+        return true;
+    }
+
+    if (in_session) {
+        build_session_end();
+        return true;
+    }
+    return false;
+}
+
+/* ---------------------------------------------------------------------------
+ * Scheduler
+ * ------------------------------------------------------------------------ */
+
+/**
+ * Run the next step of the script, returning how long to wait before the one after.
+ */
+static uint16_t step(void) {
+    if (held_key != KC_NO) {
+        unregister_code16(held_key);
+        held_key = KC_NO;
+        return 0;
+    }
+
+    while (script_position < script_length || load_script()) {
+        unicode_step_t *current = &script[script_position++];
+        switch (current->type) {
+            case STEP_TAP:
+                register_code16(current->keycode);
+                held_key = current->keycode;
+                return current->keycode == KC_CAPS_LOCK ? TAP_HOLD_CAPS_DELAY : TAP_CODE_DELAY;
+            case STEP_DOWN:
+                register_code16(current->keycode);
+                return 0;
+            case STEP_UP:
+                unregister_code16(current->keycode);
+                return 0;
+            case STEP_WAIT:
+                return UNICODE_TYPE_DELAY;
+            case STEP_SAVE_MODS:
+                saved_mods = get_mods();
+                clear_mods();
+                clear_weak_mods();
+                break;
+            case STEP_RESTORE_MODS:
+                set_mods(saved_mods);
+                break;
+        }
+    }
+    return 0;
+}
+
+/* Pass on the key events held back during the session, in order, until one of them queues more characters */
+static void replay_events(void) {
+    while (events_tail != events_head && !unicode_async_is_busy()) {
+        action_exec(events[(events_tail++) & (UNICODE_ASYNC_EVENT_QUEUE_SIZE - 1)]);
+    }
+}
+
+void unicode_async_task(void) {
+    if (unicode_async_is_busy()) {
+        if (!timer_expired32(timer_read32(), next_step) || !host_keyboard_is_ready()) {
+            return;
+        }
+        uint16_t delay = step();
+        next_step      = timer_read32() + delay;
+    }
+    replay_events();
+}
+
+/* ---------------------------------------------------------------------------
+ * API
+ * ------------------------------------------------------------------------ */
+
+static void start_if_idle(void) {
+    if (!unicode_async_is_busy()) {
+        next_step = timer_read32();
+    }
+}
+
+bool register_unicode_async(uint32_t code_point) {
+    if ((uint8_t)(queue_head - queue_tail) >= UNICODE_ASYNC_QUEUE_SIZE) {
+        return false;
+    }
+    start_if_idle();
+    queue[(queue_head++) & (UNICODE_ASYNC_QUEUE_SIZE - 1)] = code_point;
+    return true;
+}
+
+bool send_unicode_string_async(const char *str) {
+    if (!str) {
+        return true;
+    }
+
+    uint16_t    count  = 0;
+    const char *cursor = str;
+    while (*cursor) {
+        int32_t code_point = 0;
+        cursor             = decode_utf8(cursor, &code_point);
+        if (code_point >= 0) {
+            count++;
+        }
+    }
+    if (count > UNICODE_ASYNC_QUEUE_SIZE - (uint8_t)(queue_head - queue_tail)) {
+        return false;
+    }
+
+    start_if_idle();
+    while (*str) {
+        int32_t code_point = 0;
+        str                = decode_utf8(str, &code_point);
+        if (code_point >= 0) {
+            queue[(queue_head++) & (UNICODE_ASYNC_QUEUE_SIZE - 1)] = code_point;
+        }
+    }
+    return true;
+}
+
+bool unicode_async_action_exec(keyevent_t event) {
+    if (!unicode_async_is_busy() && events_tail == events_head) {
+        action_exec(event);
+        return true;
+    }
+    if (IS_EVENT(event)) {
+        if ((uint8_t)(events_head - events_tail) >= UNICODE_ASYNC_EVENT_QUEUE_SIZE) {
+            return false;
+        }
+        events[(events_head++) & (UNICODE_ASYNC_EVENT_QUEUE_SIZE - 1)] = event;
+    }
+    return true;
+}
+
+bool unicode_async_is_busy(void) {
+    return queue_head != queue_tail || script_position < script_length || held_key != KC_NO || in_session;
+}
+
+uint16_t unicode_async_remaining(void) {
+    bool typing = sending_code_point && (script_position < script_length || held_key != KC_NO);
+    return (uint8_t)(queue_head - queue_tail) + (typing ? 1 : 0);
+}
+
+void unicode_async_cancel(void) {
+    queue_tail = queue_head;
+    if (held_key != KC_NO) {
+        unregister_code16(held_key);
+        held_key = KC_NO;
+    }
+    if (!in_session) {
+        // Nothing started, or the session is already being finished off
+        return;
+    }
+
+    bool cancel_code_point = sending_code_point && script_position < script_length;
+    script_length          = 0;
+    script_position        = 0;
+    sending_code_point     = false;
+    if (cancel_code_point) {
+        build_cancel();
+    }
+    build_session_end();
+}
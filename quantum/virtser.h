@@ -1,5 +1,8 @@
 #pragma once
 
+#include <stdint.h>
+#include <stdbool.h>
+
 void virtser_init(void);
 
 /* Define this function in your code to process incoming bytes */
@@ -7,3 +10,8 @@ void virtser_recv(const uint8_t ch);
 
 /* Call this to send a character over the Virtual Serial Device */
 void virtser_send(const uint8_t byte);
+
+/* Call this to send less than an endpoint's worth of characters in one go, without waiting for the host.
+ * Returns false if the endpoint has no room for them right now. When the port isn't in use, the data is
+ * dropped and true is returned. */
+bool virtser_send_buffer(const uint8_t *data, uint8_t length);
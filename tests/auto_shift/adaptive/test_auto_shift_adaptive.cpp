@@ -0,0 +1,247 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "eeconfig.h"
+}
+
+using testing::_;
+using testing::Invoke;
+
+#define TRACE_LEARNING_PASSES 6
+
+/* One keystroke of a typing trace: the character typed, how long its key is held, and the pause after it */
+struct stroke {
+    char     c;
+    uint16_t hold;
+    uint16_t gap;
+};
+
+/* A slow typist who holds their pinky keys longer than the rest, and holds
+ * capitals on purpose. Hold times vary by up to 40ms either way around each
+ * finger's habit, drawn from a fixed seed so the trace is the same every run. */
+static std::vector<stroke> typing_trace(void) {
+    const std::string text =
+        "Pack my box with five dozen liquor jugs. "
+        "A quick sprint past the plaza was all Paula wanted. "
+        "Sad lads saw a pale zebra nap on a warm quay. "
+        "Apples and papayas pile up as Opal packs a wax crate. "
+        "Zoe and Sam passed the salsa across a long wooden table. "
+        "Please wrap up all the quizzes and pass them along. ";
+    const std::string pinky = "aqzp.";
+    const std::string ring  = "swxol";
+
+    std::vector<stroke> trace;
+    uint32_t            seed   = 1;
+    auto                jitter = [&seed](uint16_t range) {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 16) % (range + 1);
+    };
+    for (char c : text) {
+        uint16_t hold;
+        if (isupper(c)) {
+            hold = 420;
+        } else if (pinky.find(c) != std::string::npos) {
+            hold = 140 + jitter(40) + jitter(40);
+        } else if (ring.find(c) != std::string::npos) {
+            hold = 110 + jitter(40) + jitter(40);
+        } else {
+            hold = 80 + jitter(40) + jitter(40);
+        }
+        trace.push_back({c, hold, (uint16_t)(80 + jitter(80))});
+    }
+    return trace;
+}
+
+static char char_for(uint8_t key, bool shifted) {
+    if (key >= KC_A && key <= KC_Z) {
+        return (shifted ? 'A' : 'a') + (key - KC_A);
+    }
+    switch (key) {
+        case KC_SPACE:
+            return ' ';
+        case KC_DOT:
+            return shifted ? '>' : '.';
+    }
+    return '?';
+}
+
+class AutoShiftAdaptive : public TestFixture {
+   public:
+    void SetUp() override {
+        autoshift_adaptive_reset();
+        std::string chars = "abcdefghijklmnopqrstuvwxyz .";
+        for (size_t i = 0; i < chars.size(); i++) {
+            auto key = KeymapKey(0, i % MATRIX_COLS, i / MATRIX_COLS, chars[i] == ' ' ? KC_SPACE : chars[i] == '.' ? KC_DOT : KC_A + (chars[i] - 'a'));
+            add_key(key);
+            keys.emplace(chars[i], key);
+        }
+    }
+
+    void record(TestDriver &driver) {
+        EXPECT_ANY_REPORT(driver).WillRepeatedly(Invoke([this](const report_keyboard_t &report) {
+            for (uint8_t key : report.keys) {
+                if (key != KC_NO && std::find(std::begin(previous.keys), std::end(previous.keys), key) == std::end(previous.keys)) {
+                    typed += char_for(key, report.mods & MOD_BIT(KC_LEFT_SHIFT));
+                }
+            }
+            previous = report;
+        }));
+    }
+
+    void hold_key(char c, uint16_t hold) {
+        KeymapKey &key = keys.at(tolower(c));
+        key.press();
+        run_one_scan_loop();
+        idle_for(hold - 1);
+        key.release();
+        run_one_scan_loop();
+    }
+
+    /* Replays the trace, forgetting everything learned before each keystroke unless `learn` is set */
+    void replay(const std::vector<stroke> &trace, bool learn) {
+        for (const stroke &s : trace) {
+            if (!learn) {
+                autoshift_adaptive_reset();
+            }
+            hold_key(s.c, s.hold);
+            idle_for(s.gap);
+        }
+    }
+
+    /* Counts lowercase keystrokes that came out shifted, and capitals that did not */
+    void score(const std::vector<stroke> &trace, int &false_shifts, int &missed_shifts) {
+        false_shifts  = 0;
+        missed_shifts = 0;
+        ASSERT_EQ(typed.size(), trace.size());
+        for (size_t i = 0; i < trace.size(); i++) {
+            if (isupper(trace[i].c)) {
+                missed_shifts += typed[i] != trace[i].c;
+            } else {
+                false_shifts += typed[i] != trace[i].c;
+            }
+        }
+    }
+
+    std::map<char, KeymapKey> keys;
+    report_keyboard_t         previous = {};
+    std::string               typed    = "";
+};
+
+TEST_F(AutoShiftAdaptive, UntrainedKeyUsesTheTimeout) {
+    EXPECT_EQ(get_autoshift_adaptive_timeout(KC_A), AUTO_SHIFT_TIMEOUT);
+    // Keys outside the tracked range always do
+    EXPECT_EQ(get_autoshift_adaptive_timeout(KC_ENTER), AUTO_SHIFT_TIMEOUT);
+}
+
+TEST_F(AutoShiftAdaptive, QuickTapsLowerTheTimeout) {
+    TestDriver driver;
+
+    record(driver);
+    for (int i = 0; i < AUTO_SHIFT_ADAPTIVE_MIN_SAMPLES; i++) {
+        hold_key('a', 40);
+        idle_for(100);
+    }
+    EXPECT_EQ(get_autoshift_adaptive_timeout(KC_A), AUTO_SHIFT_ADAPTIVE_TIMEOUT_MIN);
+    // Only for the key that was trained
+    EXPECT_EQ(get_autoshift_adaptive_timeout(KC_B), AUTO_SHIFT_TIMEOUT);
+
+    // Short of AUTO_SHIFT_TIMEOUT, but well past anything this key is usually held for
+    hold_key('a', AUTO_SHIFT_ADAPTIVE_TIMEOUT_MIN + 20);
+    hold_key('b', AUTO_SHIFT_ADAPTIVE_TIMEOUT_MIN + 20);
+    EXPECT_EQ(typed, std::string(AUTO_SHIFT_ADAPTIVE_MIN_SAMPLES, 'a') + "Ab");
+}
+
+TEST_F(AutoShiftAdaptive, RolledTapsRaiseTheTimeout) {
+    TestDriver driver;
+
+    record(driver);
+    // Held well past the timeout, but unshifted because the next key came down first
+    for (int i = 0; i < AUTO_SHIFT_ADAPTIVE_MIN_SAMPLES; i++) {
+        keys.at('a').press();
+        idle_for(50);
+        keys.at(' ').press();
+        idle_for(160);
+        keys.at('a').release();
+        run_one_scan_loop();
+        keys.at(' ').release();
+        idle_for(100);
+    }
+    const uint16_t timeout = get_autoshift_adaptive_timeout(KC_A);
+    EXPECT_GT(timeout, AUTO_SHIFT_TIMEOUT + 30);
+
+    hold_key('a', AUTO_SHIFT_TIMEOUT + 30);
+    hold_key('a', AUTO_SHIFT_ADAPTIVE_TIMEOUT_MAX + 10);
+    std::string expected;
+    for (int i = 0; i < AUTO_SHIFT_ADAPTIVE_MIN_SAMPLES; i++) {
+        expected += "a ";
+    }
+    EXPECT_EQ(typed, expected + "aA");
+}
+
+TEST_F(AutoShiftAdaptive, ShiftedPressesAreNotLearned) {
+    TestDriver driver;
+
+    record(driver);
+    for (int i = 0; i < AUTO_SHIFT_ADAPTIVE_MIN_SAMPLES; i++) {
+        hold_key('a', AUTO_SHIFT_TIMEOUT + 10);
+        idle_for(100);
+    }
+    EXPECT_EQ(typed, std::string(AUTO_SHIFT_ADAPTIVE_MIN_SAMPLES, 'A'));
+    EXPECT_EQ(get_autoshift_adaptive_timeout(KC_A), AUTO_SHIFT_TIMEOUT);
+}
+
+TEST_F(AutoShiftAdaptive, LearnedTimeoutIsStoredOncePerWindow) {
+    TestDriver driver;
+
+    record(driver);
+    for (int i = 0; i < AUTO_SHIFT_ADAPTIVE_WINDOW - 1; i++) {
+        hold_key('s', 60);
+        idle_for(100);
+    }
+    EXPECT_EQ(eeprom_read_byte(EECONFIG_AUTO_SHIFT + (KC_S - KC_A)), 0);
+
+    hold_key('s', 60);
+    EXPECT_EQ(eeprom_read_byte(EECONFIG_AUTO_SHIFT + (KC_S - KC_A)) * 2, get_autoshift_adaptive_timeout(KC_S));
+}
+
+TEST_F(AutoShiftAdaptive, TraceReplayFalseShiftRate) {
+    TestDriver                driver;
+    const std::vector<stroke> trace = typing_trace();
+    int                       fixed_false, fixed_missed, adaptive_false, adaptive_missed;
+
+    record(driver);
+
+    // Everything forgotten before every keystroke, so AUTO_SHIFT_TIMEOUT decides them all
+    replay(trace, false);
+    score(trace, fixed_false, fixed_missed);
+
+    // Learned over a few passes, then measured on one more
+    autoshift_adaptive_reset();
+    for (int pass = 0; pass < TRACE_LEARNING_PASSES; pass++) {
+        replay(trace, true);
+    }
+    typed = "";
+    replay(trace, true);
+    score(trace, adaptive_false, adaptive_missed);
+
+    RecordProperty("keystrokes", trace.size());
+    RecordProperty("fixed_false_shifts", fixed_false);
+    RecordProperty("adaptive_false_shifts", adaptive_false);
+
+    EXPECT_GT(fixed_false, 0);
+    EXPECT_LT(adaptive_false * 4, fixed_false);
+    // Intentional holds are still shifted
+    EXPECT_EQ(fixed_missed, 0);
+    EXPECT_EQ(adaptive_missed, 0);
+}
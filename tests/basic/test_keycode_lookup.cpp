@@ -0,0 +1,165 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class KeycodeLookup : public TestFixture {
+   public:
+    /* Runs a scan with `key` changing state, returning how many keymap lookups it took. */
+    uint32_t lookups_for(KeymapKey& key, bool pressed) {
+        uint32_t before = keymap_lookups;
+        if (pressed) {
+            key.press();
+        } else {
+            key.release();
+        }
+        run_one_scan_loop();
+        return keymap_lookups - before;
+    }
+};
+
+TEST_F(KeycodeLookup, PlainKeyIsLookedUpOncePerEvent) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EQ(lookups_for(key, true), 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_EQ(lookups_for(key, false), 1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeycodeLookup, ModTapIsLookedUpOncePerEvent) {
+    TestDriver driver;
+    InSequence s;
+    auto       key = KeymapKey(0, 0, 0, SFT_T(KC_A));
+
+    set_keymap({key});
+
+    // The tapping term checks on the following scans reuse the press lookup
+    EXPECT_NO_REPORT(driver);
+    EXPECT_EQ(lookups_for(key, true), 1);
+    uint32_t before = keymap_lookups;
+    idle_for(TAPPING_TERM / 2);
+    EXPECT_EQ(keymap_lookups - before, 0);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_EQ(lookups_for(key, false), 1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeycodeLookup, KeyOnMomentaryLayerIsLookedUpOncePerEvent) {
+    TestDriver driver;
+    auto       layer_key = KeymapKey(0, 0, 0, MO(1));
+    auto       key       = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({layer_key, key, KeymapKey(1, 1, 0, KC_B)});
+
+    EXPECT_NO_REPORT(driver);
+    EXPECT_EQ(lookups_for(layer_key, true), 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EQ(lookups_for(key, true), 1);
+    VERIFY_AND_CLEAR(driver);
+
+    // Released after the layer is gone, still resolved through the layer cache
+    EXPECT_NO_REPORT(driver);
+    EXPECT_EQ(lookups_for(layer_key, false), 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_EQ(lookups_for(key, false), 1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeycodeLookup, BufferedPressIsResolvedOnTheLayerItIsReplayedOn) {
+    TestDriver driver;
+    InSequence s;
+    auto       layer_key = KeymapKey(0, 0, 0, LT(1, KC_A));
+    auto       key       = KeymapKey(0, 1, 0, KC_B);
+
+    set_keymap({layer_key, key, KeymapKey(1, 1, 0, KC_C)});
+
+    // The press of key is looked up on layer 0 and buffered while the layer tap is undecided
+    EXPECT_NO_REPORT(driver);
+    layer_key.press();
+    run_one_scan_loop();
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Once the layer tap turns into a hold, the buffered press is replayed on layer 1
+    EXPECT_REPORT(driver, (KC_C));
+    idle_for(TAPPING_TERM);
+    EXPECT_TRUE(layer_state_is(1));
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    layer_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeycodeLookup, BufferedPressOutlivesManyLookupGenerations) {
+    TestDriver driver;
+    InSequence s;
+    auto       layer_key = KeymapKey(0, 0, 0, LT(1, KC_A));
+    auto       key       = KeymapKey(0, 1, 0, KC_B);
+
+    set_keymap({layer_key, key, KeymapKey(1, 1, 0, KC_C)});
+
+    EXPECT_NO_REPORT(driver);
+    layer_key.press();
+    run_one_scan_loop();
+    key.press();
+    run_one_scan_loop();
+    // Enough invalidations to wrap an 8 bit generation back to the one the buffered press was looked up in,
+    // together with the one from the layer tap turning into a hold
+    for (int i = 0; i < 254; i++) {
+        keymap_lookup_invalidate();
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_C));
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    layer_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeycodeLookup, LayerChangedByTheUserIsHonoured) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key, KeymapKey(1, 0, 0, KC_B)});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key);
+    VERIFY_AND_CLEAR(driver);
+
+    layer_on(1);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key);
+    VERIFY_AND_CLEAR(driver);
+}
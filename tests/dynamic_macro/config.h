@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+/* Room for only 8 events in the old keyrecord_t based format */
+#define DYNAMIC_MACRO_SIZE 8
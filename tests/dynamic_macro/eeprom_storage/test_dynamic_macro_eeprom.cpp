@@ -0,0 +1,53 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "eeprom.h"
+#include "eeconfig.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+class DynamicMacroEeprom : public TestFixture {};
+
+TEST_F(DynamicMacroEeprom, RecordedMacroSurvivesReload) {
+    TestDriver driver;
+    InSequence s;
+    auto       rec   = KeymapKey(0, 0, 0, DM_REC1);
+    auto       stop  = KeymapKey(0, 1, 0, DM_RSTP);
+    auto       play  = KeymapKey(0, 2, 0, DM_PLY1);
+    auto       key_a = KeymapKey(0, 3, 0, KC_A);
+    auto       key_b = KeymapKey(0, 4, 0, KC_B);
+
+    set_keymap({rec, stop, play, key_a, key_b});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_key(rec);
+    tap_keys(key_a, key_b);
+    tap_key(stop);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Header: magic, buffer size and both lengths */
+    uint8_t *addr = (uint8_t *)EECONFIG_SIZE;
+    EXPECT_EQ(eeprom_read_word((uint16_t *)addr), 0xD3AC);
+    EXPECT_EQ(eeprom_read_word((uint16_t *)(addr + 2)), DYNAMIC_MACRO_BUFFER_SIZE);
+    EXPECT_GT(eeprom_read_word((uint16_t *)(addr + 4)), 0);
+    EXPECT_EQ(eeprom_read_word((uint16_t *)(addr + 6)), 0);
+
+    /* Loading brings back the same macro */
+    dynamic_macro_init();
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(play);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,55 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+class DynamicMacroRealtime : public TestFixture {};
+
+TEST_F(DynamicMacroRealtime, PlaybackKeepsRecordedTiming) {
+    TestDriver driver;
+    InSequence s;
+    auto       rec   = KeymapKey(0, 0, 0, DM_REC1);
+    auto       stop  = KeymapKey(0, 1, 0, DM_RSTP);
+    auto       play  = KeymapKey(0, 2, 0, DM_PLY1);
+    auto       key_a = KeymapKey(0, 3, 0, KC_A);
+
+    set_keymap({rec, stop, play, key_a});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_key(rec);
+    tap_key(key_a, 20);
+    idle_for(200);
+    tap_key(key_a, 50);
+    tap_key(stop);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    tap_key(play);
+    VERIFY_AND_CLEAR(driver);
+
+    /* The key is held for as long as it was while recording */
+    EXPECT_NO_REPORT(driver);
+    idle_for(18);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(2);
+    VERIFY_AND_CLEAR(driver);
+
+    /* ... and so is the pause, which needs more than the 5 bits of the header */
+    EXPECT_NO_REPORT(driver);
+    idle_for(199);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_REPORT(driver, (KC_A));
+    idle_for(2);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(50);
+    VERIFY_AND_CLEAR(driver);
+}
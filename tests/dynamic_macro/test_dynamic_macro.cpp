@@ -0,0 +1,193 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+/* Size of an encoded key event: the header, which holds short time deltas, and the key index */
+#define EVENT_SIZE 2
+
+class DynamicMacro : public TestFixture {
+   protected:
+    KeymapKey rec1  = KeymapKey(0, 0, 0, DM_REC1);
+    KeymapKey rec2  = KeymapKey(0, 1, 0, DM_REC2);
+    KeymapKey stop  = KeymapKey(0, 2, 0, DM_RSTP);
+    KeymapKey play1 = KeymapKey(0, 3, 0, DM_PLY1);
+    KeymapKey play2 = KeymapKey(0, 4, 0, DM_PLY2);
+    KeymapKey key_a = KeymapKey(0, 5, 0, KC_A);
+    KeymapKey key_b = KeymapKey(0, 6, 0, KC_B);
+    KeymapKey shift = KeymapKey(0, 7, 0, KC_LSFT);
+
+    void SetUp() override {
+        set_keymap({rec1, rec2, stop, play1, play2, key_a, key_b, shift});
+
+        /* Macros outlive a test, start each one with both of them empty */
+        TestDriver driver;
+        record(driver, rec1, []() {});
+        record(driver, rec2, []() {});
+    }
+
+    void record(TestDriver &driver, KeymapKey &start, std::function<void()> keys) {
+        EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+        tap_key(start);
+        keys();
+        tap_key(stop);
+        VERIFY_AND_CLEAR(driver);
+    }
+
+    void play(KeymapKey &key) {
+        tap_key(key);
+        idle_for(100);
+    }
+};
+
+TEST_F(DynamicMacro, ReplayMatchesRecording) {
+    TestDriver driver;
+    InSequence s;
+
+    record(driver, rec1, [&]() {
+        shift.press();
+        run_one_scan_loop();
+        tap_key(key_a);
+        shift.release();
+        run_one_scan_loop();
+        tap_key(key_b);
+    });
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_A));
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    play(play1);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Playing again gives the same result */
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_A));
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    play(play1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, PlaybackDoesNotBlockTheKeyboardTask) {
+    TestDriver driver;
+    InSequence s;
+
+    record(driver, rec1, [&]() { tap_keys(key_a, key_b, key_a); });
+
+    /* The first event goes out in the same scan that triggers the playback */
+    EXPECT_REPORT(driver, (KC_A));
+    tap_key(play1);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Afterwards, each scan sends one event */
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, FitsThreeTimesTheKeyrecordCapacity) {
+    TestDriver driver;
+    const int  taps = DYNAMIC_MACRO_SIZE * 3 / 2;
+
+    ASSERT_LE(2 * taps * EVENT_SIZE, DYNAMIC_MACRO_BUFFER_SIZE);
+
+    record(driver, rec1, [&]() {
+        for (int i = 0; i < taps; i++) {
+            tap_key(key_a);
+        }
+    });
+
+    EXPECT_REPORT(driver, (KC_A)).Times(taps);
+    EXPECT_EMPTY_REPORT(driver).Times(taps);
+    play(play1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, FullBufferTruncatesTheRecording) {
+    TestDriver driver;
+    const int  stored_events = DYNAMIC_MACRO_BUFFER_SIZE / EVENT_SIZE;
+    const int  stored_taps   = stored_events / 2; // a trailing key-down is trimmed
+
+    record(driver, rec1, [&]() {
+        for (int i = 0; i < stored_taps + 10; i++) {
+            tap_key(key_a);
+        }
+    });
+
+    EXPECT_REPORT(driver, (KC_A)).Times(stored_taps);
+    EXPECT_EMPTY_REPORT(driver).Times(stored_taps);
+    play(play1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, BothMacrosShareTheBuffer) {
+    TestDriver driver;
+    InSequence s;
+
+    record(driver, rec2, [&]() { tap_keys(key_b, key_b); });
+    record(driver, rec1, [&]() { tap_keys(key_a, key_a, key_a); });
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    play(play2);
+    VERIFY_AND_CLEAR(driver);
+
+    for (int i = 0; i < 3; i++) {
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    play(play1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, NestedPlaybackIsSpliced) {
+    TestDriver driver;
+    InSequence s;
+
+    record(driver, rec2, [&]() { tap_key(key_b); });
+    record(driver, rec1, [&]() { tap_keys(key_a, play2, key_a); });
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    play(play1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, RecursivePlaybackIsIgnored) {
+    TestDriver driver;
+    InSequence s;
+
+    record(driver, rec1, [&]() { tap_keys(key_a, play1); });
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    play(play1);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,153 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+
+namespace {
+
+struct RecordedEvent {
+    uint8_t  row;
+    uint8_t  col;
+    bool     pressed;
+    uint16_t time;
+};
+
+std::vector<RecordedEvent> recorded_events;
+
+// How long before the scan each key changed, for keys that report it
+std::map<std::pair<uint8_t, uint8_t>, int16_t> key_ages;
+
+} // namespace
+
+extern "C" uint16_t matrix_get_key_time(uint8_t row, uint8_t col) {
+    auto age = key_ages.find({row, col});
+    return timer_read() - (age == key_ages.end() ? 0 : age->second);
+}
+
+extern "C" bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    recorded_events.push_back({record->event.key.row, record->event.key.col, record->event.pressed, record->event.time});
+    return true;
+}
+
+class KeyEventOrder : public TestFixture {
+   public:
+    void SetUp() override {
+        recorded_events.clear();
+        key_ages.clear();
+    }
+};
+
+TEST_F(KeyEventOrder, OlderKeyIsProcessedFirst) {
+    TestDriver driver;
+    auto       key_a     = KeymapKey(0, 0, 0, KC_A);
+    auto       key_shift = KeymapKey(0, 0, 1, KC_LSFT);
+    set_keymap({key_a, key_shift});
+
+    // Start later than any earlier key event
+    idle_for(10);
+
+    // Shift went down 5ms before A, but only got reported in the same scan
+    key_ages[{1, 0}] = 5;
+    key_a.press();
+    key_shift.press();
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_A));
+    uint16_t now = timer_read();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    ASSERT_EQ(recorded_events.size(), 2u);
+    EXPECT_EQ(recorded_events[0].row, 1);
+    EXPECT_EQ(recorded_events[0].time, (uint16_t)(now - 5));
+    EXPECT_EQ(recorded_events[1].row, 0);
+    EXPECT_EQ(recorded_events[1].time, now);
+
+    key_a.release();
+    key_shift.release();
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyEventOrder, SameTimeKeepsMatrixOrder) {
+    TestDriver driver;
+    auto       key_a     = KeymapKey(0, 0, 0, KC_A);
+    auto       key_shift = KeymapKey(0, 0, 1, KC_LSFT);
+    set_keymap({key_a, key_shift});
+
+    key_a.press();
+    key_shift.press();
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_A));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    ASSERT_EQ(recorded_events.size(), 2u);
+    EXPECT_EQ(recorded_events[0].row, 0);
+    EXPECT_EQ(recorded_events[1].row, 1);
+    EXPECT_EQ(recorded_events[0].time, recorded_events[1].time);
+
+    key_a.release();
+    key_shift.release();
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyEventOrder, EventTimesNeverGoBackwards) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 0, 1, KC_B);
+    set_keymap({key_a, key_b});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    key_a.press();
+    uint16_t now = timer_read();
+    run_one_scan_loop();
+
+    // B happened before A, but arrives one scan too late to be ordered before it
+    key_ages[{1, 0}] = 10;
+    key_b.press();
+    run_one_scan_loop();
+
+    ASSERT_EQ(recorded_events.size(), 2u);
+    EXPECT_EQ(recorded_events[1].row, 1);
+    EXPECT_EQ(recorded_events[1].time, now);
+
+    key_a.release();
+    key_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyEventOrder, FutureTimeIsTreatedAsNow) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 0, 1, KC_B);
+    set_keymap({key_a, key_b});
+
+    key_ages[{0, 0}] = -3;
+    key_a.press();
+    key_b.press();
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    uint16_t now = timer_read();
+    run_one_scan_loop();
+
+    ASSERT_EQ(recorded_events.size(), 2u);
+    EXPECT_EQ(recorded_events[0].row, 0);
+    EXPECT_EQ(recorded_events[0].time, now);
+    EXPECT_EQ(recorded_events[1].time, now);
+
+    key_a.release();
+    key_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,112 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Measures how often tap-hold and auto shift decisions match what was physically typed, when the matrix reports releases
+late. The tests scan through quantum/matrix_common.c and asym_eager_defer_pk debouncing, which reports presses at once
+and holds releases back by DEBOUNCE ms, once with DEBOUNCE_COMPENSATION and once without.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::Invoke;
+
+/* A change of the switch `time` ms into a trace */
+struct PhysicalEvent {
+    uint16_t time;
+    bool     pressed;
+};
+
+/* How many decisions matched the physical trace */
+struct Accuracy {
+    int correct = 0;
+    int total   = 0;
+};
+
+static bool has_key(const report_keyboard_t &report, uint8_t keycode) {
+    return std::find(std::begin(report.keys), std::end(report.keys), keycode) != std::end(report.keys);
+}
+
+static bool has_shift(const report_keyboard_t &report) {
+    return report.mods & MOD_BIT(KC_LSFT);
+}
+
+static void print_accuracy(const char *scenario, const Accuracy &accuracy) {
+    printf("%-30s %-16s %3d/%-3d correct\n", scenario,
+#ifdef DEBOUNCE_COMPENSATION
+           "key times",
+#else
+           "detection times",
+#endif
+           accuracy.correct, accuracy.total);
+}
+
+class KeyEventTime : public TestFixture {
+   public:
+    /* Types `events` on `key`, returning every report sent to the host */
+    std::vector<report_keyboard_t> simulate(KeymapKey key, const std::vector<PhysicalEvent> &events) {
+        TestDriver                     driver;
+        std::vector<report_keyboard_t> reports;
+        EXPECT_CALL(driver, send_keyboard_mock(_)).WillRepeatedly(Invoke([&reports](report_keyboard_t &report) { reports.push_back(report); }));
+
+        uint16_t start = timer_read();
+        for (auto &event : events) {
+            while (timer_read() != (uint16_t)(start + event.time)) {
+                run_one_scan_loop();
+            }
+            if (event.pressed) {
+                key.press();
+            } else {
+                key.release();
+            }
+        }
+        idle_for(TAPPING_TERM * 2);
+        testing::Mock::VerifyAndClearExpectations(&driver);
+
+        return reports;
+    }
+
+    /* Holds a mod-tap key for about TAPPING_TERM, counting the holds decided as a tap or a hold correctly */
+    Accuracy tap_hold_accuracy(void) {
+        auto mod_tap = KeymapKey(0, 0, 0, LSFT_T(KC_F3));
+        set_keymap({mod_tap});
+        autoshift_disable();
+
+        Accuracy accuracy;
+        for (uint16_t hold = TAPPING_TERM - 10; hold <= TAPPING_TERM + 10; hold++) {
+            auto reports = simulate(mod_tap, {{0, true}, {hold, false}});
+            bool tapped  = std::any_of(reports.begin(), reports.end(), [](auto &report) { return has_key(report, KC_F3); });
+            bool held    = std::any_of(reports.begin(), reports.end(), has_shift);
+
+            EXPECT_NE(tapped, held) << "hold " << hold;
+            accuracy.correct += tapped == (hold < TAPPING_TERM);
+            accuracy.total++;
+        }
+        return accuracy;
+    }
+
+    /* Holds a key for about AUTO_SHIFT_TIMEOUT, counting the holds shifted or not correctly */
+    Accuracy auto_shift_accuracy(void) {
+        auto key_a = KeymapKey(0, 0, 0, KC_A);
+        set_keymap({key_a});
+        autoshift_enable();
+
+        Accuracy accuracy;
+        for (uint16_t hold = AUTO_SHIFT_TIMEOUT - 10; hold <= AUTO_SHIFT_TIMEOUT + 10; hold++) {
+            auto reports = simulate(key_a, {{0, true}, {hold, false}});
+            bool shifted = std::any_of(reports.begin(), reports.end(), [](auto &report) { return has_key(report, KC_A) && has_shift(report); });
+
+            accuracy.correct += shifted == (hold >= AUTO_SHIFT_TIMEOUT);
+            accuracy.total++;
+        }
+        return accuracy;
+    }
+};
@@ -0,0 +1,6 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+CUSTOM_MATRIX = lite
+DEBOUNCE_TYPE = asym_eager_defer_pk
+AUTO_SHIFT_ENABLE = yes
@@ -0,0 +1,16 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "key_event_time.hpp"
+
+TEST_F(KeyEventTime, TapHoldWithDeferredRelease) {
+    Accuracy accuracy = tap_hold_accuracy();
+    print_accuracy("tap-hold, deferred release", accuracy);
+    EXPECT_EQ(accuracy.correct, accuracy.total);
+}
+
+TEST_F(KeyEventTime, AutoShiftWithDeferredRelease) {
+    Accuracy accuracy = auto_shift_accuracy();
+    print_accuracy("auto shift, deferred release", accuracy);
+    EXPECT_EQ(accuracy.correct, accuracy.total);
+}
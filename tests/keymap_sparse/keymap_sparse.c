@@ -0,0 +1,50 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "quantum.h"
+
+// clang-format off
+
+// The dense keymap the sparse one below was generated from, by `qmk json2c` with "keymap_format": "sparse". The
+// outermost positions of the bottom row are not part of the layout.
+const uint16_t keymaps_dense[][MATRIX_ROWS][MATRIX_COLS] = {
+    [0] = {
+        {KC_Q, KC_W, KC_E, KC_R, KC_T, KC_Y, KC_U, KC_I, KC_O, KC_P},
+        {KC_A, KC_S, KC_D, KC_F, KC_G, KC_H, KC_J, KC_K, KC_L, KC_SCLN},
+        {KC_Z, KC_X, KC_C, KC_V, KC_B, KC_N, KC_M, KC_COMM, KC_DOT, KC_SLSH},
+        {KC_NO, KC_LCTL, KC_LALT, MO(1), KC_SPC, KC_SPC, MO(2), KC_RALT, KC_RCTL, KC_NO},
+    },
+    [1] = {
+        {KC_1, KC_2, KC_3, KC_4, KC_5, KC_6, KC_7, KC_8, KC_9, KC_0},
+        {KC_NO, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS},
+        {KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_BSLS},
+        {KC_NO, KC_TRNS, KC_TRNS, KC_TRNS, KC_ENT, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_NO},
+    },
+    [2] = {
+        {KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS},
+        {KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS},
+        {KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS},
+        {KC_NO, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, KC_TRNS, QK_BOOT, KC_NO},
+    },
+};
+
+// Sparse keymap, see keycode_at_keymap_location_raw() in keymap_introspection.c
+#define KEYMAP_SPARSE
+
+const uint32_t PROGMEM keymap_sparse_bitmap[] = {
+    /* 0 */ 0xBFFFFFFF, 0x0000007F,
+    /* 1 */ 0x200007FF, 0x00000004,
+    /* 2 */ 0x00000000, 0x00000040,
+};
+const uint16_t PROGMEM keymap_sparse_index[] = {
+    /* 0 */ 0, 31,
+    /* 1 */ 38, 50,
+    /* 2 */ 51, 51,
+};
+const uint16_t PROGMEM keymap_sparse_keycodes[] = {
+    /* 0 */ KC_Q, KC_W, KC_E, KC_R, KC_T, KC_Y, KC_U, KC_I, KC_O, KC_P, KC_A, KC_S, KC_D, KC_F, KC_G, KC_H, KC_J, KC_K, KC_L, KC_SCLN, KC_Z, KC_X, KC_C, KC_V, KC_B, KC_N, KC_M, KC_COMM, KC_DOT, KC_SLSH, KC_LCTL, KC_LALT, MO(1), KC_SPC, KC_SPC, MO(2), KC_RALT, KC_RCTL,
+    /* 1 */ KC_1, KC_2, KC_3, KC_4, KC_5, KC_6, KC_7, KC_8, KC_9, KC_0, KC_NO, KC_BSLS, KC_ENT,
+    /* 2 */ QK_BOOT,
+};
+const uint32_t PROGMEM keymap_sparse_unused[] = {0x40000000, 0x00000080};
+
+// clang-format on
@@ -0,0 +1,33 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "keymap_introspection.h"
+
+extern const uint16_t keymaps_dense[][MATRIX_ROWS][MATRIX_COLS];
+}
+
+class KeymapSparse : public TestFixture {};
+
+TEST_F(KeymapSparse, layer_count_matches_dense_keymap) {
+    EXPECT_EQ(keymap_layer_count_raw(), 3);
+}
+
+TEST_F(KeymapSparse, every_position_matches_dense_keymap) {
+    for (uint8_t layer = 0; layer < keymap_layer_count_raw(); layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                EXPECT_EQ(keycode_at_keymap_location_raw(layer, row, col), keymaps_dense[layer][row][col]) << "layer " << +layer << ", row " << +row << ", col " << +col;
+            }
+        }
+    }
+}
+
+TEST_F(KeymapSparse, out_of_range_is_transparent) {
+    EXPECT_EQ(keycode_at_keymap_location_raw(3, 0, 0), KC_TRNS);
+    EXPECT_EQ(keycode_at_keymap_location_raw(0, MATRIX_ROWS, 0), KC_TRNS);
+    EXPECT_EQ(keycode_at_keymap_location_raw(0, 0, MATRIX_COLS), KC_TRNS);
+}
@@ -0,0 +1,38 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+/* 512 four key sequences Q ? ? ?, for the benchmark */
+#define BENCHMARK_SEQUENCE(a, b) LEADER_SEQUENCE(KC_F1, KC_Q, a, b, KC_R), LEADER_SEQUENCE(KC_F1, KC_Q, a, b, KC_S), LEADER_SEQUENCE(KC_F1, KC_Q, a, b, KC_T), LEADER_SEQUENCE(KC_F1, KC_Q, a, b, KC_U), LEADER_SEQUENCE(KC_F1, KC_Q, a, b, KC_V), LEADER_SEQUENCE(KC_F1, KC_Q, a, b, KC_W), LEADER_SEQUENCE(KC_F1, KC_Q, a, b, KC_X), LEADER_SEQUENCE(KC_F2, KC_Q, a, b, KC_Y)
+#define BENCHMARK_SEQUENCES(a) BENCHMARK_SEQUENCE(a, KC_R), BENCHMARK_SEQUENCE(a, KC_S), BENCHMARK_SEQUENCE(a, KC_T), BENCHMARK_SEQUENCE(a, KC_U), BENCHMARK_SEQUENCE(a, KC_V), BENCHMARK_SEQUENCE(a, KC_W), BENCHMARK_SEQUENCE(a, KC_X), BENCHMARK_SEQUENCE(a, KC_Y)
+
+// clang-format off
+LEADER_SEQUENCES(
+    LEADER_SEQUENCE(KC_1, KC_A),
+    LEADER_SEQUENCE(KC_2, KC_A, KC_B),
+    LEADER_SEQUENCE(KC_3, KC_A, KC_B, KC_C),
+    // Not grouped by prefix
+    LEADER_SEQUENCE(KC_7, KC_M, KC_N, KC_O),
+    LEADER_SEQUENCE(KC_4, KC_C, KC_D, KC_E),
+    LEADER_SEQUENCE(KC_5, KC_C, KC_D, KC_F),
+    LEADER_SEQUENCE(KC_8, KC_M, KC_P),
+    LEADER_SEQUENCE(KC_6, KC_F, KC_G, KC_H, KC_I, KC_J, KC_K, KC_L),
+    LEADER_SEQUENCE(KC_9, KC_M, KC_N, KC_Q),
+    BENCHMARK_SEQUENCES(KC_R),
+    BENCHMARK_SEQUENCES(KC_S),
+    BENCHMARK_SEQUENCES(KC_T),
+    BENCHMARK_SEQUENCES(KC_U),
+    BENCHMARK_SEQUENCES(KC_V),
+    BENCHMARK_SEQUENCES(KC_W),
+    BENCHMARK_SEQUENCES(KC_X),
+    BENCHMARK_SEQUENCES(KC_Y)
+)
+// clang-format on
+
+bool leader_benchmark = false;
+
+bool leader_sequence_matched_user(uint16_t keycode) {
+    // The benchmark only measures the matching
+    return !leader_benchmark;
+}
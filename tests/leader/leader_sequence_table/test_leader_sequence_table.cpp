@@ -0,0 +1,214 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <map>
+#include <string>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+extern bool leader_benchmark;
+}
+
+using testing::_;
+
+#define BENCHMARK_ITERATIONS 20
+
+class LeaderSequenceTable : public TestFixture {
+   public:
+    void SetUp() override {
+        leader_benchmark = false;
+        add_key(key_leader);
+        std::string letters = "abcdefghijklmnopqrstuvwxyz";
+        for (size_t i = 0; i < letters.size(); i++) {
+            auto key = KeymapKey(0, (i + 1) % MATRIX_COLS, (i + 1) / MATRIX_COLS, KC_A + i);
+            add_key(key);
+            keys.emplace(letters[i], key);
+        }
+    }
+
+    void type(const std::string &sequence) {
+        tap_key(key_leader);
+        for (char c : sequence) {
+            tap_key(keys.at(c));
+        }
+    }
+
+    KeymapKey                 key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    std::map<char, KeymapKey> keys;
+};
+
+TEST_F(LeaderSequenceTable, PrefixOfALongerSequenceWaitsForTheTimeout) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    type("a");
+    EXPECT_TRUE(leader_sequence_active());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_1));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(LEADER_TIMEOUT);
+    EXPECT_FALSE(leader_sequence_active());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LeaderSequenceTable, MiddleOfAChainWaitsForTheTimeout) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    type("ab");
+    EXPECT_TRUE(leader_sequence_active());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_2));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(LEADER_TIMEOUT);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LeaderSequenceTable, LongestOfAChainFiresImmediately) {
+    TestDriver driver;
+
+    EXPECT_REPORT(driver, (KC_3));
+    EXPECT_EMPTY_REPORT(driver);
+    type("abc");
+    EXPECT_FALSE(leader_sequence_active());
+    VERIFY_AND_CLEAR(driver);
+
+    // Nothing else fires at the timeout
+    EXPECT_NO_REPORT(driver);
+    idle_for(LEADER_TIMEOUT);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LeaderSequenceTable, SiblingsAreToldApartByTheirLastKey) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    type("cd");
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_5));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(keys.at('f'));
+    EXPECT_FALSE(leader_sequence_active());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_4));
+    EXPECT_EMPTY_REPORT(driver);
+    type("cde");
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LeaderSequenceTable, UngroupedTableStillMatches) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    type("mn");
+    EXPECT_TRUE(leader_sequence_active());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_9));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(keys.at('q'));
+    EXPECT_FALSE(leader_sequence_active());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_7));
+    EXPECT_EMPTY_REPORT(driver);
+    type("mno");
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_8));
+    EXPECT_EMPTY_REPORT(driver);
+    type("mp");
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LeaderSequenceTable, SequenceLongerThanFiveKeys) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    type("fghijk");
+    EXPECT_TRUE(leader_sequence_active());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_6));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(keys.at('l'));
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LeaderSequenceTable, IncompleteSequenceSendsNothing) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    type("fgh");
+    idle_for(LEADER_TIMEOUT);
+    EXPECT_FALSE(leader_sequence_active());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LeaderSequenceTable, UnknownSequenceSendsNothing) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    type("az");
+    idle_for(LEADER_TIMEOUT);
+    VERIFY_AND_CLEAR(driver);
+
+    // Keys are processed normally again afterwards
+    EXPECT_REPORT(driver, (KC_Z));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(keys.at('z'));
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LeaderSequenceTable, MatchingLatency) {
+    const leader_sequence_t *table = leader_sequences_get();
+    const uint16_t           count = leader_sequences_count();
+    const uint16_t           first = 9;
+
+    leader_benchmark = true;
+    ASSERT_GE(count - first, 500);
+
+    // Matched as the keys come in
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        for (uint16_t s = first; s < count; s++) {
+            leader_start();
+            for (uint8_t k = 0; k < 4; k++) {
+                leader_sequence_add(table[s].keys[k]);
+            }
+            ASSERT_FALSE(leader_sequence_active());
+        }
+    }
+    auto trie = std::chrono::steady_clock::now() - start;
+
+    // Compared against every sequence in turn once the sequence is complete, as leader_end_user() chains do
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        for (uint16_t s = first; s < count; s++) {
+            leader_start();
+            for (uint8_t k = 0; k < 4; k++) {
+                leader_sequence_add(table[s].keys[k]);
+            }
+            uint16_t match = first;
+            while (!leader_sequence_four_keys(table[match].keys[0], table[match].keys[1], table[match].keys[2], table[match].keys[3])) {
+                match++;
+            }
+            ASSERT_EQ(match, s);
+        }
+    }
+    auto chain = std::chrono::steady_clock::now() - start - trie;
+
+    const long lookups = (long)BENCHMARK_ITERATIONS * (count - first);
+    RecordProperty("sequences", count);
+    RecordProperty("trie_ns_per_sequence", std::chrono::duration_cast<std::chrono::nanoseconds>(trie).count() / lookups);
+    RecordProperty("chain_ns_per_sequence", std::chrono::duration_cast<std::chrono::nanoseconds>(chain).count() / lookups);
+}
@@ -0,0 +1,89 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "timer.h"
+#include "lib/lib8tion/lib8tion.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+#define EFFECT_HARNESS_FRAMES 64
+
+/* A frame of every LED on the test matrix, as handed to the driver */
+struct EffectFrame {
+    std::vector<uint8_t> pixels;
+    unsigned             flushes = 0;
+
+    void resize(size_t leds, size_t channels) {
+        pixels.assign(leds * channels, 0);
+    }
+};
+
+struct EffectRun {
+    uint32_t checksum = 2166136261u;
+    double   frames_per_second;
+};
+
+/* Key presses and releases sent to the effect while it renders, as {frame, row, col, pressed} */
+struct EffectKeyEvent {
+    unsigned frame;
+    uint8_t  row;
+    uint8_t  col;
+    bool     pressed;
+};
+
+static const std::vector<EffectKeyEvent> effect_key_events = {
+    {2, 1, 3, true}, {4, 1, 3, false}, {6, 2, 7, true}, {7, 0, 0, true}, {9, 2, 7, false}, {12, 0, 0, false}, {30, 3, 5, true}, {31, 3, 5, false},
+};
+
+/**
+ * Renders `frames` frames of the current effect from a fixed starting point.
+ *
+ * The clock advances 1 ms per task call, and each frame sent to the driver is folded
+ * into a FNV-1a checksum. Only the time spent inside `task` counts towards the frame rate.
+ * Key events are skipped when `key_event` is empty.
+ */
+inline EffectRun render_effect(EffectFrame &frame, std::function<void(void)> task, std::function<void(uint8_t, uint8_t, bool)> key_event, unsigned frames = EFFECT_HARNESS_FRAMES) {
+    EffectRun                            run;
+    std::chrono::steady_clock::duration  busy{0};
+    auto                                 next_event = effect_key_events.begin();
+
+    // Effects drawing random pixels start from the same seed every time
+    random16_set_seed(1337);
+    srand(1);
+    set_time(0);
+    frame.flushes = 0;
+
+    for (unsigned done = 0; done < frames;) {
+        while (key_event && next_event != effect_key_events.end() && next_event->frame == done) {
+            key_event(next_event->row, next_event->col, next_event->pressed);
+            next_event++;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        task();
+        busy += std::chrono::steady_clock::now() - start;
+
+        if (frame.flushes != done) {
+            done = frame.flushes;
+            for (uint8_t byte : frame.pixels) {
+                run.checksum = (run.checksum ^ byte) * 16777619u;
+            }
+        }
+        advance_time(1);
+    }
+
+    run.frames_per_second = frames / std::chrono::duration<double>(busy).count();
+    return run;
+}
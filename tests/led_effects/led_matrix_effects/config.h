@@ -0,0 +1,37 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#ifdef __cplusplus
+// The tests include the matrix headers, which check the EECONFIG layout with C11 static asserts
+#    define _Static_assert static_assert
+#endif
+
+#define LED_MATRIX_LED_COUNT (MATRIX_ROWS * MATRIX_COLS)
+
+// Every core effect, so each of them is rendered by the harness
+#define ENABLE_LED_MATRIX_ALPHAS_MODS
+#define ENABLE_LED_MATRIX_BAND
+#define ENABLE_LED_MATRIX_BAND_PINWHEEL
+#define ENABLE_LED_MATRIX_BAND_SPIRAL
+#define ENABLE_LED_MATRIX_BREATHING
+#define ENABLE_LED_MATRIX_CYCLE_LEFT_RIGHT
+#define ENABLE_LED_MATRIX_CYCLE_OUT_IN
+#define ENABLE_LED_MATRIX_CYCLE_UP_DOWN
+#define ENABLE_LED_MATRIX_DUAL_BEACON
+#define ENABLE_LED_MATRIX_MULTISPLASH
+#define ENABLE_LED_MATRIX_SOLID_MULTISPLASH
+#define ENABLE_LED_MATRIX_SOLID_REACTIVE_CROSS
+#define ENABLE_LED_MATRIX_SOLID_REACTIVE_MULTICROSS
+#define ENABLE_LED_MATRIX_SOLID_REACTIVE_MULTINEXUS
+#define ENABLE_LED_MATRIX_SOLID_REACTIVE_MULTIWIDE
+#define ENABLE_LED_MATRIX_SOLID_REACTIVE_NEXUS
+#define ENABLE_LED_MATRIX_SOLID_REACTIVE_SIMPLE
+#define ENABLE_LED_MATRIX_SOLID_REACTIVE_WIDE
+#define ENABLE_LED_MATRIX_SOLID_SPLASH
+#define ENABLE_LED_MATRIX_SPLASH
+#define ENABLE_LED_MATRIX_WAVE_LEFT_RIGHT
+#define ENABLE_LED_MATRIX_WAVE_UP_DOWN
@@ -0,0 +1,5 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+LED_MATRIX_ENABLE = yes
+LED_MATRIX_DRIVER = custom
@@ -0,0 +1,123 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "test_common.hpp"
+#include "../effect_harness.hpp"
+
+extern "C" {
+#include "led_matrix.h"
+}
+
+static EffectFrame frame;
+
+static void test_driver_init(void) {}
+
+static void test_driver_set_value(int index, uint8_t value) {
+    frame.pixels[index] = value;
+}
+
+static void test_driver_set_value_all(uint8_t value) {
+    for (int i = 0; i < LED_MATRIX_LED_COUNT; i++) {
+        test_driver_set_value(i, value);
+    }
+}
+
+static void test_driver_flush(void) {
+    frame.flushes++;
+}
+
+extern "C" const led_matrix_driver_t led_matrix_driver = {test_driver_init, test_driver_set_value, test_driver_set_value_all, test_driver_flush};
+
+extern "C" led_config_t g_led_config = {};
+
+struct Effect {
+    uint8_t     mode;
+    std::string name;
+};
+
+static const std::vector<Effect> effects = {
+#define LED_MATRIX_EFFECT(name, ...) {LED_MATRIX_##name, #name},
+#include "led_matrix_effects.inc"
+#undef LED_MATRIX_EFFECT
+};
+
+/* Checksums of EFFECT_HARNESS_FRAMES frames of each effect. */
+static const std::map<std::string, uint32_t> golden = {
+    // clang-format off
+    {"SOLID", 0xcbb5efc5},
+    {"ALPHAS_MODS", 0x3fff25c5},
+    {"BREATHING", 0xc03c4865},
+    {"BAND", 0x65844155},
+    {"BAND_PINWHEEL", 0x4ac72294},
+    {"BAND_SPIRAL", 0x80aeb217},
+    {"CYCLE_LEFT_RIGHT", 0x66ea04bd},
+    {"CYCLE_UP_DOWN", 0x13b8758b},
+    {"CYCLE_OUT_IN", 0x2f472db5},
+    {"DUAL_BEACON", 0xcf087146},
+    {"SOLID_REACTIVE_SIMPLE", 0xb48f3419},
+    {"SOLID_REACTIVE_WIDE", 0x10c08ebb},
+    {"SOLID_REACTIVE_MULTIWIDE", 0x6d302f58},
+    {"SOLID_REACTIVE_CROSS", 0x5e5cd8c4},
+    {"SOLID_REACTIVE_MULTICROSS", 0x6caec5f6},
+    {"SOLID_REACTIVE_NEXUS", 0x80f95ea2},
+    {"SOLID_REACTIVE_MULTINEXUS", 0xe7db51ae},
+    {"SOLID_SPLASH", 0x5054dd92},
+    {"SOLID_MULTISPLASH", 0x6cbeaf51},
+    {"WAVE_LEFT_RIGHT", 0x7f07fc6d},
+    {"WAVE_UP_DOWN", 0x131bb59f},
+    // clang-format on
+};
+
+class LedMatrixEffects : public TestFixture {
+   public:
+    void SetUp() override {
+        // One LED per key, spread evenly over the 224x64 LED space, with the outer columns as modifiers
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                uint8_t index                       = row * MATRIX_COLS + col;
+                g_led_config.matrix_co[row][col]    = index;
+                g_led_config.point[index]           = {(uint8_t)(col * 224 / (MATRIX_COLS - 1)), (uint8_t)(row * 64 / (MATRIX_ROWS - 1))};
+                g_led_config.flags[index]           = (col == 0 || col == MATRIX_COLS - 1) ? LED_FLAG_MODIFIER : LED_FLAG_KEYLIGHT;
+            }
+        }
+        frame.resize(LED_MATRIX_LED_COUNT, 1);
+    }
+
+    /* Renders `mode` from a blank matrix with no key hits, so every run starts out the same */
+    EffectRun render(uint8_t mode) {
+        led_matrix_init();
+        led_matrix_disable_noeeprom();
+        render_effect(frame, led_matrix_task, nullptr, 1);
+
+        led_matrix_enable_noeeprom();
+        led_matrix_mode_noeeprom(mode);
+        led_matrix_set_val_noeeprom(192);
+        led_matrix_set_speed_noeeprom(128);
+        return render_effect(frame, led_matrix_task, led_matrix_handle_key_event);
+    }
+};
+
+TEST_F(LedMatrixEffects, EffectsRenderGoldenFrames) {
+    ASSERT_GT(effects.size(), 0);
+
+    for (const auto &effect : effects) {
+        EffectRun run = render(effect.mode);
+        RecordProperty(effect.name + "_fps", (int)run.frames_per_second);
+
+        auto expected = golden.find(effect.name);
+        if (expected == golden.end()) {
+            continue;
+        }
+        EXPECT_EQ(run.checksum, expected->second) << effect.name << ": {\"" << effect.name << "\", 0x" << std::hex << run.checksum << "},";
+    }
+}
+
+TEST_F(LedMatrixEffects, SameEffectRendersTheSameFrames) {
+    for (const auto &effect : effects) {
+        EXPECT_EQ(render(effect.mode).checksum, render(effect.mode).checksum) << effect.name;
+    }
+}
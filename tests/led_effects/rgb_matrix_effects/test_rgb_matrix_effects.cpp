@@ -0,0 +1,152 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "test_common.hpp"
+#include "../effect_harness.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+}
+
+static EffectFrame frame;
+
+static void test_driver_init(void) {}
+
+static void test_driver_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    frame.pixels[index * 3 + 0] = r;
+    frame.pixels[index * 3 + 1] = g;
+    frame.pixels[index * 3 + 2] = b;
+}
+
+static void test_driver_set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        test_driver_set_color(i, r, g, b);
+    }
+}
+
+static void test_driver_flush(void) {
+    frame.flushes++;
+}
+
+extern "C" const rgb_matrix_driver_t rgb_matrix_driver = {test_driver_init, test_driver_set_color, test_driver_set_color_all, test_driver_flush};
+
+extern "C" led_config_t g_led_config = {};
+
+struct Effect {
+    uint8_t     mode;
+    std::string name;
+};
+
+static const std::vector<Effect> effects = {
+#define RGB_MATRIX_EFFECT(name, ...) {RGB_MATRIX_##name, #name},
+#include "rgb_matrix_effects.inc"
+#undef RGB_MATRIX_EFFECT
+};
+
+/* Checksums of EFFECT_HARNESS_FRAMES frames of each effect. Effects drawing with rand() depend on the C library and are only timed. */
+static const std::map<std::string, uint32_t> golden = {
+    // clang-format off
+    {"SOLID_COLOR", 0xe9e0a7c5},
+    {"ALPHAS_MODS", 0xb1ff97c5},
+    {"GRADIENT_UP_DOWN", 0x3c94a2c5},
+    {"GRADIENT_LEFT_RIGHT", 0x5805ddc5},
+    {"BREATHING", 0x1eef579d},
+    {"BAND_SAT", 0x52f47675},
+    {"BAND_VAL", 0x9bcb084d},
+    {"BAND_PINWHEEL_SAT", 0x5da9df94},
+    {"BAND_PINWHEEL_VAL", 0x5949dbe8},
+    {"BAND_SPIRAL_SAT", 0xcf7f7282},
+    {"BAND_SPIRAL_VAL", 0x6a27afff},
+    {"CYCLE_ALL", 0xf2c5ab55},
+    {"CYCLE_LEFT_RIGHT", 0xa4945b85},
+    {"CYCLE_UP_DOWN", 0x91cbb581},
+    {"RAINBOW_MOVING_CHEVRON", 0x04a4eb6b},
+    {"CYCLE_OUT_IN", 0x1d496463},
+    {"CYCLE_OUT_IN_DUAL", 0xfc05d5e1},
+    {"CYCLE_PINWHEEL", 0x87a0bd4b},
+    {"CYCLE_SPIRAL", 0xd2f735fb},
+    {"DUAL_BEACON", 0xf7a434a3},
+    {"RAINBOW_BEACON", 0x24106195},
+    {"RAINBOW_PINWHEELS", 0x35afb7f1},
+    {"FLOWER_BLOOMING", 0x29e0f781},
+    {"RAINDROPS", 0x6d10eec9},
+    {"JELLYBEAN_RAINDROPS", 0x1b52e87b},
+    {"HUE_BREATHING", 0xfe5cb665},
+    {"HUE_PENDULUM", 0x347f57b5},
+    {"HUE_WAVE", 0xf453025d},
+    {"PIXEL_RAIN", 0x30a81df8},
+    {"PIXEL_FLOW", 0x90344d45},
+    {"PIXEL_FRACTAL", 0x846a3d4b},
+    {"TYPING_HEATMAP", 0x55997db2},
+    {"SOLID_REACTIVE_SIMPLE", 0x526b627d},
+    {"SOLID_REACTIVE", 0x78698ac5},
+    {"SOLID_REACTIVE_WIDE", 0x8ba271f6},
+    {"SOLID_REACTIVE_MULTIWIDE", 0x54908efd},
+    {"SOLID_REACTIVE_CROSS", 0x36122c18},
+    {"SOLID_REACTIVE_MULTICROSS", 0x8c01c5bf},
+    {"SOLID_REACTIVE_NEXUS", 0x3abc8774},
+    {"SOLID_REACTIVE_MULTINEXUS", 0xe7682e87},
+    {"SPLASH", 0x730402a1},
+    {"MULTISPLASH", 0xeae05ae1},
+    {"SOLID_SPLASH", 0x97b2910b},
+    {"SOLID_MULTISPLASH", 0xbc8c6283},
+    {"STARLIGHT", 0xd572de40},
+    {"STARLIGHT_DUAL_SAT", 0xb1e40520},
+    {"STARLIGHT_DUAL_HUE", 0x54f1123d},
+    {"RIVERFLOW", 0x66bfbbc3},
+    // clang-format on
+};
+
+class RgbMatrixEffects : public TestFixture {
+   public:
+    void SetUp() override {
+        // One LED per key, spread evenly over the 224x64 LED space, with the outer columns as modifiers
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                uint8_t index                       = row * MATRIX_COLS + col;
+                g_led_config.matrix_co[row][col]    = index;
+                g_led_config.point[index]           = {(uint8_t)(col * 224 / (MATRIX_COLS - 1)), (uint8_t)(row * 64 / (MATRIX_ROWS - 1))};
+                g_led_config.flags[index]           = (col == 0 || col == MATRIX_COLS - 1) ? LED_FLAG_MODIFIER : LED_FLAG_KEYLIGHT;
+            }
+        }
+        frame.resize(RGB_MATRIX_LED_COUNT, 3);
+    }
+
+    /* Renders `mode` from a blank matrix with no key hits, so every run starts out the same */
+    EffectRun render(uint8_t mode) {
+        rgb_matrix_init();
+        rgb_matrix_disable_noeeprom();
+        render_effect(frame, rgb_matrix_task, nullptr, 1);
+
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_mode_noeeprom(mode);
+        rgb_matrix_sethsv_noeeprom(HSV_RED);
+        rgb_matrix_set_speed_noeeprom(128);
+        return render_effect(frame, rgb_matrix_task, rgb_matrix_handle_key_event);
+    }
+};
+
+TEST_F(RgbMatrixEffects, EffectsRenderGoldenFrames) {
+    ASSERT_GT(effects.size(), 0);
+
+    for (const auto &effect : effects) {
+        EffectRun run = render(effect.mode);
+        RecordProperty(effect.name + "_fps", (int)run.frames_per_second);
+
+        auto expected = golden.find(effect.name);
+        if (expected == golden.end()) {
+            continue;
+        }
+        EXPECT_EQ(run.checksum, expected->second) << effect.name << ": {\"" << effect.name << "\", 0x" << std::hex << run.checksum << "},";
+    }
+}
+
+TEST_F(RgbMatrixEffects, SameEffectRendersTheSameFrames) {
+    for (const auto &effect : effects) {
+        EXPECT_EQ(render(effect.mode).checksum, render(effect.mode).checksum) << effect.name;
+    }
+}
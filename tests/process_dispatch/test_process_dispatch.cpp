@@ -0,0 +1,135 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <vector>
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "process_dispatch.h"
+#include "timer.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+#define BENCHMARK_ITERATIONS 20000
+
+/* Calls every registered handler in turn, as process_record_quantum() used to */
+static bool dispatch_linear(uint16_t keycode, keyrecord_t *record) {
+    for (uint8_t i = 0; i < process_dispatch_count(); i++) {
+        if (!process_dispatch_get(i).process(keycode, record)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static keyrecord_t make_record(bool pressed) {
+    keyrecord_t record   = {};
+    record.event.pressed = pressed;
+    record.event.type    = KEY_EVENT;
+    record.event.time    = timer_read();
+    return record;
+}
+
+/* Keycodes no enabled feature acts on, so every handler lets them through */
+static const std::vector<uint16_t> passthrough_keycodes = {KC_F13, KC_F14, KC_F15, KC_F16, KC_INT1, KC_LNG1, QK_KB_0, QK_KB_1, QK_USER_0, QK_USER_1};
+
+class ProcessDispatch : public TestFixture {};
+
+TEST_F(ProcessDispatch, RoutingMatchesRegisteredRanges) {
+    ASSERT_GT(process_dispatch_count(), 0);
+
+    for (uint8_t i = 0; i < process_dispatch_count(); i++) {
+        process_handler_t handler = process_dispatch_get(i);
+        ASSERT_LE(handler.first, handler.last);
+        for (uint32_t keycode = 0; keycode <= 0xFFFF; keycode++) {
+            bool in_range = handler.first <= keycode && keycode <= handler.last;
+            ASSERT_EQ(process_dispatch_routes(keycode, i), in_range) << "handler " << (int)i << ", keycode 0x" << std::hex << keycode;
+        }
+    }
+}
+
+TEST_F(ProcessDispatch, PassthroughKeycodesReachTheHost) {
+    TestDriver driver;
+    InSequence s;
+    auto       key = KeymapKey(0, 0, 0, KC_F13);
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_F13));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ProcessDispatch, HandlersStillInterceptTheirKeycodes) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, UC_NEXT);
+
+    set_keymap({key});
+
+    // Unicode mode keys are consumed by their handler and never reach the host
+    EXPECT_NO_REPORT(driver);
+    tap_key(key);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ProcessDispatch, IndexedDispatchLatency) {
+    std::vector<keyrecord_t> records = {make_record(true), make_record(false)};
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        for (uint16_t keycode : passthrough_keycodes) {
+            for (auto &record : records) {
+                ASSERT_TRUE(dispatch_linear(keycode, &record));
+            }
+        }
+    }
+    auto linear = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        for (uint16_t keycode : passthrough_keycodes) {
+            for (auto &record : records) {
+                ASSERT_TRUE(process_dispatch(keycode, &record));
+            }
+        }
+    }
+    auto indexed = std::chrono::steady_clock::now() - start;
+
+    const long events = (long)BENCHMARK_ITERATIONS * passthrough_keycodes.size() * records.size();
+    RecordProperty("handlers", process_dispatch_count());
+    RecordProperty("linear_ns_per_event", std::chrono::duration_cast<std::chrono::nanoseconds>(linear).count() / events);
+    RecordProperty("indexed_ns_per_event", std::chrono::duration_cast<std::chrono::nanoseconds>(indexed).count() / events);
+}
+
+TEST_F(ProcessDispatch, ProcessRecordQuantumLatency) {
+    TestDriver driver;
+
+    EXPECT_ANY_REPORT(driver).Times(0);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        for (uint16_t keycode : passthrough_keycodes) {
+            keyrecord_t press   = make_record(true);
+            keyrecord_t release = make_record(false);
+            press.keycode       = keycode;
+            release.keycode     = keycode;
+            // Only the handlers run here, the action layer is not involved
+            ASSERT_TRUE(process_record_quantum(&press));
+            ASSERT_TRUE(process_record_quantum(&release));
+        }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    const long events = (long)BENCHMARK_ITERATIONS * passthrough_keycodes.size() * 2;
+    RecordProperty("process_record_ns_per_event", std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / events);
+}
@@ -0,0 +1,6 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+REPORT_QUEUE_ENABLE = yes
+MOUSE_ENABLE = yes
+EXTRAKEY_ENABLE = yes
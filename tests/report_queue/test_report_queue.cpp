@@ -0,0 +1,188 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "host.h"
+#include "report_queue.h"
+}
+
+using testing::_;
+using testing::AllOf;
+using testing::Field;
+using testing::InSequence;
+
+class ReportQueue : public TestFixture {};
+
+TEST_F(ReportQueue, KeyboardReportsAreSentImmediatelyWhenEndpointIsReady) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    key.press();
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    key.release();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportQueue, NoKeyboardStateIsLostWhileEndpointIsBusy) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+
+    set_keymap({key_a, key_b});
+    driver.set_endpoint_busy_period(10);
+
+    /* The first report goes out right away, the following ones queue up behind it. */
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    key_b.press();
+    run_one_scan_loop();
+    key_a.release();
+    run_one_scan_loop();
+    key_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Every intermediate state is delivered, in order, one per busy period. */
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(40);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportQueue, FullKeyboardQueueFallsBackToBlockingSend) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+    driver.set_endpoint_busy_period(1000);
+
+    /* One report in flight plus a full queue, the next press has to push the oldest out. */
+    EXPECT_ANY_REPORT(driver).Times(2);
+    for (int i = 0; i < (REPORT_QUEUE_KEYBOARD_SIZE + 2) / 2; i++) {
+        key.press();
+        run_one_scan_loop();
+        key.release();
+        run_one_scan_loop();
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_ANY_REPORT(driver).Times(REPORT_QUEUE_KEYBOARD_SIZE);
+    idle_for(1000 * (REPORT_QUEUE_KEYBOARD_SIZE + 1));
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportQueue, MouseMovementAccumulatesWhileEndpointIsBusy) {
+    TestDriver     driver;
+    InSequence     s;
+    report_mouse_t report = {};
+
+    driver.set_endpoint_busy_period(10);
+
+    report.x = 10;
+    report.y = -3;
+    EXPECT_CALL(driver, send_mouse_mock(AllOf(Field(&report_mouse_t::x, 10), Field(&report_mouse_t::y, -3))));
+    host_mouse_send(&report);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_mouse_mock(_)).Times(0);
+    for (int i = 0; i < 3; i++) {
+        report   = {};
+        report.x = 10;
+        report.y = -3;
+        host_mouse_send(&report);
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    /* Three reports worth of movement end up in a single one. */
+    EXPECT_CALL(driver, send_mouse_mock(AllOf(Field(&report_mouse_t::x, 30), Field(&report_mouse_t::y, -9))));
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportQueue, MouseButtonChangeIsNotMergedAway) {
+    TestDriver     driver;
+    InSequence     s;
+    report_mouse_t report = {};
+
+    driver.set_endpoint_busy_period(10);
+
+    EXPECT_CALL(driver, send_mouse_mock(Field(&report_mouse_t::buttons, 0)));
+    report.x = 5;
+    host_mouse_send(&report);
+    VERIFY_AND_CLEAR(driver);
+
+    report         = {};
+    report.x       = 5;
+    host_mouse_send(&report);
+    report         = {};
+    report.buttons = 1;
+    host_mouse_send(&report);
+    report         = {};
+    host_mouse_send(&report);
+
+    EXPECT_CALL(driver, send_mouse_mock(AllOf(Field(&report_mouse_t::buttons, 0), Field(&report_mouse_t::x, 5))));
+    EXPECT_CALL(driver, send_mouse_mock(Field(&report_mouse_t::buttons, 1)));
+    EXPECT_CALL(driver, send_mouse_mock(Field(&report_mouse_t::buttons, 0)));
+    idle_for(40);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportQueue, ConsumerReportIsLastWriterWins) {
+    TestDriver driver;
+    InSequence s;
+
+    driver.set_endpoint_busy_period(10);
+
+    EXPECT_CALL(driver, send_extra_mock(Field(&report_extra_t::usage, AUDIO_VOL_UP)));
+    host_consumer_send(AUDIO_VOL_UP);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_extra_mock(_)).Times(0);
+    host_consumer_send(AUDIO_VOL_DOWN);
+    host_consumer_send(AUDIO_MUTE);
+    host_consumer_send(0);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Volume down is replaced by mute, but mute isn't replaced by its release. */
+    EXPECT_CALL(driver, send_extra_mock(Field(&report_extra_t::usage, AUDIO_MUTE)));
+    EXPECT_CALL(driver, send_extra_mock(Field(&report_extra_t::usage, 0)));
+    idle_for(30);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportQueue, ConsumerTapIsNotLostWhileEndpointIsBusy) {
+    TestDriver driver;
+    InSequence s;
+
+    driver.set_endpoint_busy_period(10);
+
+    EXPECT_CALL(driver, send_extra_mock(Field(&report_extra_t::usage, AUDIO_MUTE)));
+    host_consumer_send(AUDIO_MUTE);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_CALL(driver, send_extra_mock(_)).Times(0);
+    tap_code16(KC_AUDIO_VOL_UP);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Both the press and the release of the tap reach the host. */
+    EXPECT_CALL(driver, send_extra_mock(Field(&report_extra_t::usage, AUDIO_VOL_UP)));
+    EXPECT_CALL(driver, send_extra_mock(Field(&report_extra_t::usage, 0)));
+    idle_for(30);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,5 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+RGBLIGHT_ENABLE = yes
+RGBLIGHT_DRIVER = custom
@@ -0,0 +1,163 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+
+extern "C" {
+#include "rgblight.h"
+#include "rgblight_drivers.h"
+
+// Output of the current effect, before any layers
+extern rgb_led_t led[RGBLIGHT_LED_COUNT];
+void             sethsv(uint8_t hue, uint8_t sat, uint8_t val, rgb_led_t *led1);
+}
+
+static std::vector<rgb_led_t> sent;
+static unsigned               frames_sent = 0;
+
+static void test_driver_init(void) {}
+
+static void test_driver_setleds(rgb_led_t *ledarray, uint16_t number_of_leds) {
+    sent.assign(ledarray, ledarray + number_of_leds);
+    frames_sent++;
+}
+
+extern "C" const rgblight_driver_t rgblight_driver = {test_driver_init, test_driver_setleds, NULL};
+
+static const rgblight_segment_t PROGMEM left_layer[]  = RGBLIGHT_LAYER_SEGMENTS({0, 3, HSV_RED});
+static const rgblight_segment_t PROGMEM right_layer[] = RGBLIGHT_LAYER_SEGMENTS({7, 3, HSV_GREEN});
+// Covers part of the left layer, and lights LED 5 with a later segment winning over an earlier one
+static const rgblight_segment_t PROGMEM top_layer[] = RGBLIGHT_LAYER_SEGMENTS({2, 4, HSV_BLUE}, {5, 1, HSV_WHITE});
+
+// Entirely under the top layer
+static const rgblight_segment_t PROGMEM hidden_layer[] = RGBLIGHT_LAYER_SEGMENTS({3, 2, HSV_ORANGE});
+
+static const rgblight_segment_t *const PROGMEM test_layers[] = RGBLIGHT_LAYERS_LIST(left_layer, right_layer, hidden_layer, top_layer);
+
+static rgb_led_t rgb_of(uint8_t hue, uint8_t sat, uint8_t val) {
+    rgb_led_t led = {};
+    sethsv(hue, sat, val, &led);
+    return led;
+}
+
+static bool same(const rgb_led_t &a, const rgb_led_t &b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
+class RgblightLayers : public TestFixture {
+   public:
+    void SetUp() override {
+        rgblight_layers = test_layers;
+        for (uint8_t i = 0; i < RGBLIGHT_MAX_LAYERS; i++) {
+            rgblight_set_layer_state(i, false);
+        }
+        rgblight_enable_noeeprom();
+        rgblight_mode_noeeprom(RGBLIGHT_MODE_STATIC_LIGHT);
+        rgblight_sethsv_noeeprom(HSV_YELLOW);
+        rgblight_task();
+        base = rgb_of(HSV_YELLOW);
+    }
+
+    /* Runs the deferred layer update, returning how many frames were sent to the driver. */
+    unsigned frames_for_task(void) {
+        unsigned before = frames_sent;
+        rgblight_task();
+        return frames_sent - before;
+    }
+
+    void expect_frame(std::vector<rgb_led_t> expected) {
+        ASSERT_EQ(sent.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); i++) {
+            EXPECT_TRUE(same(sent[i], expected[i])) << "LED " << i;
+        }
+    }
+
+    rgb_led_t base;
+};
+
+TEST_F(RgblightLayers, LayerIsDrawnOverTheEffect) {
+    const rgb_led_t red = rgb_of(HSV_RED);
+
+    rgblight_set_layer_state(0, true);
+    EXPECT_EQ(frames_for_task(), 1);
+    expect_frame({red, red, red, base, base, base, base, base, base, base});
+
+    // The effect output underneath is left alone
+    for (uint8_t i = 0; i < RGBLIGHT_LED_COUNT; i++) {
+        EXPECT_TRUE(same(led[i], base)) << "LED " << (int)i;
+    }
+
+    rgblight_set_layer_state(0, false);
+    EXPECT_EQ(frames_for_task(), 1);
+    expect_frame(std::vector<rgb_led_t>(RGBLIGHT_LED_COUNT, base));
+}
+
+TEST_F(RgblightLayers, TopmostLayerWins) {
+    const rgb_led_t red   = rgb_of(HSV_RED);
+    const rgb_led_t green = rgb_of(HSV_GREEN);
+    const rgb_led_t blue  = rgb_of(HSV_BLUE);
+    const rgb_led_t white = rgb_of(HSV_WHITE);
+
+    rgblight_set_layer_state(0, true);
+    rgblight_set_layer_state(1, true);
+    rgblight_set_layer_state(3, true);
+    EXPECT_EQ(frames_for_task(), 1);
+    expect_frame({red, red, blue, blue, blue, white, base, green, green, green});
+
+    // Switching the top layer off uncovers the one below
+    rgblight_set_layer_state(3, false);
+    EXPECT_EQ(frames_for_task(), 1);
+    expect_frame({red, red, red, base, base, base, base, green, green, green});
+}
+
+TEST_F(RgblightLayers, UnchangedFrameIsNotSent) {
+    rgblight_set_layer_state(1, true);
+    EXPECT_EQ(frames_for_task(), 1);
+
+    // Nothing changes on screen, so nothing goes to the driver
+    rgblight_set_layer_state(1, true);
+    EXPECT_EQ(frames_for_task(), 0);
+    unsigned before = frames_sent;
+    rgblight_set();
+    EXPECT_EQ(frames_sent - before, 0);
+
+    // Neither does a layer switched off and back on before the next task
+    rgblight_set_layer_state(1, false);
+    rgblight_set_layer_state(1, true);
+    EXPECT_EQ(frames_for_task(), 0);
+
+    // Or a layer hidden under another one
+    rgblight_set_layer_state(3, true);
+    EXPECT_EQ(frames_for_task(), 1);
+    rgblight_set_layer_state(2, true);
+    EXPECT_EQ(frames_for_task(), 0);
+}
+
+TEST_F(RgblightLayers, LayersFollowAnimatedEffect) {
+    TestDriver      driver;
+    const rgb_led_t red = rgb_of(HSV_RED);
+
+    EXPECT_NO_REPORT(driver);
+    rgblight_set_layer_state(0, true);
+    rgblight_task();
+    rgblight_mode_noeeprom(RGBLIGHT_MODE_BREATHING);
+    idle_for(500);
+
+    // The layer stays on top while the effect underneath keeps changing
+    for (uint8_t i = 0; i < 3; i++) {
+        EXPECT_TRUE(same(sent[i], red)) << "LED " << (int)i;
+    }
+    for (uint8_t i = 3; i < RGBLIGHT_LED_COUNT; i++) {
+        EXPECT_TRUE(same(sent[i], led[i])) << "LED " << (int)i;
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    rgblight_set_layer_state(0, false);
+    rgblight_mode_noeeprom(RGBLIGHT_MODE_STATIC_LIGHT);
+    rgblight_task();
+}
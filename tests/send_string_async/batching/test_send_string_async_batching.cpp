@@ -0,0 +1,74 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "send_string.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+class SendStringAsyncBatching : public TestFixture {
+   public:
+    void SetUp() override {
+        send_string_async_cancel();
+    }
+
+    void run_until_idle() {
+        for (int i = 0; i < 200 && send_string_async_is_busy(); i++) {
+            run_one_scan_loop();
+        }
+        EXPECT_FALSE(send_string_async_is_busy());
+    }
+};
+
+TEST_F(SendStringAsyncBatching, DistinctKeysShareAReport) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+
+    EXPECT_TRUE(SEND_STRING_ASYNC("abc"));
+    run_until_idle();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsyncBatching, RepeatedKeysAreReleasedInBetween) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+
+    EXPECT_TRUE(SEND_STRING_ASYNC("aab"));
+    run_until_idle();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsyncBatching, ModifierChangesAreNotBatched) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_B));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_C));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_D));
+    EXPECT_EMPTY_REPORT(driver);
+
+    EXPECT_TRUE(SEND_STRING_ASYNC("aBCd"));
+    run_until_idle();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,252 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "send_string.h"
+#include "timer.h"
+}
+
+using testing::_;
+using testing::InSequence;
+using testing::Invoke;
+
+struct SentReport {
+    uint32_t          time;
+    report_keyboard_t report;
+};
+
+/* Replays the reports like a host with a US layout would, returning the text that was typed */
+static std::string typed_text(const std::vector<SentReport>& sent) {
+    std::string       text;
+    report_keyboard_t previous = {};
+
+    for (auto& entry : sent) {
+        bool shifted = entry.report.mods & (MOD_BIT(KC_LEFT_SHIFT) | MOD_BIT(KC_RIGHT_SHIFT));
+        for (uint8_t key : entry.report.keys) {
+            if (key == KC_NO || std::find(std::begin(previous.keys), std::end(previous.keys), key) != std::end(previous.keys)) {
+                continue;
+            }
+            for (int c = 0; c < 128; c++) {
+                if (pgm_read_byte(&ascii_to_keycode_lut[c]) == key && (bool)((ascii_to_shift_lut[c / 8] >> (c % 8)) & 1) == shifted) {
+                    text += (char)c;
+                    break;
+                }
+            }
+        }
+        previous = entry.report;
+    }
+    return text;
+}
+
+class SendStringAsync : public TestFixture {
+   public:
+    void SetUp() override {
+        send_string_async_cancel();
+    }
+
+    void record(TestDriver& driver) {
+        EXPECT_ANY_REPORT(driver).WillRepeatedly(Invoke([this](report_keyboard_t& report) { sent.push_back({timer_read32(), report}); }));
+    }
+
+    void run_until_idle() {
+        for (int i = 0; i < 2000 && send_string_async_is_busy(); i++) {
+            run_one_scan_loop();
+        }
+        EXPECT_FALSE(send_string_async_is_busy());
+    }
+
+    std::vector<SentReport> sent;
+};
+
+TEST_F(SendStringAsync, TypesOutCharactersInOrder) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_B));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_C));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+
+    EXPECT_TRUE(SEND_STRING_ASYNC("aBC"));
+    run_until_idle();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, QueueingDoesNotSendAnything) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    EXPECT_TRUE(send_string_async("hello"));
+    EXPECT_TRUE(send_string_async_is_busy());
+    EXPECT_EQ(send_string_async_remaining(), 5);
+    VERIFY_AND_CLEAR(driver);
+
+    record(driver);
+    run_until_idle();
+    EXPECT_EQ(typed_text(sent), "hello");
+}
+
+TEST_F(SendStringAsync, TypedTextMatchesBlockingSendString) {
+    TestDriver  driver;
+    const char* text = "Hello, World! {qmk} ~/[x]|y\\z \"quoted\" 100% & 42;\n";
+
+    record(driver);
+    send_string(text);
+    std::string blocking = typed_text(sent);
+    sent.clear();
+
+    EXPECT_TRUE(send_string_async_P(text));
+    run_until_idle();
+    EXPECT_EQ(typed_text(sent), blocking);
+    EXPECT_EQ(blocking, text);
+}
+
+TEST_F(SendStringAsync, OneReportPerScanAndKeysStillGetThrough) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_Z);
+
+    set_keymap({key});
+    record(driver);
+    EXPECT_TRUE(SEND_STRING_ASYNC("the quick brown fox jumps over the lazy dog"));
+
+    for (int scan = 0; scan < 20; scan++) {
+        size_t before = sent.size();
+        run_one_scan_loop();
+        EXPECT_LE(sent.size() - before, 1);
+    }
+
+    // A key pressed in the middle of the string is reported in the very same scan
+    key.press();
+    size_t before = sent.size();
+    run_one_scan_loop();
+    ASSERT_GT(sent.size(), before);
+    bool found = false;
+    for (size_t i = before; i < sent.size(); i++) {
+        found |= std::find(std::begin(sent[i].report.keys), std::end(sent[i].report.keys), KC_Z) != std::end(sent[i].report.keys);
+    }
+    EXPECT_TRUE(found);
+    EXPECT_TRUE(send_string_async_is_busy());
+
+    key.release();
+    run_one_scan_loop();
+    run_until_idle();
+}
+
+TEST_F(SendStringAsync, StringsAreTypedInTheOrderTheyWereQueued) {
+    TestDriver driver;
+    char       runtime[] = "two ";
+
+    record(driver);
+    EXPECT_TRUE(SEND_STRING_ASYNC("one "));
+    EXPECT_TRUE(send_string_async(runtime));
+    runtime[0] = 'x'; // the copy is not affected
+    EXPECT_TRUE(send_char_async('3'));
+    run_until_idle();
+
+    EXPECT_EQ(typed_text(sent), "one two 3");
+}
+
+TEST_F(SendStringAsync, FullQueueIsRejected) {
+    TestDriver driver;
+
+    record(driver);
+    // Longer than the ring buffer, but PROGMEM strings are not copied
+    EXPECT_FALSE(send_string_async("0123456789012345678901234567890123456789"));
+    EXPECT_TRUE(SEND_STRING_ASYNC("0123456789012345678901234567890123456789"));
+    EXPECT_TRUE(send_string_async("ab"));
+    EXPECT_TRUE(send_string_async("cd"));
+    EXPECT_TRUE(send_string_async("ef"));
+    EXPECT_FALSE(send_string_async("gh"));
+    run_until_idle();
+
+    EXPECT_EQ(typed_text(sent), "0123456789012345678901234567890123456789abcdef");
+}
+
+TEST_F(SendStringAsync, KeycodeInjectionAndDelays) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_A));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    EXPECT_EMPTY_REPORT(driver);
+
+    EXPECT_TRUE(SEND_STRING_ASYNC(SS_LCTL("a") SS_DELAY(50) SS_TAP(X_LEFT)));
+    for (int i = 0; i < 10; i++) {
+        run_one_scan_loop();
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(30);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT));
+    EXPECT_EMPTY_REPORT(driver);
+    run_until_idle();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, IntervalSpacesOutReports) {
+    TestDriver driver;
+
+    record(driver);
+    EXPECT_TRUE(SEND_STRING_ASYNC_DELAY("abc", 10));
+    run_until_idle();
+
+    ASSERT_EQ(sent.size(), 6);
+    for (size_t i = 1; i < sent.size(); i++) {
+        EXPECT_GE(sent[i].time - sent[i - 1].time, 10);
+    }
+}
+
+TEST_F(SendStringAsync, WaitsForABusyEndpoint) {
+    TestDriver driver;
+
+    driver.set_endpoint_busy_period(4);
+    record(driver);
+    EXPECT_TRUE(SEND_STRING_ASYNC("abcd"));
+    run_until_idle();
+
+    EXPECT_EQ(typed_text(sent), "abcd");
+    for (size_t i = 1; i < sent.size(); i++) {
+        EXPECT_GE(sent[i].time - sent[i - 1].time, 4);
+    }
+}
+
+TEST_F(SendStringAsync, ProgressAndCancel) {
+    TestDriver driver;
+
+    record(driver);
+    EXPECT_TRUE(SEND_STRING_ASYNC("ABCDEFGH"));
+    EXPECT_EQ(send_string_async_remaining(), 8);
+
+    for (int i = 0; i < 5; i++) {
+        run_one_scan_loop();
+    }
+    EXPECT_LT(send_string_async_remaining(), 8);
+    EXPECT_GT(send_string_async_remaining(), 0);
+
+    send_string_async_cancel();
+    EXPECT_FALSE(send_string_async_is_busy());
+    EXPECT_EQ(send_string_async_remaining(), 0);
+
+    // Everything the string held down has been released
+    ASSERT_FALSE(sent.empty());
+    EXPECT_EQ(sent.back().report, report_keyboard_t{});
+
+    size_t count = sent.size();
+    idle_for(20);
+    EXPECT_EQ(sent.size(), count);
+}
@@ -0,0 +1,101 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <map>
+#include <vector>
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "../steno_host.h"
+}
+
+using testing::_;
+
+class StenoFirstUp : public TestFixture {
+   public:
+    void SetUp() override {
+        steno_host_reset();
+        for (uint8_t i = 0; i < sizeof(steno_keys) / sizeof(steno_keys[0]); i++) {
+            auto key = KeymapKey(0, i % MATRIX_COLS, i / MATRIX_COLS, steno_keys[i]);
+            add_key(key);
+            keys.emplace(steno_keys[i], key);
+        }
+    }
+
+    void press(std::initializer_list<uint16_t> keycodes) {
+        for (uint16_t keycode : keycodes) {
+            keys.at(keycode).press();
+        }
+        run_one_scan_loop();
+    }
+
+    void release(std::initializer_list<uint16_t> keycodes) {
+        for (uint16_t keycode : keycodes) {
+            keys.at(keycode).release();
+        }
+        run_one_scan_loop();
+    }
+
+    std::vector<uint64_t> received() {
+        std::vector<uint64_t> chords;
+        uint64_t              chord;
+        while (steno_host_read_chord(&chord)) {
+            chords.push_back(chord);
+        }
+        return chords;
+    }
+
+    const uint16_t                steno_keys[8] = {STN_S1, STN_TL, STN_KL, STN_PL, STN_A, STN_O, STN_E, STN_U};
+    std::map<uint16_t, KeymapKey> keys;
+};
+
+TEST_F(StenoFirstUp, ChordIsSentWhenTheFirstKeyComesUp) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    press({STN_S1, STN_TL, STN_A});
+    EXPECT_TRUE(received().empty());
+
+    release({STN_A});
+    EXPECT_EQ(received(), std::vector<uint64_t>({STENO_KEY_BIT(STN_S1) | STENO_KEY_BIT(STN_TL) | STENO_KEY_BIT(STN_A)}));
+
+    // Letting go of the rest sends nothing more
+    release({STN_S1, STN_TL});
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_TRUE(received().empty());
+}
+
+TEST_F(StenoFirstUp, HeldKeysCarryOverIntoTheNextChord) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    press({STN_S1, STN_TL, STN_A});
+    release({STN_A});
+    EXPECT_EQ(received().size(), 1);
+
+    // S and T are still down, so they repeat with the next vowel
+    press({STN_O});
+    release({STN_O});
+    EXPECT_EQ(received(), std::vector<uint64_t>({STENO_KEY_BIT(STN_S1) | STENO_KEY_BIT(STN_TL) | STENO_KEY_BIT(STN_O)}));
+
+    press({STN_E});
+    release({STN_S1, STN_TL, STN_E});
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(received(), std::vector<uint64_t>({STENO_KEY_BIT(STN_S1) | STENO_KEY_BIT(STN_TL) | STENO_KEY_BIT(STN_E)}));
+}
+
+TEST_F(StenoFirstUp, FreshChordAfterEverythingIsReleased) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    press({STN_KL, STN_U});
+    release({STN_KL, STN_U});
+    press({STN_PL, STN_E});
+    release({STN_E});
+    release({STN_PL});
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(received(), std::vector<uint64_t>({STENO_KEY_BIT(STN_KL) | STENO_KEY_BIT(STN_U), STENO_KEY_BIT(STN_PL) | STENO_KEY_BIT(STN_E)}));
+}
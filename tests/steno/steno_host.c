@@ -0,0 +1,85 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "steno_host.h"
+#include "virtser.h"
+#include "process_steno.h"
+
+#define STENO_HOST_BUFFER_SIZE 1024
+
+static uint8_t  received[STENO_HOST_BUFFER_SIZE];
+static uint16_t received_length = 0;
+static uint16_t read_position   = 0;
+static uint16_t transfers       = 0;
+static uint16_t single_bytes    = 0;
+static bool     host_blocked    = false;
+
+void steno_host_reset(void) {
+    received_length = 0;
+    read_position   = 0;
+    transfers       = 0;
+    single_bytes    = 0;
+    host_blocked    = false;
+}
+
+void steno_host_set_blocked(bool blocked) {
+    host_blocked = blocked;
+}
+
+uint16_t steno_host_transfers(void) {
+    return transfers;
+}
+
+uint16_t steno_host_single_bytes(void) {
+    return single_bytes;
+}
+
+bool steno_host_read_chord(uint64_t *keys) {
+    if (read_position == received_length) {
+        return false;
+    }
+
+    *keys = 0;
+    if (received_length - read_position < GEMINI_STROKE_SIZE || !(received[read_position] & 0x80)) {
+        *keys         = UINT64_MAX;
+        read_position = received_length;
+        return true;
+    }
+    for (uint8_t i = 0; i < GEMINI_STROKE_SIZE; i++) {
+        uint8_t byte = received[read_position + i];
+        if (i > 0 && (byte & 0x80)) {
+            *keys         = UINT64_MAX;
+            read_position = received_length;
+            return true;
+        }
+        for (uint8_t bit = 0; bit < 7; bit++) {
+            if (byte & (1 << (6 - bit))) {
+                *keys |= (uint64_t)1 << (i * 7 + bit);
+            }
+        }
+    }
+    read_position += GEMINI_STROKE_SIZE;
+    return true;
+}
+
+void virtser_init(void) {}
+
+void virtser_recv(const uint8_t ch) {}
+
+void virtser_send(const uint8_t byte) {
+    if (received_length < STENO_HOST_BUFFER_SIZE) {
+        received[received_length++] = byte;
+    }
+    single_bytes++;
+}
+
+bool virtser_send_buffer(const uint8_t *data, uint8_t length) {
+    if (host_blocked) {
+        return false;
+    }
+    for (uint8_t i = 0; i < length && received_length < STENO_HOST_BUFFER_SIZE; i++) {
+        received[received_length++] = data[i];
+    }
+    transfers++;
+    return true;
+}
@@ -0,0 +1,26 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define STENO_KEY_BIT(kc) ((uint64_t)1 << ((kc) - QK_STENO))
+
+/* Clears everything the host has received so far */
+void steno_host_reset(void);
+
+/* While blocked, the virtual serial port refuses every transfer */
+void steno_host_set_blocked(bool blocked);
+
+/* Number of transfers the virtual serial port has accepted */
+uint16_t steno_host_transfers(void);
+
+/* Number of bytes sent through virtser_send() one at a time */
+uint16_t steno_host_single_bytes(void);
+
+/* Decodes the next GeminiPR packet into a bitmap of `STENO_KEY_BIT()`s, returns false when there is none.
+ * A packet that isn't framed as six bytes with only the first one having its MSB set is reported as `UINT64_MAX`.
+ */
+bool steno_host_read_chord(uint64_t *keys);
@@ -0,0 +1,150 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <map>
+#include <vector>
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "steno_host.h"
+}
+
+using testing::_;
+
+class Steno : public TestFixture {
+   public:
+    void SetUp() override {
+        steno_host_reset();
+        for (uint8_t i = 0; i < sizeof(steno_keys) / sizeof(steno_keys[0]); i++) {
+            auto key = KeymapKey(0, i % MATRIX_COLS, i / MATRIX_COLS, steno_keys[i]);
+            add_key(key);
+            keys.emplace(steno_keys[i], key);
+        }
+    }
+
+    KeymapKey &key(uint16_t keycode) {
+        return keys.at(keycode);
+    }
+
+    /* Presses all of `chord` one scan after another, then releases them in the same order */
+    uint64_t stroke(const std::vector<uint16_t> &chord) {
+        uint64_t bits = 0;
+        for (uint16_t keycode : chord) {
+            key(keycode).press();
+            run_one_scan_loop();
+            bits |= STENO_KEY_BIT(keycode);
+        }
+        for (uint16_t keycode : chord) {
+            key(keycode).release();
+            run_one_scan_loop();
+        }
+        return bits;
+    }
+
+    std::vector<uint64_t> received() {
+        std::vector<uint64_t> chords;
+        uint64_t              chord;
+        while (steno_host_read_chord(&chord)) {
+            chords.push_back(chord);
+        }
+        return chords;
+    }
+
+    const uint16_t                steno_keys[16] = {STN_N1, STN_S1, STN_TL, STN_KL, STN_PL, STN_WL, STN_HL, STN_RL, STN_A, STN_O, STN_ST1, STN_E, STN_U, STN_FR, STN_RR, STN_ZR};
+    std::map<uint16_t, KeymapKey> keys;
+};
+
+TEST_F(Steno, ChordIsSentAsOnePacketInOneTransfer) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    uint64_t expected = stroke({STN_S1, STN_TL, STN_A, STN_ZR});
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(received(), std::vector<uint64_t>({expected}));
+    EXPECT_EQ(steno_host_transfers(), 1);
+    EXPECT_EQ(steno_host_single_bytes(), 0);
+}
+
+TEST_F(Steno, NothingIsSentWhileKeysAreHeld) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    key(STN_KL).press();
+    key(STN_E).press();
+    run_one_scan_loop();
+    key(STN_KL).release();
+    run_one_scan_loop();
+    EXPECT_TRUE(received().empty());
+
+    // A key pressed after another came up still joins the chord
+    key(STN_RR).press();
+    run_one_scan_loop();
+    key(STN_E).release();
+    key(STN_RR).release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(received(), std::vector<uint64_t>({STENO_KEY_BIT(STN_KL) | STENO_KEY_BIT(STN_E) | STENO_KEY_BIT(STN_RR)}));
+}
+
+TEST_F(Steno, BackToBackStrokesArriveInOrder) {
+    TestDriver                                driver;
+    std::vector<uint64_t>                     expected;
+    const std::vector<std::vector<uint16_t>> strokes = {
+        {STN_TL, STN_HL, STN_E},
+        {STN_KL, STN_WL, STN_U},
+        {STN_KL, STN_WL, STN_RL, STN_FR, STN_RR},
+        {STN_PL, STN_O},
+        {STN_N1, STN_ZR},
+        {STN_ST1},
+    };
+
+    EXPECT_NO_REPORT(driver);
+    for (int i = 0; i < 40; i++) {
+        expected.push_back(stroke(strokes[i % strokes.size()]));
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(received(), expected);
+    EXPECT_EQ(steno_host_transfers(), expected.size());
+}
+
+TEST_F(Steno, ChordsWaitForABusyHost) {
+    TestDriver            driver;
+    std::vector<uint64_t> expected;
+
+    EXPECT_NO_REPORT(driver);
+    steno_host_set_blocked(true);
+    expected.push_back(stroke({STN_S1, STN_A}));
+    expected.push_back(stroke({STN_TL, STN_O}));
+    expected.push_back(stroke({STN_PL, STN_E, STN_ZR}));
+    EXPECT_TRUE(received().empty());
+
+    steno_host_set_blocked(false);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(received(), expected);
+    // Two whole packets fit into a transfer
+    EXPECT_EQ(steno_host_transfers(), 2);
+}
+
+TEST_F(Steno, FullQueueDropsTheOldestChord) {
+    TestDriver            driver;
+    std::vector<uint64_t> expected;
+
+    EXPECT_NO_REPORT(driver);
+    steno_host_set_blocked(true);
+    for (uint16_t keycode : {STN_S1, STN_TL, STN_KL, STN_PL, STN_WL, STN_HL}) {
+        expected.push_back(stroke({keycode}));
+    }
+    steno_host_set_blocked(false);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    expected.erase(expected.begin(), expected.end() - STENO_CHORD_QUEUE_SIZE);
+    EXPECT_EQ(received(), expected);
+}
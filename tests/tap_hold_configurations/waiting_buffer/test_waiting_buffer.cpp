@@ -0,0 +1,181 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+
+using testing::_;
+using testing::Invoke;
+
+/* Home row mods on a s d f j k l, every other letter and space as a regular key */
+static uint16_t keycode_for(char c) {
+    switch (c) {
+        case 'a':
+            return LGUI_T(KC_A);
+        case 's':
+            return LALT_T(KC_S);
+        case 'd':
+            return LCTL_T(KC_D);
+        case 'f':
+            return LSFT_T(KC_F);
+        case 'j':
+            return RSFT_T(KC_J);
+        case 'k':
+            return RCTL_T(KC_K);
+        case 'l':
+            return RALT_T(KC_L);
+        case ' ':
+            return KC_SPACE;
+        default:
+            return KC_A + (c - 'a');
+    }
+}
+
+static char char_for(uint8_t key) {
+    if (key == KC_SPACE) {
+        return ' ';
+    }
+    if (key >= KC_A && key <= KC_Z) {
+        return 'a' + (key - KC_A);
+    }
+    return '?';
+}
+
+class WaitingBuffer : public TestFixture {
+   public:
+    void SetUp() override {
+        std::string chars = "abcdefghijklmnopqrstuvwxyz ";
+        for (size_t i = 0; i < chars.size(); i++) {
+            auto key = KeymapKey(0, i % MATRIX_COLS, i / MATRIX_COLS, keycode_for(chars[i]));
+            add_key(key);
+            keys.emplace(chars[i], key);
+        }
+    }
+
+    void record(TestDriver &driver) {
+        EXPECT_ANY_REPORT(driver).WillRepeatedly(Invoke([this](const report_keyboard_t &report) {
+            mods_seen |= report.mods;
+            for (uint8_t key : report.keys) {
+                if (key != KC_NO && std::find(std::begin(previous.keys), std::end(previous.keys), key) == std::end(previous.keys)) {
+                    typed += char_for(key);
+                }
+            }
+            previous = report;
+        }));
+    }
+
+    /* Types `text` with a press every `interval` ms, each key held for `hold` ms, overlapping the next ones. */
+    void roll(const std::string &text, unsigned interval, unsigned hold) {
+        std::map<unsigned, std::vector<std::pair<char, bool>>> events;
+        std::map<char, unsigned>                               released_at;
+
+        for (size_t i = 0; i < text.size(); i++) {
+            unsigned press = i * interval;
+            char     c     = text[i];
+            // A key typed twice in a row has to come up before it goes down again
+            if (released_at.count(c) && released_at[c] >= press) {
+                auto &pending = events[released_at[c]];
+                pending.erase(std::find(pending.begin(), pending.end(), std::make_pair(c, false)));
+                events[press - 1].push_back({c, false});
+            }
+            events[press].push_back({c, true});
+            events[press + hold].push_back({c, false});
+            released_at[c] = press + hold;
+        }
+
+        unsigned now = 0;
+        for (auto &[time, changes] : events) {
+            if (time > now) {
+                idle_for(time - now);
+                now = time;
+            }
+            for (auto &[c, pressed] : changes) {
+                if (pressed) {
+                    keys.at(c).press();
+                } else {
+                    keys.at(c).release();
+                }
+            }
+            run_one_scan_loop();
+            now++;
+        }
+        idle_for(TAPPING_TERM * 2);
+    }
+
+    std::map<char, KeymapKey> keys;
+    report_keyboard_t         previous  = {};
+    std::string               typed     = "";
+    uint8_t                   mods_seen = 0;
+};
+
+TEST_F(WaitingBuffer, FastRollsOverHomeRowModsAreAllTaps) {
+    TestDriver        driver;
+    const std::string text = "the quick brown fox jumps over the lazy dog as skills and flasks fall off desks ";
+
+    record(driver);
+    // About 240 words per minute, each key held down over the next two
+    roll(text, 50, 120);
+
+    EXPECT_EQ(typed, text);
+    EXPECT_EQ(mods_seen, 0);
+}
+
+TEST_F(WaitingBuffer, RepeatedLettersAreTrackedPerEvent) {
+    TestDriver        driver;
+    const std::string text = "fall asleep add all kiss jazz shall llama dd ss ff jj kk ";
+
+    record(driver);
+    roll(text, 40, 70);
+
+    EXPECT_EQ(typed, text);
+    EXPECT_EQ(mods_seen, 0);
+}
+
+TEST_F(WaitingBuffer, BurstWhileModTapIsUndecidedFitsTheBuffer) {
+    TestDriver driver;
+    // Every tap is two events, on top of the mod-tap release
+    const std::string burst = std::string("qwertyuiopzxcvbnm").substr(0, (WAITING_BUFFER_SIZE - 2) / 2);
+
+    record(driver);
+    keys.at('f').press();
+    run_one_scan_loop();
+    for (char c : burst) {
+        keys.at(c).press();
+        run_one_scan_loop();
+        keys.at(c).release();
+        run_one_scan_loop();
+    }
+    keys.at('f').release();
+    run_one_scan_loop();
+    idle_for(TAPPING_TERM);
+
+    EXPECT_EQ(typed, "f" + burst);
+    EXPECT_EQ(mods_seen, 0);
+}
+
+TEST_F(WaitingBuffer, HoldAfterARollStillResolves) {
+    TestDriver driver;
+
+    record(driver);
+    roll("sad lads ", 30, 60);
+
+    // Held past the tapping term, the mod-tap turns into a modifier
+    keys.at('f').press();
+    idle_for(TAPPING_TERM + 1);
+    keys.at('x').press();
+    run_one_scan_loop();
+    keys.at('x').release();
+    run_one_scan_loop();
+    keys.at('f').release();
+    run_one_scan_loop();
+
+    EXPECT_EQ(typed, "sad lads x");
+    EXPECT_EQ(mods_seen, MOD_BIT(KC_LEFT_SHIFT));
+}
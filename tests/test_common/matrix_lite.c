@@ -0,0 +1,27 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "matrix.h"
+#include "test_matrix.h"
+#include <string.h>
+
+// Switch states, read by matrix_common.c at each scan
+static matrix_row_t switches[MATRIX_ROWS] = {};
+
+bool matrix_scan_custom(matrix_row_t current_matrix[]) {
+    bool changed = memcmp(current_matrix, switches, sizeof(switches)) != 0;
+    memcpy(current_matrix, switches, sizeof(switches));
+    return changed;
+}
+
+void press_key(uint8_t col, uint8_t row) {
+    switches[row] |= (matrix_row_t)1 << col;
+}
+
+void release_key(uint8_t col, uint8_t row) {
+    switches[row] &= ~((matrix_row_t)1 << col);
+}
+
+void clear_all_keys(void) {
+    memset(switches, 0, sizeof(switches));
+}
@@ -15,6 +15,7 @@
  */
 
 #include "test_driver.hpp"
+#include "timer.h"
 
 TestDriver* TestDriver::m_this = nullptr;
 
@@ -31,7 +32,7 @@ uint8_t hex_digit_to_keycode(uint8_t digit) {
 }
 } // namespace
 
-TestDriver::TestDriver() : m_driver{&TestDriver::keyboard_leds, &TestDriver::send_keyboard, &TestDriver::send_nkro, &TestDriver::send_mouse, &TestDriver::send_extra} {
+TestDriver::TestDriver() : m_driver{&TestDriver::keyboard_leds, &TestDriver::send_keyboard, &TestDriver::send_nkro, &TestDriver::send_mouse, &TestDriver::send_extra, &TestDriver::is_ready} {
     host_set_driver(&m_driver);
     m_this = this;
 }
@@ -44,20 +45,42 @@ uint8_t TestDriver::keyboard_leds(void) {
     return m_this->m_leds;
 }
 
+bool TestDriver::is_ready(uint8_t report_id) {
+    if (!m_this->m_busy[report_id]) {
+        return true;
+    }
+    if (timer_elapsed32(m_this->m_busy_since[report_id]) >= m_this->m_busy_period) {
+        m_this->m_busy[report_id] = false;
+        return true;
+    }
+    return false;
+}
+
+void TestDriver::mark_busy(uint8_t report_id) {
+    if (m_this->m_busy_period > 0) {
+        m_this->m_busy[report_id]       = true;
+        m_this->m_busy_since[report_id] = timer_read32();
+    }
+}
+
 void TestDriver::send_keyboard(report_keyboard_t* report) {
     test_logger.trace() << *report;
+    mark_busy(REPORT_ID_KEYBOARD);
     m_this->send_keyboard_mock(*report);
 }
 
 void TestDriver::send_nkro(report_nkro_t* report) {
+    mark_busy(REPORT_ID_NKRO);
     m_this->send_nkro_mock(*report);
 }
 
 void TestDriver::send_mouse(report_mouse_t* report) {
+    mark_busy(REPORT_ID_MOUSE);
     m_this->send_mouse_mock(*report);
 }
 
 void TestDriver::send_extra(report_extra_t* report) {
+    mark_busy(report->report_id);
     m_this->send_extra_mock(*report);
 }
 
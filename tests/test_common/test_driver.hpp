@@ -31,6 +31,14 @@ class TestDriver {
         m_leds = leds;
     }
 
+    /**
+     * @brief Simulate a slow host: after each report, the endpoint carrying
+     * it reports busy for `period` milliseconds. Zero disables the simulation.
+     */
+    void set_endpoint_busy_period(uint16_t period) {
+        m_busy_period = period;
+    }
+
     MOCK_METHOD1(send_keyboard_mock, void(report_keyboard_t&));
     MOCK_METHOD1(send_nkro_mock, void(report_nkro_t&));
     MOCK_METHOD1(send_mouse_mock, void(report_mouse_t&));
@@ -42,8 +50,13 @@ class TestDriver {
     static void        send_nkro(report_nkro_t* report);
     static void        send_mouse(report_mouse_t* report);
     static void        send_extra(report_extra_t* report);
+    static bool        is_ready(uint8_t report_id);
+    static void        mark_busy(uint8_t report_id);
     host_driver_t      m_driver;
-    uint8_t            m_leds = 0;
+    uint8_t            m_leds        = 0;
+    uint16_t           m_busy_period = 0;
+    uint32_t           m_busy_since[REPORT_ID_COUNT + 1] = {};
+    bool               m_busy[REPORT_ID_COUNT + 1]       = {};
     static TestDriver* m_this;
 };
 
@@ -22,6 +22,7 @@ extern "C" {
 #include "debug.h"
 #include "eeconfig.h"
 #include "keyboard.h"
+#include "keymap_common.h"
 
 void set_time(uint32_t t);
 void advance_time(uint32_t ms);
@@ -36,6 +37,7 @@ TestFixture* TestFixture::m_this = nullptr;
  * The actual call is dynamicaly dispatched to the current active test fixture, which in turn has it's own keymap. */
 extern "C" uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t position) {
     uint16_t keycode;
+    TestFixture::m_this->keymap_lookups++;
     TestFixture::m_this->get_keycode(layer, position, &keycode);
     return keycode;
 }
@@ -100,6 +102,7 @@ void TestFixture::add_key(KeymapKey key) {
     }
 
     this->keymap.push_back(key);
+    keymap_lookup_invalidate();
 }
 
 void TestFixture::tap_key(KeymapKey key, unsigned delay_ms) {
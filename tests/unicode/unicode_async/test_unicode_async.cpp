@@ -0,0 +1,429 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "unicode.h"
+}
+
+using testing::_;
+using testing::Invoke;
+
+struct HostInput {
+    std::vector<uint32_t> code_points;
+    int                   caps_lock_taps  = 0;
+    int                   num_lock_taps   = 0;
+    int                   mac_key_presses = 0;
+};
+
+static int hex_value(uint8_t mode, uint8_t key) {
+    if (mode == UNICODE_MODE_WINDOWS) {
+        if (key >= KC_KP_1 && key <= KC_KP_0) {
+            return (key - KC_KP_1 + 1) % 10;
+        }
+    } else if (key >= KC_1 && key <= KC_0) {
+        return (key - KC_1 + 1) % 10;
+    }
+    if (key >= KC_A && key <= KC_F) {
+        return 10 + key - KC_A;
+    }
+    return -1;
+}
+
+/* Replays the reports like each input method on the host would, returning what was entered */
+static HostInput decode(uint8_t mode, const std::vector<report_keyboard_t>& reports) {
+    HostInput         input;
+    report_keyboard_t previous = {};
+    uint8_t           prefix   = 0;
+    bool              entering = false;
+    uint32_t          value    = 0;
+    int               digits   = 0;
+    uint32_t          high     = 0;
+
+    auto commit = [&](uint32_t code_point) {
+        input.code_points.push_back(code_point);
+        entering = false;
+        value    = 0;
+        digits   = 0;
+    };
+
+    for (auto& report : reports) {
+        uint8_t pressed_mods  = report.mods & ~previous.mods;
+        uint8_t released_mods = previous.mods & ~report.mods;
+
+        if (mode == UNICODE_MODE_MACOS && (pressed_mods & MOD_BIT(KC_LEFT_ALT))) {
+            input.mac_key_presses++;
+            entering = true;
+        }
+        if (mode == UNICODE_MODE_WINCOMPOSE && (pressed_mods & MOD_BIT(KC_RIGHT_ALT))) {
+            prefix = 1;
+        }
+        if (released_mods & MOD_BIT(KC_LEFT_ALT)) {
+            if (mode == UNICODE_MODE_WINDOWS && entering) {
+                commit(value);
+            }
+            entering = false;
+        }
+
+        for (uint8_t key : report.keys) {
+            if (key == KC_NO || std::find(std::begin(previous.keys), std::end(previous.keys), key) != std::end(previous.keys)) {
+                continue;
+            }
+            if (key == KC_CAPS_LOCK) {
+                input.caps_lock_taps++;
+                continue;
+            }
+            if (key == KC_NUM_LOCK) {
+                input.num_lock_taps++;
+                continue;
+            }
+
+            if (entering && hex_value(mode, key) >= 0) {
+                value = value * 16 + hex_value(mode, key);
+                digits++;
+                // Unicode Hex Input takes four digits at a time, combining surrogate pairs
+                if (mode == UNICODE_MODE_MACOS && digits == 4) {
+                    if (value >= 0xD800 && value < 0xDC00) {
+                        high   = value;
+                        value  = 0;
+                        digits = 0;
+                    } else if (value >= 0xDC00 && value < 0xE000) {
+                        commit(0x10000 + ((high - 0xD800) << 10) + (value - 0xDC00));
+                    } else {
+                        commit(value);
+                    }
+                    entering = true;
+                }
+                continue;
+            }
+
+            switch (mode) {
+                case UNICODE_MODE_LINUX:
+                    if (key == KC_U && report.mods == (MOD_BIT(KC_LEFT_CTRL) | MOD_BIT(KC_LEFT_SHIFT))) {
+                        entering = true;
+                    } else if (entering && key == KC_SPACE) {
+                        commit(value);
+                    }
+                    break;
+                case UNICODE_MODE_WINDOWS:
+                    if (key == KC_KP_PLUS && (report.mods & MOD_BIT(KC_LEFT_ALT))) {
+                        entering = true;
+                    }
+                    break;
+                case UNICODE_MODE_WINCOMPOSE:
+                    if (prefix == 1 && key == KC_U) {
+                        entering = true;
+                    } else if (entering && key == KC_ENTER) {
+                        commit(value);
+                    }
+                    prefix = 0;
+                    break;
+                case UNICODE_MODE_EMACS:
+                    if (key == KC_X && report.mods == MOD_BIT(KC_LEFT_CTRL)) {
+                        prefix = 1;
+                    } else if (prefix == 1 && key == KC_8) {
+                        prefix = 2;
+                    } else if (prefix == 2 && key == KC_ENTER) {
+                        prefix   = 0;
+                        entering = true;
+                    } else if (entering && key == KC_ENTER) {
+                        commit(value);
+                    } else {
+                        prefix = 0;
+                    }
+                    break;
+            }
+        }
+        previous = report;
+    }
+    return input;
+}
+
+class UnicodeAsync : public TestFixture {
+   public:
+    void SetUp() override {
+        unicode_async_cancel();
+        run_until_idle();
+    }
+
+    void record(TestDriver& driver) {
+        EXPECT_ANY_REPORT(driver).WillRepeatedly(Invoke([this](report_keyboard_t& report) { sent.push_back(report); }));
+    }
+
+    void turn_on_caps_lock(TestDriver& driver) {
+        led_t leds     = {};
+        leds.caps_lock = true;
+        driver.set_leds(leds.raw);
+    }
+
+    void run_until_idle() {
+        for (int i = 0; i < 5000 && unicode_async_is_busy(); i++) {
+            run_one_scan_loop();
+        }
+    }
+
+    std::vector<report_keyboard_t> sent;
+};
+
+class UnicodeAsyncMode : public ::testing::WithParamInterface<uint8_t>, public UnicodeAsync {
+   public:
+    /* A character outside of the Basic Multilingual Plane where the input mode supports it */
+    uint32_t wide_code_point() {
+        return GetParam() == UNICODE_MODE_WINDOWS ? 0x2603 : 0x1F9D9;
+    }
+};
+
+TEST_P(UnicodeAsyncMode, OneCharacterIsTypedLikeRegisterUnicode) {
+    TestDriver driver;
+
+    set_unicode_input_mode(GetParam());
+    record(driver);
+
+    register_unicode(wide_code_point());
+    auto blocking = sent;
+    sent.clear();
+
+    EXPECT_TRUE(register_unicode_async(wide_code_point()));
+    run_until_idle();
+
+    EXPECT_EQ(sent, blocking);
+}
+
+TEST_P(UnicodeAsyncMode, StringIsEnteredOnTheHost) {
+    TestDriver            driver;
+    std::string           text     = GetParam() == UNICODE_MODE_WINDOWS ? "Ψ café ＱＭＫ☃" : "Ψ café 🧙ＱＭＫ";
+    std::vector<uint32_t> expected = {0x03A8, 0x20, 0x63, 0x61, 0x66, 0xE9, 0x20};
+    if (GetParam() == UNICODE_MODE_WINDOWS) {
+        expected.insert(expected.end(), {0xFF31, 0xFF2D, 0xFF2B, 0x2603});
+    } else {
+        expected.insert(expected.end(), {0x1F9D9, 0xFF31, 0xFF2D, 0xFF2B});
+    }
+
+    set_unicode_input_mode(GetParam());
+    record(driver);
+
+    EXPECT_TRUE(send_unicode_string_async(text.c_str()));
+    run_until_idle();
+
+    EXPECT_EQ(decode(GetParam(), sent).code_points, expected);
+    EXPECT_EQ(sent.back(), report_keyboard_t{});
+}
+
+TEST_P(UnicodeAsyncMode, HeldModifiersAreRestoredAfterTheString) {
+    TestDriver driver;
+
+    set_unicode_input_mode(GetParam());
+    add_mods(MOD_BIT(KC_LEFT_GUI));
+    record(driver);
+
+    EXPECT_TRUE(send_unicode_string_async("ΨΨ"));
+    run_until_idle();
+
+    // Nothing is entered with GUI held down
+    for (auto& report : sent) {
+        EXPECT_FALSE(report.mods & MOD_BIT(KC_LEFT_GUI));
+    }
+    EXPECT_EQ(decode(GetParam(), sent).code_points, std::vector<uint32_t>({0x03A8, 0x03A8}));
+    EXPECT_EQ(get_mods(), MOD_BIT(KC_LEFT_GUI));
+
+    clear_mods();
+}
+
+static std::string input_mode_name(const ::testing::TestParamInfo<uint8_t>& info) {
+    const char* names[] = {"macOS", "Linux", "Windows", "BSD", "WinCompose", "Emacs"};
+    return names[info.param];
+}
+
+INSTANTIATE_TEST_CASE_P(InputModes, UnicodeAsyncMode, ::testing::Values(UNICODE_MODE_MACOS, UNICODE_MODE_LINUX, UNICODE_MODE_WINDOWS, UNICODE_MODE_WINCOMPOSE, UNICODE_MODE_EMACS), input_mode_name);
+
+TEST_F(UnicodeAsync, QueueingDoesNotBlock) {
+    TestDriver driver;
+
+    set_unicode_input_mode(UNICODE_MODE_LINUX);
+
+    EXPECT_NO_REPORT(driver);
+    EXPECT_TRUE(send_unicode_string_async("ＱＭＫ！"));
+    VERIFY_AND_CLEAR(driver);
+
+    // Never more than a keycode with its modifiers per scan
+    record(driver);
+    uint16_t remaining = unicode_async_remaining();
+    EXPECT_EQ(remaining, 4);
+    while (unicode_async_is_busy()) {
+        size_t before = sent.size();
+        run_one_scan_loop();
+        EXPECT_LE(sent.size() - before, 2);
+        EXPECT_LE(unicode_async_remaining(), remaining);
+        remaining = unicode_async_remaining();
+    }
+    EXPECT_EQ(remaining, 0);
+    EXPECT_EQ(decode(UNICODE_MODE_LINUX, sent).code_points, std::vector<uint32_t>({0xFF31, 0xFF2D, 0xFF2B, 0xFF01}));
+}
+
+TEST_F(UnicodeAsync, LinuxCapsLockIsToggledOncePerString) {
+    TestDriver driver;
+
+    set_unicode_input_mode(UNICODE_MODE_LINUX);
+    turn_on_caps_lock(driver);
+    record(driver);
+
+    EXPECT_TRUE(send_unicode_string_async("ＱＭＫ！"));
+    run_until_idle();
+
+    auto input = decode(UNICODE_MODE_LINUX, sent);
+    EXPECT_EQ(input.code_points.size(), 4);
+    EXPECT_EQ(input.caps_lock_taps, 2);
+
+    // One at a time, it is toggled around every character
+    sent.clear();
+    send_unicode_string("ＱＭＫ！");
+    EXPECT_EQ(decode(UNICODE_MODE_LINUX, sent).caps_lock_taps, 8);
+}
+
+TEST_F(UnicodeAsync, WindowsNumLockIsToggledOncePerString) {
+    TestDriver driver;
+
+    set_unicode_input_mode(UNICODE_MODE_WINDOWS);
+    record(driver);
+
+    EXPECT_TRUE(send_unicode_string_async("ＱＭＫ！"));
+    run_until_idle();
+
+    auto input = decode(UNICODE_MODE_WINDOWS, sent);
+    EXPECT_EQ(input.code_points.size(), 4);
+    EXPECT_EQ(input.num_lock_taps, 2);
+}
+
+TEST_F(UnicodeAsync, MacOSHoldsTheInputKeyForTheWholeString) {
+    TestDriver driver;
+
+    set_unicode_input_mode(UNICODE_MODE_MACOS);
+    record(driver);
+
+    EXPECT_TRUE(send_unicode_string_async("🧙ＱＭＫ！"));
+    run_until_idle();
+    auto async_reports = sent.size();
+
+    auto input = decode(UNICODE_MODE_MACOS, sent);
+    EXPECT_EQ(input.code_points, std::vector<uint32_t>({0x1F9D9, 0xFF31, 0xFF2D, 0xFF2B, 0xFF01}));
+    EXPECT_EQ(input.mac_key_presses, 1);
+
+    sent.clear();
+    send_unicode_string("🧙ＱＭＫ！");
+    EXPECT_EQ(decode(UNICODE_MODE_MACOS, sent).mac_key_presses, 5);
+    EXPECT_LT(async_reports, sent.size());
+}
+
+TEST_F(UnicodeAsync, CharactersQueuedWhileTypingJoinTheSession) {
+    TestDriver driver;
+
+    set_unicode_input_mode(UNICODE_MODE_LINUX);
+    turn_on_caps_lock(driver);
+    record(driver);
+
+    EXPECT_TRUE(register_unicode_async(0x03A8));
+    for (int i = 0; i < 10; i++) {
+        run_one_scan_loop();
+    }
+    EXPECT_TRUE(register_unicode_async(0x03A9));
+    run_until_idle();
+
+    auto input = decode(UNICODE_MODE_LINUX, sent);
+    EXPECT_EQ(input.code_points, std::vector<uint32_t>({0x03A8, 0x03A9}));
+    EXPECT_EQ(input.caps_lock_taps, 2);
+}
+
+TEST_F(UnicodeAsync, StringThatDoesNotFitIsNotQueued) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    EXPECT_FALSE(send_unicode_string_async("0123456789abcdefg"));
+    EXPECT_FALSE(unicode_async_is_busy());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(UnicodeAsync, CancelAbandonsTheCharacterBeingEntered) {
+    TestDriver driver;
+
+    set_unicode_input_mode(UNICODE_MODE_LINUX);
+    add_mods(MOD_BIT(KC_LEFT_CTRL));
+    record(driver);
+
+    EXPECT_TRUE(send_unicode_string_async("ＱＭＫ"));
+    // Part way through the first character
+    for (int i = 0; i < 5; i++) {
+        run_one_scan_loop();
+    }
+    unicode_async_cancel();
+    EXPECT_EQ(unicode_async_remaining(), 0);
+    run_until_idle();
+
+    EXPECT_TRUE(decode(UNICODE_MODE_LINUX, sent).code_points.empty());
+    auto escape = std::find_if(sent.begin(), sent.end(), [](const report_keyboard_t& report) { return report.keys[0] == KC_ESCAPE; });
+    EXPECT_NE(escape, sent.end());
+    EXPECT_EQ(get_mods(), MOD_BIT(KC_LEFT_CTRL));
+
+    clear_mods();
+}
+
+TEST_F(UnicodeAsync, ModReleasedMidSessionStaysReleased) {
+    TestDriver driver;
+    auto       key_shift = KeymapKey(0, 0, 0, KC_LEFT_SHIFT);
+    set_keymap({key_shift});
+
+    set_unicode_input_mode(UNICODE_MODE_LINUX);
+    key_shift.press();
+    run_one_scan_loop();
+    record(driver);
+
+    EXPECT_TRUE(send_unicode_string_async("ＱＭＫ"));
+    for (int i = 0; i < 5; i++) {
+        run_one_scan_loop();
+    }
+    key_shift.release();
+    run_until_idle();
+    run_one_scan_loop();
+
+    EXPECT_EQ(decode(UNICODE_MODE_LINUX, sent).code_points, std::vector<uint32_t>({0xFF31, 0xFF2D, 0xFF2B}));
+    EXPECT_EQ(get_mods(), 0);
+    EXPECT_EQ(sent.back(), report_keyboard_t{});
+}
+
+TEST_F(UnicodeAsync, KeyPressedMidSessionIsTypedAfterIt) {
+    TestDriver driver;
+    auto       key_a     = KeymapKey(0, 0, 0, KC_A);
+    auto       key_shift = KeymapKey(0, 1, 0, KC_LEFT_SHIFT);
+    set_keymap({key_a, key_shift});
+
+    set_unicode_input_mode(UNICODE_MODE_LINUX);
+    record(driver);
+
+    EXPECT_TRUE(send_unicode_string_async("ＱＭＫ"));
+    for (int i = 0; i < 5; i++) {
+        run_one_scan_loop();
+    }
+    key_shift.press();
+    run_one_scan_loop();
+    key_a.press();
+    run_one_scan_loop();
+    key_a.release();
+    run_one_scan_loop();
+    key_shift.release();
+    run_until_idle();
+    run_one_scan_loop();
+
+    // The shifted A comes after the last character, and doesn't change it
+    EXPECT_EQ(decode(UNICODE_MODE_LINUX, sent).code_points, std::vector<uint32_t>({0xFF31, 0xFF2D, 0xFF2B}));
+    auto shifted_a = std::find_if(sent.begin(), sent.end(), [](const report_keyboard_t& report) { return report.keys[0] == KC_A && report.mods == MOD_BIT(KC_LEFT_SHIFT); });
+    ASSERT_NE(shifted_a, sent.end());
+    auto last_space = std::find_if(sent.rbegin(), sent.rend(), [](const report_keyboard_t& report) { return report.keys[0] == KC_SPACE; });
+    EXPECT_GT(shifted_a - sent.begin(), sent.rend() - last_space - 1);
+    EXPECT_EQ(get_mods(), 0);
+    EXPECT_EQ(sent.back(), report_keyboard_t{});
+}
@@ -54,6 +54,11 @@ ifeq ($(strip $(NKRO_ENABLE)), yes)
     endif
 endif
 
+ifeq ($(strip $(REPORT_QUEUE_ENABLE)), yes)
+    OPT_DEFS += -DREPORT_QUEUE_ENABLE
+    SRC += $(PROTOCOL_DIR)/report_queue.c
+endif
+
 ifeq ($(strip $(RING_BUFFERED_6KRO_REPORT_ENABLE)), yes)
     OPT_DEFS += -DRING_BUFFERED_6KRO_REPORT_ENABLE
 endif
@@ -67,9 +67,10 @@ void    send_keyboard(report_keyboard_t *report);
 void    send_nkro(report_nkro_t *report);
 void    send_mouse(report_mouse_t *report);
 void    send_extra(report_extra_t *report);
+bool    is_ready(uint8_t report_id);
 
 /* host struct */
-host_driver_t chibios_driver = {keyboard_leds, send_keyboard, send_nkro, send_mouse, send_extra};
+host_driver_t chibios_driver = {keyboard_leds, send_keyboard, send_nkro, send_mouse, send_extra, is_ready};
 
 #ifdef VIRTSER_ENABLE
 void virtser_task(void);
@@ -401,6 +401,41 @@ uint8_t keyboard_leds(void) {
     return keyboard_led_state;
 }
 
+/**
+ * @brief Check whether the IN endpoint carrying the given report can enqueue
+ * another report without blocking. The output queue itself is drained from the
+ * USB ISR as each transfer completes.
+ *
+ * @param report_id report id of the report about to be sent
+ * @return true The endpoint has a free buffer
+ * @return false The endpoint is busy
+ */
+bool is_ready(uint8_t report_id) {
+    usb_endpoint_in_lut_t endpoint;
+
+    switch (report_id) {
+        case REPORT_ID_KEYBOARD:
+            endpoint = USB_ENDPOINT_IN_KEYBOARD;
+            break;
+#if defined(MOUSE_ENABLE)
+        case REPORT_ID_MOUSE:
+            endpoint = USB_ENDPOINT_IN_MOUSE;
+            break;
+#endif
+#if defined(SHARED_EP_ENABLE)
+        case REPORT_ID_SYSTEM:
+        case REPORT_ID_CONSUMER:
+        case REPORT_ID_NKRO:
+            endpoint = USB_ENDPOINT_IN_SHARED;
+            break;
+#endif
+        default:
+            return true;
+    }
+
+    return !usb_endpoint_in_is_full(&usb_endpoints_in[endpoint]);
+}
+
 /**
  * @brief Send a report to the host, the report is enqueued into an output
  * queue and send once the USB endpoint becomes empty.
@@ -600,6 +635,26 @@ void virtser_send(const uint8_t byte) {
     send_report_buffered(USB_ENDPOINT_IN_CDC_DATA, (void *)&byte, sizeof(byte));
 }
 
+bool virtser_send_buffer(const uint8_t *data, uint8_t length) {
+    usb_endpoint_in_t *endpoint = &usb_endpoints_in[USB_ENDPOINT_IN_CDC_DATA];
+
+    if (usbGetDriverStateI(endpoint->config.usbp) != USB_ACTIVE) {
+        // Nobody is listening, drop the data like the LUFA implementation does
+        return true;
+    }
+
+    // Hand over whatever virtser_send() left in a partial buffer, then only
+    // send into a free buffer, which never has to wait for the host
+    flush_report_buffered(USB_ENDPOINT_IN_CDC_DATA, false);
+    if (usb_endpoint_in_is_full(endpoint)) {
+        return false;
+    }
+
+    send_report_buffered(USB_ENDPOINT_IN_CDC_DATA, (void *)data, length);
+    flush_report_buffered(USB_ENDPOINT_IN_CDC_DATA, false);
+    return true;
+}
+
 __attribute__((weak)) void virtser_recv(uint8_t c) {
     // Ignore by default
 }
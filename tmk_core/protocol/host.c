@@ -40,6 +40,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 extern keymap_config_t keymap_config;
 #endif
 
+#ifdef REPORT_QUEUE_ENABLE
+#    include "report_queue.h"
+#endif
+
 static host_driver_t *driver;
 static uint16_t       last_system_usage   = 0;
 static uint16_t       last_consumer_usage = 0;
@@ -71,6 +75,17 @@ led_t host_keyboard_led_state(void) {
     return (led_t)host_keyboard_leds();
 }
 
+bool host_keyboard_is_ready(void) {
+    if (!driver) return false;
+    if (!driver->is_ready) return true;
+#ifdef NKRO_ENABLE
+    if (keyboard_protocol && keymap_config.nkro) {
+        return driver->is_ready(REPORT_ID_NKRO);
+    }
+#endif
+    return driver->is_ready(REPORT_ID_KEYBOARD);
+}
+
 /* send report */
 void host_keyboard_send(report_keyboard_t *report) {
 #ifdef BLUETOOTH_ENABLE
@@ -84,7 +99,11 @@ void host_keyboard_send(report_keyboard_t *report) {
 #ifdef KEYBOARD_SHARED_EP
     report->report_id = REPORT_ID_KEYBOARD;
 #endif
+#ifdef REPORT_QUEUE_ENABLE
+    report_queue_keyboard(report);
+#else
     (*driver->send_keyboard)(report);
+#endif
 
     if (debug_keyboard) {
         dprintf("keyboard_report: %02X | ", report->mods);
@@ -98,7 +117,11 @@ void host_keyboard_send(report_keyboard_t *report) {
 void host_nkro_send(report_nkro_t *report) {
     if (!driver) return;
     report->report_id = REPORT_ID_NKRO;
+#ifdef REPORT_QUEUE_ENABLE
+    report_queue_nkro(report);
+#else
     (*driver->send_nkro)(report);
+#endif
 
     if (debug_keyboard) {
         dprintf("nkro_report: %02X | ", report->mods);
@@ -126,7 +149,11 @@ void host_mouse_send(report_mouse_t *report) {
     report->boot_x = (report->x > 127) ? 127 : ((report->x < -127) ? -127 : report->x);
     report->boot_y = (report->y > 127) ? 127 : ((report->y < -127) ? -127 : report->y);
 #endif
+#ifdef REPORT_QUEUE_ENABLE
+    report_queue_mouse(report);
+#else
     (*driver->send_mouse)(report);
+#endif
 }
 
 void host_system_send(uint16_t usage) {
@@ -139,7 +166,11 @@ void host_system_send(uint16_t usage) {
         .report_id = REPORT_ID_SYSTEM,
         .usage     = usage,
     };
+#ifdef REPORT_QUEUE_ENABLE
+    report_queue_extra(&report);
+#else
     (*driver->send_extra)(&report);
+#endif
 }
 
 void host_consumer_send(uint16_t usage) {
@@ -159,7 +190,11 @@ void host_consumer_send(uint16_t usage) {
         .report_id = REPORT_ID_CONSUMER,
         .usage     = usage,
     };
+#ifdef REPORT_QUEUE_ENABLE
+    report_queue_extra(&report);
+#else
     (*driver->send_extra)(&report);
+#endif
 }
 
 #ifdef JOYSTICK_ENABLE
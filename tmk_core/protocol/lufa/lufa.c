@@ -85,7 +85,8 @@ static void    send_keyboard(report_keyboard_t *report);
 static void    send_nkro(report_nkro_t *report);
 static void    send_mouse(report_mouse_t *report);
 static void    send_extra(report_extra_t *report);
-host_driver_t  lufa_driver = {keyboard_leds, send_keyboard, send_nkro, send_mouse, send_extra};
+static bool    is_ready(uint8_t report_id);
+host_driver_t  lufa_driver = {keyboard_leds, send_keyboard, send_nkro, send_mouse, send_extra, is_ready};
 
 void send_report(uint8_t endpoint, void *report, size_t size) {
     uint8_t timeout = 255;
@@ -530,6 +531,43 @@ static uint8_t keyboard_leds(void) {
     return keyboard_led_state;
 }
 
+/** \brief Check whether the IN endpoint carrying the given report has a free bank
+ *
+ * While the device is not configured, reports are dropped by send_report() anyway.
+ */
+static bool is_ready(uint8_t report_id) {
+    uint8_t endpoint;
+
+    switch (report_id) {
+        case REPORT_ID_KEYBOARD:
+            endpoint = KEYBOARD_IN_EPNUM;
+            break;
+#if defined(MOUSE_ENABLE)
+        case REPORT_ID_MOUSE:
+            endpoint = MOUSE_IN_EPNUM;
+            break;
+#endif
+#if defined(SHARED_EP_ENABLE)
+        case REPORT_ID_SYSTEM:
+        case REPORT_ID_CONSUMER:
+        case REPORT_ID_NKRO:
+            endpoint = SHARED_IN_EPNUM;
+            break;
+#endif
+        default:
+            return true;
+    }
+
+    if (USB_DeviceState != DEVICE_STATE_Configured) return true;
+
+    uint8_t previous_endpoint = Endpoint_GetCurrentEndpoint();
+    Endpoint_SelectEndpoint(endpoint);
+    bool ready = Endpoint_IsReadWriteAllowed();
+    Endpoint_SelectEndpoint(previous_endpoint);
+
+    return ready;
+}
+
 /** \brief Send Keyboard
  *
  * FIXME: Needs doc
@@ -760,6 +798,42 @@ void virtser_send(const uint8_t byte) {
         Endpoint_SelectEndpoint(ep);
     }
 }
+
+/** \brief Virtual Serial Send Buffer
+ *
+ * Sends all of `data` in a single IN transfer, without waiting for the endpoint.
+ * `length` must be less than CDC_EPSIZE, so that the transfer is a single short
+ * packet and no zero length packet has to be waited for after it.
+ */
+bool virtser_send_buffer(const uint8_t *data, uint8_t length) {
+    uint8_t ep = Endpoint_GetCurrentEndpoint();
+
+    if (!(cdc_device.State.ControlLineStates.HostToDevice & CDC_CONTROL_LINE_OUT_DTR)) {
+        // Nobody is listening, drop the data like virtser_send() does
+        return true;
+    }
+
+    Endpoint_SelectEndpoint(cdc_device.Config.DataINEndpoint.Address);
+
+    if (!Endpoint_IsEnabled() || !Endpoint_IsConfigured()) {
+        Endpoint_SelectEndpoint(ep);
+        return true;
+    }
+
+    if (!Endpoint_IsReadWriteAllowed()) {
+        // The host hasn't picked up the previous transfer yet, try again later
+        Endpoint_SelectEndpoint(ep);
+        return false;
+    }
+
+    for (uint8_t i = 0; i < length; i++) {
+        Endpoint_Write_8(data[i]);
+    }
+    Endpoint_ClearIN();
+
+    Endpoint_SelectEndpoint(ep);
+    return true;
+}
 #endif
 
 /*******************************************************************************
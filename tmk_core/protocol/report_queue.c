@@ -0,0 +1,241 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "report_queue.h"
+#include "host.h"
+
+_Static_assert((REPORT_QUEUE_KEYBOARD_SIZE & (REPORT_QUEUE_KEYBOARD_SIZE - 1)) == 0 && REPORT_QUEUE_KEYBOARD_SIZE <= 128, "REPORT_QUEUE_KEYBOARD_SIZE must be a power of two no larger than 128");
+_Static_assert((REPORT_QUEUE_MOUSE_SIZE & (REPORT_QUEUE_MOUSE_SIZE - 1)) == 0 && REPORT_QUEUE_MOUSE_SIZE <= 128, "REPORT_QUEUE_MOUSE_SIZE must be a power of two no larger than 128");
+
+#define REPORT_RING(name, type, size)             \
+    static type          name##_buffer[size];     \
+    static report_ring_t name = {                 \
+        .buffer       = (uint8_t *)name##_buffer, \
+        .element_size = sizeof(type),             \
+        .capacity     = size,                     \
+    }
+
+/* ---------------------------------------------------------------------------
+ * Report ring
+ * ------------------------------------------------------------------------ */
+
+bool report_ring_push(report_ring_t *queue, const void *element) {
+    if ((uint8_t)(queue->head - queue->tail) >= queue->capacity) {
+        return false;
+    }
+
+    memcpy(&queue->buffer[(queue->head & (queue->capacity - 1)) * queue->element_size], element, queue->element_size);
+    queue->head++;
+    return true;
+}
+
+void *report_ring_peek(report_ring_t *queue) {
+    if (queue->head == queue->tail) {
+        return NULL;
+    }
+
+    return &queue->buffer[(queue->tail & (queue->capacity - 1)) * queue->element_size];
+}
+
+void report_ring_pop(report_ring_t *queue) {
+    queue->tail++;
+}
+
+bool report_ring_is_empty(report_ring_t *queue) {
+    return queue->head == queue->tail;
+}
+
+/* ---------------------------------------------------------------------------
+ * Host report queues
+ * ------------------------------------------------------------------------ */
+
+REPORT_RING(keyboard_queue, report_keyboard_t, REPORT_QUEUE_KEYBOARD_SIZE);
+#ifdef NKRO_ENABLE
+REPORT_RING(nkro_queue, report_nkro_t, REPORT_QUEUE_KEYBOARD_SIZE);
+#endif
+#ifdef MOUSE_ENABLE
+REPORT_RING(mouse_queue, report_mouse_t, REPORT_QUEUE_MOUSE_SIZE);
+
+static report_mouse_t mouse_pending;
+static bool           mouse_pending_valid = false;
+#endif
+
+// Two reports per ID are enough for a press and its release to both get out while the endpoint is busy
+REPORT_RING(system_queue, report_extra_t, 2);
+REPORT_RING(consumer_queue, report_extra_t, 2);
+
+static bool endpoint_ready(host_driver_t *driver, uint8_t report_id) {
+    return driver->is_ready == NULL || driver->is_ready(report_id);
+}
+
+static void drain_keyboard(host_driver_t *driver, bool force) {
+    report_keyboard_t *report;
+    while ((report = report_ring_peek(&keyboard_queue)) != NULL && (force || endpoint_ready(driver, REPORT_ID_KEYBOARD))) {
+        (*driver->send_keyboard)(report);
+        report_ring_pop(&keyboard_queue);
+        force = false;
+    }
+}
+
+#ifdef NKRO_ENABLE
+static void drain_nkro(host_driver_t *driver, bool force) {
+    report_nkro_t *report;
+    while ((report = report_ring_peek(&nkro_queue)) != NULL && (force || endpoint_ready(driver, REPORT_ID_NKRO))) {
+        (*driver->send_nkro)(report);
+        report_ring_pop(&nkro_queue);
+        force = false;
+    }
+}
+#endif
+
+static void drain_extra(host_driver_t *driver, report_ring_t *queue, uint8_t report_id) {
+    report_extra_t *report;
+    while ((report = report_ring_peek(queue)) != NULL && endpoint_ready(driver, report_id)) {
+        (*driver->send_extra)(report);
+        report_ring_pop(queue);
+    }
+}
+
+#ifdef MOUSE_ENABLE
+static void drain_mouse(host_driver_t *driver, bool force) {
+    report_mouse_t *report;
+    while ((report = report_ring_peek(&mouse_queue)) != NULL && (force || endpoint_ready(driver, REPORT_ID_MOUSE))) {
+        (*driver->send_mouse)(report);
+        report_ring_pop(&mouse_queue);
+        force = false;
+    }
+}
+
+static bool mouse_can_merge(report_mouse_t *into, report_mouse_t *from) {
+#    ifdef MOUSE_EXTENDED_REPORT
+    const int32_t xy_max = 32767;
+#    else
+    const int32_t xy_max = 127;
+#    endif
+    int32_t x = (int32_t)into->x + from->x;
+    int32_t y = (int32_t)into->y + from->y;
+    int16_t v = (int16_t)into->v + from->v;
+    int16_t h = (int16_t)into->h + from->h;
+
+    return into->buttons == from->buttons && x >= -xy_max && x <= xy_max && y >= -xy_max && y <= xy_max && v >= -127 && v <= 127 && h >= -127 && h <= 127;
+}
+
+static void mouse_merge(report_mouse_t *into, report_mouse_t *from) {
+    into->x += from->x;
+    into->y += from->y;
+    into->v += from->v;
+    into->h += from->h;
+#    ifdef MOUSE_EXTENDED_REPORT
+    into->boot_x = (into->x > 127) ? 127 : ((into->x < -127) ? -127 : into->x);
+    into->boot_y = (into->y > 127) ? 127 : ((into->y < -127) ? -127 : into->y);
+#    endif
+}
+#endif
+
+void report_queue_keyboard(report_keyboard_t *report) {
+    host_driver_t *driver = host_get_driver();
+    if (!driver) return;
+
+    while (!report_ring_push(&keyboard_queue, report)) {
+        // Never drop a keyboard state, fall back to a blocking send of the oldest one
+        drain_keyboard(driver, true);
+    }
+    report_queue_task();
+}
+
+void report_queue_nkro(report_nkro_t *report) {
+#ifdef NKRO_ENABLE
+    host_driver_t *driver = host_get_driver();
+    if (!driver) return;
+
+    while (!report_ring_push(&nkro_queue, report)) {
+        drain_nkro(driver, true);
+    }
+    report_queue_task();
+#endif
+}
+
+void report_queue_mouse(report_mouse_t *report) {
+#ifdef MOUSE_ENABLE
+    host_driver_t *driver = host_get_driver();
+    if (!driver) return;
+
+    if (mouse_pending_valid) {
+        if (mouse_can_merge(&mouse_pending, report)) {
+            mouse_merge(&mouse_pending, report);
+            report_queue_task();
+            return;
+        }
+        // Button state changed, the accumulated movement has to go out first
+        while (!report_ring_push(&mouse_queue, &mouse_pending)) {
+            drain_mouse(driver, true);
+        }
+    }
+
+    memcpy(&mouse_pending, report, sizeof(report_mouse_t));
+    mouse_pending_valid = true;
+    report_queue_task();
+#endif
+}
+
+void report_queue_extra(report_extra_t *report) {
+    report_ring_t *queue = report->report_id == REPORT_ID_SYSTEM ? &system_queue : &consumer_queue;
+
+    if (!report_ring_push(queue, report)) {
+        report_extra_t *oldest = report_ring_peek(queue);
+        report_extra_t *newest = (report_extra_t *)&queue->buffer[((queue->head - 1) & (queue->capacity - 1)) * queue->element_size];
+        if (report->usage == 0 && newest->usage != 0) {
+            // A release never replaces a press that hasn't gone out, the press before that one makes way instead
+            *oldest = *newest;
+        }
+        *newest = *report;
+    }
+    report_queue_task();
+}
+
+void report_queue_task(void) {
+    host_driver_t *driver = host_get_driver();
+    if (!driver) return;
+
+    drain_keyboard(driver, false);
+#ifdef NKRO_ENABLE
+    drain_nkro(driver, false);
+#endif
+
+#ifdef MOUSE_ENABLE
+    drain_mouse(driver, false);
+    // Movement keeps accumulating until the endpoint can actually take it
+    if (mouse_pending_valid && report_ring_is_empty(&mouse_queue) && endpoint_ready(driver, REPORT_ID_MOUSE)) {
+        report_ring_push(&mouse_queue, &mouse_pending);
+        mouse_pending_valid = false;
+        drain_mouse(driver, false);
+    }
+#endif
+
+    drain_extra(driver, &system_queue, REPORT_ID_SYSTEM);
+    drain_extra(driver, &consumer_queue, REPORT_ID_CONSUMER);
+}
+
+void report_queue_clear(void) {
+    while (report_ring_peek(&keyboard_queue) != NULL) {
+        report_ring_pop(&keyboard_queue);
+    }
+#ifdef NKRO_ENABLE
+    while (report_ring_peek(&nkro_queue) != NULL) {
+        report_ring_pop(&nkro_queue);
+    }
+#endif
+#ifdef MOUSE_ENABLE
+    while (report_ring_peek(&mouse_queue) != NULL) {
+        report_ring_pop(&mouse_queue);
+    }
+    mouse_pending_valid = false;
+#endif
+    while (report_ring_peek(&system_queue) != NULL) {
+        report_ring_pop(&system_queue);
+    }
+    while (report_ring_peek(&consumer_queue) != NULL) {
+        report_ring_pop(&consumer_queue);
+    }
+}
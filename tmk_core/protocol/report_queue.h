@@ -0,0 +1,69 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "report.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Depth of the keyboard and NKRO report queues, must be a power of two. */
+#ifndef REPORT_QUEUE_KEYBOARD_SIZE
+#    define REPORT_QUEUE_KEYBOARD_SIZE 8
+#endif
+
+/* Depth of the mouse report queue, must be a power of two. */
+#ifndef REPORT_QUEUE_MOUSE_SIZE
+#    define REPORT_QUEUE_MOUSE_SIZE 4
+#endif
+
+/**
+ * \brief Bounded ring of fixed size elements.
+ *
+ * Reports are queued and handed to the driver from the main loop only, so the ring needs no locking.
+ * `head` and `tail` are free running counters, so `head - tail` is the number of queued elements.
+ */
+typedef struct {
+    uint8_t *buffer;
+    uint8_t  element_size;
+    uint8_t  capacity;
+    uint8_t  head;
+    uint8_t  tail;
+} report_ring_t;
+
+bool  report_ring_push(report_ring_t *queue, const void *element);
+void *report_ring_peek(report_ring_t *queue);
+void  report_ring_pop(report_ring_t *queue);
+bool  report_ring_is_empty(report_ring_t *queue);
+
+/**
+ * \brief Queue reports for the host, applying per report type coalescing rules.
+ *
+ * - Keyboard and NKRO states are all delivered, in order.
+ * - Mouse movement and wheel deltas accumulate while the endpoint is busy, as long as
+ *   the button state is unchanged.
+ * - System and consumer reports are last-writer-wins, except that a press which has not
+ *   gone out yet is only replaced by a later press, never by a release.
+ */
+void report_queue_keyboard(report_keyboard_t *report);
+void report_queue_nkro(report_nkro_t *report);
+void report_queue_mouse(report_mouse_t *report);
+void report_queue_extra(report_extra_t *report);
+
+/**
+ * \brief Hand queued reports to the host driver for as long as its endpoints are ready.
+ */
+void report_queue_task(void);
+
+/**
+ * \brief Discard all queued and pending reports.
+ */
+void report_queue_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -217,8 +217,9 @@ static void    send_keyboard(report_keyboard_t *report);
 static void    send_nkro(report_nkro_t *report);
 static void    send_mouse(report_mouse_t *report);
 static void    send_extra(report_extra_t *report);
+static bool    is_ready(uint8_t report_id);
 
-static host_driver_t driver = {keyboard_leds, send_keyboard, send_nkro, send_mouse, send_extra};
+static host_driver_t driver = {keyboard_leds, send_keyboard, send_nkro, send_mouse, send_extra, is_ready};
 
 host_driver_t *vusb_driver(void) {
     return &driver;
@@ -264,6 +265,37 @@ static void send_extra(report_extra_t *report) {
 #endif
 }
 
+static bool is_ready(uint8_t report_id) {
+    uint8_t endpoint;
+
+    switch (report_id) {
+        case REPORT_ID_KEYBOARD:
+            endpoint = 1;
+            break;
+        case REPORT_ID_NKRO:
+            endpoint = 3;
+            break;
+        case REPORT_ID_MOUSE:
+            endpoint = MOUSE_IN_EPNUM;
+            break;
+        case REPORT_ID_SYSTEM:
+        case REPORT_ID_CONSUMER:
+            endpoint = SHARED_IN_EPNUM;
+            break;
+        default:
+            return true;
+    }
+
+    switch (endpoint) {
+        case 1:
+            return usbInterruptIsReady();
+        case USB_CFG_EP3_NUMBER:
+            return usbInterruptIsReady3();
+        default:
+            return true;
+    }
+}
+
 void send_joystick(report_joystick_t *report) {
 #ifdef JOYSTICK_ENABLE
     send_report(SHARED_IN_EPNUM, report, sizeof(report_joystick_t));